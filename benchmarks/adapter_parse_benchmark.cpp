@@ -0,0 +1,180 @@
+#include <benchmark/benchmark.h>
+#include "benchmark_payloads.h"
+#include "adapters/elegoo_cc_adapters.h"
+#include "adapters/elegoo_cc2_adapters.h"
+#include "adapters/generic_moonraker_adapters.h"
+
+using namespace elink;
+using namespace elink::benchmarks;
+
+namespace
+{
+    /**
+     * Exposes the status cache merge of the CC2 adapter so it can be measured in isolation
+     */
+    class BenchCC2MessageAdapter : public ElegooFdmCC2MessageAdapter
+    {
+    public:
+        using ElegooFdmCC2MessageAdapter::ElegooFdmCC2MessageAdapter;
+        using ElegooFdmCC2MessageAdapter::cacheFullPrinterStatusJson;
+        using ElegooFdmCC2MessageAdapter::mergeStatusUpdateJson;
+    };
+
+    /**
+     * Exposes the status cache merge of the Moonraker adapter so it can be measured in isolation
+     */
+    class BenchMoonrakerMessageAdapter : public GenericMoonrakerMessageAdapter
+    {
+    public:
+        using GenericMoonrakerMessageAdapter::GenericMoonrakerMessageAdapter;
+        using GenericMoonrakerMessageAdapter::cacheFullPrinterStatusJson;
+        using GenericMoonrakerMessageAdapter::mergeStatusUpdateJson;
+    };
+
+    // Rewrite the status event id so that every iteration passes the continuity check
+    std::string withEventId(const nlohmann::json &message, int id)
+    {
+        nlohmann::json copy = message;
+        copy["id"] = id;
+        return copy.dump();
+    }
+}
+
+// ========== CC1 (SDCP over WebSocket) ==========
+
+static void BM_CC1_ParseStatusEvent(benchmark::State &state)
+{
+    ElegooFdmCCMessageAdapter adapter(SharedPrinterInfo::create(makePrinterInfo(PrinterType::ELEGOO_FDM_CC, 0)));
+    const std::string payload = loadPayload("cc1_sdcp_status.json");
+
+    for (auto _ : state)
+    {
+        MessageParseScope parseScope(payload); // As BasePrinter::onMessage does
+        auto types = adapter.parseMessageType(payload);
+        auto event = adapter.convertToEvent(payload);
+        benchmark::DoNotOptimize(types);
+        benchmark::DoNotOptimize(event);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * payload.size()));
+}
+BENCHMARK(BM_CC1_ParseStatusEvent);
+
+// ========== CC2 (MQTT) ==========
+
+static void BM_CC2_ParseFullStatus(benchmark::State &state)
+{
+    ElegooFdmCC2MessageAdapter adapter(SharedPrinterInfo::create(makePrinterInfo(PrinterType::ELEGOO_FDM_CC2, 0)));
+    const std::string payload = loadPayload("cc2_full_status.json");
+
+    for (auto _ : state)
+    {
+        auto event = adapter.convertToEvent(payload);
+        benchmark::DoNotOptimize(event);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * payload.size()));
+}
+BENCHMARK(BM_CC2_ParseFullStatus);
+
+// Attributes pushed again unchanged, as printers do on every request
+static void BM_CC2_ParseAttributes(benchmark::State &state)
+{
+    ElegooFdmCC2MessageAdapter adapter(SharedPrinterInfo::create(makePrinterInfo(PrinterType::ELEGOO_FDM_CC2, 0)));
+    const std::string payload = loadPayload("cc2_attributes.json");
+
+    for (auto _ : state)
+    {
+        auto event = adapter.convertToEvent(payload);
+        benchmark::DoNotOptimize(event);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * payload.size()));
+}
+BENCHMARK(BM_CC2_ParseAttributes);
+
+static void BM_CC2_ParseStatusDelta(benchmark::State &state)
+{
+    ElegooFdmCC2MessageAdapter adapter(SharedPrinterInfo::create(makePrinterInfo(PrinterType::ELEGOO_FDM_CC2, 0)));
+    const std::string fullStatus = loadPayload("cc2_full_status.json");
+    adapter.convertToEvent(fullStatus);
+
+    // Pre-render a window of consecutive 6000 events so the id rewrite is not measured
+    const auto delta = nlohmann::json::parse(loadPayload("cc2_status_delta.json"));
+    std::vector<std::string> payloads;
+    for (int i = 0; i < 1024; ++i)
+    {
+        payloads.push_back(withEventId(delta, i + 1));
+    }
+
+    size_t index = 0;
+    int64_t bytes = 0;
+    for (auto _ : state)
+    {
+        if (index == payloads.size())
+        {
+            // Restart the event sequence from a fresh full status once the window is exhausted
+            state.PauseTiming();
+            adapter.resetStatusSequence();
+            adapter.convertToEvent(fullStatus);
+            index = 0;
+            state.ResumeTiming();
+        }
+        const std::string &payload = payloads[index++];
+        MessageParseScope parseScope(payload); // As BasePrinter::onMessage does
+        auto types = adapter.parseMessageType(payload);
+        auto event = adapter.convertToEvent(payload);
+        benchmark::DoNotOptimize(types);
+        benchmark::DoNotOptimize(event);
+        bytes += static_cast<int64_t>(payload.size());
+    }
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_CC2_ParseStatusDelta);
+
+static void BM_CC2_MergeStatusUpdateJson(benchmark::State &state)
+{
+    BenchCC2MessageAdapter adapter(SharedPrinterInfo::create(makePrinterInfo(PrinterType::ELEGOO_FDM_CC2, 0)));
+    const auto full = nlohmann::json::parse(loadPayload("cc2_full_status.json"));
+    const auto delta = nlohmann::json::parse(loadPayload("cc2_status_delta.json"));
+    adapter.cacheFullPrinterStatusJson(full["result"]);
+
+    for (auto _ : state)
+    {
+        auto merged = adapter.mergeStatusUpdateJson(delta["result"]);
+        benchmark::DoNotOptimize(merged);
+    }
+}
+BENCHMARK(BM_CC2_MergeStatusUpdateJson);
+
+// ========== Moonraker (JSON-RPC over WebSocket) ==========
+
+static void BM_Moonraker_ParseNotifyStatusUpdate(benchmark::State &state)
+{
+    GenericMoonrakerMessageAdapter adapter(SharedPrinterInfo::create(makePrinterInfo(PrinterType::GENERIC_FDM_KLIPPER, 0)));
+    adapter.convertToEvent(loadPayload("moonraker_full_status.json"));
+    const std::string payload = loadPayload("moonraker_notify_status_update.json");
+
+    for (auto _ : state)
+    {
+        MessageParseScope parseScope(payload); // As BasePrinter::onMessage does
+        auto types = adapter.parseMessageType(payload);
+        auto event = adapter.convertToEvent(payload);
+        benchmark::DoNotOptimize(types);
+        benchmark::DoNotOptimize(event);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * payload.size()));
+}
+BENCHMARK(BM_Moonraker_ParseNotifyStatusUpdate);
+
+static void BM_Moonraker_MergeStatusUpdateJson(benchmark::State &state)
+{
+    BenchMoonrakerMessageAdapter adapter(SharedPrinterInfo::create(makePrinterInfo(PrinterType::GENERIC_FDM_KLIPPER, 0)));
+    const auto full = nlohmann::json::parse(loadPayload("moonraker_full_status.json"));
+    const auto update = nlohmann::json::parse(loadPayload("moonraker_notify_status_update.json"));
+    adapter.cacheFullPrinterStatusJson(full["result"]["status"]);
+
+    for (auto _ : state)
+    {
+        auto merged = adapter.mergeStatusUpdateJson(update["params"][0]);
+        benchmark::DoNotOptimize(merged);
+    }
+}
+BENCHMARK(BM_Moonraker_MergeStatusUpdateJson);
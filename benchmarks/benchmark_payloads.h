@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <stdexcept>
+#include "type.h"
+#include "utils/utils.h"
+
+namespace elink
+{
+    namespace benchmarks
+    {
+        /**
+         * Load a recorded printer payload from the benchmarks/payloads directory
+         * @param name Payload file name (e.g., "cc2_status_delta.json")
+         * @return Raw payload content exactly as received from the printer
+         */
+        inline std::string loadPayload(const std::string &name)
+        {
+            const std::string path = std::string(ELINK_BENCHMARK_PAYLOAD_DIR) + "/" + name;
+            std::string content = FileUtils::readFile(path);
+            if (content.empty())
+            {
+                throw std::runtime_error("Missing benchmark payload: " + path);
+            }
+            return content;
+        }
+
+        /**
+         * Build a printer info record for benchmark fixtures
+         * @param type Printer type
+         * @param index Printer index, used to derive a unique printer ID and host
+         * @return Printer information
+         */
+        inline PrinterInfo makePrinterInfo(PrinterType type, int index)
+        {
+            PrinterInfo info;
+            info.printerId = "bench-printer-" + std::to_string(index);
+            info.printerType = type;
+            info.brand = "Elegoo";
+            info.manufacturer = "Elegoo";
+            info.name = "Bench Printer " + std::to_string(index);
+            info.model = "Centauri Carbon";
+            info.firmwareVersion = "1.1.25";
+            info.mainboardId = "2c7f81a05e1b" + std::to_string(1000 + index);
+            info.serialNumber = "F01PB" + std::to_string(100000 + index);
+            info.host = "127.0." + std::to_string((index >> 8) & 0xFF) + "." + std::to_string(index & 0xFF);
+            info.webUrl = "http://" + info.host;
+            return info;
+        }
+    } // namespace benchmarks
+} // namespace elink
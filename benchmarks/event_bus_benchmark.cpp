@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include "benchmark_payloads.h"
+#include "events/event_system.h"
+#include "events/event_export.h"
+#include "types/internal/internal.h"
+#include "types/internal/json_serializer.h"
+#include "adapters/elegoo_cc2_adapters.h"
+
+using namespace elink;
+using namespace elink::benchmarks;
+
+namespace
+{
+    // Status snapshot produced by the CC2 adapter from a recorded full status payload
+    PrinterStatusData recordedStatus()
+    {
+        ElegooFdmCC2MessageAdapter adapter(SharedPrinterInfo::create(makePrinterInfo(PrinterType::ELEGOO_FDM_CC2, 0)));
+        auto event = adapter.convertToEvent(loadPayload("cc2_full_status.json"));
+        return event.data.value().get<PrinterStatusData>();
+    }
+}
+
+// Typed publish fan-out, range(0) is the number of subscribers
+static void BM_EventBus_Publish(benchmark::State &state)
+{
+    EventBus bus;
+    std::atomic<int64_t> delivered{0};
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        bus.subscribe<PrinterStatusEvent>([&delivered](const std::shared_ptr<PrinterStatusEvent> &event)
+                                          {
+            benchmark::DoNotOptimize(event->status.printerStatus.state);
+            delivered.fetch_add(1, std::memory_order_relaxed); });
+    }
+
+    auto event = std::make_shared<PrinterStatusEvent>();
+    event->status = recordedStatus();
+
+    for (auto _ : state)
+    {
+        bus.publish<PrinterStatusEvent>(event);
+    }
+    state.counters["deliveries"] = benchmark::Counter(static_cast<double>(delivered.load()), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_EventBus_Publish)->Arg(1)->Arg(4)->Arg(16)->Arg(64);
+
+// Full BizEvent -> typed event conversion and fan-out as used by LanService event forwarding
+static void BM_EventBus_PublishFromEvent(benchmark::State &state)
+{
+    EventBus bus;
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        bus.subscribe<PrinterStatusEvent>([](const std::shared_ptr<PrinterStatusEvent> &event)
+                                          { benchmark::DoNotOptimize(event->status.printerStatus.state); });
+    }
+
+    BizEvent bizEvent;
+    bizEvent.method = MethodType::ON_PRINTER_STATUS;
+    bizEvent.data = recordedStatus();
+
+    for (auto _ : state)
+    {
+        bus.publishFromEvent(bizEvent);
+    }
+}
+BENCHMARK(BM_EventBus_PublishFromEvent)->Arg(1)->Arg(4)->Arg(16)->Arg(64);
+
+// ========== Event export ==========
+
+// JSON text of a status event, what an external pipeline had to parse before binary export
+static void BM_EventExport_JsonText(benchmark::State &state)
+{
+    BizEvent bizEvent(MethodType::ON_PRINTER_STATUS, recordedStatus());
+    int64_t bytes = 0;
+    for (auto _ : state)
+    {
+        std::string text = bizEvent.data.dump();
+        bytes += static_cast<int64_t>(text.size());
+        benchmark::DoNotOptimize(text);
+    }
+    state.counters["bytes_per_event"] = static_cast<double>(bytes) / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_EventExport_JsonText);
+
+// One exported record, range(0) selects MessagePack (0) or CBOR (1)
+static void BM_EventExport_EncodeRecord(benchmark::State &state)
+{
+    auto format = state.range(0) ? EventExportFormat::CBOR : EventExportFormat::MSGPACK;
+    BizEvent bizEvent(MethodType::ON_PRINTER_STATUS, recordedStatus());
+    std::string record;
+    for (auto _ : state)
+    {
+        record.clear();
+        EventExporter::encodeRecord(format, bizEvent, 0, record);
+        benchmark::DoNotOptimize(record.data());
+    }
+    state.counters["bytes_per_event"] = static_cast<double>(record.size());
+}
+BENCHMARK(BM_EventExport_EncodeRecord)->Arg(0)->Arg(1);
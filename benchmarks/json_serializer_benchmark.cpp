@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+#include "benchmark_payloads.h"
+#include "types/internal/internal.h"
+#include "types/internal/json_serializer.h"
+#include "adapters/elegoo_cc2_adapters.h"
+
+using namespace elink;
+using namespace elink::benchmarks;
+
+namespace
+{
+    PrinterStatusData recordedStatus()
+    {
+        ElegooFdmCC2MessageAdapter adapter(SharedPrinterInfo::create(makePrinterInfo(PrinterType::ELEGOO_FDM_CC2, 0)));
+        auto event = adapter.convertToEvent(loadPayload("cc2_full_status.json"));
+        return event.data.value().get<PrinterStatusData>();
+    }
+
+    PrinterAttributes recordedAttributes()
+    {
+        ElegooFdmCC2MessageAdapter adapter(SharedPrinterInfo::create(makePrinterInfo(PrinterType::ELEGOO_FDM_CC2, 0)));
+        auto event = adapter.convertToEvent(loadPayload("cc2_attributes.json"));
+        return event.data.value().get<PrinterAttributes>();
+    }
+}
+
+static void BM_Json_PrinterStatusData_ToJson(benchmark::State &state)
+{
+    const PrinterStatusData status = recordedStatus();
+    for (auto _ : state)
+    {
+        nlohmann::json json = status;
+        benchmark::DoNotOptimize(json);
+    }
+}
+BENCHMARK(BM_Json_PrinterStatusData_ToJson);
+
+static void BM_Json_PrinterStatusData_FromJson(benchmark::State &state)
+{
+    const nlohmann::json json = recordedStatus();
+    for (auto _ : state)
+    {
+        auto status = json.get<PrinterStatusData>();
+        benchmark::DoNotOptimize(status);
+    }
+}
+BENCHMARK(BM_Json_PrinterStatusData_FromJson);
+
+static void BM_Json_PrinterStatusData_RoundTripText(benchmark::State &state)
+{
+    const std::string text = nlohmann::json(recordedStatus()).dump();
+    for (auto _ : state)
+    {
+        auto status = nlohmann::json::parse(text).get<PrinterStatusData>();
+        auto dumped = nlohmann::json(status).dump();
+        benchmark::DoNotOptimize(dumped);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+}
+BENCHMARK(BM_Json_PrinterStatusData_RoundTripText);
+
+static void BM_Json_PrinterInfo_RoundTrip(benchmark::State &state)
+{
+    const PrinterInfo info = makePrinterInfo(PrinterType::ELEGOO_FDM_CC2, 7);
+    for (auto _ : state)
+    {
+        nlohmann::json json = info;
+        auto copy = json.get<PrinterInfo>();
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK(BM_Json_PrinterInfo_RoundTrip);
+
+static void BM_Json_PrinterAttributes_RoundTrip(benchmark::State &state)
+{
+    const PrinterAttributes attributes = recordedAttributes();
+    for (auto _ : state)
+    {
+        nlohmann::json json = attributes;
+        auto copy = json.get<PrinterAttributes>();
+        benchmark::DoNotOptimize(copy);
+    }
+}
+BENCHMARK(BM_Json_PrinterAttributes_RoundTrip);
@@ -0,0 +1,106 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include "benchmark_payloads.h"
+#include "core/printer_manager.h"
+
+using namespace elink;
+using namespace elink::benchmarks;
+
+namespace
+{
+    // Registers range(0) unconnected printers, alternating across the supported printer types
+    void populate(PrinterManager &manager, int64_t count, std::vector<std::string> &printerIds)
+    {
+        static const PrinterType types[] = {PrinterType::ELEGOO_FDM_CC2, PrinterType::ELEGOO_FDM_CC, PrinterType::GENERIC_FDM_KLIPPER};
+        manager.initialize();
+        for (int64_t i = 0; i < count; ++i)
+        {
+            auto info = makePrinterInfo(types[i % 3], static_cast<int>(i));
+            if (manager.createPrinter(info))
+            {
+                printerIds.push_back(info.printerId);
+            }
+        }
+    }
+}
+
+static void BM_PrinterManager_GetPrinter(benchmark::State &state)
+{
+    PrinterManager manager;
+    std::vector<std::string> printerIds;
+    populate(manager, state.range(0), printerIds);
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<size_t> dis(0, printerIds.size() - 1);
+    std::vector<size_t> order(4096);
+    for (auto &index : order)
+    {
+        index = dis(gen);
+    }
+
+    size_t cursor = 0;
+    for (auto _ : state)
+    {
+        auto printer = manager.getPrinter(printerIds[order[cursor]]);
+        benchmark::DoNotOptimize(printer);
+        cursor = (cursor + 1) % order.size();
+    }
+}
+BENCHMARK(BM_PrinterManager_GetPrinter)->Arg(16)->Arg(128)->Arg(512);
+
+static void BM_PrinterManager_GetPrinterContended(benchmark::State &state)
+{
+    static PrinterManager *manager = nullptr;
+    static std::vector<std::string> printerIds;
+    if (state.thread_index() == 0)
+    {
+        manager = new PrinterManager();
+        printerIds.clear();
+        populate(*manager, 128, printerIds);
+    }
+
+    size_t cursor = static_cast<size_t>(state.thread_index()) * 31;
+    for (auto _ : state)
+    {
+        auto printer = manager->getPrinter(printerIds[cursor % printerIds.size()]);
+        benchmark::DoNotOptimize(printer);
+        ++cursor;
+    }
+
+    if (state.thread_index() == 0)
+    {
+        delete manager;
+        manager = nullptr;
+    }
+}
+BENCHMARK(BM_PrinterManager_GetPrinterContended)->Threads(1)->Threads(4)->Threads(8);
+
+static void BM_PrinterManager_GetAllPrinters(benchmark::State &state)
+{
+    PrinterManager manager;
+    std::vector<std::string> printerIds;
+    populate(manager, state.range(0), printerIds);
+
+    for (auto _ : state)
+    {
+        auto printers = manager.getAllPrinters();
+        benchmark::DoNotOptimize(printers);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PrinterManager_GetAllPrinters)->Arg(16)->Arg(128)->Arg(512);
+
+static void BM_PrinterManager_GetPrinterInfos(benchmark::State &state)
+{
+    PrinterManager manager;
+    std::vector<std::string> printerIds;
+    populate(manager, state.range(0), printerIds);
+
+    for (auto _ : state)
+    {
+        auto printers = manager.getPrinterInfos();
+        benchmark::DoNotOptimize(printers);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PrinterManager_GetPrinterInfos)->Arg(16)->Arg(128)->Arg(512);
@@ -0,0 +1,127 @@
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <random>
+#include <string>
+#include "telemetry/gorilla_codec.h"
+#include "telemetry/telemetry_store.h"
+
+using namespace elink;
+
+namespace
+{
+    constexpr int64_t SAMPLE_INTERVAL_MS = 500;
+
+    // Nozzle temperature wandering around its target in 0.1 degree steps, sampled at 2 Hz
+    struct TemperatureWalk
+    {
+        std::mt19937 rng{42};
+        int64_t timestampMs = 1700000000000;
+        int tenths = 2100;
+
+        void next(int64_t &ts, double &value)
+        {
+            timestampMs += SAMPLE_INTERVAL_MS + static_cast<int64_t>(rng() % 5) - 2;
+            tenths += static_cast<int>(rng() % 3) - 1;
+            ts = timestampMs;
+            value = tenths / 10.0;
+        }
+    };
+}
+
+// Samples appended to a 1 KiB block until it is full
+static void BM_Telemetry_Encode(benchmark::State &state)
+{
+    TemperatureWalk walk;
+    GorillaEncoder encoder(1024);
+    int64_t samples = 0;
+    for (auto _ : state)
+    {
+        int64_t ts;
+        double value;
+        walk.next(ts, value);
+        if (!encoder.append(ts, value))
+        {
+            encoder.release();
+            encoder.append(ts, value);
+        }
+        ++samples;
+    }
+    state.SetItemsProcessed(samples);
+}
+BENCHMARK(BM_Telemetry_Encode);
+
+// Decode of one full 1 KiB block
+static void BM_Telemetry_Decode(benchmark::State &state)
+{
+    TemperatureWalk walk;
+    GorillaEncoder encoder(1024);
+    int64_t ts;
+    double value;
+    do
+    {
+        walk.next(ts, value);
+    } while (encoder.append(ts, value));
+
+    for (auto _ : state)
+    {
+        GorillaDecoder decoder(encoder.bytes().data(), encoder.bitCount(), encoder.count());
+        double sum = 0.0;
+        while (decoder.next(ts, value))
+        {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * encoder.count());
+    state.counters["bits/sample"] = static_cast<double>(encoder.bitCount()) / encoder.count();
+}
+BENCHMARK(BM_Telemetry_Decode);
+
+// One hour of 2 Hz extruder temperature for 16 printers, reduced to buckets of range(0) seconds
+static void BM_Telemetry_Query(benchmark::State &state)
+{
+    auto &store = TelemetryStore::getInstance();
+    ElegooTelemetryConfig config;
+    config.telemetryRetentionMinutes = 120;
+    std::string error;
+    if (!store.start(config, error))
+    {
+        state.SkipWithError(error.c_str());
+        return;
+    }
+
+    // The last hour, inside the retention window queries are limited to
+    int64_t startMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::system_clock::now().time_since_epoch())
+                          .count() -
+                      3600 * 1000;
+    TemperatureWalk walk;
+    TelemetryQueryParams params;
+    for (int p = 0; p < 16; ++p)
+    {
+        std::string printerId = "printer-" + std::to_string(p);
+        params.printerIds.push_back(printerId);
+        walk.timestampMs = startMs;
+        for (int i = 0; i < 3600 * 2; ++i)
+        {
+            int64_t ts;
+            double value;
+            walk.next(ts, value);
+            store.record(printerId, TelemetryMetric::EXTRUDER_TEMPERATURE, ts, value);
+        }
+    }
+    params.metrics = {TelemetryMetric::EXTRUDER_TEMPERATURE};
+    params.startMs = startMs;
+    params.endMs = walk.timestampMs + 1;
+    params.bucketMs = state.range(0) * 1000;
+
+    for (auto _ : state)
+    {
+        auto result = store.query(params);
+        benchmark::DoNotOptimize(result.value().series.size());
+    }
+    state.SetItemsProcessed(state.iterations() * 16 * 3600 * 2);
+    state.counters["bytes"] = static_cast<double>(store.getMemoryUsage());
+    store.stop();
+}
+BENCHMARK(BM_Telemetry_Query)->Arg(1)->Arg(60)->Arg(3600);
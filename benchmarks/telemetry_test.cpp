@@ -0,0 +1,442 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+#include "telemetry/gorilla_codec.h"
+#include "telemetry/telemetry_segment.h"
+#include "telemetry/telemetry_store.h"
+
+using namespace elink;
+
+// Functional checks of the telemetry history: exact codec round trips, segment recovery and
+// query bucketing. Run by ctest; exits non-zero when a check fails.
+
+namespace
+{
+    int failures = 0;
+
+#define EXPECT(condition)                                                          \
+    do                                                                             \
+    {                                                                              \
+        if (!(condition))                                                          \
+        {                                                                          \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": " #condition "\n";      \
+            ++failures;                                                            \
+        }                                                                          \
+    } while (0)
+
+    struct Sample
+    {
+        int64_t timestampMs;
+        double value;
+    };
+
+    uint64_t bitsOf(double value)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    int64_t nowMs()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    }
+
+    // Values are compared bit for bit, so NaN payloads and the sign of zero must survive
+    void expectRoundTrip(const std::vector<Sample> &samples, size_t blockBytes = 4096)
+    {
+        GorillaEncoder encoder(blockBytes);
+        for (const auto &sample : samples)
+        {
+            EXPECT(encoder.append(sample.timestampMs, sample.value));
+        }
+        EXPECT(encoder.count() == samples.size());
+
+        GorillaDecoder decoder(encoder.bytes().data(), encoder.bitCount(), encoder.count());
+        int64_t timestampMs;
+        double value;
+        for (const auto &sample : samples)
+        {
+            if (!decoder.next(timestampMs, value))
+            {
+                EXPECT(!"decoder ended early");
+                return;
+            }
+            EXPECT(timestampMs == sample.timestampMs);
+            EXPECT(bitsOf(value) == bitsOf(sample.value));
+        }
+        EXPECT(!decoder.next(timestampMs, value));
+    }
+
+    // ========== Gorilla codec ==========
+
+    void testFirstSample()
+    {
+        expectRoundTrip({{1700000000123, 21.5}});
+        expectRoundTrip({{0, 0.0}});
+        expectRoundTrip({{-1, -1.0}});
+
+        // Too small for the raw first sample
+        GorillaEncoder tiny(15);
+        EXPECT(!tiny.append(1700000000000, 1.0));
+        EXPECT(tiny.count() == 0);
+    }
+
+    void testEqualTimestamps()
+    {
+        expectRoundTrip({{1700000000000, 1.0}, {1700000000000, 2.0}, {1700000000000, 2.0}, {1700000000000, 3.0}});
+        // Steady rate, then a repeated timestamp, then back to the rate
+        expectRoundTrip({{1000, 1.0}, {1500, 1.0}, {2000, 1.5}, {2000, 1.5}, {2500, 1.0}, {3000, 1.0}});
+    }
+
+    void testSpecialValues()
+    {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        const double inf = std::numeric_limits<double>::infinity();
+        expectRoundTrip({{1000, nan}, {1500, nan}, {2000, 20.0}, {2500, nan}, {3000, -nan}});
+        expectRoundTrip({{1000, 0.0}, {1500, -0.0}, {2000, 0.0}, {2500, -0.0}, {3000, -0.0}});
+        expectRoundTrip({{1000, inf}, {1500, -inf}, {2000, std::numeric_limits<double>::denorm_min()},
+                         {2500, std::numeric_limits<double>::max()}, {3000, std::numeric_limits<double>::lowest()}});
+    }
+
+    void testLargeGaps()
+    {
+        const int64_t start = 1700000000000;
+        const int64_t day = 24 * 60 * 60 * 1000;
+        // Each delta-of-delta bucket edge, then gaps only the 64-bit escape holds
+        std::vector<Sample> samples = {{start, 1.0}, {start + 500, 1.0}};
+        for (int64_t deltaOfDelta : {63, 64, 65, -63, -64, 255, 256, 257, -255, -256, 2047, 2048, 2049, -2047, -2048})
+        {
+            int64_t delta = samples.back().timestampMs - samples[samples.size() - 2].timestampMs + deltaOfDelta;
+            samples.push_back({samples.back().timestampMs + std::max<int64_t>(delta, 0), 1.0});
+        }
+        for (int64_t gap : {day, int64_t(0), 365 * day, int64_t(1), int64_t(1) << 40, int64_t(500)})
+        {
+            samples.push_back({samples.back().timestampMs + gap, 2.0});
+        }
+        expectRoundTrip(samples);
+    }
+
+    void testFullBlock()
+    {
+        GorillaEncoder encoder(256);
+        std::vector<Sample> written;
+        int64_t timestampMs = 1700000000000;
+        for (int i = 0; i < 10000; ++i)
+        {
+            timestampMs += 500 + (i * 7919) % 13;
+            double value = 200.0 + ((i * 104729) % 1000) / 10.0;
+            if (!encoder.append(timestampMs, value))
+            {
+                break;
+            }
+            written.push_back({timestampMs, value});
+        }
+        EXPECT(!written.empty());
+        EXPECT(encoder.bitCount() <= 256 * 8);
+        expectRoundTrip(written, 256);
+
+        // A count past the written samples ends at the block's bytes instead of reading beyond them
+        GorillaDecoder decoder(encoder.bytes().data(), encoder.bitCount(), encoder.count() + 1000);
+        int64_t ts;
+        double value;
+        uint32_t decoded = 0;
+        while (decoder.next(ts, value))
+        {
+            ++decoded;
+        }
+        EXPECT(decoded >= encoder.count() && decoded < encoder.count() + 1000);
+    }
+
+    // ========== Segment recovery ==========
+
+    struct SegmentFiles
+    {
+        std::string indexPath;
+        std::string dataPath;
+    };
+
+    std::vector<SegmentFiles> listSegments(const std::filesystem::path &directory)
+    {
+        std::vector<SegmentFiles> segments;
+        for (const auto &entry : std::filesystem::directory_iterator(directory))
+        {
+            if (entry.path().extension() == ".idx")
+            {
+                auto data = entry.path();
+                data.replace_extension(".dat");
+                segments.push_back({entry.path().string(), data.string()});
+            }
+        }
+        std::sort(segments.begin(), segments.end(),
+                  [](const SegmentFiles &a, const SegmentFiles &b)
+                  { return a.indexPath < b.indexPath; });
+        return segments;
+    }
+
+    uint64_t queriedSamples(const std::string &printerId, int64_t startMs, int64_t endMs)
+    {
+        TelemetryQueryParams params;
+        params.printerIds = {printerId};
+        params.metrics = {TelemetryMetric::EXTRUDER_TEMPERATURE};
+        params.startMs = startMs;
+        params.endMs = endMs;
+        params.bucketMs = endMs - startMs;
+        auto result = TelemetryStore::getInstance().query(params);
+        EXPECT(result.isSuccess());
+        uint64_t count = 0;
+        if (result.isSuccess())
+        {
+            for (const auto &series : result.value().series)
+            {
+                for (const auto &bucket : series.buckets)
+                {
+                    count += bucket.count;
+                }
+            }
+        }
+        return count;
+    }
+
+    /**
+     * Record samples to a segment directory and seal them with stop()
+     * @return Recorded samples
+     */
+    uint64_t writeSegments(const std::filesystem::path &directory, int64_t startMs, int64_t &endMs)
+    {
+        ElegooTelemetryConfig config;
+        config.telemetryPath = directory.string();
+        config.telemetryBlockBytes = 64;
+        std::string error;
+        auto &store = TelemetryStore::getInstance();
+        if (!store.start(config, error))
+        {
+            std::cerr << "Cannot start telemetry: " << error << "\n";
+            ++failures;
+            return 0;
+        }
+        uint64_t samples = 0;
+        for (int64_t ts = startMs; ts < startMs + 60 * 1000; ts += 250)
+        {
+            store.record("printer-1", TelemetryMetric::EXTRUDER_TEMPERATURE, ts, 200.0 + (ts / 250) % 17);
+            ++samples;
+        }
+        endMs = startMs + 60 * 1000;
+        store.stop();
+        return samples;
+    }
+
+    /**
+     * Reopen the directory's last segment after damaging it and check what survives
+     * @param damage Damages the files of the last segment, given its last entry
+     */
+    template <typename Damage>
+    void expectRecovery(const char *name, Damage damage)
+    {
+        auto directory = std::filesystem::path(ELINK_BENCHMARK_TEMP_DIR) / (std::string("telemetry_test_") + name);
+        std::filesystem::remove_all(directory);
+
+        int64_t startMs = nowMs() - 5 * 60 * 1000;
+        int64_t endMs = 0;
+        uint64_t recorded = writeSegments(directory, startMs, endMs);
+        EXPECT(queriedSamples("printer-1", startMs, endMs) == 0); // Stopped store holds nothing
+
+        auto segments = listSegments(directory);
+        EXPECT(!segments.empty());
+        if (segments.empty())
+        {
+            return;
+        }
+        std::string error;
+        size_t entries = 0;
+        uint64_t persisted = 0;
+        TelemetryIndexEntry last{};
+        for (const auto &files : segments)
+        {
+            auto segment = TelemetrySegment::open(files.indexPath, error);
+            EXPECT(segment && error.empty());
+            if (!segment)
+            {
+                return;
+            }
+            for (size_t i = 0; i < segment->entryCount(); ++i)
+            {
+                persisted += segment->entry(i).count;
+                last = segment->entry(i);
+            }
+            entries = segment->entryCount();
+        }
+        EXPECT(persisted == recorded);
+        EXPECT(entries > 1);
+
+        damage(segments.back(), last);
+
+        auto reopened = TelemetrySegment::open(segments.back().indexPath, error);
+        EXPECT(reopened);
+        if (!reopened)
+        {
+            return;
+        }
+        EXPECT(reopened->entryCount() == entries - 1);
+        EXPECT(error.find("dropped 1 damaged entries") != std::string::npos);
+        reopened.reset();
+
+        // A restarted store loads every block but the damaged one
+        ElegooTelemetryConfig config;
+        config.telemetryPath = directory.string();
+        auto &store = TelemetryStore::getInstance();
+        EXPECT(store.start(config, error));
+        EXPECT(queriedSamples("printer-1", startMs, endMs) == recorded - last.count);
+        store.stop();
+        std::filesystem::remove_all(directory);
+    }
+
+    void testTornTail()
+    {
+        // The data file ends inside the last block, as after a crash before the bytes reached disk
+        expectRecovery("torn", [](const SegmentFiles &files, const TelemetryIndexEntry &last)
+                       { std::filesystem::resize_file(files.dataPath, last.dataOffset + 1); });
+    }
+
+    void testBadChecksum()
+    {
+        expectRecovery("checksum", [](const SegmentFiles &files, const TelemetryIndexEntry &last)
+                       {
+                           std::fstream data(files.dataPath, std::ios::in | std::ios::out | std::ios::binary);
+                           data.seekg(static_cast<std::streamoff>(last.dataOffset + 9));
+                           char byte = 0;
+                           data.get(byte);
+                           data.seekp(static_cast<std::streamoff>(last.dataOffset + 9));
+                           data.put(static_cast<char>(byte ^ 0x5A)); });
+    }
+
+    // ========== Store queries ==========
+
+    void testQueryBuckets()
+    {
+        ElegooTelemetryConfig config;
+        config.telemetryBlockBytes = 64; // Several sealed blocks per bucket
+        std::string error;
+        auto &store = TelemetryStore::getInstance();
+        EXPECT(store.start(config, error));
+
+        // One sample per second for 10 minutes, value = seconds since start
+        int64_t startMs = nowMs() - 20 * 60 * 1000;
+        startMs -= startMs % 1000;
+        for (int i = 0; i < 600; ++i)
+        {
+            store.record("printer-1", TelemetryMetric::HEATED_BED_TEMPERATURE, startMs + i * 1000, i);
+        }
+
+        TelemetryQueryParams params;
+        params.metrics = {TelemetryMetric::HEATED_BED_TEMPERATURE};
+        params.startMs = startMs;
+        params.endMs = startMs + 600 * 1000;
+        params.bucketMs = 60 * 1000;
+        auto result = store.query(params);
+        EXPECT(result.isSuccess() && result.value().series.size() == 1);
+        if (result.isSuccess() && result.value().series.size() == 1)
+        {
+            const auto &buckets = result.value().series[0].buckets;
+            EXPECT(buckets.size() == 10);
+            for (size_t b = 0; b < buckets.size(); ++b)
+            {
+                EXPECT(buckets[b].startMs == startMs + static_cast<int64_t>(b) * 60 * 1000);
+                EXPECT(buckets[b].count == 60);
+                EXPECT(buckets[b].min == b * 60.0);
+                EXPECT(buckets[b].max == b * 60.0 + 59);
+                EXPECT(buckets[b].avg == b * 60.0 + 29.5);
+            }
+        }
+
+        // Bucket bounds follow startMs, not the block bounds; empty buckets are omitted
+        params.startMs = startMs + 30 * 1000;
+        params.endMs = startMs + 30 * 1000 + 20 * 60 * 1000;
+        params.bucketMs = 7 * 60 * 1000;
+        result = store.query(params);
+        EXPECT(result.isSuccess() && result.value().series.size() == 1);
+        if (result.isSuccess() && result.value().series.size() == 1)
+        {
+            const auto &buckets = result.value().series[0].buckets;
+            EXPECT(buckets.size() == 2);
+            if (buckets.size() == 2)
+            {
+                EXPECT(buckets[0].count == 420 && buckets[0].min == 30.0 && buckets[0].max == 449.0);
+                EXPECT(buckets[1].count == 150 && buckets[1].min == 450.0 && buckets[1].max == 599.0);
+            }
+        }
+
+        params.bucketMs = 0;
+        EXPECT(!store.query(params).isSuccess());
+        params.bucketMs = 1;
+        params.endMs = params.startMs + 1000000 * 1000LL;
+        EXPECT(!store.query(params).isSuccess()); // Too many buckets
+        store.stop();
+    }
+
+    void testQueryRetention()
+    {
+        ElegooTelemetryConfig config;
+        config.telemetryRetentionMinutes = 1;
+        config.telemetryBlockBytes = 64;
+        std::string error;
+        auto &store = TelemetryStore::getInstance();
+        EXPECT(store.start(config, error));
+
+        // Three minutes of samples, the first two outside the retention window
+        int64_t now = nowMs();
+        int64_t startMs = now - 3 * 60 * 1000;
+        for (int64_t ts = startMs; ts < now; ts += 1000)
+        {
+            store.record("printer-1", TelemetryMetric::PRINT_PROGRESS, ts, 1.0);
+        }
+
+        TelemetryQueryParams params;
+        params.metrics = {TelemetryMetric::PRINT_PROGRESS};
+        params.startMs = startMs;
+        params.endMs = now;
+        params.bucketMs = 1000;
+        auto result = store.query(params);
+        EXPECT(result.isSuccess() && result.value().series.size() == 1);
+        if (result.isSuccess() && result.value().series.size() == 1)
+        {
+            const auto &buckets = result.value().series[0].buckets;
+            // The window moves while the test runs, so allow for a second or two of slack
+            EXPECT(buckets.size() >= 55 && buckets.size() <= 60);
+            EXPECT(!buckets.empty() && buckets.front().startMs >= now - 60 * 1000 - 2000);
+        }
+        store.stop();
+    }
+} // namespace
+
+int main()
+{
+    testFirstSample();
+    testEqualTimestamps();
+    testSpecialValues();
+    testLargeGaps();
+    testFullBlock();
+#ifndef _WIN32
+    testTornTail();
+    testBadChecksum();
+#endif
+    testQueryBuckets();
+    testQueryRetention();
+
+    if (failures > 0)
+    {
+        std::cerr << failures << " telemetry checks failed\n";
+        return 1;
+    }
+    std::cout << "All telemetry checks passed\n";
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <vector>
+#include "benchmark_payloads.h"
+
+using namespace elink;
+using namespace elink::benchmarks;
+
+namespace
+{
+    // Deterministic pseudo G-code sized like a typical print job
+    std::string makeGcode(size_t size)
+    {
+        std::string data;
+        data.reserve(size);
+        std::mt19937 gen(7);
+        std::uniform_real_distribution<double> coord(0.0, 256.0);
+        char line[96];
+        while (data.size() < size)
+        {
+            int n = std::snprintf(line, sizeof(line), "G1 X%.3f Y%.3f E%.5f\n", coord(gen), coord(gen), coord(gen) / 100.0);
+            data.append(line, static_cast<size_t>(n));
+        }
+        data.resize(size);
+        return data;
+    }
+
+    /**
+     * Temporary G-code file on disk, removed when the benchmark finishes
+     */
+    class TempGcodeFile
+    {
+    public:
+        explicit TempGcodeFile(size_t size)
+            : path_(std::string(ELINK_BENCHMARK_TEMP_DIR) + "/elink_bench_" + std::to_string(size) + ".gcode")
+        {
+            auto out = PathUtils::openOutputStream(path_, std::ios::binary | std::ios::trunc);
+            const std::string data = makeGcode(size);
+            out.write(data.data(), static_cast<std::streamsize>(data.size()));
+        }
+        ~TempGcodeFile() { std::remove(path_.c_str()); }
+        const std::string &path() const { return path_; }
+
+    private:
+        std::string path_;
+    };
+
+    // Same chunk size as the CC1/CC2 chunked HTTP uploaders
+    constexpr size_t UPLOAD_CHUNK_SIZE = 1024 * 1024;
+}
+
+static void BM_CryptoUtils_MD5(benchmark::State &state)
+{
+    const std::string data = makeGcode(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        auto md5 = CryptoUtils::calculateMD5(data.data(), data.size());
+        benchmark::DoNotOptimize(md5);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+BENCHMARK(BM_CryptoUtils_MD5)->Arg(64 << 10)->Arg(1 << 20)->Arg(16 << 20);
+
+static void BM_FileUtils_MD5(benchmark::State &state)
+{
+    TempGcodeFile file(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        auto md5 = FileUtils::calculateMD5(file.path());
+        benchmark::DoNotOptimize(md5);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FileUtils_MD5)->Arg(1 << 20)->Arg(16 << 20)->Unit(benchmark::kMillisecond);
+
+// Reproduces the uploader read loop: whole-file MD5, then 1MB chunks read into fresh buffers
+static void BM_Upload_ChunkedRead(benchmark::State &state)
+{
+    const size_t totalSize = static_cast<size_t>(state.range(0));
+    TempGcodeFile file(totalSize);
+    for (auto _ : state)
+    {
+        auto fileMD5 = FileUtils::calculateMD5(file.path());
+        benchmark::DoNotOptimize(fileMD5);
+
+        auto in = PathUtils::openInputStream(file.path(), std::ios::binary);
+        size_t offset = 0;
+        while (offset < totalSize)
+        {
+            size_t currentChunkSize = (UPLOAD_CHUNK_SIZE < (totalSize - offset)) ? UPLOAD_CHUNK_SIZE : (totalSize - offset);
+            std::vector<char> buffer(currentChunkSize);
+            in.read(buffer.data(), static_cast<std::streamsize>(currentChunkSize));
+            benchmark::DoNotOptimize(buffer.data());
+            offset += currentChunkSize;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Upload_ChunkedRead)->Arg(4 << 20)->Arg(32 << 20)->Unit(benchmark::kMillisecond);
@@ -2,6 +2,8 @@
 
 #include <string>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include "version.h"
 namespace elink
 {
@@ -23,9 +25,127 @@ namespace elink
         size_t logMaxFiles = 5;                   // Maximum number of log files
     };
 
+    /**
+     * Span tracing configuration (Chrome trace JSON, open in ui.perfetto.dev)
+     */
+    struct ElegooTraceConfig
+    {
+        bool traceEnable = false;          // Record request/message spans from initialization
+        std::string traceFileName;         // Trace file written on cleanup
+        size_t traceMaxEvents = 1000000;   // Events beyond this count are dropped
+    };
+
+    /**
+     * Wire capture configuration (raw printer traffic, replayable with elink-replay)
+     */
+    struct ElegooCaptureConfig
+    {
+        bool captureEnable = false;   // Record every printer message from initialization
+        std::string captureDirectory; // Output directory, one file per printer
+    };
+
+    /**
+     * Binary encoding of exported events
+     */
+    enum class EventExportFormat
+    {
+        MSGPACK = 0, // MessagePack
+        CBOR = 1,    // CBOR (RFC 8949)
+    };
+
+    /**
+     * Destination of exported event batches
+     */
+    enum class EventExportSink
+    {
+        LOCAL_FILE = 0,    // Appended to exportPath
+        UNIX_SOCKET = 1,   // Sent to a consumer listening on exportPath, reconnected when it restarts
+        USER_CALLBACK = 2, // Handed to the callback passed to ElegooLink::startEventExport()
+    };
+
+    /**
+     * Receives one batch of exported events
+     * @param data Batch, one MessagePack/CBOR array of event records
+     * @param size Batch size in bytes
+     * @param eventCount Number of records in the batch
+     */
+    using EventExportCallback = std::function<void(const uint8_t *data, size_t size, size_t eventCount)>;
+
+    /**
+     * Binary event export configuration (every event, batched, for external pipelines)
+     *
+     * A batch is one array of records; each record is the array
+     * [schema version (1), timestamp (unix ms), method (MethodType value), printer ID, event data].
+     * File and socket sinks prefix every batch with its 4-byte big-endian length.
+     */
+    struct ElegooEventExportConfig
+    {
+        bool exportEnable = false;                                   // Export events from initialization
+        EventExportFormat exportFormat = EventExportFormat::MSGPACK; // Record encoding
+        EventExportSink exportSink = EventExportSink::LOCAL_FILE;    // Batch destination
+        std::string exportPath;                                      // File or Unix socket path
+        size_t exportBatchEvents = 256;                              // Send a batch once it holds this many events
+        size_t exportBatchBytes = 1024 * 1024;                       // ... or this many bytes
+        int exportFlushIntervalMs = 100;                             // ... or its first event is this old
+        size_t exportMaxPendingBatches = 64;                         // Oldest batches are dropped while the sink falls behind
+    };
+
+    /**
+     * Shared-memory status configuration (latest status of every printer, read by other local
+     * processes with ElegooLinkStatusReader; POSIX systems only)
+     */
+    struct ElegooStatusShareConfig
+    {
+        bool statusShareEnable = false;           // Publish status from initialization
+        std::string segmentName;                  // Shared memory name, empty for the per-user default
+        size_t maxPrinters = 256;                 // Printer slots in the segment
+        size_t slotPayloadBytes = 16 * 1024;      // Larger encoded statuses share only the summary fields
+    };
+
+    /**
+     * Telemetry history configuration (compressed per-printer series of temperatures, fan speeds
+     * and progress, downsampled with ElegooLink::queryTelemetry())
+     */
+    struct ElegooTelemetryConfig
+    {
+        bool telemetryEnable = false;                    // Record status events from initialization
+        int telemetryRetentionMinutes = 60;              // Older samples are dropped, a block at a time
+        size_t telemetryBlockBytes = 1024;               // Compressed block size per series
+        std::string telemetryPath;                       // Directory of day segment files, empty to keep history in memory only
+        size_t telemetrySegmentBytes = 64 * 1024 * 1024; // Size limit of one segment file; a full day continues in a new part
+    };
+
+    /**
+     * Fleet index configuration (printer status indexed for ElegooLink::queryFleet(),
+     * watchFleet() and getFleetSummary())
+     */
+    struct ElegooFleetConfig
+    {
+        bool fleetIndexEnable = false; // Index status events from initialization
+    };
+
+    /**
+     * Alert rule configuration (rules added with ElegooLink::addAlertRule())
+     */
+    struct ElegooAlertConfig
+    {
+        bool alertsEnable = false; // Evaluate alert rules on status events from initialization
+    };
+
+    /**
+     * Local gateway configuration (serves this instance to other processes through ElegooLinkClient)
+     */
+    struct ElegooGatewayConfig
+    {
+        bool gatewayEnable = false; // Start the gateway on initialization
+        std::string socketPath;     // Unix socket path, empty for the per-user default
+        int gatewayThreads = 0;     // Request worker threads, 0 for the default
+    };
+
     struct ElegooLocalConfig
     {
         std::string staticWebPath; // Static web files path
+        int webServerThreads = 0;  // Static web server worker threads, 0 for the default
     };
 
 #ifdef ENABLE_CLOUD_FEATURES
@@ -52,6 +172,14 @@ namespace elink
         // Shared configurations
         ElegooLogConfig log;
         ElegooLocalConfig local;
+        ElegooTraceConfig trace;
+        ElegooCaptureConfig capture;
+        ElegooEventExportConfig eventExport;
+        ElegooStatusShareConfig statusShare;
+        ElegooTelemetryConfig telemetry;
+        ElegooFleetConfig fleet;
+        ElegooAlertConfig alerts;
+        ElegooGatewayConfig gateway;
         
 #ifdef ENABLE_CLOUD_FEATURES
         ElegooCloudConfig cloud;
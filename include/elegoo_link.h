@@ -314,12 +314,21 @@ namespace elink
 
         /**
          * Get printer status
-         * @param params Status parameters
+         * @param params Status parameters; readMode CACHED answers from memory, with statusAgeMs set,
+         *               while pushed updates keep the status of a LAN printer current
          * @param timeout Timeout in milliseconds
          * @return Status result
          */
         PrinterStatusResult getPrinterStatus(const PrinterStatusParams &params, int timeout = 3000);
 
+        /**
+         * Get the latest status of a LAN printer if its statusVersion differs from knownVersion
+         * Answered from memory, so it is cheap enough to poll
+         * @param params Printer ID and the statusVersion the caller already has
+         * @return Status result, changed = false when the caller is up to date
+         */
+        StatusIfNewerResult getStatusIfNewer(const StatusIfNewerParams &params);
+
         /**
          * Refresh printer attributes (async, result via event)
          * @param params Attribute parameters
@@ -420,6 +429,174 @@ namespace elink
          */
         bool isNetworkServiceEnabled() const;
 
+        // ========== Diagnostics ==========
+
+        /**
+         * Start recording request and message lifecycle spans
+         * @param fileName Chrome trace JSON file written by stopTracing() (open in ui.perfetto.dev)
+         * @param maxEvents Events beyond this count are dropped
+         * @return Operation result
+         */
+        VoidResult startTracing(const std::string &fileName, size_t maxEvents = 1000000);
+
+        /**
+         * Stop recording spans and write the trace file
+         * @return Operation result
+         */
+        VoidResult stopTracing();
+
+        /**
+         * Start recording every inbound and outbound printer message with timestamps
+         * Captures contain raw printer traffic, including credentials sent in it
+         * @param directory Output directory, one .elwc file per printer; replay with elink-replay
+         * @return Operation result
+         */
+        VoidResult startWireCapture(const std::string &directory);
+
+        /**
+         * Stop recording and close the capture files
+         * @return Operation result
+         */
+        VoidResult stopWireCapture();
+
+        /**
+         * Start exporting every event as MessagePack or CBOR batches (see ElegooEventExportConfig)
+         * @param config Format, sink and batching; exportEnable is ignored
+         * @param callback Receives the batches when config.exportSink is EventExportSink::USER_CALLBACK,
+         *                 called from the export thread; it may call stopEventExport() but not
+         *                 startEventExport()
+         * @return Operation result
+         */
+        VoidResult startEventExport(const ElegooEventExportConfig &config, EventExportCallback callback = nullptr);
+
+        /**
+         * Send the buffered events and stop exporting
+         * @return Operation result
+         */
+        VoidResult stopEventExport();
+
+        /**
+         * Start publishing printer status to shared memory for ElegooLinkStatusReader (see ElegooStatusShareConfig)
+         * @param config Segment name and size; statusShareEnable is ignored
+         * @return Operation result, an error if another process already publishes to the segment
+         */
+        VoidResult startStatusSharing(const ElegooStatusShareConfig &config);
+
+        /**
+         * Stop publishing and remove the segment
+         * @return Operation result
+         */
+        VoidResult stopStatusSharing();
+
+        /**
+         * Start recording temperature, fan and progress history of every printer (see ElegooTelemetryConfig)
+         * @param config Retention, block size and segment directory; telemetryEnable is ignored
+         * @return Operation result
+         */
+        VoidResult startTelemetry(const ElegooTelemetryConfig &config);
+
+        /**
+         * Stop recording and release the history
+         * @return Operation result
+         */
+        VoidResult stopTelemetry();
+
+        /**
+         * Downsample the recorded history to min/max/avg buckets
+         * @param params Printers, metrics, time range and bucket width
+         * @return One series per printer and metric with samples in the range
+         */
+        TelemetryQueryResult queryTelemetry(const TelemetryQueryParams &params);
+
+        /**
+         * Find the printers whose latest status satisfies every condition
+         * The fleet methods need config.fleet.fleetIndexEnable (see ElegooFleetConfig).
+         * @param params Conditions on state, model, exception codes, progress and temperatures
+         * @return Matching printer IDs, sorted
+         */
+        FleetQueryResult queryFleet(const FleetQueryParams &params);
+
+        /**
+         * Keep a fleet query's matches up to date
+         * Printers entering or leaving the result are reported as FleetQueryChangedEvent
+         * @param params Conditions, as for queryFleet
+         * @return Watch ID and the current matches
+         */
+        FleetWatchResult watchFleet(const FleetQueryParams &params);
+
+        /**
+         * Stop reporting changes of a watched fleet query
+         * @param params Watch ID returned by watchFleet
+         * @return Operation result
+         */
+        VoidResult unwatchFleet(const FleetUnwatchParams &params);
+
+        /**
+         * Get printer counts by state, model and exception code, and fleet-wide averages
+         * @return Fleet summary of the printers that have reported status
+         */
+        FleetSummaryResult getFleetSummary();
+
+        /**
+         * Add an alert rule evaluated on every printer's status (or one printer's, see AlertRule::printerId)
+         * Alerts raised and cleared by the rule arrive as AlertEvent. Rules are removed by cleanup().
+         * The alert methods need config.alerts.alertsEnable (see ElegooAlertConfig).
+         * @param rule Conditions, time windows and hysteresis
+         * @return Operation result, an error if the rule is invalid or its ID is taken
+         */
+        VoidResult addAlertRule(const AlertRule &rule);
+
+        /**
+         * Remove an alert rule and drop its active alerts
+         * @param params Rule ID
+         * @return Operation result
+         */
+        VoidResult removeAlertRule(const AlertRuleParams &params);
+
+        /**
+         * Get the alert rules
+         * @return Rules, sorted by rule ID
+         */
+        AlertRuleListResult getAlertRules();
+
+        /**
+         * Get the alerts currently raised
+         * @return Active alerts, sorted by rule ID and printer ID
+         */
+        AlertListResult getActiveAlerts();
+
+        /**
+         * Get traffic, file transfer, cache memory and event rate counters of a LAN printer
+         * Use it to find printers responsible for bandwidth or memory growth
+         * @param params Printer base parameters
+         * @return Printer resource counters
+         */
+        PrinterResourceStatsResult getPrinterResourceStats(const PrinterResourceStatsParams &params);
+
+        /**
+         * Get resource counters of all LAN printers
+         * @return Resource counters, one entry per printer
+         */
+        PrinterResourceStatsListResult getAllPrinterResourceStats();
+
+        // ========== Gateway ==========
+
+        /**
+         * Serve this instance to other local processes over a Unix domain socket
+         * This process keeps owning every printer connection; other processes use ElegooLinkClient.
+         * The socket is accessible to the current user only.
+         * @param socketPath Socket path, empty for the per-user default
+         * @param workerThreads Request worker threads, 0 for the default
+         * @return Operation result
+         */
+        VoidResult startGateway(const std::string &socketPath = "", int workerThreads = 0);
+
+        /**
+         * Disconnect gateway clients and remove the socket
+         * @return Operation result
+         */
+        VoidResult stopGateway();
+
     private:
         /**
          * Private constructor (singleton pattern)
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "type.h"
+#include "events/event_system.h"
+#include "elegoo_export.h"
+
+namespace elink
+{
+    /**
+     * Client of an ElegooLink gateway running in another process
+     *
+     * Mirrors the ElegooLink API, so tools that would otherwise initialize their own SDK can
+     * share the printer connections of one gateway process (see ElegooLink::startGateway()
+     * and the elink-gateway tool). Unlike ElegooLink this class is not a singleton; each
+     * instance holds one connection. All methods are thread-safe and requests issued from
+     * several threads are pipelined over that connection.
+     *
+     * Methods return NOT_CONNECTED_TO_SUBSERVICE errors (or empty values) when the gateway
+     * is not reachable or the connection drops while a request is in flight.
+     *
+     * Event handlers, discovery and upload progress callbacks run on one event thread of the
+     * client. Callbacks may call disconnect(), but must not destroy the client or reconnect it.
+     */
+    class ELEGOO_LINK_API ElegooLinkClient
+    {
+    public:
+        using FileUploadProgressCallback = std::function<bool(const FileUploadProgressData &progress)>;
+        using EventSubscriptionId = EventBus::EventId;
+
+        ElegooLinkClient();
+        ~ElegooLinkClient();
+
+        ElegooLinkClient(const ElegooLinkClient &) = delete;
+        ElegooLinkClient &operator=(const ElegooLinkClient &) = delete;
+
+        /**
+         * Connect to a gateway
+         * @param socketPath Gateway socket path, empty for the default path of the current user
+         * @return true if connected
+         */
+        bool connect(const std::string &socketPath = "");
+
+        /**
+         * Close the connection; requests in flight fail
+         */
+        void disconnect();
+
+        bool isConnected() const;
+
+        /**
+         * Send a raw request
+         * @param method ElegooLink method name, e.g. "getPrinterStatus"
+         * @param params Method parameters as JSON
+         * @return Future of the {"code", "message", "data"} result
+         */
+        std::future<nlohmann::json> callAsync(const std::string &method,
+                                              const nlohmann::json &params = nlohmann::json::object());
+
+        // ========== Local Printer Discovery (LAN) ==========
+
+        BizResult<PrinterDiscoveryData> startPrinterDiscovery(const PrinterDiscoveryParams &params);
+
+        /**
+         * Callbacks run on the client's event thread and may call its methods
+         */
+        VoidResult startPrinterDiscoveryAsync(
+            const PrinterDiscoveryParams &params,
+            std::function<void(const PrinterInfo &)> discoveredCallback,
+            std::function<void(const std::vector<PrinterInfo> &)> completionCallback);
+
+        VoidResult stopPrinterDiscovery();
+        std::vector<PrinterInfo> getDiscoveredPrinters() const;
+
+        // ========== Printer Connection Management ==========
+
+        ConnectPrinterResult connectPrinter(const ConnectPrinterParams &params);
+        VoidResult disconnectPrinter(const std::string &printerId);
+        GetPrinterListResult getPrinters();
+        bool isPrinterConnected(const std::string &printerId) const;
+
+#ifdef ENABLE_CLOUD_FEATURES
+        // ========== Network/Cloud Service Functions ==========
+
+        VoidResult setRegion(const SetRegionParams &params);
+        GetUserInfoResult getUserInfo(const GetUserInfoParams &params);
+        VoidResult setHttpCredential(const HttpCredential &credential);
+        BizResult<HttpCredential> getHttpCredential() const;
+        BizResult<HttpCredential> refreshHttpCredential(const HttpCredential &credential);
+        VoidResult clearHttpCredential();
+        VoidResult logout();
+        GetRtcTokenResult getRtcToken() const;
+        VoidResult sendRtmMessage(const SendRtmMessageParams &params);
+        BindPrinterResult bindPrinter(const BindPrinterParams &params);
+        VoidResult cancelBindPrinter(const CancelBindPrinterParams &params);
+        VoidResult unbindPrinter(const UnbindPrinterParams &params);
+        GetLicenseExpiredDevicesResult getLicenseExpiredDevices();
+        RenewLicenseResult renewLicense(const RenewLicenseParams &params);
+#endif
+        // ========== File Management ==========
+
+        GetFileListResult getFileList(const GetFileListParams &params);
+        GetFileDetailResult getFileDetail(const GetFileDetailParams &params);
+
+        /**
+         * Upload a file through the gateway
+         * The file path is opened by the gateway process, so it must be readable there.
+         * The progress callback runs on the client's event thread; returning false cancels.
+         */
+        FileUploadResult uploadFile(
+            const FileUploadParams &params,
+            FileUploadProgressCallback progressCallback = nullptr);
+
+        // ========== Print Task Management ==========
+
+        PrintTaskListResult getPrintTaskList(const PrintTaskListParams &params);
+        DeletePrintTasksResult deletePrintTasks(const DeletePrintTasksParams &params);
+        StartPrintResult startPrint(const StartPrintParams &params);
+        VoidResult pausePrint(const PausePrintParams &params);
+        VoidResult resumePrint(const ResumePrintParams &params);
+        VoidResult stopPrint(const StopPrintParams &params);
+
+        // ========== Printer Status and Control ==========
+
+        PrinterAttributesResult getPrinterAttributes(const PrinterAttributesParams &params, int timeout = 3000);
+        PrinterStatusResult getPrinterStatus(const PrinterStatusParams &params, int timeout = 3000);
+        StatusIfNewerResult getStatusIfNewer(const StatusIfNewerParams &params);
+        VoidResult refreshPrinterAttributes(const PrinterAttributesParams &params);
+        VoidResult refreshPrinterStatus(const PrinterStatusParams &params);
+        GetCanvasStatusResult getCanvasStatus(const GetCanvasStatusParams &params);
+        VoidResult setAutoRefill(const SetAutoRefillParams &params);
+        VoidResult updatePrinterName(const UpdatePrinterNameParams &params);
+        BizResult<std::string> getPrinterStatusRaw(const PrinterStatusParams &params);
+
+        // ========== Event Management ==========
+
+        /**
+         * Ask the gateway to forward events to this client
+         * Handlers registered with subscribeEvent() only receive events after this call.
+         * @param printerIds Printers whose events to forward, empty for all; account-wide
+         *                   events (printer list, online status, login) are always forwarded
+         * @return Operation result
+         */
+        VoidResult subscribeEvents(const std::vector<std::string> &printerIds = {});
+
+        /**
+         * Stop event forwarding; local subscriptions are kept
+         */
+        VoidResult unsubscribeEvents();
+
+        /**
+         * Subscribe to a forwarded event
+         * Handlers run on a dedicated event thread of this client and may call its methods.
+         */
+        template <typename EventType>
+        EventSubscriptionId subscribeEvent(
+            std::function<void(const std::shared_ptr<EventType> &)> handler)
+        {
+            return eventBus_.subscribe<EventType>(handler);
+        }
+
+        template <typename EventType>
+        bool unsubscribeEvent(EventSubscriptionId id)
+        {
+            return eventBus_.unsubscribe<EventType>(id);
+        }
+
+        void clearAllEventSubscriptions();
+
+        // ========== Utility Functions ==========
+
+        /**
+         * Version of the gateway's SDK
+         */
+        std::string getVersion() const;
+        std::vector<PrinterType> getSupportedPrinterTypes() const;
+        bool isLocalServiceEnabled() const;
+        bool isNetworkServiceEnabled() const;
+
+        // ========== Diagnostics ==========
+
+        VoidResult startTracing(const std::string &fileName, size_t maxEvents = 1000000);
+        VoidResult stopTracing();
+        VoidResult startWireCapture(const std::string &directory);
+        VoidResult stopWireCapture();
+        PrinterResourceStatsResult getPrinterResourceStats(const PrinterResourceStatsParams &params);
+        PrinterResourceStatsListResult getAllPrinterResourceStats();
+        TelemetryQueryResult queryTelemetry(const TelemetryQueryParams &params);
+
+        // ========== Fleet Queries ==========
+
+        FleetQueryResult queryFleet(const FleetQueryParams &params);
+        FleetWatchResult watchFleet(const FleetQueryParams &params);
+        VoidResult unwatchFleet(const FleetUnwatchParams &params);
+        FleetSummaryResult getFleetSummary();
+
+        // ========== Alert Rules ==========
+
+        VoidResult addAlertRule(const AlertRule &rule);
+        VoidResult removeAlertRule(const AlertRuleParams &params);
+        AlertRuleListResult getAlertRules();
+        AlertListResult getActiveAlerts();
+
+    private:
+        EventBus eventBus_;
+
+        class Impl;
+        std::unique_ptr<Impl> pImpl_;
+    };
+
+} // namespace elink
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "type.h"
+#include "elegoo_export.h"
+
+namespace elink
+{
+    /**
+     * Frequently read status fields, available without decoding the full status
+     */
+    struct PrinterStatusSummary
+    {
+        PrinterState state = PrinterState::UNKNOWN;
+        PrinterSubState subState = PrinterSubState::NONE;
+        int progress = 0;          // PrinterStatus::progress
+        int printProgress = 0;     // PrintStatus::progress
+        int currentLayer = 0;
+        int totalLayer = 0;
+        int64_t estimatedTime = 0; // Remaining print time (seconds)
+        double extruderTemperature = 0.0;
+        double extruderTarget = 0.0;
+        double heatedBedTemperature = 0.0;
+        double heatedBedTarget = 0.0;
+        double chamberTemperature = 0.0;
+        int64_t updatedAtMs = 0;   // Unix time of the last update
+        uint64_t updateCount = 0;  // Updates received for the printer; unchanged means nothing new
+    };
+
+    /**
+     * Reads the printer status an ElegooLink process publishes to shared memory
+     *
+     * Enable publishing in the SDK process with config.statusShare.statusShareEnable or
+     * ElegooLink::startStatusSharing(). Reads copy the printer's slot from the mapped segment
+     * without any IPC round trip: readSummary() takes tens of nanoseconds, readStatus() adds
+     * decoding the full status. POSIX systems only.
+     *
+     * An instance caches slot positions and is not thread-safe; use one reader per thread.
+     * When isWriterActive() turns false the SDK process stopped publishing, and a later
+     * publisher creates a new segment: call open() again to follow it.
+     */
+    class ELEGOO_LINK_API ElegooLinkStatusReader
+    {
+    public:
+        ElegooLinkStatusReader();
+        ~ElegooLinkStatusReader();
+
+        ElegooLinkStatusReader(const ElegooLinkStatusReader &) = delete;
+        ElegooLinkStatusReader &operator=(const ElegooLinkStatusReader &) = delete;
+
+        /**
+         * Map the status segment
+         * @param segmentName Shared memory name, empty for the default of the current user
+         * @return false if no process publishes status under that name
+         */
+        bool open(const std::string &segmentName = "");
+
+        /**
+         * Unmap the segment
+         */
+        void close();
+
+        bool isOpen() const;
+
+        /**
+         * Whether the process that created the segment is still publishing to it
+         */
+        bool isWriterActive() const;
+
+        /**
+         * IDs of the printers that have published status
+         */
+        std::vector<std::string> getPrinterIds();
+
+        /**
+         * Read the summary fields of a printer
+         * @return false if the printer has not published status
+         */
+        bool readSummary(const std::string &printerId, PrinterStatusSummary &summary);
+
+        /**
+         * Read the full status of a printer
+         * @return false if the printer has not published status or its status exceeds the slot size
+         */
+        bool readStatus(const std::string &printerId, PrinterStatusData &status);
+
+    private:
+        class Impl;
+        std::unique_ptr<Impl> pImpl_;
+    };
+
+} // namespace elink
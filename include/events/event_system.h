@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <unordered_map>
 #include <vector>
@@ -58,6 +59,23 @@ namespace elink
         HandlerFunc handler_;
     };
 
+    /**
+     * Recycling statistics of the event pools behind EventBus::publishFromEvent()
+     */
+    struct EventPoolStats
+    {
+        uint64_t hits = 0;   // Events built in the storage of a released event
+        uint64_t misses = 0; // Events that needed a new allocation
+        size_t pooled = 0;   // Events currently kept by the pools
+        size_t capacity = 0; // Upper bound of pooled
+
+        double hitRate() const
+        {
+            uint64_t total = hits + misses;
+            return total ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+        }
+    };
+
     /**
      * Event Bus
      * Responsible for event dispatching and subscription management
@@ -126,9 +144,16 @@ namespace elink
 
         /**
          * Convert from old BizEvent and publish an event
+         * Status and raw printer events are taken from process-wide pools and recycled once
+         * every subscriber has released them.
          */
         void publishFromEvent(const BizEvent &event);
 
+        /**
+         * Statistics of the pools used by publishFromEvent(), summed over all event buses
+         */
+        static EventPoolStats getEventPoolStats();
+
         /**
          * Clear all subscriptions
          */
@@ -20,6 +20,14 @@ namespace elink
 
     using GetPrinterListResult = BizResult<GetPrinterListData>;
 
+    /**
+     * Printer list changed event data
+     */
+    struct PrinterListChangedData
+    {
+        std::vector<std::string> removedPrinterIds; // Printers removed from the list, empty when not known
+    };
+
 
     /**
      * Printer discovery configuration
@@ -41,4 +49,14 @@ namespace elink
 
     using PrinterDiscoveryResult = BizResult<PrinterDiscoveryData>;
 
+    /**
+     * Resource accounting of all printers
+     */
+    struct PrinterResourceStatsListData
+    {
+        std::vector<PrinterResourceStats> printers; // One entry per registered printer
+    };
+
+    using PrinterResourceStatsListResult = BizResult<PrinterResourceStatsListData>;
+
 } // namespace elink
@@ -0,0 +1,330 @@
+#pragma once
+#include "../elegoo_export.h"
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+namespace elink
+{
+    /**
+     * Interned printer component name, e.g. "extruder", "model", "main"
+     * Standard component names have fixed ids; other names are interned process-wide on first
+     * use, so a key is a 16-bit id that compares and copies like an integer. The intern table is
+     * bounded: once it holds 1024 names, further new names are refused with an invalid key, which
+     * maps skip when decoding. Converts to and from std::string for code written against the
+     * former std::map<std::string, ...> fields.
+     */
+    class ELEGOO_LINK_API ComponentKey
+    {
+    public:
+        enum Standard : uint16_t
+        {
+            // Temperatures
+            EXTRUDER,
+            HEATED_BED,
+            CHAMBER,
+            // Fans
+            FAN_MODEL,
+            FAN_HEATSINK,
+            FAN_CONTROLLER,
+            FAN_CHASSIS,
+            FAN_AUX,
+            // Lights
+            LIGHT_MAIN,
+            // Storage
+            STORAGE_LOCAL,
+            STORAGE_UDISK,
+            STORAGE_SDCARD,
+
+            STANDARD_COUNT
+        };
+
+        constexpr ComponentKey(Standard id = EXTRUDER) : id_(id) {}
+        ComponentKey(const char *name) : id_(intern(name)) {}
+        ComponentKey(const std::string &name) : id_(intern(name)) {}
+        ComponentKey(std::string_view name) : id_(intern(name)) {}
+
+        uint16_t id() const { return id_; }
+        bool isStandard() const { return id_ < STANDARD_COUNT; }
+
+        /**
+         * False if the name was refused because the intern table is full
+         */
+        bool isValid() const { return id_ != INVALID_ID; }
+
+        /**
+         * Component name, empty for an invalid key; the reference stays valid for the life of the process
+         */
+        const std::string &name() const;
+        operator const std::string &() const { return name(); }
+
+        bool operator==(const ComponentKey &other) const { return id_ == other.id_; }
+        bool operator!=(const ComponentKey &other) const { return id_ != other.id_; }
+        bool operator<(const ComponentKey &other) const { return name() < other.name(); }
+
+    private:
+        static constexpr uint16_t INVALID_ID = 0xFFFF;
+
+        static uint16_t intern(std::string_view name);
+
+        uint16_t id_;
+    };
+
+    inline std::ostream &operator<<(std::ostream &stream, const ComponentKey &key)
+    {
+        return stream << key.name();
+    }
+
+    /**
+     * Map from component name to status, laid out for status snapshots
+     *
+     * The Count standard components starting at First live in fixed inline slots tracked by a
+     * presence mask, so the usual status of a printer is built, copied and looked up without
+     * allocating or comparing strings. Other components go to an overflow vector, which stays
+     * unallocated until one appears. Offers the subset of the std::map interface used on
+     * status data; iteration visits the standard slots in declaration order, then the others
+     * in insertion order. As in flat maps, value_type holds a non-const key, which callers
+     * must not modify.
+     */
+    template <typename T, ComponentKey::Standard First, size_t Count>
+    class ComponentMap
+    {
+        static_assert(Count > 0 && Count <= 32, "presence mask holds at most 32 slots");
+
+    public:
+        using key_type = ComponentKey;
+        using mapped_type = T;
+        using value_type = std::pair<ComponentKey, T>;
+        using size_type = size_t;
+
+        template <bool IsConst>
+        class Iterator
+        {
+        public:
+            using Map = std::conditional_t<IsConst, const ComponentMap, ComponentMap>;
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = ComponentMap::value_type;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::conditional_t<IsConst, const value_type &, value_type &>;
+            using pointer = std::conditional_t<IsConst, const value_type *, value_type *>;
+
+            Iterator() = default;
+            Iterator(Map *map, size_t index) : map_(map), index_(index) { skipAbsent(); }
+            template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+            Iterator(const Iterator<OtherConst> &other) : map_(other.map_), index_(other.index_) {}
+
+            reference operator*() const { return index_ < Count ? map_->slots_[index_] : map_->extras_[index_ - Count]; }
+            pointer operator->() const { return &**this; }
+
+            Iterator &operator++()
+            {
+                ++index_;
+                skipAbsent();
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator previous = *this;
+                ++*this;
+                return previous;
+            }
+
+            bool operator==(const Iterator &other) const { return index_ == other.index_; }
+            bool operator!=(const Iterator &other) const { return index_ != other.index_; }
+
+        private:
+            template <bool>
+            friend class Iterator;
+            friend class ComponentMap;
+
+            void skipAbsent()
+            {
+                while (index_ < Count && !(map_->present_ & (1u << index_)))
+                {
+                    ++index_;
+                }
+            }
+
+            Map *map_ = nullptr;
+            size_t index_ = 0;
+        };
+
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        ComponentMap() : ComponentMap(std::make_index_sequence<Count>()) {}
+
+        ComponentMap(std::initializer_list<std::pair<ComponentKey, T>> items) : ComponentMap()
+        {
+            for (const auto &item : items)
+            {
+                (*this)[item.first] = item.second;
+            }
+        }
+
+        ComponentMap(const ComponentMap &other) = default;
+        ComponentMap(ComponentMap &&other) noexcept = default;
+        ComponentMap &operator=(const ComponentMap &other) = default;
+        ComponentMap &operator=(ComponentMap &&other) noexcept = default;
+
+        iterator begin() { return iterator(this, 0); }
+        iterator end() { return iterator(this, Count + extras_.size()); }
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, Count + extras_.size()); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+
+        size_t size() const { return popcount(present_) + extras_.size(); }
+        bool empty() const { return present_ == 0 && extras_.empty(); }
+
+        T &operator[](const ComponentKey &key)
+        {
+            size_t slot = slotOf(key);
+            if (slot < Count)
+            {
+                if (!(present_ & (1u << slot)))
+                {
+                    slots_[slot].second = T();
+                    present_ |= 1u << slot;
+                }
+                return slots_[slot].second;
+            }
+            size_t extra = extraOf(key);
+            if (extra < extras_.size())
+            {
+                return extras_[extra].second;
+            }
+            extras_.emplace_back(key, T());
+            return extras_.back().second;
+        }
+
+        iterator find(const ComponentKey &key) { return iterator(this, indexOf(key)); }
+        const_iterator find(const ComponentKey &key) const { return const_iterator(this, indexOf(key)); }
+
+        size_t count(const ComponentKey &key) const { return indexOf(key) < Count + extras_.size() ? 1 : 0; }
+        bool contains(const ComponentKey &key) const { return count(key) > 0; }
+
+        T &at(const ComponentKey &key)
+        {
+            size_t index = indexOf(key);
+            if (index >= Count + extras_.size())
+            {
+                throw std::out_of_range("ComponentMap::at: no component " + key.name());
+            }
+            return index < Count ? slots_[index].second : extras_[index - Count].second;
+        }
+
+        const T &at(const ComponentKey &key) const
+        {
+            return const_cast<ComponentMap *>(this)->at(key);
+        }
+
+        size_t erase(const ComponentKey &key)
+        {
+            size_t index = indexOf(key);
+            if (index < Count)
+            {
+                present_ &= ~(1u << index);
+                return 1;
+            }
+            if (index >= Count + extras_.size())
+            {
+                return 0;
+            }
+            extras_.erase(extras_.begin() + (index - Count));
+            return 1;
+        }
+
+        void clear()
+        {
+            present_ = 0;
+            extras_.clear();
+        }
+
+        bool operator==(const ComponentMap &other) const
+        {
+            if (present_ != other.present_ || extras_.size() != other.extras_.size())
+            {
+                return false;
+            }
+            for (size_t i = 0; i < Count; ++i)
+            {
+                if ((present_ & (1u << i)) && !(slots_[i].second == other.slots_[i].second))
+                {
+                    return false;
+                }
+            }
+            for (const auto &entry : extras_)
+            {
+                auto it = other.find(entry.first);
+                if (it == other.end() || !(it->second == entry.second))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool operator!=(const ComponentMap &other) const { return !(*this == other); }
+
+    private:
+        template <size_t... Slots>
+        explicit ComponentMap(std::index_sequence<Slots...>)
+            : slots_{value_type(ComponentKey(static_cast<ComponentKey::Standard>(First + Slots)), T())...}
+        {
+        }
+
+        static size_t popcount(uint32_t mask)
+        {
+            size_t bits = 0;
+            for (; mask; mask &= mask - 1)
+            {
+                ++bits;
+            }
+            return bits;
+        }
+
+        static size_t slotOf(const ComponentKey &key)
+        {
+            return key.id() >= First && key.id() < First + Count ? key.id() - First : Count;
+        }
+
+        size_t extraOf(const ComponentKey &key) const
+        {
+            for (size_t i = 0; i < extras_.size(); ++i)
+            {
+                if (extras_[i].first == key)
+                {
+                    return i;
+                }
+            }
+            return extras_.size();
+        }
+
+        /**
+         * Iterator index of key, Count + extras_.size() (end) if absent
+         */
+        size_t indexOf(const ComponentKey &key) const
+        {
+            size_t slot = slotOf(key);
+            if (slot < Count)
+            {
+                return (present_ & (1u << slot)) ? slot : Count + extras_.size();
+            }
+            return Count + extraOf(key);
+        }
+
+        value_type slots_[Count];
+        uint32_t present_ = 0;
+        std::vector<value_type> extras_;
+    };
+
+} // namespace elink
@@ -3,6 +3,7 @@
 #include "../events/event_system.h"
 #include "printer.h"
 #include "cloud.h"
+#include "common.h"
 
 namespace elink
 {
@@ -82,6 +83,8 @@ namespace elink
 
     class PrinterListChangedEvent : public BaseEvent
     {
+    public:
+        PrinterListChangedData change;
     };
 
     // Online status changed event
@@ -90,5 +93,23 @@ namespace elink
     public:
         bool isOnline; // Online status
     };
+
+    /**
+     * Printers entered or left a fleet query registered with ElegooLink::watchFleet()
+     */
+    class FleetQueryChangedEvent : public BaseEvent
+    {
+    public:
+        FleetQueryChangedData change;
+    };
+
+    /**
+     * An alert rule added with ElegooLink::addAlertRule() raised or cleared an alert
+     */
+    class AlertEvent : public BaseEvent
+    {
+    public:
+        AlertData alert;
+    };
 }
 #endif // ELEGOO_EVENT_H
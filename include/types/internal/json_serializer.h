@@ -3,19 +3,68 @@
 #include "../cloud.h"
 #include "../printer.h"
 #include "../common.h"
+#include <cstdint>
+#include <string_view>
 #include <variant>
 #ifdef NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT
 #undef NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT
 #endif
 
+namespace elink
+{
+    namespace json_detail
+    {
+        /**
+         * FNV-1a hash of a JSON key, usable as a case label
+         */
+        constexpr uint64_t keyHash(std::string_view key)
+        {
+            uint64_t hash = 14695981039346656037ull;
+            for (char c : key)
+            {
+                hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+            }
+            return hash;
+        }
+    } // namespace json_detail
+} // namespace elink
+
+// One case per field; two fields of a type hashing alike fail to compile as duplicate case labels
+#define ELINK_JSON_FROM_FIELD(v1)                                      \
+    case ::elink::json_detail::keyHash(#v1):                           \
+        if (nlohmann_json_key == #v1)                                  \
+        {                                                              \
+            nlohmann_json_value.get_to(nlohmann_json_t.v1);            \
+        }                                                              \
+        break;
+
+// Copy-assigned rather than replaced, so strings and containers of a reused target keep their capacity
+#define ELINK_JSON_RESET_FIELD(v1) nlohmann_json_t.v1 = nlohmann_json_default_obj.v1;
+
+/**
+ * to_json/from_json for a struct with the given fields
+ * from_json walks the JSON object once and dispatches each key with a switch on its hash, so it
+ * does not look every field up by name. Every field is first restored to its default in place,
+ * so fields missing from the JSON do not keep stale values when a target is decoded into again.
+ */
 #define NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(Type, ...)                                                                                                \
     template <typename BasicJsonType, nlohmann::detail::enable_if_t<nlohmann::detail::is_basic_json<BasicJsonType>::value, int> = 0>                              \
     static void to_json(BasicJsonType &nlohmann_json_j, const Type &nlohmann_json_t) { NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(NLOHMANN_JSON_TO, __VA_ARGS__)) } \
     template <typename BasicJsonType, nlohmann::detail::enable_if_t<nlohmann::detail::is_basic_json<BasicJsonType>::value, int> = 0>                              \
     static void from_json(const BasicJsonType &nlohmann_json_j, Type &nlohmann_json_t)                                                                            \
     {                                                                                                                                                             \
-        const Type nlohmann_json_default_obj{};                                                                                                                   \
-        NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(NLOHMANN_JSON_FROM_WITH_DEFAULT, __VA_ARGS__))                                                                   \
+        static const Type nlohmann_json_default_obj{};                                                                                                            \
+        NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(ELINK_JSON_RESET_FIELD, __VA_ARGS__))                                                                            \
+        for (const auto &[nlohmann_json_key, nlohmann_json_value] :                                                                                               \
+             nlohmann_json_j.template get_ref<const typename BasicJsonType::object_t &>())                                                                        \
+        {                                                                                                                                                         \
+            switch (::elink::json_detail::keyHash(nlohmann_json_key))                                                                                             \
+            {                                                                                                                                                     \
+                NLOHMANN_JSON_EXPAND(NLOHMANN_JSON_PASTE(ELINK_JSON_FROM_FIELD, __VA_ARGS__))                                                                     \
+            default:                                                                                                                                              \
+                break;                                                                                                                                            \
+            }                                                                                                                                                     \
+        }                                                                                                                                                         \
     }
 
 namespace elink
@@ -67,7 +116,11 @@ namespace elink
 
         if (result.data.has_value())
         {
-            if constexpr (std::is_same_v<T, nlohmann::json>)
+            if constexpr (std::is_same_v<T, std::monostate>)
+            {
+                // No data field for VoidResult
+            }
+            else if constexpr (std::is_same_v<T, nlohmann::json>)
             {
                 j["data"] = *result.data;
             }
@@ -92,6 +145,9 @@ namespace elink
     NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(GetPrinterListData,
                                                     printers)
 
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(PrinterListChangedData,
+                                                    removedPrinterIds)
+
     NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(PrinterDiscoveryParams,
                                                     timeoutMs, broadcastInterval, enableAutoRetry, preferredListenPorts)
 
@@ -198,9 +254,51 @@ namespace elink
     NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(ExternalDeviceStatus,
                                                     usbConnected, sdCardConnected, cameraConnected, canvasConnected)
 
+    // Component maps serialize as objects keyed by component name, like the std::map they replaced
+    template <typename BasicJsonType, typename T, ComponentKey::Standard First, size_t Count,
+              nlohmann::detail::enable_if_t<nlohmann::detail::is_basic_json<BasicJsonType>::value, int> = 0>
+    static void to_json(BasicJsonType &j, const ComponentMap<T, First, Count> &map)
+    {
+        j = BasicJsonType::object();
+        for (const auto &[key, value] : map)
+        {
+            j[key.name()] = value;
+        }
+    }
+
+    template <typename BasicJsonType, typename T, ComponentKey::Standard First, size_t Count,
+              nlohmann::detail::enable_if_t<nlohmann::detail::is_basic_json<BasicJsonType>::value, int> = 0>
+    static void from_json(const BasicJsonType &j, ComponentMap<T, First, Count> &map)
+    {
+        map.clear();
+        if (!j.is_object())
+        {
+            return;
+        }
+        for (auto it = j.begin(); it != j.end(); ++it)
+        {
+            // Names refused by a full intern table would all share the invalid key
+            ComponentKey key(it.key());
+            if (key.isValid())
+            {
+                map[key] = it.value().template get<T>();
+            }
+        }
+    }
+
     NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(PrinterStatusData,
                                                     printerId, printerStatus, printStatus, temperatureStatus, fanStatus,
-                                                    printAxesStatus, lightStatus, storageStatus, canvasStatus, externalDeviceStatus)
+                                                    printAxesStatus, lightStatus, storageStatus, canvasStatus, externalDeviceStatus,
+                                                    statusVersion, statusAgeMs)
+
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(PrinterStatusParams,
+                                                    printerId, readMode)
+
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(StatusIfNewerParams,
+                                                    printerId, knownVersion)
+
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(StatusIfNewerData,
+                                                    changed, statusVersion, status)
 
     NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(StartPrintParams,
                                                     printerId, storageLocation, fileName, autoBedLeveling, heatedBedType, enableTimeLapse, bedLevelForce, slotMap)
@@ -252,6 +350,71 @@ namespace elink
     NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(SetAutoRefillParams,
                                                     printerId, enable)
 
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(PrinterResourceStats,
+                                                    printerId, transport, messagesReceived, bytesReceived,
+                                                    messagesSent, bytesSent, bytesUploaded, bytesDownloaded,
+                                                    statusCacheBytes, pendingRequests, pendingRequestBytes,
+                                                    eventsReceived, eventsPerSecond, collectionDurationMs)
+
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(TelemetryQueryParams,
+                                                    printerIds, metrics, startMs, endMs, bucketMs)
+
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(TelemetryBucket,
+                                                    startMs, min, max, avg, count)
+
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(TelemetrySeries,
+                                                    printerId, metric, buckets)
+
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(TelemetryQueryData,
+                                                    series)
+
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(FleetCondition,
+                                                    field, op, value, text)
+
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(FleetQueryParams,
+                                                    conditions)
+
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(FleetQueryData,
+                                                    printerIds)
+
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(FleetWatchData,
+                                                    watchId, printerIds)
+
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(FleetUnwatchParams,
+                                                    watchId)
+
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(FleetQueryChangedData,
+                                                    watchId, added, removed)
+
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(FleetGroupCount,
+                                                    value, text, count)
+
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(FleetSummaryData,
+                                                    printerCount, byState, byModel, byExceptionCode, printingCount,
+                                                    averagePrintProgress, totalRemainingTime,
+                                                    averageExtruderTemperature, averageHeatedBedTemperature)
+
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(AlertCondition,
+                                                    field, op, value, hysteresis)
+
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(AlertRule,
+                                                    ruleId, printerId, conditions, forMs, clearForMs, message)
+
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(AlertRuleParams,
+                                                    ruleId)
+
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(AlertRuleListData,
+                                                    rules)
+
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(AlertData,
+                                                    ruleId, printerId, active, timestampMs, message)
+
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(AlertListData,
+                                                    alerts)
+
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(PrinterResourceStatsListData,
+                                                    printers)
+
 #endif
 
 #if 1 // Cloud-related structs
@@ -312,5 +475,12 @@ namespace elink
     NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(CancelPrinterDownloadFileParams, printerId, taskId)
 
     NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(UpdatePrinterNameParams, printerId, printerName)
+
+    // License-related structs
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(LicenseExpiredDevice, serialNumber, status)
+
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(GetLicenseExpiredDevicesData, devices)
+
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(RenewLicenseParams, serialNumber)
 #endif
 } // namespace elink
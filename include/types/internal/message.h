@@ -65,6 +65,8 @@ namespace elink
         ON_LOGGED_IN_ELSEWHERE,    // Logged in elsewhere
         ON_PRINTER_LIST_CHANGED,   // Printer list changed
         ON_ONLINE_STATUS_CHANGED,  // Online status changed
+        ON_FLEET_QUERY_CHANGED,    // Printers entered or left a watched fleet query
+        ON_ALERT,                  // An alert rule raised or cleared an alert
     };
 
     struct BizRequest
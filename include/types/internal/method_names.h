@@ -87,6 +87,10 @@ namespace elink
         constexpr const char *EVENT_RTC_TOKEN_CHANGED = "event.rtc.token.changed";
         // File Events
         constexpr const char *EVENT_FILE_UPLOAD_PROGRESS = "event.file.upload.progress";
+        // Fleet Events
+        constexpr const char *EVENT_FLEET_QUERY_CHANGED = "event.fleet.query.changed";
+        // Alert Events
+        constexpr const char *EVENT_ALERT = "event.alert";
 
         // Event mapping table - bidirectional lookup
         struct EventMapping
@@ -108,7 +112,9 @@ namespace elink
                 {MethodType::ON_PRINTER_EVENT_RAW, EVENT_PRINTER_RAW},
                 {MethodType::ON_LOGGED_IN_ELSEWHERE, EVENT_USER_LOGGED_ELSEWHERE},
                 {MethodType::ON_PRINTER_LIST_CHANGED, EVENT_PRINTER_LIST_CHANGED},
-                {MethodType::ON_ONLINE_STATUS_CHANGED, EVENT_USER_ONLINE_STATUS}
+                {MethodType::ON_ONLINE_STATUS_CHANGED, EVENT_USER_ONLINE_STATUS},
+                {MethodType::ON_FLEET_QUERY_CHANGED, EVENT_FLEET_QUERY_CHANGED},
+                {MethodType::ON_ALERT, EVENT_ALERT}
             };
             return mappings;
         }
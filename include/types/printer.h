@@ -1,8 +1,10 @@
 #pragma once
 #include "biz.h"
+#include "component_map.h"
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 #include <optional>
 #include <cstdint>
 namespace elink
@@ -115,6 +117,11 @@ namespace elink
         std::map<std::string, std::string> extraInfo;
     };
 
+    /**
+     * Shared immutable printer information, used where many readers need the same snapshot
+     */
+    using PrinterInfoPtr = std::shared_ptr<const PrinterInfo>;
+
     // Storage printer information
     struct StorageComponent
     {
@@ -429,40 +436,72 @@ namespace elink
         bool cameraConnected = false; // Whether camera is connected
         bool canvasConnected = false; // Whether canvas is connected
     };
+    using TemperatureMap = ComponentMap<TemperatureStatus, ComponentKey::EXTRUDER, 3>;
+    using FanMap = ComponentMap<FanStatus, ComponentKey::FAN_MODEL, 5>;
+    using LightMap = ComponentMap<LightStatus, ComponentKey::LIGHT_MAIN, 1>;
+    using StorageMap = ComponentMap<StorageStatus, ComponentKey::STORAGE_LOCAL, 3>;
+
     // Printer status information
     struct PrinterStatusData : public PrinterEventData
     {
         PrinterStatus printerStatus;
         PrintStatus printStatus; // Print status
-        // Use maps to store temperatures and fans for better extensibility
-        // Temperature and fan names can be keys, such as "heatedBed", "extruder", "chamber", etc.
-        std::map<std::string, TemperatureStatus> temperatureStatus; // Temperature information
-        // Fans can also be stored in a map for flexibility
-        // Fan names can be keys, such as "model", "heatsink", "controller", "chassis", "aux", etc.
-        std::map<std::string, FanStatus> fanStatus;
-        PrintAxesStatus printAxesStatus; // Print axes status information
-                                         // Light status information
-        // Use map to store light status, key is light name, e.g., "main"
-        std::map<std::string, LightStatus> lightStatus;
-        // Storage printer status information, key is storage printer name, e.g., "local", "udisk", "sdcard"
-        std::map<std::string, StorageStatus> storageStatus;
+        // Temperature, fan, light and storage maps are keyed by component name. Standard
+        // components (see ComponentKey::Standard) are held in fixed slots, other names are
+        // kept alongside them, so the maps are used like std::map<std::string, ...>.
+        TemperatureMap temperatureStatus; // Temperature information, e.g. "heatedBed", "extruder", "chamber"
+        FanMap fanStatus;                 // Fans, e.g. "model", "heatsink", "controller", "chassis", "aux"
+        PrintAxesStatus printAxesStatus;  // Print axes status information
+        LightMap lightStatus;             // Lights, e.g. "main"
+        StorageMap storageStatus;         // Storage, e.g. "local", "udisk", "sdcard"
 
         CanvasStatus canvasStatus; // Canvas status information, optional,some printers may not support it
 
         ExternalDeviceStatus externalDeviceStatus; // External device status information, such as USB disk, SD card, camera, etc.
+
+        uint64_t statusVersion = 0; // Increases with every status recorded for a LAN printer, 0 if unversioned
+        int64_t statusAgeMs = -1;   // Age of a status answered from memory, -1 if it was just received
         PrinterStatusData(const std::string &printerId = "")
             : PrinterEventData(printerId) {}
     };
 
-    using PrinterStatusParams = PrinterBaseParams;
-    // struct PrinterStatusParams : public PrinterBaseParams
-    // {
-    //     PrinterStatusParams(const std::string &printerId)
-    //         : PrinterBaseParams(printerId) {}
-    // };
+    /**
+     * How getPrinterStatus obtains the status
+     */
+    enum class StatusReadMode
+    {
+        REQUEST = 0, // Ask the printer
+        CACHED = 1,  // Answer from memory while pushed updates keep the status current, else ask the printer
+    };
+
+    struct PrinterStatusParams : public PrinterBaseParams
+    {
+        StatusReadMode readMode = StatusReadMode::REQUEST;
+        PrinterStatusParams(const std::string &printerId = "", StatusReadMode readMode = StatusReadMode::REQUEST)
+            : PrinterBaseParams(printerId), readMode(readMode) {}
+    };
 
     using PrinterStatusResult = BizResult<PrinterStatusData>;
 
+    struct StatusIfNewerParams : public PrinterBaseParams
+    {
+        uint64_t knownVersion = 0; // statusVersion the caller already has, 0 for none
+        StatusIfNewerParams(const std::string &printerId = "", uint64_t knownVersion = 0)
+            : PrinterBaseParams(printerId), knownVersion(knownVersion) {}
+    };
+
+    /**
+     * Conditional status read, answered from memory
+     */
+    struct StatusIfNewerData
+    {
+        bool changed = false;       // Whether status holds a version newer than knownVersion
+        uint64_t statusVersion = 0; // Latest version, 0 if no status was received yet
+        PrinterStatusData status;   // Only filled when changed
+    };
+
+    using StatusIfNewerResult = BizResult<StatusIfNewerData>;
+
     using PrinterAttributesParams = PrinterBaseParams;
 
     /**
@@ -738,4 +777,259 @@ namespace elink
     };
 
     using SetAutoRefillResult = VoidResult;    
+
+    /**
+     * Per-printer resource accounting
+     * Counters accumulate from the time the printer was added and are approximate
+     */
+    struct PrinterResourceStats
+    {
+        std::string printerId;
+        std::string transport;              // Message transport ("mqtt", "websocket")
+        uint64_t messagesReceived = 0;      // Messages received on the transport
+        uint64_t bytesReceived = 0;         // Payload bytes received on the transport
+        uint64_t messagesSent = 0;          // Messages sent on the transport
+        uint64_t bytesSent = 0;             // Payload bytes sent on the transport
+        uint64_t bytesUploaded = 0;         // File bytes uploaded over HTTP
+        uint64_t bytesDownloaded = 0;       // File bytes downloaded over HTTP
+        uint64_t statusCacheBytes = 0;      // Approximate memory held by the cached full status
+        uint64_t pendingRequests = 0;       // Requests waiting for a response
+        uint64_t pendingRequestBytes = 0;   // Approximate memory held by pending request tracking
+        uint64_t eventsReceived = 0;        // Events delivered from this printer
+        double eventsPerSecond = 0.0;       // Event rate over the last measurement window
+        int64_t collectionDurationMs = 0;   // Time since the counters started
+    };
+
+    using PrinterResourceStatsParams = PrinterBaseParams;
+    using PrinterResourceStatsResult = BizResult<PrinterResourceStats>;
+
+    /**
+     * Status values kept in the telemetry history
+     */
+    enum class TelemetryMetric
+    {
+        EXTRUDER_TEMPERATURE = 0,
+        EXTRUDER_TARGET = 1,
+        HEATED_BED_TEMPERATURE = 2,
+        HEATED_BED_TARGET = 3,
+        CHAMBER_TEMPERATURE = 4,
+        MODEL_FAN_SPEED = 5,   // Percent
+        AUX_FAN_SPEED = 6,     // Percent
+        CHASSIS_FAN_SPEED = 7, // Percent
+        PRINT_PROGRESS = 8,    // PrintStatus::progress
+    };
+
+    struct TelemetryQueryParams
+    {
+        std::vector<std::string> printerIds;  // Empty for every printer with history
+        std::vector<TelemetryMetric> metrics; // Empty for every metric
+        int64_t startMs = 0;                  // Range start (unix ms), inclusive
+        int64_t endMs = 0;                    // Range end (unix ms), exclusive; 0 for now
+        int64_t bucketMs = 60000;             // Bucket width
+    };
+
+    struct TelemetryBucket
+    {
+        int64_t startMs = 0; // Bucket start (unix ms)
+        double min = 0.0;
+        double max = 0.0;
+        double avg = 0.0;
+        uint32_t count = 0; // Samples in the bucket
+    };
+
+    struct TelemetrySeries
+    {
+        std::string printerId;
+        TelemetryMetric metric = TelemetryMetric::EXTRUDER_TEMPERATURE;
+        std::vector<TelemetryBucket> buckets; // Buckets without samples are omitted
+    };
+
+    struct TelemetryQueryData
+    {
+        std::vector<TelemetrySeries> series; // Series without samples in the range are omitted
+    };
+
+    using TelemetryQueryResult = BizResult<TelemetryQueryData>;
+
+    /**
+     * Status values a fleet query can test, taken from the latest status of each printer
+     */
+    enum class FleetField
+    {
+        STATE = 0,                  // PrinterState
+        SUB_STATE = 1,              // PrinterSubState
+        MODEL = 2,                  // PrinterInfo::model, compared with FleetCondition::text
+        EXCEPTION_CODE = 3,         // Any of PrinterStatus::exceptionCodes
+        PRINT_PROGRESS = 4,         // PrintStatus::progress
+        REMAINING_TIME = 5,         // PrintStatus::estimatedTime (seconds)
+        EXTRUDER_TEMPERATURE = 6,   // Missing while offline or without an extruder
+        HEATED_BED_TEMPERATURE = 7, // Missing while offline or without a heated bed
+        CHAMBER_TEMPERATURE = 8,    // Missing while offline or without a chamber sensor
+    };
+
+    enum class FleetOperator
+    {
+        EQUAL = 0,
+        NOT_EQUAL = 1,
+        LESS = 2,
+        LESS_EQUAL = 3,
+        GREATER = 4,
+        GREATER_EQUAL = 5,
+    };
+
+    /**
+     * One test of a fleet query; a missing value fails every test
+     */
+    struct FleetCondition
+    {
+        FleetField field = FleetField::STATE;
+        FleetOperator op = FleetOperator::EQUAL;
+        double value = 0.0; // Compared with numeric fields; the code for EXCEPTION_CODE
+        std::string text;   // Compared with MODEL, which supports EQUAL and NOT_EQUAL only
+    };
+
+    struct FleetQueryParams
+    {
+        std::vector<FleetCondition> conditions; // All must hold; empty matches every printer
+    };
+
+    struct FleetQueryData
+    {
+        std::vector<std::string> printerIds; // Sorted
+    };
+
+    using FleetQueryResult = BizResult<FleetQueryData>;
+
+    struct FleetWatchData
+    {
+        uint64_t watchId = 0;
+        std::vector<std::string> printerIds; // Current matches, sorted; later changes arrive as FleetQueryChangedEvent
+    };
+
+    using FleetWatchResult = BizResult<FleetWatchData>;
+
+    struct FleetUnwatchParams
+    {
+        uint64_t watchId = 0;
+    };
+
+    /**
+     * Printers that started or stopped matching a watched fleet query
+     */
+    struct FleetQueryChangedData
+    {
+        uint64_t watchId = 0;
+        std::vector<std::string> added;
+        std::vector<std::string> removed;
+    };
+
+    struct FleetGroupCount
+    {
+        int value = 0;    // PrinterState or exception code
+        std::string text; // Model
+        size_t count = 0;
+    };
+
+    /**
+     * Counts and running aggregates over the latest status of every printer
+     */
+    struct FleetSummaryData
+    {
+        size_t printerCount = 0;
+        std::vector<FleetGroupCount> byState;         // Sorted by state
+        std::vector<FleetGroupCount> byModel;         // Sorted by model
+        std::vector<FleetGroupCount> byExceptionCode; // Printers reporting each code, sorted by code
+        size_t printingCount = 0;                     // Printers in PrinterState::PRINTING
+        double averagePrintProgress = 0.0;            // Over printing printers
+        int64_t totalRemainingTime = 0;               // Seconds, over printing printers
+        double averageExtruderTemperature = 0.0;      // Over printers reporting an extruder temperature
+        double averageHeatedBedTemperature = 0.0;     // Over printers reporting a heated bed temperature
+    };
+
+    using FleetSummaryResult = BizResult<FleetSummaryData>;
+
+    /**
+     * Status values an alert rule can test
+     */
+    enum class AlertField
+    {
+        STATE = 0,                  // PrinterState, PrinterState::OFFLINE once the printer disconnects
+        SUB_STATE = 1,              // PrinterSubState
+        PRINT_PROGRESS = 2,         // PrintStatus::progress
+        CURRENT_LAYER = 3,          // PrintStatus::currentLayer
+        EXTRUDER_TEMPERATURE = 4,   // Missing while offline or without an extruder
+        EXTRUDER_DEVIATION = 5,     // |current - target| of the extruder, missing while no target is set
+        HEATED_BED_TEMPERATURE = 6, // Missing while offline or without a heated bed
+        HEATED_BED_DEVIATION = 7,   // |current - target| of the heated bed, missing while no target is set
+        CHAMBER_TEMPERATURE = 8,    // Missing while offline or without a chamber sensor
+    };
+
+    enum class AlertOperator
+    {
+        EQUAL = 0,
+        NOT_EQUAL = 1,
+        LESS = 2,
+        LESS_EQUAL = 3,
+        GREATER = 4,
+        GREATER_EQUAL = 5,
+        UNCHANGED = 6, // Holds while the field keeps its value; each change restarts the rule's window
+    };
+
+    /**
+     * One test of an alert rule; a missing value fails every test
+     */
+    struct AlertCondition
+    {
+        AlertField field = AlertField::STATE;
+        AlertOperator op = AlertOperator::EQUAL;
+        double value = 0.0;      // Threshold, unused by UNCHANGED
+        double hysteresis = 0.0; // While the alert is raised, LESS and GREATER tests hold until the value is this far past the threshold
+    };
+
+    /**
+     * Alert raised when every condition has held for forMs
+     *
+     * Examples: extruder deviation GREATER 15 for 30 s; state EQUAL PRINTING and progress
+     * UNCHANGED for 10 min; state EQUAL OFFLINE.
+     */
+    struct AlertRule
+    {
+        std::string ruleId;
+        std::string printerId;                  // Empty for every printer
+        std::vector<AlertCondition> conditions; // All must hold
+        int64_t forMs = 0;                      // How long the conditions must hold before the alert is raised
+        int64_t clearForMs = 0;                 // How long they must fail before the alert is cleared
+        std::string message;                    // Copied to the alert events
+    };
+
+    struct AlertRuleParams
+    {
+        std::string ruleId;
+    };
+
+    struct AlertRuleListData
+    {
+        std::vector<AlertRule> rules; // Sorted by rule ID
+    };
+
+    using AlertRuleListResult = BizResult<AlertRuleListData>;
+
+    /**
+     * An alert of one rule for one printer
+     */
+    struct AlertData
+    {
+        std::string ruleId;
+        std::string printerId;
+        bool active = false;      // Raised, or cleared
+        int64_t timestampMs = 0;  // When it was raised or cleared, milliseconds since the epoch
+        std::string message;
+    };
+
+    struct AlertListData
+    {
+        std::vector<AlertData> alerts; // Sorted by rule ID, then printer ID
+    };
+
+    using AlertListResult = BizResult<AlertListData>;
 } // namespace elink
@@ -0,0 +1,581 @@
+#include "alerts/alert_engine.h"
+#include "types/internal/internal.h"
+#include "types/internal/json_serializer.h"
+#include "utils/logger.h"
+#include "utils/utils.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace elink
+{
+    namespace
+    {
+        constexpr size_t MAX_ALERT_RULES = 256;
+        constexpr double MISSING = std::numeric_limits<double>::quiet_NaN();
+        // Wait of the timer thread while no window is open
+        constexpr std::chrono::hours IDLE_WAIT{1};
+
+        const nlohmann::json *objectAt(const nlohmann::json *object, const char *key)
+        {
+            if (!object)
+            {
+                return nullptr;
+            }
+            auto it = object->find(key);
+            return it != object->end() && it->is_object() ? &*it : nullptr;
+        }
+
+        double numberAt(const nlohmann::json *object, const char *key)
+        {
+            if (!object)
+            {
+                return MISSING;
+            }
+            auto it = object->find(key);
+            return it != object->end() && it->is_number() ? it->get<double>() : MISSING;
+        }
+
+        double deviation(const nlohmann::json *component)
+        {
+            double target = numberAt(component, "target");
+            if (!(target > 0.0))
+            {
+                return MISSING;
+            }
+            return std::fabs(numberAt(component, "current") - target);
+        }
+
+        bool sameValue(double a, double b)
+        {
+            return a == b || (std::isnan(a) && std::isnan(b));
+        }
+
+        size_t fieldIndex(AlertField field)
+        {
+            return static_cast<size_t>(field);
+        }
+
+        std::chrono::milliseconds windowOf(int64_t ms)
+        {
+            return std::chrono::milliseconds(std::max<int64_t>(ms, 0));
+        }
+    } // namespace
+
+    bool AlertEngine::Predicate::operator()(const Values &values, bool raised) const
+    {
+        double value = values[field];
+        if (std::isnan(value))
+        {
+            return false;
+        }
+        double threshold = raised ? clearThreshold : raiseThreshold;
+        switch (op)
+        {
+        case AlertOperator::EQUAL:
+            return value == threshold;
+        case AlertOperator::NOT_EQUAL:
+            return value != threshold;
+        case AlertOperator::LESS:
+            return value < threshold;
+        case AlertOperator::LESS_EQUAL:
+            return value <= threshold;
+        case AlertOperator::GREATER:
+            return value > threshold;
+        case AlertOperator::GREATER_EQUAL:
+            return value >= threshold;
+        case AlertOperator::UNCHANGED:
+            return true;
+        }
+        return false;
+    }
+
+    std::atomic<bool> AlertEngine::enabled_{false};
+
+    AlertEngine &AlertEngine::getInstance()
+    {
+        static AlertEngine instance;
+        return instance;
+    }
+
+    AlertEngine::~AlertEngine()
+    {
+        stop();
+    }
+
+    void AlertEngine::start(EventCallback callback)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        callback_ = std::move(callback);
+        if (running_)
+        {
+            return;
+        }
+        running_ = true;
+        timer_ = std::thread(&AlertEngine::run, this);
+        enabled_ = true;
+    }
+
+    void AlertEngine::stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            enabled_ = false;
+            running_ = false;
+            callback_ = nullptr;
+        }
+        condition_.notify_all();
+        if (timer_.joinable())
+        {
+            timer_.join();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        rules_.clear();
+        for (auto &rules : rulesByField_)
+        {
+            rules.clear();
+        }
+        printers_.clear();
+        deadlines_.clear();
+        queued_.clear();
+    }
+
+    void AlertEngine::update(const BizEvent &event)
+    {
+        if (event.method == MethodType::ON_PRINTER_LIST_CHANGED)
+        {
+            removePrinters(event);
+            return;
+        }
+        if (event.method != MethodType::ON_PRINTER_STATUS || !event.data.is_object())
+        {
+            return;
+        }
+        auto printerIdIt = event.data.find("printerId");
+        if (printerIdIt == event.data.end() || !printerIdIt->is_string())
+        {
+            return;
+        }
+        const auto &printerId = printerIdIt->get_ref<const std::string &>();
+
+        // Fields are read before taking the lock
+        Values values;
+        const auto *printerStatus = objectAt(&event.data, "printerStatus");
+        const auto *printStatus = objectAt(&event.data, "printStatus");
+        const auto *temperatures = objectAt(&event.data, "temperatureStatus");
+        values[fieldIndex(AlertField::STATE)] = numberAt(printerStatus, "state");
+        values[fieldIndex(AlertField::SUB_STATE)] = numberAt(printerStatus, "subState");
+        values[fieldIndex(AlertField::PRINT_PROGRESS)] = numberAt(printStatus, "progress");
+        values[fieldIndex(AlertField::CURRENT_LAYER)] = numberAt(printStatus, "currentLayer");
+        // The status sent on disconnect carries defaults, not readings
+        bool offline = values[fieldIndex(AlertField::STATE)] == static_cast<int>(PrinterState::OFFLINE);
+        const auto *extruder = offline ? nullptr : objectAt(temperatures, ComponentKey(ComponentKey::EXTRUDER).name().c_str());
+        const auto *heatedBed = offline ? nullptr : objectAt(temperatures, ComponentKey(ComponentKey::HEATED_BED).name().c_str());
+        const auto *chamber = offline ? nullptr : objectAt(temperatures, ComponentKey(ComponentKey::CHAMBER).name().c_str());
+        values[fieldIndex(AlertField::EXTRUDER_TEMPERATURE)] = numberAt(extruder, "current");
+        values[fieldIndex(AlertField::EXTRUDER_DEVIATION)] = deviation(extruder);
+        values[fieldIndex(AlertField::HEATED_BED_TEMPERATURE)] = numberAt(heatedBed, "current");
+        values[fieldIndex(AlertField::HEATED_BED_DEVIATION)] = deviation(heatedBed);
+        values[fieldIndex(AlertField::CHAMBER_TEMPERATURE)] = numberAt(chamber, "current");
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto inserted = printers_.emplace(printerId, values);
+        auto &previous = inserted.first->second;
+        FieldMask changed = 0;
+        for (size_t field = 0; field < FIELD_COUNT; ++field)
+        {
+            if (inserted.second || !sameValue(previous[field], values[field]))
+            {
+                changed |= FieldMask(1) << field;
+            }
+        }
+        if (changed == 0)
+        {
+            return;
+        }
+        previous = values;
+
+        // Only the rules reading a changed field are evaluated, each once
+        auto now = Clock::now();
+        auto stamp = ++updateStamp_;
+        for (size_t field = 0; field < FIELD_COUNT; ++field)
+        {
+            if (!(changed & (FieldMask(1) << field)))
+            {
+                continue;
+            }
+            for (CompiledRule *rule : rulesByField_[field])
+            {
+                if (rule->visited == stamp || (!rule->rule.printerId.empty() && rule->rule.printerId != printerId))
+                {
+                    continue;
+                }
+                rule->visited = stamp;
+                evaluate(*rule, printerId, values, changed, now, queued_);
+            }
+        }
+        publishQueued(lock);
+    }
+
+    void AlertEngine::removePrinters(const BizEvent &event)
+    {
+        if (!event.data.is_object())
+        {
+            return;
+        }
+        PrinterListChangedData change;
+        event.data.get_to(change);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (const auto &printerId : change.removedPrinterIds)
+        {
+            printers_.erase(printerId);
+            for (auto &[ruleId, rule] : rules_)
+            {
+                auto state = rule->states.find(printerId);
+                if (state == rule->states.end())
+                {
+                    continue;
+                }
+                // Alerts of a removed printer are cleared rather than left active
+                bool active = state->second.phase == Phase::ACTIVE || state->second.phase == Phase::CLEARING;
+                setPhase(*rule, printerId, state->second, Phase::IDLE);
+                if (active)
+                {
+                    queued_.push_back(alertEvent(*rule, printerId, false, TimeUtils::getCurrentTimestamp()));
+                }
+                rule->states.erase(state);
+            }
+        }
+        publishQueued(lock);
+    }
+
+    bool AlertEngine::addRule(const AlertRule &rule, std::string &error)
+    {
+        auto compiled = std::make_unique<CompiledRule>();
+        if (!compile(rule, *compiled, error))
+        {
+            return false;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (rules_.count(rule.ruleId))
+        {
+            error = "Alert rule " + rule.ruleId + " already exists";
+            return false;
+        }
+        if (rules_.size() >= MAX_ALERT_RULES)
+        {
+            error = "Too many alert rules, remove unused ones with removeAlertRule";
+            return false;
+        }
+        CompiledRule *added = compiled.get();
+        rules_.emplace(rule.ruleId, std::move(compiled));
+        for (size_t field = 0; field < FIELD_COUNT; ++field)
+        {
+            if (added->reads & (FieldMask(1) << field))
+            {
+                rulesByField_[field].push_back(added);
+            }
+        }
+
+        auto now = Clock::now();
+        for (const auto &[printerId, values] : printers_)
+        {
+            if (rule.printerId.empty() || rule.printerId == printerId)
+            {
+                evaluate(*added, printerId, values, 0, now, queued_);
+            }
+        }
+        publishQueued(lock);
+        return true;
+    }
+
+    bool AlertEngine::removeRule(const std::string &ruleId)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = rules_.find(ruleId);
+        if (it == rules_.end())
+        {
+            return false;
+        }
+        CompiledRule *rule = it->second.get();
+        for (auto &rules : rulesByField_)
+        {
+            rules.erase(std::remove(rules.begin(), rules.end(), rule), rules.end());
+        }
+        for (const auto &[printerId, state] : rule->states)
+        {
+            deadlines_.erase(std::make_tuple(state.deadline, ruleId, printerId));
+        }
+        rules_.erase(it);
+        return true;
+    }
+
+    std::vector<AlertRule> AlertEngine::getRules() const
+    {
+        std::vector<AlertRule> rules;
+        std::lock_guard<std::mutex> lock(mutex_);
+        rules.reserve(rules_.size());
+        for (const auto &[ruleId, rule] : rules_)
+        {
+            rules.push_back(rule->rule);
+        }
+        return rules;
+    }
+
+    std::vector<AlertData> AlertEngine::getActiveAlerts() const
+    {
+        std::vector<AlertData> alerts;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto &[ruleId, rule] : rules_)
+            {
+                for (const auto &[printerId, state] : rule->states)
+                {
+                    if (state.phase == Phase::ACTIVE || state.phase == Phase::CLEARING)
+                    {
+                        alerts.push_back(AlertData{ruleId, printerId, true, state.raisedAtMs, rule->rule.message});
+                    }
+                }
+            }
+        }
+        std::sort(alerts.begin(), alerts.end(),
+                  [](const AlertData &a, const AlertData &b)
+                  { return std::tie(a.ruleId, a.printerId) < std::tie(b.ruleId, b.printerId); });
+        return alerts;
+    }
+
+    bool AlertEngine::compile(const AlertRule &rule, CompiledRule &compiled, std::string &error)
+    {
+        if (rule.ruleId.empty())
+        {
+            error = "Alert rules need a rule ID";
+            return false;
+        }
+        if (rule.conditions.empty())
+        {
+            error = "Alert rule " + rule.ruleId + " has no conditions";
+            return false;
+        }
+        compiled.rule = rule;
+        for (const auto &condition : rule.conditions)
+        {
+            auto field = static_cast<int>(condition.field);
+            auto op = static_cast<int>(condition.op);
+            if (field < 0 || field >= static_cast<int>(FIELD_COUNT))
+            {
+                error = "Unknown alert field " + std::to_string(field);
+                return false;
+            }
+            if (op < static_cast<int>(AlertOperator::EQUAL) || op > static_cast<int>(AlertOperator::UNCHANGED))
+            {
+                error = "Unknown alert operator " + std::to_string(op);
+                return false;
+            }
+            if (std::isnan(condition.value) || std::isnan(condition.hysteresis) || condition.hysteresis < 0.0)
+            {
+                error = "Alert thresholds must be numbers and hysteresis must not be negative";
+                return false;
+            }
+
+            // Once raised, LESS and GREATER tests hold until the value is past the threshold by the hysteresis
+            Predicate predicate{static_cast<size_t>(field), condition.op, condition.value, condition.value};
+            if (condition.op == AlertOperator::LESS || condition.op == AlertOperator::LESS_EQUAL)
+            {
+                predicate.clearThreshold = condition.value + condition.hysteresis;
+            }
+            else if (condition.op == AlertOperator::GREATER || condition.op == AlertOperator::GREATER_EQUAL)
+            {
+                predicate.clearThreshold = condition.value - condition.hysteresis;
+            }
+            compiled.predicates.push_back(predicate);
+            compiled.reads |= FieldMask(1) << field;
+            if (condition.op == AlertOperator::UNCHANGED)
+            {
+                compiled.unchanged |= FieldMask(1) << field;
+            }
+        }
+        return true;
+    }
+
+    void AlertEngine::evaluate(CompiledRule &rule, const std::string &printerId, const Values &values,
+                               FieldMask changed, Clock::time_point now, std::vector<BizEvent> &events)
+    {
+        auto &state = rule.states[printerId];
+        auto holds = [&rule, &values](bool raised)
+        {
+            return std::all_of(rule.predicates.begin(), rule.predicates.end(),
+                               [&values, raised](const Predicate &predicate)
+                               { return predicate(values, raised); });
+        };
+        auto pend = [&]()
+        {
+            if (rule.rule.forMs > 0)
+            {
+                setPhase(rule, printerId, state, Phase::PENDING, now + windowOf(rule.rule.forMs));
+                return;
+            }
+            state.raisedAtMs = TimeUtils::getCurrentTimestamp();
+            setPhase(rule, printerId, state, Phase::ACTIVE);
+            events.push_back(alertEvent(rule, printerId, true, state.raisedAtMs));
+        };
+        // A change of a field tested with UNCHANGED ends the current hold
+        bool restarted = (changed & rule.unchanged) != 0;
+
+        switch (state.phase)
+        {
+        case Phase::IDLE:
+            if (holds(false))
+            {
+                pend();
+            }
+            break;
+        case Phase::PENDING:
+            if (!holds(false))
+            {
+                setPhase(rule, printerId, state, Phase::IDLE);
+            }
+            else if (restarted)
+            {
+                pend();
+            }
+            break;
+        case Phase::ACTIVE:
+        case Phase::CLEARING:
+            if (restarted)
+            {
+                setPhase(rule, printerId, state, Phase::IDLE);
+                events.push_back(alertEvent(rule, printerId, false, TimeUtils::getCurrentTimestamp()));
+                if (holds(false))
+                {
+                    pend();
+                }
+            }
+            else if (holds(true))
+            {
+                if (state.phase == Phase::CLEARING)
+                {
+                    setPhase(rule, printerId, state, Phase::ACTIVE);
+                }
+            }
+            else if (state.phase == Phase::ACTIVE)
+            {
+                if (rule.rule.clearForMs > 0)
+                {
+                    setPhase(rule, printerId, state, Phase::CLEARING, now + windowOf(rule.rule.clearForMs));
+                }
+                else
+                {
+                    setPhase(rule, printerId, state, Phase::IDLE);
+                    events.push_back(alertEvent(rule, printerId, false, TimeUtils::getCurrentTimestamp()));
+                }
+            }
+            break;
+        }
+    }
+
+    void AlertEngine::setPhase(CompiledRule &rule, const std::string &printerId, RuleState &state, Phase phase,
+                               Clock::time_point deadline)
+    {
+        bool wasWaiting = state.phase == Phase::PENDING || state.phase == Phase::CLEARING;
+        if (wasWaiting)
+        {
+            deadlines_.erase(std::make_tuple(state.deadline, rule.rule.ruleId, printerId));
+        }
+        state.phase = phase;
+        state.deadline = deadline;
+        if (phase == Phase::PENDING || phase == Phase::CLEARING)
+        {
+            bool earliest = deadlines_.empty() || deadline < std::get<0>(*deadlines_.begin());
+            deadlines_.emplace(deadline, rule.rule.ruleId, printerId);
+            if (earliest)
+            {
+                condition_.notify_all();
+            }
+        }
+    }
+
+    BizEvent AlertEngine::alertEvent(const CompiledRule &rule, const std::string &printerId, bool active,
+                                     int64_t timestampMs)
+    {
+        return BizEvent(MethodType::ON_ALERT,
+                        nlohmann::json(AlertData{rule.rule.ruleId, printerId, active, timestampMs, rule.rule.message}));
+    }
+
+    void AlertEngine::publishQueued(std::unique_lock<std::mutex> &lock)
+    {
+        if (!running_)
+        {
+            // Without a timer thread nothing would publish them
+            queued_.clear();
+        }
+        bool queued = !queued_.empty();
+        lock.unlock();
+        if (queued)
+        {
+            condition_.notify_all();
+        }
+    }
+
+    void AlertEngine::run()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (running_)
+        {
+            auto &clock = Clock::getClock();
+            auto now = clock.now();
+            while (!deadlines_.empty() && std::get<0>(*deadlines_.begin()) <= now)
+            {
+                auto [deadline, ruleId, printerId] = *deadlines_.begin();
+                deadlines_.erase(deadlines_.begin());
+                auto rule = rules_.find(ruleId);
+                if (rule == rules_.end())
+                {
+                    continue;
+                }
+                auto &state = rule->second->states[printerId];
+                if (state.phase == Phase::PENDING)
+                {
+                    state.phase = Phase::ACTIVE;
+                    state.raisedAtMs = TimeUtils::getCurrentTimestamp();
+                    queued_.push_back(alertEvent(*rule->second, printerId, true, state.raisedAtMs));
+                }
+                else if (state.phase == Phase::CLEARING)
+                {
+                    state.phase = Phase::IDLE;
+                    queued_.push_back(alertEvent(*rule->second, printerId, false, TimeUtils::getCurrentTimestamp()));
+                }
+            }
+
+            // The only thread publishing, so events leave in the order their state changed
+            if (!queued_.empty())
+            {
+                std::vector<BizEvent> events;
+                events.swap(queued_);
+                auto callback = callback_;
+                lock.unlock();
+                if (callback)
+                {
+                    for (const auto &event : events)
+                    {
+                        callback(event);
+                    }
+                }
+                lock.lock();
+                continue;
+            }
+
+            auto wake = deadlines_.empty() ? now + IDLE_WAIT : std::get<0>(*deadlines_.begin());
+            auto nextDeadline = deadlines_.empty() ? Clock::time_point::max() : std::get<0>(*deadlines_.begin());
+            clock.waitUntil(lock, condition_, wake,
+                            [this, nextDeadline]()
+                            {
+                                return !running_ || !queued_.empty() ||
+                                       (!deadlines_.empty() && std::get<0>(*deadlines_.begin()) < nextDeadline);
+                            });
+        }
+    }
+
+} // namespace elink
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include "type.h"
+#include "types/internal/message.h"
+#include "utils/clock.h"
+
+namespace elink
+{
+    /**
+     * Alert rules evaluated incrementally on the status stream
+     *
+     * Rules are compiled into per-condition predicates with their hysteresis thresholds
+     * precomputed, and registered under the fields they read. A status event is reduced to the
+     * fields that changed since the printer's previous status, and only the rules reading one of
+     * those fields are re-evaluated for that printer. Each rule and printer pair keeps a small
+     * state machine (idle, pending, active, clearing); time windows are deadlines served by one
+     * timer thread, so a rule that holds without further status events still fires on time.
+     * Every ON_ALERT event is queued as its state changes and published by the timer thread, so
+     * the events of one rule and printer arrive in order.
+     */
+    class AlertEngine
+    {
+    public:
+        using EventCallback = std::function<void(const BizEvent &)>;
+
+        static AlertEngine &getInstance();
+
+        /**
+         * Start the timer thread
+         * @param callback Receives every ON_ALERT event, on the timer thread
+         */
+        void start(EventCallback callback);
+
+        /**
+         * Stop the timer thread and forget every rule, printer and alert
+         */
+        void stop();
+
+        static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+        /**
+         * Apply a status event, or forget the printers a list change removed; other events are ignored
+         * Alerts raised or cleared by the change are published through the start() callback.
+         */
+        void update(const BizEvent &event);
+
+        /**
+         * Add a rule, evaluated right away against every printer with a status
+         * @return false with a reason if the rule is invalid or its ID is taken
+         */
+        bool addRule(const AlertRule &rule, std::string &error);
+
+        /**
+         * Remove a rule; its active alerts are dropped without a cleared event
+         * @return false if there is no such rule
+         */
+        bool removeRule(const std::string &ruleId);
+
+        std::vector<AlertRule> getRules() const;
+        std::vector<AlertData> getActiveAlerts() const;
+
+    private:
+        AlertEngine() = default;
+        ~AlertEngine();
+        AlertEngine(const AlertEngine &) = delete;
+        AlertEngine &operator=(const AlertEngine &) = delete;
+
+        static constexpr size_t FIELD_COUNT = static_cast<size_t>(AlertField::CHAMBER_TEMPERATURE) + 1;
+        using FieldMask = uint32_t;
+        using Values = std::array<double, FIELD_COUNT>; // NaN when not reported
+
+        /**
+         * A condition with the thresholds it tests before and after the alert is raised
+         */
+        struct Predicate
+        {
+            size_t field;
+            AlertOperator op;
+            double raiseThreshold;
+            double clearThreshold;
+
+            bool operator()(const Values &values, bool raised) const;
+        };
+
+        enum class Phase
+        {
+            IDLE,     // Conditions fail
+            PENDING,  // Conditions hold, waiting for forMs
+            ACTIVE,   // Alert raised
+            CLEARING, // Alert raised, conditions fail, waiting for clearForMs
+        };
+
+        struct RuleState
+        {
+            Phase phase = Phase::IDLE;
+            Clock::time_point deadline{};
+            int64_t raisedAtMs = 0;
+        };
+
+        struct CompiledRule
+        {
+            AlertRule rule;
+            std::vector<Predicate> predicates;
+            FieldMask reads = 0;     // Fields any predicate tests
+            FieldMask unchanged = 0; // Fields tested with UNCHANGED
+            uint64_t visited = 0;    // Update stamp, so a rule is evaluated once per update
+            std::unordered_map<std::string, RuleState> states;
+        };
+
+        static bool compile(const AlertRule &rule, CompiledRule &compiled, std::string &error);
+
+        /**
+         * Drop the values, rule states and open windows of removed printers
+         * Their active alerts are queued as cleared.
+         */
+        void removePrinters(const BizEvent &event);
+
+        /**
+         * Advance one rule for one printer
+         * @param changed Fields that changed in this update, empty for a timer or a new rule
+         */
+        void evaluate(CompiledRule &rule, const std::string &printerId, const Values &values, FieldMask changed,
+                      Clock::time_point now, std::vector<BizEvent> &events);
+        void setPhase(CompiledRule &rule, const std::string &printerId, RuleState &state, Phase phase,
+                      Clock::time_point deadline = {});
+        static BizEvent alertEvent(const CompiledRule &rule, const std::string &printerId, bool active, int64_t timestampMs);
+        /**
+         * Release mutex_ and wake the timer thread if events were queued
+         */
+        void publishQueued(std::unique_lock<std::mutex> &lock);
+        void run();
+
+        static std::atomic<bool> enabled_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable condition_;
+        std::thread timer_;
+        bool running_ = false;
+        EventCallback callback_;
+
+        std::map<std::string, std::unique_ptr<CompiledRule>> rules_;
+        std::array<std::vector<CompiledRule *>, FIELD_COUNT> rulesByField_;
+        std::unordered_map<std::string, Values> printers_;
+        std::set<std::tuple<Clock::time_point, std::string, std::string>> deadlines_; // Deadline, rule ID, printer ID
+        uint64_t updateStamp_ = 0;
+        std::vector<BizEvent> queued_; // ON_ALERT events not yet published, oldest first
+    };
+
+} // namespace elink
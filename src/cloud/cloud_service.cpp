@@ -1,6 +1,7 @@
 #include "cloud_service.h"
 #include "utils/logger.h"
 #include "utils/utils.h"
+#include "utils/clock.h"
 #include "app_utils.h"
 #include "types/internal/internal.h"
 #include "types/internal/json_serializer.h"
@@ -593,10 +594,10 @@ namespace elink
         {
             // Wait for specified time or receive stop signal
             std::unique_lock<std::mutex> lock(m_backgroundTasksMutex);
-            m_backgroundTasksCv.wait_for(lock,
-                                         std::chrono::seconds(CONNECTION_MONITOR_INTERVAL_SECONDS),
-                                         [this]()
-                                         { return !m_backgroundTasksRunning.load() || m_backgroundTasksWakeRequested.load(); });
+            Clock::waitFor(lock, m_backgroundTasksCv,
+                           std::chrono::seconds(CONNECTION_MONITOR_INTERVAL_SECONDS),
+                           [this]()
+                           { return !m_backgroundTasksRunning.load() || m_backgroundTasksWakeRequested.load(); });
             // If explicitly awakened, clear wake flag
             if (m_backgroundTasksWakeRequested.load())
             {
@@ -841,7 +842,7 @@ namespace elink
                 {
                 default:
                     // Default to using ElegooFdmCC2MessageAdapter
-                    m_messageAdapters[printer.printerId] = std::make_shared<ElegooFdmCC2MessageAdapter>(printer);
+                    m_messageAdapters[printer.printerId] = std::make_shared<ElegooFdmCC2MessageAdapter>(SharedPrinterInfo::create(printer));
                     std::string printerId = printer.printerId;
 
                     // When the adapted cached messages are non-continuous, a send callback will be triggered to refresh RTM messages, ensuring messages are up-to-date
@@ -1080,7 +1081,7 @@ namespace elink
         ELEGOO_LOG_INFO("Bind printer request sent successfully for printer: {}", StringUtils::maskString(serialNumber));
 
         // Optimize waiting logic to avoid deadlock
-        const auto startTime = std::chrono::steady_clock::now();
+        const auto startTime = Clock::now();
         // Determine timeout duration based on binding method
         // Auto bind: 20 seconds (default), Manual bind: calculated from expireTime
         const auto timeoutDuration = std::chrono::seconds(timeoutSeconds);
@@ -1132,7 +1133,7 @@ namespace elink
             }
             bool isTimeout = false;
             // Check if timeout
-            auto currentTime = std::chrono::steady_clock::now();
+            auto currentTime = Clock::now();
             if ((currentTime - startTime >= timeoutDuration))
             {
                 ELEGOO_LOG_ERROR("Bind printer result timeout for printer: {}", StringUtils::maskString(serialNumber));
@@ -1193,8 +1194,8 @@ namespace elink
 
             // Use condition variable to wait, can be interrupted by cleanup()
             std::unique_lock<std::mutex> waitLock(m_backgroundTasksMutex);
-            m_backgroundTasksCv.wait_for(waitLock, checkInterval, [this]()
-                                         { return !m_backgroundTasksRunning.load() || m_backgroundTasksWakeRequested.load(); });
+            Clock::waitFor(waitLock, m_backgroundTasksCv, checkInterval, [this]()
+                           { return !m_backgroundTasksRunning.load() || m_backgroundTasksWakeRequested.load(); });
 
             // If explicitly awakened (e.g., credential refresh), clear flag and continue checking binding result
             if (m_backgroundTasksWakeRequested.load())
@@ -1967,9 +1968,9 @@ namespace elink
                 return FileUploadResult::Error(ELINK_ERROR_CODE::OPERATION_CANCELLED, "Network service was cleaned up");
             }
 
-            std::this_thread::sleep_for(checkInterval);
+            Clock::sleepFor(checkInterval);
 
-            auto currentTime = std::chrono::steady_clock::now();
+            auto currentTime = Clock::now();
             auto status = m_rtmService->getDownloadFileStatus(params.printerId);
 
             // Check if upload is complete
@@ -438,8 +438,11 @@ namespace elink
                                     eventCallback(statusEvent);
                                 }
                                 {
+                                    PrinterListChangedData change;
+                                    change.removedPrinterIds.push_back(printerId);
                                     BizEvent event;
                                     event.method = MethodType::ON_PRINTER_LIST_CHANGED;
+                                    event.data = change;
                                     eventCallback(event);
                                 }
                             }else if(eventType == "deviceRejectBind") {  
@@ -1,6 +1,7 @@
 #include "services/rtm_service.h"
 #include "utils/logger.h"
 #include "utils/utils.h"
+#include "utils/clock.h"
 #include "utils/json_utils.h"
 #include <nlohmann/json.hpp>
 #include "private_config.h"
@@ -377,7 +378,7 @@ namespace elink
             }
 
             // Wait for response with timeout
-            if (future.wait_for(actualTimeout) == std::future_status::timeout)
+            if (Clock::waitFor(future, actualTimeout) == std::future_status::timeout)
             {
                 // Timeout - remove pending request
                 {
@@ -642,7 +643,7 @@ namespace elink
                         downloadFileStatus.progress = JsonUtils::safeGetInt(result, "progress", 0);
                         downloadFileStatus.status = JsonUtils::safeGetInt(result, "status", 0);
 
-                        downloadFileStatus.lastUpdatedTime = std::chrono::steady_clock::now();
+                        downloadFileStatus.lastUpdatedTime = Clock::now();
                         {
                             std::lock_guard<std::mutex> lock(m_downloadFileStatusMutex);
 
@@ -678,6 +679,7 @@ namespace elink
 
             if (adapter)
             {
+                MessageParseScope parseScope(message.content);
                 std::vector<std::string> parsedMessageTypes = adapter->parseMessageType(message.content);
                 if (parsedMessageTypes.empty())
                 {
@@ -15,6 +15,7 @@
 #include "adapters/elegoo_fdm_cc2_message_adapter.h"
 #include "utils/process_mutex.h"
 #include "utils/logger.h"
+#include "utils/clock.h"
 #include <map>
 
 namespace elink
@@ -189,7 +190,7 @@ namespace elink
             status.taskId = "";
             status.status = 0;
             status.progress = 0;
-            status.lastUpdatedTime = std::chrono::steady_clock::now();
+            status.lastUpdatedTime = Clock::now();
             m_cacheDownloadFileStatus[printerId] = status;
         }
 
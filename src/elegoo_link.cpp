@@ -4,6 +4,14 @@
 #include "cloud/cloud_service.h"
 #endif
 #include "utils/logger.h"
+#include "utils/tracer.h"
+#include "lan/core/wire_capture.h"
+#include "events/event_export.h"
+#include "gateway/status_segment_writer.h"
+#include "telemetry/telemetry_store.h"
+#include "fleet/fleet_index.h"
+#include "alerts/alert_engine.h"
+#include "gateway/gateway_server.h"
 #include "version.h"
 #include <algorithm>
 
@@ -38,8 +46,52 @@ namespace elink
                     config.log.logMaxFileSize,
                     config.log.logMaxFiles});
 
+            if (config.trace.traceEnable && !Tracer::getInstance().start(config.trace.traceFileName, config.trace.traceMaxEvents))
+            {
+                ELEGOO_LOG_WARN("Failed to start tracing, trace file: {}", config.trace.traceFileName);
+            }
+
+            if (config.capture.captureEnable && !WireCapture::getInstance().start(config.capture.captureDirectory))
+            {
+                ELEGOO_LOG_WARN("Failed to start wire capture, directory: {}", config.capture.captureDirectory);
+            }
+
+            if (config.eventExport.exportEnable)
+            {
+                std::string error;
+                auto sink = createEventExportSink(config.eventExport, nullptr, error);
+                if (!sink || !EventExporter::getInstance().start(config.eventExport, std::move(sink)))
+                {
+                    ELEGOO_LOG_WARN("Failed to start event export: {}", error);
+                }
+            }
+
+            if (config.statusShare.statusShareEnable)
+            {
+                std::string error;
+                if (!StatusSegmentWriter::getInstance().start(config.statusShare, error))
+                {
+                    ELEGOO_LOG_WARN("Failed to start status sharing: {}", error);
+                }
+            }
+
+            if (config.telemetry.telemetryEnable)
+            {
+                std::string error;
+                if (!TelemetryStore::getInstance().start(config.telemetry, error))
+                {
+                    ELEGOO_LOG_WARN("Failed to start telemetry history: {}", error);
+                }
+            }
+
+            if (config.fleet.fleetIndexEnable)
+            {
+                FleetIndex::getInstance().start();
+            }
+
             LanService::Config localConfig;
             localConfig.staticWebPath = config.local.staticWebPath;
+            localConfig.webServerThreads = config.local.webServerThreads;
 
             if (LanService::getInstance().initialize(localConfig))
             {
@@ -87,6 +139,15 @@ namespace elink
 #ifdef ENABLE_CLOUD_FEATURES
             getCloudService().cleanup();
 #endif
+            if (Tracer::isEnabled())
+            {
+                Tracer::getInstance().stop();
+            }
+            WireCapture::getInstance().stop();
+            EventExporter::getInstance().stop();
+            StatusSegmentWriter::getInstance().stop();
+            TelemetryStore::getInstance().stop();
+            FleetIndex::getInstance().stop();
 
             initialized_ = false;
         }
@@ -128,19 +189,60 @@ namespace elink
             auto printers = LanService::getInstance().getCachedPrinters();
 
             auto it = std::find_if(printers.begin(), printers.end(),
-                                   [&printerId](const PrinterInfo &info)
+                                   [&printerId](const PrinterInfoPtr &info)
                                    {
-                                       return info.printerId == printerId;
+                                       return info->printerId == printerId;
                                    });
             return it != printers.end();
         }
 
+        /**
+         * Pass an event from the LAN or cloud service through the enabled stages to the bus
+         */
+        static void forwardEvent(EventBus &targetBus, const BizEvent &event)
+        {
+            if (EventExporter::isEnabled())
+            {
+                EventExporter::getInstance().submit(event);
+            }
+            if (StatusSegmentWriter::isEnabled())
+            {
+                StatusSegmentWriter::getInstance().publish(event);
+            }
+            if (TelemetryStore::isEnabled())
+            {
+                TelemetryStore::getInstance().record(event);
+            }
+            targetBus.publishFromEvent(event);
+            if (FleetIndex::isEnabled())
+            {
+                for (const auto &change : FleetIndex::getInstance().update(event))
+                {
+                    targetBus.publishFromEvent(change);
+                }
+            }
+            if (AlertEngine::isEnabled())
+            {
+                AlertEngine::getInstance().update(event);
+            }
+        }
+
         void setupEventForwarding(EventBus &targetBus)
         {
+            if (config_.alerts.alertsEnable)
+            {
+                // Alert events are published from the alert engine's timer thread
+                AlertEngine::getInstance().start(
+                    [&targetBus](const BizEvent &event)
+                    {
+                        targetBus.publishFromEvent(event);
+                    });
+            }
+
             LanService::getInstance().setEventCallback(
                 [&targetBus](const BizEvent &event)
                 {
-                    targetBus.publishFromEvent(event);
+                    forwardEvent(targetBus, event);
                     return 0;
                 });
 
@@ -149,7 +251,7 @@ namespace elink
             getCloudService().setEventCallback(
                 [&targetBus](const BizEvent &event)
                 {
-                    targetBus.publishFromEvent(event);
+                    forwardEvent(targetBus, event);
                     return 0;
                 });
 #endif
@@ -157,6 +259,8 @@ namespace elink
 
         void teardownEventForwarding()
         {
+            AlertEngine::getInstance().stop();
+
             // Clear LanService event callback
             LanService::getInstance().setEventCallback(nullptr);
 
@@ -213,6 +317,15 @@ namespace elink
         if (ok && !wasInitialized)
         {
             pImpl_->setupEventForwarding(eventBus_);
+
+            if (config.gateway.gatewayEnable)
+            {
+                auto result = startGateway(config.gateway.socketPath, config.gateway.gatewayThreads);
+                if (!result.isSuccess())
+                {
+                    ELEGOO_LOG_WARN("Failed to start gateway: {}", result.message);
+                }
+            }
         }
 
         return ok;
@@ -224,6 +337,7 @@ namespace elink
         {
             return;
         }
+        GatewayServer::getInstance().stop();
         // Teardown event forwarding before cleanup
         pImpl_->teardownEventForwarding();
         pImpl_->cleanup();
@@ -339,9 +453,7 @@ namespace elink
         auto localResult = LanService::getInstance().getPrinters();
         if (localResult.isSuccess())
         {
-            allPrinters.insert(allPrinters.end(),
-                               localResult.value().printers.begin(),
-                               localResult.value().printers.end());
+            allPrinters = std::move(localResult.value().printers);
         }
 
         // Get printers from network service
@@ -350,8 +462,8 @@ namespace elink
         if (networkResult.isSuccess())
         {
             allPrinters.insert(allPrinters.end(),
-                               networkResult.value().printers.begin(),
-                               networkResult.value().printers.end());
+                               std::make_move_iterator(networkResult.value().printers.begin()),
+                               std::make_move_iterator(networkResult.value().printers.end()));
         }
         else
         {
@@ -814,6 +926,23 @@ namespace elink
         return LanService::getInstance().getPrinterStatus(params, timeout);
     }
 
+    StatusIfNewerResult ElegooLink::getStatusIfNewer(const StatusIfNewerParams &params)
+    {
+        if (!pImpl_->isInitialized())
+        {
+            return StatusIfNewerResult::Error(
+                ELINK_ERROR_CODE::NOT_INITIALIZED,
+                "ElegooLink is not initialized");
+        }
+        if (pImpl_->isNetworkPrinter(params.printerId))
+        {
+            return StatusIfNewerResult::Error(
+                ELINK_ERROR_CODE::OPERATION_NOT_IMPLEMENTED,
+                "Versioned status is only available for LAN printers");
+        }
+        return LanService::getInstance().getStatusIfNewer(params);
+    }
+
     VoidResult ElegooLink::refreshPrinterAttributes(const PrinterAttributesParams &params)
     {
         if (!pImpl_->isInitialized())
@@ -981,4 +1110,314 @@ namespace elink
         return pImpl_->isNetworkServiceEnabled();
     }
 
+    // ========== Diagnostics ==========
+
+    VoidResult ElegooLink::startTracing(const std::string &fileName, size_t maxEvents)
+    {
+        if (fileName.empty())
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::INVALID_PARAMETER, "Trace file name is empty");
+        }
+        if (!Tracer::getInstance().start(fileName, maxEvents))
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::OPERATION_IN_PROGRESS, "Tracing is already running");
+        }
+        return VoidResult::Success();
+    }
+
+    VoidResult ElegooLink::stopTracing()
+    {
+        if (!Tracer::isEnabled())
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::INVALID_PARAMETER, "Tracing is not running");
+        }
+        if (!Tracer::getInstance().stop())
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::UNKNOWN_ERROR, "Failed to write trace file");
+        }
+        return VoidResult::Success();
+    }
+
+    VoidResult ElegooLink::startWireCapture(const std::string &directory)
+    {
+        if (directory.empty())
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::INVALID_PARAMETER, "Capture directory is empty");
+        }
+        if (WireCapture::isEnabled())
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::OPERATION_IN_PROGRESS, "Wire capture is already running");
+        }
+        if (!WireCapture::getInstance().start(directory))
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::UNKNOWN_ERROR, "Failed to create capture directory");
+        }
+        return VoidResult::Success();
+    }
+
+    VoidResult ElegooLink::stopWireCapture()
+    {
+        if (!WireCapture::isEnabled())
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::INVALID_PARAMETER, "Wire capture is not running");
+        }
+        WireCapture::getInstance().stop();
+        return VoidResult::Success();
+    }
+
+    VoidResult ElegooLink::startEventExport(const ElegooEventExportConfig &config, EventExportCallback callback)
+    {
+        if (EventExporter::isEnabled())
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::OPERATION_IN_PROGRESS, "Event export is already running");
+        }
+        std::string error;
+        auto sink = createEventExportSink(config, std::move(callback), error);
+        if (!sink)
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::INVALID_PARAMETER, error);
+        }
+        if (!EventExporter::getInstance().start(config, std::move(sink)))
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::OPERATION_IN_PROGRESS, "Event export is already running");
+        }
+        return VoidResult::Success();
+    }
+
+    VoidResult ElegooLink::stopEventExport()
+    {
+        if (!EventExporter::isEnabled())
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::INVALID_PARAMETER, "Event export is not running");
+        }
+        EventExporter::getInstance().stop();
+        return VoidResult::Success();
+    }
+
+    VoidResult ElegooLink::startStatusSharing(const ElegooStatusShareConfig &config)
+    {
+        if (StatusSegmentWriter::isEnabled())
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::OPERATION_IN_PROGRESS, "Status sharing is already running");
+        }
+        std::string error;
+        if (!StatusSegmentWriter::getInstance().start(config, error))
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::UNKNOWN_ERROR, error);
+        }
+        return VoidResult::Success();
+    }
+
+    VoidResult ElegooLink::stopStatusSharing()
+    {
+        if (!StatusSegmentWriter::isEnabled())
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::INVALID_PARAMETER, "Status sharing is not running");
+        }
+        StatusSegmentWriter::getInstance().stop();
+        return VoidResult::Success();
+    }
+
+    VoidResult ElegooLink::startTelemetry(const ElegooTelemetryConfig &config)
+    {
+        if (TelemetryStore::isEnabled())
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::OPERATION_IN_PROGRESS, "Telemetry history is already recording");
+        }
+        std::string error;
+        if (!TelemetryStore::getInstance().start(config, error))
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::UNKNOWN_ERROR, error);
+        }
+        return VoidResult::Success();
+    }
+
+    VoidResult ElegooLink::stopTelemetry()
+    {
+        if (!TelemetryStore::isEnabled())
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::INVALID_PARAMETER, "Telemetry history is not recording");
+        }
+        TelemetryStore::getInstance().stop();
+        return VoidResult::Success();
+    }
+
+    TelemetryQueryResult ElegooLink::queryTelemetry(const TelemetryQueryParams &params)
+    {
+        if (!TelemetryStore::isEnabled())
+        {
+            return TelemetryQueryResult::Error(ELINK_ERROR_CODE::NOT_INITIALIZED, "Telemetry history is not recording");
+        }
+        return TelemetryStore::getInstance().query(params);
+    }
+
+    FleetQueryResult ElegooLink::queryFleet(const FleetQueryParams &params)
+    {
+        if (!pImpl_->isInitialized())
+        {
+            return FleetQueryResult::Error(ELINK_ERROR_CODE::NOT_INITIALIZED, "ElegooLink is not initialized");
+        }
+        if (!FleetIndex::isEnabled())
+        {
+            return FleetQueryResult::Error(ELINK_ERROR_CODE::NOT_INITIALIZED, "Fleet index is not enabled");
+        }
+        return FleetIndex::getInstance().query(params);
+    }
+
+    FleetWatchResult ElegooLink::watchFleet(const FleetQueryParams &params)
+    {
+        if (!pImpl_->isInitialized())
+        {
+            return FleetWatchResult::Error(ELINK_ERROR_CODE::NOT_INITIALIZED, "ElegooLink is not initialized");
+        }
+        if (!FleetIndex::isEnabled())
+        {
+            return FleetWatchResult::Error(ELINK_ERROR_CODE::NOT_INITIALIZED, "Fleet index is not enabled");
+        }
+        return FleetIndex::getInstance().watch(params);
+    }
+
+    VoidResult ElegooLink::unwatchFleet(const FleetUnwatchParams &params)
+    {
+        if (!pImpl_->isInitialized())
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::NOT_INITIALIZED, "ElegooLink is not initialized");
+        }
+        if (!FleetIndex::isEnabled())
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::NOT_INITIALIZED, "Fleet index is not enabled");
+        }
+        if (!FleetIndex::getInstance().unwatch(params.watchId))
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::INVALID_PARAMETER, "Unknown fleet watch");
+        }
+        return VoidResult::Success();
+    }
+
+    FleetSummaryResult ElegooLink::getFleetSummary()
+    {
+        if (!pImpl_->isInitialized())
+        {
+            return FleetSummaryResult::Error(ELINK_ERROR_CODE::NOT_INITIALIZED, "ElegooLink is not initialized");
+        }
+        if (!FleetIndex::isEnabled())
+        {
+            return FleetSummaryResult::Error(ELINK_ERROR_CODE::NOT_INITIALIZED, "Fleet index is not enabled");
+        }
+        return FleetSummaryResult::Ok(FleetIndex::getInstance().getSummary());
+    }
+
+    VoidResult ElegooLink::addAlertRule(const AlertRule &rule)
+    {
+        if (!pImpl_->isInitialized())
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::NOT_INITIALIZED, "ElegooLink is not initialized");
+        }
+        if (!AlertEngine::isEnabled())
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::NOT_INITIALIZED, "Alert rules are not enabled");
+        }
+        std::string error;
+        if (!AlertEngine::getInstance().addRule(rule, error))
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::INVALID_PARAMETER, error);
+        }
+        return VoidResult::Success();
+    }
+
+    VoidResult ElegooLink::removeAlertRule(const AlertRuleParams &params)
+    {
+        if (!pImpl_->isInitialized())
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::NOT_INITIALIZED, "ElegooLink is not initialized");
+        }
+        if (!AlertEngine::isEnabled())
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::NOT_INITIALIZED, "Alert rules are not enabled");
+        }
+        if (!AlertEngine::getInstance().removeRule(params.ruleId))
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::INVALID_PARAMETER, "Unknown alert rule");
+        }
+        return VoidResult::Success();
+    }
+
+    AlertRuleListResult ElegooLink::getAlertRules()
+    {
+        if (!pImpl_->isInitialized())
+        {
+            return AlertRuleListResult::Error(ELINK_ERROR_CODE::NOT_INITIALIZED, "ElegooLink is not initialized");
+        }
+        if (!AlertEngine::isEnabled())
+        {
+            return AlertRuleListResult::Error(ELINK_ERROR_CODE::NOT_INITIALIZED, "Alert rules are not enabled");
+        }
+        return AlertRuleListResult::Ok(AlertRuleListData{AlertEngine::getInstance().getRules()});
+    }
+
+    AlertListResult ElegooLink::getActiveAlerts()
+    {
+        if (!pImpl_->isInitialized())
+        {
+            return AlertListResult::Error(ELINK_ERROR_CODE::NOT_INITIALIZED, "ElegooLink is not initialized");
+        }
+        if (!AlertEngine::isEnabled())
+        {
+            return AlertListResult::Error(ELINK_ERROR_CODE::NOT_INITIALIZED, "Alert rules are not enabled");
+        }
+        return AlertListResult::Ok(AlertListData{AlertEngine::getInstance().getActiveAlerts()});
+    }
+
+    PrinterResourceStatsResult ElegooLink::getPrinterResourceStats(const PrinterResourceStatsParams &params)
+    {
+        if (!pImpl_->isInitialized())
+        {
+            return PrinterResourceStatsResult::Error(
+                ELINK_ERROR_CODE::NOT_INITIALIZED,
+                "ElegooLink is not initialized");
+        }
+        return LanService::getInstance().getPrinterResourceStats(params);
+    }
+
+    PrinterResourceStatsListResult ElegooLink::getAllPrinterResourceStats()
+    {
+        if (!pImpl_->isInitialized())
+        {
+            return PrinterResourceStatsListResult::Error(
+                ELINK_ERROR_CODE::NOT_INITIALIZED,
+                "ElegooLink is not initialized");
+        }
+        return LanService::getInstance().getAllPrinterResourceStats();
+    }
+
+    // ========== Gateway ==========
+
+    VoidResult ElegooLink::startGateway(const std::string &socketPath, int workerThreads)
+    {
+        if (!pImpl_->isInitialized())
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::NOT_INITIALIZED, "ElegooLink is not initialized");
+        }
+        if (GatewayServer::getInstance().isRunning())
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::OPERATION_IN_PROGRESS, "Gateway is already running");
+        }
+        std::string error;
+        if (!GatewayServer::getInstance().start(socketPath, static_cast<size_t>(std::max(0, workerThreads)), error))
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::UNKNOWN_ERROR, error);
+        }
+        return VoidResult::Success();
+    }
+
+    VoidResult ElegooLink::stopGateway()
+    {
+        if (!GatewayServer::getInstance().isRunning())
+        {
+            return VoidResult::Error(ELINK_ERROR_CODE::INVALID_PARAMETER, "Gateway is not running");
+        }
+        GatewayServer::getInstance().stop();
+        return VoidResult::Success();
+    }
+
 } // namespace elink
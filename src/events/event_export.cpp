@@ -0,0 +1,420 @@
+#include "events/event_export.h"
+#include "gateway/gateway_channel.h"
+#include "types/internal/internal.h"
+#include "utils/clock.h"
+#include "utils/logger.h"
+#include "utils/utils.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <fstream>
+
+namespace elink
+{
+    std::atomic<bool> EventExporter::enabled_{false};
+
+    namespace
+    {
+        // Room for the array header written when a batch is sealed: marker byte and 32-bit count
+        constexpr size_t BATCH_HEADER_SIZE = 5;
+        constexpr size_t BATCH_INITIAL_CAPACITY = 64 * 1024;
+        constexpr std::chrono::seconds SOCKET_RETRY_INTERVAL{1};
+
+        // Set on the export thread, which runs the sink and so the user callback
+        thread_local bool onExportThread = false;
+
+        const char *formatName(EventExportFormat format)
+        {
+            return format == EventExportFormat::CBOR ? "CBOR" : "MessagePack";
+        }
+
+        void writeLength(std::ostream &out, size_t size)
+        {
+            auto length = static_cast<uint32_t>(size);
+            const char bytes[4] = {static_cast<char>(length >> 24), static_cast<char>(length >> 16),
+                                   static_cast<char>(length >> 8), static_cast<char>(length)};
+            out.write(bytes, sizeof(bytes));
+        }
+
+        /**
+         * Appends length-prefixed batches to a file
+         */
+        class FileEventExportSink : public IEventExportSink
+        {
+        public:
+            explicit FileEventExportSink(const std::string &path) : path_(path)
+            {
+                out_ = PathUtils::openOutputStream(path, std::ios::out | std::ios::binary | std::ios::app);
+            }
+
+            bool isOpen() const { return out_.is_open(); }
+
+            bool write(const std::string &batch, size_t eventCount) override
+            {
+                (void)eventCount;
+                writeLength(out_, batch.size());
+                out_.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+                out_.flush();
+                return out_.good();
+            }
+
+            std::string describe() const override { return "file " + path_; }
+
+        private:
+            std::string path_;
+            std::ofstream out_;
+        };
+
+        /**
+         * Sends length-prefixed batches to a consumer listening on a Unix domain socket
+         * Batches produced while no consumer is connected are dropped; the connection is retried
+         * at most once per SOCKET_RETRY_INTERVAL.
+         */
+        class UnixSocketEventExportSink : public IEventExportSink
+        {
+        public:
+            explicit UnixSocketEventExportSink(const std::string &path) : path_(path) {}
+
+            bool write(const std::string &batch, size_t eventCount) override
+            {
+                (void)eventCount;
+                if (!channel_)
+                {
+                    auto now = Clock::now();
+                    if (now < nextConnectTime_)
+                    {
+                        return false;
+                    }
+                    std::string error;
+                    channel_ = GatewayChannel::connect(path_, error);
+                    if (!channel_)
+                    {
+                        nextConnectTime_ = now + SOCKET_RETRY_INTERVAL;
+                        if (connected_)
+                        {
+                            ELEGOO_LOG_WARN("Event export consumer unavailable: {}", error);
+                            connected_ = false;
+                        }
+                        return false;
+                    }
+                    ELEGOO_LOG_INFO("Event export connected to {}", path_);
+                    connected_ = true;
+                }
+
+                if (!channel_->sendFrame(batch))
+                {
+                    ELEGOO_LOG_WARN("Event export consumer on {} disconnected", path_);
+                    channel_.reset();
+                    return false;
+                }
+                return true;
+            }
+
+            std::string describe() const override { return "socket " + path_; }
+
+        private:
+            std::string path_;
+            std::unique_ptr<GatewayChannel> channel_;
+            Clock::time_point nextConnectTime_{};
+            bool connected_ = true; // Logs the first failure
+        };
+
+        /**
+         * Hands batches to an application callback
+         */
+        class CallbackEventExportSink : public IEventExportSink
+        {
+        public:
+            explicit CallbackEventExportSink(EventExportCallback callback) : callback_(std::move(callback)) {}
+
+            bool write(const std::string &batch, size_t eventCount) override
+            {
+                try
+                {
+                    callback_(reinterpret_cast<const uint8_t *>(batch.data()), batch.size(), eventCount);
+                    return true;
+                }
+                catch (const std::exception &e)
+                {
+                    ELEGOO_LOG_ERROR("Event export callback failed: {}", e.what());
+                    return false;
+                }
+            }
+
+            std::string describe() const override { return "callback"; }
+
+        private:
+            EventExportCallback callback_;
+        };
+    } // namespace
+
+    std::unique_ptr<IEventExportSink> createEventExportSink(const ElegooEventExportConfig &config,
+                                                            EventExportCallback callback, std::string &error)
+    {
+        switch (config.exportSink)
+        {
+        case EventExportSink::LOCAL_FILE:
+        {
+            if (config.exportPath.empty())
+            {
+                error = "Event export file path is empty";
+                return nullptr;
+            }
+            auto sink = std::make_unique<FileEventExportSink>(config.exportPath);
+            if (!sink->isOpen())
+            {
+                error = "Failed to open event export file " + config.exportPath;
+                return nullptr;
+            }
+            return sink;
+        }
+        case EventExportSink::UNIX_SOCKET:
+            if (config.exportPath.empty())
+            {
+                error = "Event export socket path is empty";
+                return nullptr;
+            }
+            return std::make_unique<UnixSocketEventExportSink>(config.exportPath);
+        case EventExportSink::USER_CALLBACK:
+            if (!callback)
+            {
+                error = "Event export callback is not set";
+                return nullptr;
+            }
+            return std::make_unique<CallbackEventExportSink>(std::move(callback));
+        }
+        error = "Unknown event export sink";
+        return nullptr;
+    }
+
+    // ========== EventExporter ==========
+
+    EventExporter &EventExporter::getInstance()
+    {
+        static EventExporter instance;
+        return instance;
+    }
+
+    EventExporter::~EventExporter()
+    {
+        stop();
+    }
+
+    bool EventExporter::start(const ElegooEventExportConfig &config, std::unique_ptr<IEventExportSink> sink)
+    {
+        if (onExportThread)
+        {
+            ELEGOO_LOG_WARN("Event export cannot be restarted from its own sink");
+            return false;
+        }
+        std::lock_guard<std::mutex> controlLock(controlMutex_);
+        if (enabled_)
+        {
+            ELEGOO_LOG_WARN("Event export is already running to {}", sink_->describe());
+            return false;
+        }
+        if (!sink)
+        {
+            return false;
+        }
+        // A sink that stopped export left its finished thread behind
+        joinWorker();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            config_ = config;
+            config_.exportBatchEvents = std::max<size_t>(config_.exportBatchEvents, 1);
+            config_.exportFlushIntervalMs = std::max(config_.exportFlushIntervalMs, 1);
+            config_.exportMaxPendingBatches = std::max<size_t>(config_.exportMaxPendingBatches, 1);
+            format_ = config_.exportFormat;
+            sink_ = std::move(sink);
+            pendingBatches_.clear();
+            openBatch();
+            stopRequested_ = false;
+            exportedEvents_ = 0;
+            exportedBatches_ = 0;
+            droppedEvents_ = 0;
+        }
+        worker_ = std::thread([this]()
+                              {
+                                  onExportThread = true;
+                                  run();
+                              });
+        enabled_ = true;
+        ELEGOO_LOG_INFO("Event export started, {} batches to {}", formatName(config_.exportFormat), sink_->describe());
+        return true;
+    }
+
+    void EventExporter::stop()
+    {
+        // From the sink the thread cannot join itself, and a concurrent stop() holding
+        // controlMutex_ may be joining it; the thread drains the pending batches and exits, and
+        // the next start() or stop() joins it
+        if (onExportThread)
+        {
+            enabled_ = false;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopRequested_ = true;
+            }
+            condition_.notify_all();
+            return;
+        }
+
+        std::lock_guard<std::mutex> controlLock(controlMutex_);
+        if (enabled_)
+        {
+            enabled_ = false;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopRequested_ = true;
+            }
+            condition_.notify_all();
+        }
+        joinWorker();
+    }
+
+    void EventExporter::joinWorker()
+    {
+        if (!worker_.joinable())
+        {
+            return;
+        }
+        worker_.join();
+        ELEGOO_LOG_INFO("Event export stopped, {} events in {} batches, {} dropped",
+                        exportedEvents_, exportedBatches_, droppedEvents_);
+        sink_.reset();
+    }
+
+    void EventExporter::submit(const BizEvent &event)
+    {
+        // Encoded outside the lock; only the append is serialized between publishing threads
+        thread_local std::string record;
+        record.clear();
+        try
+        {
+            encodeRecord(format_, event, TimeUtils::getCurrentTimestamp(), record);
+        }
+        catch (const std::exception &e)
+        {
+            ELEGOO_LOG_ERROR("Failed to encode event {} for export: {}", static_cast<int>(event.method), e.what());
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopRequested_)
+        {
+            return;
+        }
+        if (openBatch_.events == 0)
+        {
+            openBatchTime_ = Clock::now();
+        }
+        openBatch_.data.append(record);
+        openBatch_.events++;
+        if (openBatch_.events >= config_.exportBatchEvents || openBatch_.data.size() >= config_.exportBatchBytes)
+        {
+            sealBatch();
+            condition_.notify_one();
+        }
+    }
+
+    void EventExporter::encodeRecord(EventExportFormat format, const BizEvent &event, int64_t timestampMs, std::string &out)
+    {
+        static const nlohmann::json noPrinterId = "";
+        const bool cbor = format == EventExportFormat::CBOR;
+        auto encode = [cbor, &out](const nlohmann::json &value)
+        {
+            if (cbor)
+            {
+                nlohmann::json::to_cbor(value, out);
+            }
+            else
+            {
+                nlohmann::json::to_msgpack(value, out);
+            }
+        };
+
+        // Array of 5: schema version, timestamp, method, printer ID, data
+        out.push_back(static_cast<char>(cbor ? 0x85 : 0x95));
+        encode(EVENT_EXPORT_SCHEMA_VERSION);
+        encode(timestampMs);
+        encode(static_cast<int>(event.method));
+        auto printerId = event.data.find("printerId");
+        encode(printerId != event.data.end() && printerId->is_string() ? *printerId : noPrinterId);
+        encode(event.data);
+    }
+
+    void EventExporter::openBatch()
+    {
+        openBatch_ = Batch();
+        openBatch_.data.reserve(std::min(config_.exportBatchBytes, BATCH_INITIAL_CAPACITY) + BATCH_HEADER_SIZE);
+        openBatch_.data.assign(BATCH_HEADER_SIZE, '\0');
+    }
+
+    void EventExporter::sealBatch()
+    {
+        if (openBatch_.events == 0)
+        {
+            return;
+        }
+
+        // Array with a 32-bit element count, so the header size is known before the batch is full
+        auto count = static_cast<uint32_t>(openBatch_.events);
+        openBatch_.data[0] = static_cast<char>(format_ == EventExportFormat::CBOR ? 0x9A : 0xDD);
+        openBatch_.data[1] = static_cast<char>(count >> 24);
+        openBatch_.data[2] = static_cast<char>(count >> 16);
+        openBatch_.data[3] = static_cast<char>(count >> 8);
+        openBatch_.data[4] = static_cast<char>(count);
+
+        if (pendingBatches_.size() >= config_.exportMaxPendingBatches)
+        {
+            droppedEvents_ += pendingBatches_.front().events;
+            pendingBatches_.pop_front();
+        }
+        pendingBatches_.push_back(std::move(openBatch_));
+        openBatch();
+    }
+
+    void EventExporter::run()
+    {
+        const auto flushInterval = std::chrono::milliseconds(config_.exportFlushIntervalMs);
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            if (pendingBatches_.empty() && !stopRequested_)
+            {
+                auto deadline = (openBatch_.events > 0 ? openBatchTime_ : Clock::now()) + flushInterval;
+                Clock::getClock().waitUntil(lock, condition_, deadline, [this]
+                                            { return !pendingBatches_.empty() || stopRequested_; });
+            }
+            if (openBatch_.events > 0 && (stopRequested_ || Clock::now() - openBatchTime_ >= flushInterval))
+            {
+                sealBatch();
+            }
+            if (pendingBatches_.empty())
+            {
+                if (stopRequested_)
+                {
+                    break;
+                }
+                continue;
+            }
+
+            Batch batch = std::move(pendingBatches_.front());
+            pendingBatches_.pop_front();
+            lock.unlock();
+            bool written = sink_->write(batch.data, batch.events);
+            lock.lock();
+            if (written)
+            {
+                exportedEvents_ += batch.events;
+                exportedBatches_++;
+            }
+            else
+            {
+                droppedEvents_ += batch.events;
+            }
+        }
+    }
+
+} // namespace elink
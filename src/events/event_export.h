@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "config.h"
+#include "elegoo_export.h"
+
+namespace elink
+{
+    struct BizEvent;
+
+    /**
+     * Schema version written as the first element of every exported record
+     * Bump it when the record layout changes; consumers dispatch on it.
+     */
+    constexpr uint32_t EVENT_EXPORT_SCHEMA_VERSION = 1;
+
+    /**
+     * Destination of sealed event batches
+     *
+     * write() is called from the exporter thread only, one batch at a time.
+     */
+    class IEventExportSink
+    {
+    public:
+        virtual ~IEventExportSink() = default;
+
+        /**
+         * Deliver one batch
+         * @param batch One MessagePack/CBOR array of event records
+         * @param eventCount Number of records in the batch
+         * @return false if the batch was lost
+         */
+        virtual bool write(const std::string &batch, size_t eventCount) = 0;
+
+        /**
+         * Sink description for logs
+         */
+        virtual std::string describe() const = 0;
+    };
+
+    /**
+     * Create the sink selected by config
+     * @param callback Receives the batches of an EventExportSink::USER_CALLBACK sink
+     * @param error Reason on failure
+     * @return nullptr if the sink cannot be opened
+     */
+    std::unique_ptr<IEventExportSink> createEventExportSink(const ElegooEventExportConfig &config,
+                                                            EventExportCallback callback, std::string &error);
+
+    /**
+     * Opt-in export of every event as compact MessagePack or CBOR batches
+     *
+     * submit() encodes the event on the calling thread straight from its JSON data and appends
+     * it to the open batch; a background thread hands sealed batches to the sink, so a slow
+     * consumer never blocks event delivery. While export is off, submit() is skipped at the
+     * call site after a single relaxed atomic load.
+     */
+    class ELEGOO_LINK_API EventExporter
+    {
+    public:
+        static EventExporter &getInstance();
+
+        /**
+         * Start exporting to sink
+         * @return false if export is already running, sink is null or the call comes from the sink
+         */
+        bool start(const ElegooEventExportConfig &config, std::unique_ptr<IEventExportSink> sink);
+
+        /**
+         * Flush the open batch, deliver pending batches and close the sink
+         * Called from the sink, e.g. a USER_CALLBACK, it only requests the stop: the export
+         * thread delivers the pending batches after the callback returns, then exits.
+         */
+        void stop();
+
+        static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+        /**
+         * Append an event to the open batch
+         */
+        void submit(const BizEvent &event);
+
+        /**
+         * Append one record to out
+         * @param timestampMs Unix time in milliseconds
+         */
+        static void encodeRecord(EventExportFormat format, const BizEvent &event, int64_t timestampMs, std::string &out);
+
+    private:
+        struct Batch
+        {
+            std::string data;
+            size_t events = 0;
+        };
+
+        EventExporter() = default;
+        ~EventExporter();
+        EventExporter(const EventExporter &) = delete;
+        EventExporter &operator=(const EventExporter &) = delete;
+
+        void run();
+        // Join a stopped export thread and close its sink; controlMutex_ must be held
+        void joinWorker();
+        void openBatch();
+        // Seal the open batch and queue it for the sink; mutex_ must be held
+        void sealBatch();
+
+        static std::atomic<bool> enabled_;
+
+        std::mutex controlMutex_; // Serializes start() and stop() outside the export thread
+        ElegooEventExportConfig config_;
+        std::atomic<EventExportFormat> format_{EventExportFormat::MSGPACK};
+        std::unique_ptr<IEventExportSink> sink_;
+        std::thread worker_;
+
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        Batch openBatch_;
+        std::chrono::steady_clock::time_point openBatchTime_;
+        std::deque<Batch> pendingBatches_;
+        bool stopRequested_ = true;
+
+        // Totals of the current session, logged by stop()
+        uint64_t exportedEvents_ = 0;
+        uint64_t exportedBatches_ = 0;
+        uint64_t droppedEvents_ = 0;
+    };
+
+} // namespace elink
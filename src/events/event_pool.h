@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "events/event_system.h"
+
+namespace elink
+{
+    /**
+     * Bounded pool of event objects for high-rate event types
+     *
+     * The pool keeps a reference to every event it hands out. Once all subscribers have
+     * released an event (the pool holds the only reference), acquire() returns it again, so
+     * its storage is reused instead of freed and allocated anew. Subscribers that keep an
+     * event must keep the shared_ptr itself; a weak_ptr does not stop the event from being
+     * recycled.
+     */
+    template <typename EventType>
+    class EventPool
+    {
+    public:
+        explicit EventPool(size_t capacity) : capacity_(capacity)
+        {
+            slots_.reserve(capacity);
+        }
+
+        /**
+         * Get an event no one else holds, or a new one
+         * A recycled event keeps its previous contents; the caller overwrites them.
+         */
+        std::shared_ptr<EventType> acquire()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (size_t i = 0; i < slots_.size(); ++i)
+            {
+                const auto &slot = slots_[cursor_];
+                cursor_ = (cursor_ + 1) % slots_.size();
+                if (slot.use_count() == 1)
+                {
+                    // Pairs with the release of the last subscriber reference
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    ++hits_;
+                    return slot;
+                }
+            }
+
+            ++misses_;
+            auto event = std::make_shared<EventType>();
+            if (slots_.size() < capacity_)
+            {
+                slots_.push_back(event);
+            }
+            return event;
+        }
+
+        void addStats(EventPoolStats &stats) const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats.hits += hits_;
+            stats.misses += misses_;
+            stats.pooled += slots_.size();
+            stats.capacity += capacity_;
+        }
+
+    private:
+        const size_t capacity_;
+        mutable std::mutex mutex_;
+        std::vector<std::shared_ptr<EventType>> slots_;
+        size_t cursor_ = 0;
+        uint64_t hits_ = 0;
+        uint64_t misses_ = 0;
+    };
+
+} // namespace elink
@@ -1,14 +1,43 @@
 #include "events/event_system.h"
+#include "events/event_pool.h"
 #include "types/event.h"
 #include "utils/logger.h"
+#include "utils/tracer.h"
 #include "types/internal/internal.h"
 #include "types/internal/json_serializer.h"
 
 namespace elink
 {
+    namespace
+    {
+        // Per event type; sized for the events a slow subscriber may still hold across a fleet
+        constexpr size_t EVENT_POOL_CAPACITY = 64;
+
+        EventPool<PrinterStatusEvent> &statusEventPool()
+        {
+            static EventPool<PrinterStatusEvent> pool(EVENT_POOL_CAPACITY);
+            return pool;
+        }
+
+        EventPool<PrinterEventRawEvent> &rawEventPool()
+        {
+            static EventPool<PrinterEventRawEvent> pool(EVENT_POOL_CAPACITY);
+            return pool;
+        }
+    } // namespace
+
+    EventPoolStats EventBus::getEventPoolStats()
+    {
+        EventPoolStats stats;
+        statusEventPool().addStats(stats);
+        rawEventPool().addStats(stats);
+        return stats;
+    }
 
     void EventBus::publishFromEvent(const BizEvent &bizEvent)
     {
+        ELEGOO_TRACE_SCOPE_ARGS("message", "EventBus::publishFromEvent",
+                                {{"method", std::to_string(static_cast<int>(bizEvent.method))}});
         std::shared_ptr<BaseEvent> event = nullptr;
 
         try
@@ -25,8 +54,9 @@ namespace elink
 
             case MethodType::ON_PRINTER_STATUS:
             {
-                auto statusEvent = std::make_shared<PrinterStatusEvent>();
-                statusEvent->status = bizEvent.data;
+                auto statusEvent = statusEventPool().acquire();
+                // Decoding resets the recycled status in place, so its strings and maps keep their capacity
+                bizEvent.data.get_to(statusEvent->status);
                 event = statusEvent;
                 break;
             }
@@ -64,8 +94,9 @@ namespace elink
 
             case MethodType::ON_PRINTER_EVENT_RAW:
             {
-                auto rawEvent = std::make_shared<PrinterEventRawEvent>();
-                rawEvent->rawData = bizEvent.data.get<PrinterEventRawData>();
+                auto rawEvent = rawEventPool().acquire();
+                // Decoding resets the recycled event in place, so the string buffers are reused
+                bizEvent.data.get_to(rawEvent->rawData);
                 event = rawEvent;
                 break;
             }
@@ -73,6 +104,10 @@ namespace elink
             case MethodType::ON_PRINTER_LIST_CHANGED:
             {
                 auto listChangedEvent = std::make_shared<PrinterListChangedEvent>();
+                if (bizEvent.data.is_object())
+                {
+                    bizEvent.data.get_to(listChangedEvent->change);
+                }
                 event = listChangedEvent;
                 break;
             }
@@ -84,6 +119,22 @@ namespace elink
                 break;
             }
 
+            case MethodType::ON_FLEET_QUERY_CHANGED:
+            {
+                auto fleetEvent = std::make_shared<FleetQueryChangedEvent>();
+                fleetEvent->change = bizEvent.data.get<FleetQueryChangedData>();
+                event = fleetEvent;
+                break;
+            }
+
+            case MethodType::ON_ALERT:
+            {
+                auto alertEvent = std::make_shared<AlertEvent>();
+                alertEvent->alert = bizEvent.data.get<AlertData>();
+                event = alertEvent;
+                break;
+            }
+
             default:
                 ELEGOO_LOG_DEBUG("Unhandled event method type: {}", static_cast<int>(bizEvent.method));
                 return;
@@ -128,6 +179,14 @@ namespace elink
                 {
                     this->publish<OnlineStatusChangedEvent>(onlineStatusEvent);
                 }
+                else if (auto fleetEvent = std::dynamic_pointer_cast<FleetQueryChangedEvent>(event))
+                {
+                    this->publish<FleetQueryChangedEvent>(fleetEvent);
+                }
+                else if (auto alertEvent = std::dynamic_pointer_cast<AlertEvent>(event))
+                {
+                    this->publish<AlertEvent>(alertEvent);
+                }
             }
         }
         catch (const std::exception &e)
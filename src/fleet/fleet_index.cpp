@@ -0,0 +1,598 @@
+#include "fleet/fleet_index.h"
+#include "types/internal/internal.h"
+#include "types/internal/json_serializer.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+
+namespace elink
+{
+    namespace
+    {
+        // Each watch is re-tested on every status update
+        constexpr size_t MAX_FLEET_WATCHES = 256;
+        constexpr double MISSING = std::numeric_limits<double>::quiet_NaN();
+
+        const nlohmann::json *objectAt(const nlohmann::json &object, const char *key)
+        {
+            auto it = object.find(key);
+            return it != object.end() && it->is_object() ? &*it : nullptr;
+        }
+
+        template <typename T>
+        T numberAt(const nlohmann::json *object, const char *key, T fallback)
+        {
+            if (!object)
+            {
+                return fallback;
+            }
+            auto it = object->find(key);
+            return it != object->end() && it->is_number() ? it->get<T>() : fallback;
+        }
+
+        double temperatureAt(const nlohmann::json *temperatures, ComponentKey key)
+        {
+            const nlohmann::json *component = temperatures ? objectAt(*temperatures, key.name().c_str()) : nullptr;
+            return numberAt<double>(component, "current", MISSING);
+        }
+
+        bool compare(double lhs, FleetOperator op, double rhs)
+        {
+            if (std::isnan(lhs))
+            {
+                return false;
+            }
+            switch (op)
+            {
+            case FleetOperator::EQUAL:
+                return lhs == rhs;
+            case FleetOperator::NOT_EQUAL:
+                return lhs != rhs;
+            case FleetOperator::LESS:
+                return lhs < rhs;
+            case FleetOperator::LESS_EQUAL:
+                return lhs <= rhs;
+            case FleetOperator::GREATER:
+                return lhs > rhs;
+            case FleetOperator::GREATER_EQUAL:
+                return lhs >= rhs;
+            }
+            return false;
+        }
+
+        bool sameValue(double a, double b)
+        {
+            return a == b || (std::isnan(a) && std::isnan(b));
+        }
+
+        // An equality condition on a field with an index names the only bucket that can match
+        bool indexKey(const FleetCondition &condition, int &key)
+        {
+            if (condition.op != FleetOperator::EQUAL ||
+                (condition.field != FleetField::STATE && condition.field != FleetField::EXCEPTION_CODE))
+            {
+                return false;
+            }
+            key = static_cast<int>(condition.value);
+            return true;
+        }
+
+        template <typename Map, typename Key>
+        void eraseFromBucket(Map &buckets, const Key &key, const void *entry)
+        {
+            auto it = buckets.find(key);
+            if (it == buckets.end())
+            {
+                return;
+            }
+            it->second.erase(static_cast<typename Map::mapped_type::key_type>(entry));
+            if (it->second.empty())
+            {
+                buckets.erase(it);
+            }
+        }
+    } // namespace
+
+    std::atomic<bool> FleetIndex::enabled_{false};
+
+    FleetIndex &FleetIndex::getInstance()
+    {
+        static FleetIndex instance;
+        return instance;
+    }
+
+    void FleetIndex::start()
+    {
+        // Also drops entries an update still in flight during stop() added
+        clear();
+        enabled_ = true;
+    }
+
+    void FleetIndex::stop()
+    {
+        enabled_ = false;
+        clear();
+    }
+
+    std::vector<BizEvent> FleetIndex::update(const BizEvent &event)
+    {
+        if (event.method == MethodType::ON_PRINTER_LIST_CHANGED)
+        {
+            return removePrinters(event);
+        }
+        if ((event.method != MethodType::ON_PRINTER_STATUS && event.method != MethodType::ON_PRINTER_ATTRIBUTES) ||
+            !event.data.is_object())
+        {
+            return {};
+        }
+        auto printerIdIt = event.data.find("printerId");
+        if (printerIdIt == event.data.end() || !printerIdIt->is_string())
+        {
+            return {};
+        }
+        const auto &printerId = printerIdIt->get_ref<const std::string &>();
+
+        // Fields are read before taking the lock
+        Entry next;
+        bool isStatus = event.method == MethodType::ON_PRINTER_STATUS;
+        if (isStatus)
+        {
+            const auto *printerStatus = objectAt(event.data, "printerStatus");
+            const auto *printStatus = objectAt(event.data, "printStatus");
+            const auto *temperatures = objectAt(event.data, "temperatureStatus");
+            next.hasStatus = true;
+            next.state = numberAt<int>(printerStatus, "state", static_cast<int>(PrinterState::UNKNOWN));
+            next.subState = numberAt<int>(printerStatus, "subState", static_cast<int>(PrinterSubState::NONE));
+            if (printerStatus)
+            {
+                auto codes = printerStatus->find("exceptionCodes");
+                if (codes != printerStatus->end() && codes->is_array())
+                {
+                    for (const auto &code : *codes)
+                    {
+                        if (code.is_number_integer())
+                        {
+                            next.exceptionCodes.push_back(code.get<int>());
+                        }
+                    }
+                    std::sort(next.exceptionCodes.begin(), next.exceptionCodes.end());
+                    next.exceptionCodes.erase(std::unique(next.exceptionCodes.begin(), next.exceptionCodes.end()),
+                                              next.exceptionCodes.end());
+                }
+            }
+            next.progress = numberAt<int>(printStatus, "progress", 0);
+            next.remainingTime = numberAt<int64_t>(printStatus, "estimatedTime", 0);
+            // The status sent on disconnect carries defaults, not readings
+            bool offline = next.state == static_cast<int>(PrinterState::OFFLINE);
+            next.extruderTemperature = offline ? MISSING : temperatureAt(temperatures, ComponentKey::EXTRUDER);
+            next.heatedBedTemperature = offline ? MISSING : temperatureAt(temperatures, ComponentKey::HEATED_BED);
+            next.chamberTemperature = offline ? MISSING : temperatureAt(temperatures, ComponentKey::CHAMBER);
+        }
+        else
+        {
+            auto model = event.data.find("model");
+            if (model == event.data.end() || !model->is_string())
+            {
+                return {};
+            }
+            next.model = model->get<std::string>();
+        }
+
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto &slot = entries_[printerId];
+        if (!slot)
+        {
+            slot = std::make_unique<Entry>();
+            slot->printerId = printerId;
+        }
+        Entry &entry = *slot;
+        if (isStatus)
+        {
+            if (entry.hasStatus && entry.state == next.state && entry.subState == next.subState &&
+                entry.exceptionCodes == next.exceptionCodes && entry.progress == next.progress &&
+                entry.remainingTime == next.remainingTime &&
+                sameValue(entry.extruderTemperature, next.extruderTemperature) &&
+                sameValue(entry.heatedBedTemperature, next.heatedBedTemperature) &&
+                sameValue(entry.chamberTemperature, next.chamberTemperature))
+            {
+                return {};
+            }
+            removeContribution(entry);
+            next.printerId = std::move(entry.printerId);
+            next.model = std::move(entry.model);
+            entry = std::move(next);
+        }
+        else
+        {
+            if (entry.model == next.model)
+            {
+                return {};
+            }
+            removeContribution(entry);
+            entry.model = std::move(next.model);
+        }
+        addContribution(entry);
+
+        // Only the changed printer is re-tested
+        std::vector<BizEvent> changes;
+        for (auto &[watchId, watch] : watches_)
+        {
+            bool wasMember = watch.members.count(&entry) > 0;
+            bool isMember = entry.hasStatus && matches(entry, watch.conditions);
+            if (wasMember == isMember)
+            {
+                continue;
+            }
+            FleetQueryChangedData change;
+            change.watchId = watchId;
+            if (isMember)
+            {
+                watch.members.insert(&entry);
+                change.added.push_back(entry.printerId);
+            }
+            else
+            {
+                watch.members.erase(&entry);
+                change.removed.push_back(entry.printerId);
+            }
+            changes.emplace_back(MethodType::ON_FLEET_QUERY_CHANGED, nlohmann::json(change));
+        }
+        return changes;
+    }
+
+    std::vector<BizEvent> FleetIndex::removePrinters(const BizEvent &event)
+    {
+        std::vector<BizEvent> changes;
+        if (!event.data.is_object())
+        {
+            return changes;
+        }
+        PrinterListChangedData removal;
+        event.data.get_to(removal);
+
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        for (const auto &printerId : removal.removedPrinterIds)
+        {
+            auto it = entries_.find(printerId);
+            if (it == entries_.end())
+            {
+                continue;
+            }
+            const Entry *entry = it->second.get();
+            removeContribution(*entry);
+            for (auto &[watchId, watch] : watches_)
+            {
+                if (watch.members.erase(entry) == 0)
+                {
+                    continue;
+                }
+                FleetQueryChangedData change;
+                change.watchId = watchId;
+                change.removed.push_back(printerId);
+                changes.emplace_back(MethodType::ON_FLEET_QUERY_CHANGED, nlohmann::json(change));
+            }
+            entries_.erase(it);
+        }
+        return changes;
+    }
+
+    FleetQueryResult FleetIndex::query(const FleetQueryParams &params) const
+    {
+        std::string error;
+        if (!validate(params, error))
+        {
+            return FleetQueryResult::Error(ELINK_ERROR_CODE::INVALID_PARAMETER, error);
+        }
+        FleetQueryData data;
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            for (const Entry *entry : evaluate(params.conditions))
+            {
+                data.printerIds.push_back(entry->printerId);
+            }
+        }
+        std::sort(data.printerIds.begin(), data.printerIds.end());
+        return FleetQueryResult::Ok(std::move(data));
+    }
+
+    FleetWatchResult FleetIndex::watch(const FleetQueryParams &params)
+    {
+        std::string error;
+        if (!validate(params, error))
+        {
+            return FleetWatchResult::Error(ELINK_ERROR_CODE::INVALID_PARAMETER, error);
+        }
+        FleetWatchData data;
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex_);
+            if (watches_.size() >= MAX_FLEET_WATCHES)
+            {
+                return FleetWatchResult::Error(ELINK_ERROR_CODE::INVALID_PARAMETER,
+                                               "Too many fleet watches, remove unused ones with unwatchFleet");
+            }
+            Watch watch;
+            watch.conditions = params.conditions;
+            for (const Entry *entry : evaluate(params.conditions))
+            {
+                watch.members.insert(entry);
+                data.printerIds.push_back(entry->printerId);
+            }
+            data.watchId = nextWatchId_++;
+            watches_.emplace(data.watchId, std::move(watch));
+        }
+        std::sort(data.printerIds.begin(), data.printerIds.end());
+        return FleetWatchResult::Ok(std::move(data));
+    }
+
+    bool FleetIndex::unwatch(uint64_t watchId)
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        return watches_.erase(watchId) > 0;
+    }
+
+    FleetSummaryData FleetIndex::getSummary() const
+    {
+        FleetSummaryData data;
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        data.printerCount = statusCount_;
+        for (const auto &[state, bucket] : byState_)
+        {
+            data.byState.push_back(FleetGroupCount{state, "", bucket.size()});
+        }
+        for (const auto &[model, bucket] : byModel_)
+        {
+            data.byModel.push_back(FleetGroupCount{0, model, bucket.size()});
+        }
+        for (const auto &[code, bucket] : byExceptionCode_)
+        {
+            data.byExceptionCode.push_back(FleetGroupCount{code, "", bucket.size()});
+        }
+        auto printing = byState_.find(static_cast<int>(PrinterState::PRINTING));
+        data.printingCount = printing != byState_.end() ? printing->second.size() : 0;
+        if (data.printingCount > 0)
+        {
+            data.averagePrintProgress = static_cast<double>(printingProgressSum_) / data.printingCount;
+        }
+        data.totalRemainingTime = printingRemainingSum_;
+        if (extruderCount_ > 0)
+        {
+            data.averageExtruderTemperature = extruderSum_ / extruderCount_;
+        }
+        if (heatedBedCount_ > 0)
+        {
+            data.averageHeatedBedTemperature = heatedBedSum_ / heatedBedCount_;
+        }
+        lock.unlock();
+
+        auto byValue = [](const FleetGroupCount &a, const FleetGroupCount &b)
+        { return a.value < b.value; };
+        std::sort(data.byState.begin(), data.byState.end(), byValue);
+        std::sort(data.byExceptionCode.begin(), data.byExceptionCode.end(), byValue);
+        std::sort(data.byModel.begin(), data.byModel.end(),
+                  [](const FleetGroupCount &a, const FleetGroupCount &b)
+                  { return a.text < b.text; });
+        return data;
+    }
+
+    void FleetIndex::clear()
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        watches_.clear();
+        byState_.clear();
+        byModel_.clear();
+        byExceptionCode_.clear();
+        entries_.clear();
+        statusCount_ = 0;
+        printingProgressSum_ = 0;
+        printingRemainingSum_ = 0;
+        extruderSum_ = 0.0;
+        extruderCount_ = 0;
+        heatedBedSum_ = 0.0;
+        heatedBedCount_ = 0;
+    }
+
+    bool FleetIndex::matches(const Entry &entry, const std::vector<FleetCondition> &conditions)
+    {
+        for (const auto &condition : conditions)
+        {
+            bool result = false;
+            switch (condition.field)
+            {
+            case FleetField::STATE:
+                result = compare(entry.state, condition.op, condition.value);
+                break;
+            case FleetField::SUB_STATE:
+                result = compare(entry.subState, condition.op, condition.value);
+                break;
+            case FleetField::MODEL:
+                result = (entry.model == condition.text) == (condition.op == FleetOperator::EQUAL);
+                break;
+            case FleetField::EXCEPTION_CODE:
+                if (condition.op == FleetOperator::NOT_EQUAL)
+                {
+                    result = !std::binary_search(entry.exceptionCodes.begin(), entry.exceptionCodes.end(),
+                                                 static_cast<int>(condition.value));
+                }
+                else
+                {
+                    result = std::any_of(entry.exceptionCodes.begin(), entry.exceptionCodes.end(),
+                                         [&condition](int code)
+                                         { return compare(code, condition.op, condition.value); });
+                }
+                break;
+            case FleetField::PRINT_PROGRESS:
+                result = compare(entry.progress, condition.op, condition.value);
+                break;
+            case FleetField::REMAINING_TIME:
+                result = compare(static_cast<double>(entry.remainingTime), condition.op, condition.value);
+                break;
+            case FleetField::EXTRUDER_TEMPERATURE:
+                result = compare(entry.extruderTemperature, condition.op, condition.value);
+                break;
+            case FleetField::HEATED_BED_TEMPERATURE:
+                result = compare(entry.heatedBedTemperature, condition.op, condition.value);
+                break;
+            case FleetField::CHAMBER_TEMPERATURE:
+                result = compare(entry.chamberTemperature, condition.op, condition.value);
+                break;
+            }
+            if (!result)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool FleetIndex::validate(const FleetQueryParams &params, std::string &error)
+    {
+        for (const auto &condition : params.conditions)
+        {
+            auto field = static_cast<int>(condition.field);
+            auto op = static_cast<int>(condition.op);
+            if (field < static_cast<int>(FleetField::STATE) || field > static_cast<int>(FleetField::CHAMBER_TEMPERATURE))
+            {
+                error = "Unknown fleet field " + std::to_string(field);
+                return false;
+            }
+            if (op < static_cast<int>(FleetOperator::EQUAL) || op > static_cast<int>(FleetOperator::GREATER_EQUAL))
+            {
+                error = "Unknown fleet operator " + std::to_string(op);
+                return false;
+            }
+            if (condition.field == FleetField::MODEL && condition.op != FleetOperator::EQUAL &&
+                condition.op != FleetOperator::NOT_EQUAL)
+            {
+                error = "Models can only be compared for equality";
+                return false;
+            }
+            if (std::isnan(condition.value))
+            {
+                error = "Fleet condition values must be numbers";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<const FleetIndex::Entry *> FleetIndex::evaluate(const std::vector<FleetCondition> &conditions) const
+    {
+        // Start from the smallest bucket an equality condition names, if any
+        const Bucket *candidates = nullptr;
+        for (const auto &condition : conditions)
+        {
+            const Bucket *bucket = nullptr;
+            int key;
+            if (condition.field == FleetField::MODEL && condition.op == FleetOperator::EQUAL)
+            {
+                auto it = byModel_.find(condition.text);
+                if (it == byModel_.end())
+                {
+                    return {};
+                }
+                bucket = &it->second;
+            }
+            else if (indexKey(condition, key))
+            {
+                if (key != condition.value)
+                {
+                    return {};
+                }
+                const auto &index = condition.field == FleetField::STATE ? byState_ : byExceptionCode_;
+                auto it = index.find(key);
+                if (it == index.end())
+                {
+                    return {};
+                }
+                bucket = &it->second;
+            }
+            if (bucket && (!candidates || bucket->size() < candidates->size()))
+            {
+                candidates = bucket;
+            }
+        }
+
+        std::vector<const Entry *> result;
+        if (candidates)
+        {
+            for (const Entry *entry : *candidates)
+            {
+                if (matches(*entry, conditions))
+                {
+                    result.push_back(entry);
+                }
+            }
+            return result;
+        }
+        for (const auto &[printerId, entry] : entries_)
+        {
+            if (entry->hasStatus && matches(*entry, conditions))
+            {
+                result.push_back(entry.get());
+            }
+        }
+        return result;
+    }
+
+    void FleetIndex::removeContribution(const Entry &entry)
+    {
+        if (!entry.hasStatus)
+        {
+            return;
+        }
+        eraseFromBucket(byState_, entry.state, &entry);
+        eraseFromBucket(byModel_, entry.model, &entry);
+        for (int code : entry.exceptionCodes)
+        {
+            eraseFromBucket(byExceptionCode_, code, &entry);
+        }
+        --statusCount_;
+        if (entry.state == static_cast<int>(PrinterState::PRINTING))
+        {
+            printingProgressSum_ -= entry.progress;
+            printingRemainingSum_ -= entry.remainingTime;
+        }
+        if (!std::isnan(entry.extruderTemperature))
+        {
+            extruderSum_ -= entry.extruderTemperature;
+            --extruderCount_;
+        }
+        if (!std::isnan(entry.heatedBedTemperature))
+        {
+            heatedBedSum_ -= entry.heatedBedTemperature;
+            --heatedBedCount_;
+        }
+    }
+
+    void FleetIndex::addContribution(const Entry &entry)
+    {
+        if (!entry.hasStatus)
+        {
+            return;
+        }
+        byState_[entry.state].insert(&entry);
+        byModel_[entry.model].insert(&entry);
+        for (int code : entry.exceptionCodes)
+        {
+            byExceptionCode_[code].insert(&entry);
+        }
+        ++statusCount_;
+        if (entry.state == static_cast<int>(PrinterState::PRINTING))
+        {
+            printingProgressSum_ += entry.progress;
+            printingRemainingSum_ += entry.remainingTime;
+        }
+        if (!std::isnan(entry.extruderTemperature))
+        {
+            extruderSum_ += entry.extruderTemperature;
+            ++extruderCount_;
+        }
+        if (!std::isnan(entry.heatedBedTemperature))
+        {
+            heatedBedSum_ += entry.heatedBedTemperature;
+            ++heatedBedCount_;
+        }
+    }
+
+} // namespace elink
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "type.h"
+#include "types/internal/message.h"
+
+namespace elink
+{
+    /**
+     * Latest status fields of every printer, indexed for fleet queries
+     *
+     * Status and attribute events update one printer's entry. Secondary indexes by state, model
+     * and exception code, and the running sums behind getSummary(), are adjusted by the
+     * difference between the old and new values, so neither queries nor the summary walk the
+     * fleet: a query starts from the smallest index bucket its equality conditions name and tests
+     * only those printers. Watched queries keep their matching set, and an update re-tests only
+     * the updated printer against each watch, producing ON_FLEET_QUERY_CHANGED events for the
+     * watches it entered or left.
+     */
+    class FleetIndex
+    {
+    public:
+        static FleetIndex &getInstance();
+
+        /**
+         * Start indexing from an empty fleet
+         */
+        void start();
+
+        /**
+         * Stop indexing and forget every printer and watch
+         */
+        void stop();
+
+        static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+        /**
+         * Apply a status or attribute event, or drop the printers a list change removed;
+         * other events are ignored
+         * @return ON_FLEET_QUERY_CHANGED events for the watches a printer entered or left
+         */
+        std::vector<BizEvent> update(const BizEvent &event);
+
+        FleetQueryResult query(const FleetQueryParams &params) const;
+
+        /**
+         * Register a query whose matches are kept up to date
+         */
+        FleetWatchResult watch(const FleetQueryParams &params);
+
+        /**
+         * @return false if there is no such watch
+         */
+        bool unwatch(uint64_t watchId);
+
+        FleetSummaryData getSummary() const;
+
+        /**
+         * Forget every printer and watch
+         */
+        void clear();
+
+    private:
+        FleetIndex() = default;
+        FleetIndex(const FleetIndex &) = delete;
+        FleetIndex &operator=(const FleetIndex &) = delete;
+
+        struct Entry
+        {
+            std::string printerId;
+            std::string model;
+            bool hasStatus = false; // Printers are indexed once their first status arrives
+            int state = static_cast<int>(PrinterState::UNKNOWN);
+            int subState = static_cast<int>(PrinterSubState::NONE);
+            std::vector<int> exceptionCodes; // Sorted, unique
+            int progress = 0;
+            int64_t remainingTime = 0;
+            double extruderTemperature = std::numeric_limits<double>::quiet_NaN(); // NaN when not reported
+            double heatedBedTemperature = std::numeric_limits<double>::quiet_NaN();
+            double chamberTemperature = std::numeric_limits<double>::quiet_NaN();
+        };
+
+        struct Watch
+        {
+            std::vector<FleetCondition> conditions;
+            std::unordered_set<const Entry *> members;
+        };
+
+        using Bucket = std::unordered_set<const Entry *>;
+
+        static bool matches(const Entry &entry, const std::vector<FleetCondition> &conditions);
+        static bool validate(const FleetQueryParams &params, std::string &error);
+        std::vector<const Entry *> evaluate(const std::vector<FleetCondition> &conditions) const;
+        std::vector<BizEvent> removePrinters(const BizEvent &event);
+
+        // Index and aggregate maintenance, around a change of one entry
+        void removeContribution(const Entry &entry);
+        void addContribution(const Entry &entry);
+
+        static std::atomic<bool> enabled_;
+
+        mutable std::shared_mutex mutex_;
+        std::unordered_map<std::string, std::unique_ptr<Entry>> entries_;
+        std::unordered_map<int, Bucket> byState_;
+        std::unordered_map<std::string, Bucket> byModel_;
+        std::unordered_map<int, Bucket> byExceptionCode_;
+        std::map<uint64_t, Watch> watches_;
+        uint64_t nextWatchId_ = 1;
+
+        // Running aggregates
+        size_t statusCount_ = 0;
+        int64_t printingProgressSum_ = 0;
+        int64_t printingRemainingSum_ = 0;
+        double extruderSum_ = 0.0;
+        size_t extruderCount_ = 0;
+        double heatedBedSum_ = 0.0;
+        size_t heatedBedCount_ = 0;
+    };
+
+} // namespace elink
@@ -0,0 +1,832 @@
+#include "elegoo_link_client.h"
+#include "gateway/gateway_channel.h"
+#include "types/internal/json_serializer.h"
+#include "types/internal/message.h"
+#include "utils/logger.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace elink
+{
+    namespace
+    {
+        nlohmann::json disconnectedResult()
+        {
+            return {{"code", static_cast<int>(ELINK_ERROR_CODE::NOT_CONNECTED_TO_SUBSERVICE)},
+                    {"message", "Not connected to the ElegooLink gateway"}};
+        }
+
+        /**
+         * Rebuild a BizResult from its {"code", "message", "data"} form
+         */
+        template <typename T>
+        BizResult<T> parseResult(const nlohmann::json &json)
+        {
+            BizResult<T> result;
+            try
+            {
+                result.code = static_cast<ELINK_ERROR_CODE>(json.value("code", static_cast<int>(ELINK_ERROR_CODE::UNKNOWN_ERROR)));
+                result.message = json.value("message", std::string());
+                if constexpr (!std::is_same_v<T, std::monostate>)
+                {
+                    auto data = json.find("data");
+                    if (data != json.end() && !data->is_null())
+                    {
+                        result.data = data->get<T>();
+                    }
+                }
+            }
+            catch (const nlohmann::json::exception &e)
+            {
+                return BizResult<T>::Error(ELINK_ERROR_CODE::PRINTER_INVALID_RESPONSE,
+                                           std::string("Invalid gateway response: ") + e.what());
+            }
+            return result;
+        }
+    } // namespace
+
+    // ========== Private Implementation Class ==========
+
+    class ElegooLinkClient::Impl
+    {
+    public:
+        using NotifyHandler = std::function<void(int64_t requestId, const nlohmann::json &notify)>;
+        using ResultHandler = std::function<void(const nlohmann::json &result)>;
+
+        explicit Impl(EventBus &eventBus) : eventBus_(eventBus) {}
+
+        ~Impl()
+        {
+            disconnect();
+            // Only left joinable when the client is destroyed from one of its own callbacks
+            if (reader_.joinable() || eventThread_.joinable())
+            {
+                ELEGOO_LOG_ERROR("ElegooLinkClient destroyed from its own callback");
+                if (reader_.joinable())
+                {
+                    reader_.detach();
+                }
+                if (eventThread_.joinable())
+                {
+                    eventThread_.detach();
+                }
+            }
+        }
+
+        bool connect(const std::string &socketPath)
+        {
+            disconnect();
+            if (reader_.joinable() || eventThread_.joinable())
+            {
+                ELEGOO_LOG_ERROR("Cannot reconnect to the gateway from a client callback");
+                return false;
+            }
+
+            std::string path = socketPath.empty() ? getDefaultGatewaySocketPath() : socketPath;
+            std::string error;
+            auto channel = std::shared_ptr<GatewayChannel>(GatewayChannel::connect(path, error));
+            if (!channel)
+            {
+                ELEGOO_LOG_ERROR("Failed to connect to gateway: {}", error);
+                return false;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            channel_ = channel;
+            eventStop_ = false;
+            overflowed_ = false;
+            reader_ = std::thread(&Impl::readLoop, this, channel);
+            eventThread_ = std::thread(&Impl::eventLoop, this);
+            ELEGOO_LOG_INFO("Connected to gateway {}", path);
+            return true;
+        }
+
+        void disconnect()
+        {
+            std::shared_ptr<GatewayChannel> channel;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                channel = std::move(channel_);
+                eventStop_ = true;
+            }
+            eventCondition_.notify_all();
+            if (channel)
+            {
+                channel->shutdown();
+            }
+
+            // Called from a callback the current thread cannot join itself; it finishes on its
+            // own and the next connect(), disconnect() or the destructor joins it
+            joinUnlessCurrent(reader_);
+            joinUnlessCurrent(eventThread_);
+        }
+
+        bool isConnected() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return channel_ != nullptr;
+        }
+
+        /**
+         * Send a request; onResult runs once with the result, or with an error if the
+         * connection is (or becomes) unavailable
+         * notify and onResult run on the reader thread and must not block; user callbacks
+         * are handed to post().
+         * @return Request id, 0 if it could not be sent
+         */
+        int64_t send(const std::string &method, const nlohmann::json &params,
+                     NotifyHandler notify, ResultHandler onResult)
+        {
+            std::shared_ptr<GatewayChannel> channel;
+            int64_t requestId = 0;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (channel_)
+                {
+                    channel = channel_;
+                    requestId = nextRequestId_++;
+                    pending_[requestId] = Pending{std::move(notify), onResult};
+                }
+            }
+            if (!channel)
+            {
+                onResult(disconnectedResult());
+                return 0;
+            }
+
+            nlohmann::json request = {{"id", requestId}, {"method", method}, {"params", params}};
+            if (!channel->sendFrame(request.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace)))
+            {
+                // The reader fails the pending request once it sees the connection drop
+                channel->shutdown();
+            }
+            return requestId;
+        }
+
+        nlohmann::json call(const std::string &method, const nlohmann::json &params = nlohmann::json::object(),
+                            NotifyHandler notify = nullptr)
+        {
+            // The reply could only be read by the blocked thread itself
+            if (readerOf == this)
+            {
+                ELEGOO_LOG_ERROR("Synchronous gateway call {} from the client's reader thread", method);
+                return {{"code", static_cast<int>(ELINK_ERROR_CODE::OPERATION_IN_PROGRESS)},
+                        {"message", "Synchronous gateway calls cannot be made from the reader thread"}};
+            }
+            return callAsync(method, params, std::move(notify)).get();
+        }
+
+        std::future<nlohmann::json> callAsync(const std::string &method, const nlohmann::json &params,
+                                              NotifyHandler notify = nullptr)
+        {
+            auto promise = std::make_shared<std::promise<nlohmann::json>>();
+            auto future = promise->get_future();
+            send(method, params, std::move(notify), [promise](const nlohmann::json &result)
+                 { promise->set_value(result); });
+            return future;
+        }
+
+        template <typename T>
+        BizResult<T> request(const std::string &method, const nlohmann::json &params = nlohmann::json::object())
+        {
+            return parseResult<T>(call(method, params));
+        }
+
+        /**
+         * Run a user callback on the event thread, where it may call the client synchronously
+         * Called from the handlers of send(); the frame being handled counts against the queue limit.
+         */
+        void post(std::function<void()> task)
+        {
+            queue(std::move(task), frameBytes_);
+        }
+
+    private:
+        struct Pending
+        {
+            NotifyHandler notify;
+            ResultHandler onResult;
+        };
+
+        struct Task
+        {
+            std::function<void()> run;
+            size_t bytes = 0;
+        };
+
+        // Set on a client's reader thread
+        static thread_local const Impl *readerOf;
+
+        static void joinUnlessCurrent(std::thread &thread)
+        {
+            if (thread.joinable() && thread.get_id() != std::this_thread::get_id())
+            {
+                thread.join();
+            }
+        }
+
+        void readLoop(std::shared_ptr<GatewayChannel> channel)
+        {
+            readerOf = this;
+            std::string frame;
+            while (channel->receiveFrame(frame))
+            {
+                nlohmann::json message = nlohmann::json::parse(frame, nullptr, false);
+                if (message.is_discarded())
+                {
+                    ELEGOO_LOG_WARN("Discarding malformed gateway frame");
+                    continue;
+                }
+                frameBytes_ = frame.size();
+                bool handled = false;
+                try
+                {
+                    handled = handleMessage(message);
+                }
+                catch (const nlohmann::json::exception &e)
+                {
+                    ELEGOO_LOG_ERROR("Invalid gateway message: {}", e.what());
+                }
+                if (!handled)
+                {
+                    channel->shutdown();
+                    break;
+                }
+            }
+
+            // Connection gone: fail everything still waiting for a response
+            frameBytes_ = 0;
+            std::unordered_map<int64_t, Pending> pending;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                pending.swap(pending_);
+                if (channel_ == channel)
+                {
+                    channel_.reset();
+                }
+            }
+            for (auto &entry : pending)
+            {
+                entry.second.onResult(disconnectedResult());
+            }
+        }
+
+        /**
+         * @return false to drop the connection
+         */
+        bool handleMessage(const nlohmann::json &message)
+        {
+            auto event = message.find("event");
+            if (event != message.end())
+            {
+                if (!event->is_number_integer())
+                {
+                    ELEGOO_LOG_ERROR("Gateway event without a method");
+                    return false;
+                }
+                BizEvent bizEvent(static_cast<MethodType>(event->get<int>()), message.value("data", nlohmann::json::object()));
+                return queue([this, bizEvent = std::move(bizEvent)]()
+                             { eventBus_.publishFromEvent(bizEvent); },
+                             frameBytes_);
+            }
+
+            auto id = message.find("id");
+            if (id == message.end() || !id->is_number_integer())
+            {
+                return true;
+            }
+            int64_t requestId = id->get<int64_t>();
+
+            auto notify = message.find("notify");
+            if (notify != message.end())
+            {
+                NotifyHandler handler;
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    auto it = pending_.find(requestId);
+                    if (it != pending_.end())
+                    {
+                        handler = it->second.notify;
+                    }
+                }
+                if (handler)
+                {
+                    handler(requestId, *notify);
+                }
+                return !overflowed_;
+            }
+
+            Pending pending;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto it = pending_.find(requestId);
+                if (it == pending_.end())
+                {
+                    return true;
+                }
+                pending = std::move(it->second);
+                pending_.erase(it);
+            }
+            pending.onResult(message.value("result", disconnectedResult()));
+            return !overflowed_;
+        }
+
+        /**
+         * Queue a task for the event thread
+         * @return false once MAX_QUEUED_BYTES of frames wait for a slow callback; the connection is then dropped
+         */
+        bool queue(std::function<void()> task, size_t bytes)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (eventStop_)
+                {
+                    return true;
+                }
+                if (queuedBytes_ + bytes > MAX_QUEUED_BYTES)
+                {
+                    ELEGOO_LOG_WARN("Client callbacks are not keeping up, {} bytes queued, disconnecting", queuedBytes_);
+                    overflowed_ = true;
+                    return false;
+                }
+                queuedBytes_ += bytes;
+                tasks_.push_back(Task{std::move(task), bytes});
+            }
+            eventCondition_.notify_one();
+            return true;
+        }
+
+        void eventLoop()
+        {
+            while (true)
+            {
+                Task task;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    eventCondition_.wait(lock, [this]
+                                         { return eventStop_ || !tasks_.empty(); });
+                    if (eventStop_)
+                    {
+                        tasks_.clear();
+                        queuedBytes_ = 0;
+                        return;
+                    }
+                    task = std::move(tasks_.front());
+                    tasks_.pop_front();
+                    queuedBytes_ -= task.bytes;
+                }
+                try
+                {
+                    task.run();
+                }
+                catch (const std::exception &e)
+                {
+                    ELEGOO_LOG_ERROR("Gateway client callback failed: {}", e.what());
+                }
+            }
+        }
+
+        // Same bound as the gateway's outbound queue per client
+        static constexpr size_t MAX_QUEUED_BYTES = 32 * 1024 * 1024;
+
+        EventBus &eventBus_;
+
+        mutable std::mutex mutex_;
+        std::shared_ptr<GatewayChannel> channel_;
+        std::thread reader_;
+        std::unordered_map<int64_t, Pending> pending_;
+        int64_t nextRequestId_ = 1;
+        size_t frameBytes_ = 0; // Reader thread only: size of the frame being handled
+
+        std::thread eventThread_;
+        std::condition_variable eventCondition_;
+        std::deque<Task> tasks_;
+        size_t queuedBytes_ = 0;
+        bool overflowed_ = false; // Reader thread only once connected
+        bool eventStop_ = false;
+    };
+
+    thread_local const ElegooLinkClient::Impl *ElegooLinkClient::Impl::readerOf = nullptr;
+
+    // ========== ElegooLinkClient Implementation ==========
+
+    ElegooLinkClient::ElegooLinkClient() : pImpl_(std::make_unique<Impl>(eventBus_))
+    {
+    }
+
+    ElegooLinkClient::~ElegooLinkClient() = default;
+
+    bool ElegooLinkClient::connect(const std::string &socketPath)
+    {
+        return pImpl_->connect(socketPath);
+    }
+
+    void ElegooLinkClient::disconnect()
+    {
+        pImpl_->disconnect();
+    }
+
+    bool ElegooLinkClient::isConnected() const
+    {
+        return pImpl_->isConnected();
+    }
+
+    std::future<nlohmann::json> ElegooLinkClient::callAsync(const std::string &method, const nlohmann::json &params)
+    {
+        return pImpl_->callAsync(method, params);
+    }
+
+    // ========== Local Printer Discovery ==========
+
+    BizResult<PrinterDiscoveryData> ElegooLinkClient::startPrinterDiscovery(const PrinterDiscoveryParams &params)
+    {
+        return pImpl_->request<PrinterDiscoveryData>("startPrinterDiscovery", params);
+    }
+
+    VoidResult ElegooLinkClient::startPrinterDiscoveryAsync(
+        const PrinterDiscoveryParams &params,
+        std::function<void(const PrinterInfo &)> discoveredCallback,
+        std::function<void(const std::vector<PrinterInfo> &)> completionCallback)
+    {
+        // The gateway notifies once discovery started and answers when it finishes
+        auto started = std::make_shared<std::promise<VoidResult>>();
+        auto startedFuture = started->get_future();
+        auto notified = std::make_shared<std::once_flag>();
+        auto setStarted = [started, notified](VoidResult result)
+        {
+            std::call_once(*notified, [&]
+                           { started->set_value(std::move(result)); });
+        };
+
+        pImpl_->send(
+            "startPrinterDiscoveryAsync", params,
+            [impl = pImpl_.get(), discoveredCallback, setStarted](int64_t, const nlohmann::json &notify)
+            {
+                setStarted(VoidResult::Success());
+                auto printer = notify.find("printer");
+                if (printer != notify.end() && discoveredCallback)
+                {
+                    impl->post([discoveredCallback, info = printer->get<PrinterInfo>()]()
+                               { discoveredCallback(info); });
+                }
+            },
+            [impl = pImpl_.get(), completionCallback, setStarted](const nlohmann::json &json)
+            {
+                auto result = parseResult<PrinterDiscoveryData>(json);
+                if (!result.isSuccess())
+                {
+                    setStarted(VoidResult::Error(result.code, result.message));
+                    return;
+                }
+                setStarted(VoidResult::Success());
+                if (completionCallback)
+                {
+                    impl->post([completionCallback, printers = result.hasValue() ? result.value().printers : std::vector<PrinterInfo>()]()
+                               { completionCallback(printers); });
+                }
+            });
+        return startedFuture.get();
+    }
+
+    VoidResult ElegooLinkClient::stopPrinterDiscovery()
+    {
+        return pImpl_->request<std::monostate>("stopPrinterDiscovery");
+    }
+
+    std::vector<PrinterInfo> ElegooLinkClient::getDiscoveredPrinters() const
+    {
+        return pImpl_->request<std::vector<PrinterInfo>>("getDiscoveredPrinters").data.value_or(std::vector<PrinterInfo>());
+    }
+
+    // ========== Printer Connection Management ==========
+
+    ConnectPrinterResult ElegooLinkClient::connectPrinter(const ConnectPrinterParams &params)
+    {
+        return pImpl_->request<ConnectPrinterData>("connectPrinter", params);
+    }
+
+    VoidResult ElegooLinkClient::disconnectPrinter(const std::string &printerId)
+    {
+        return pImpl_->request<std::monostate>("disconnectPrinter", {{"printerId", printerId}});
+    }
+
+    GetPrinterListResult ElegooLinkClient::getPrinters()
+    {
+        return pImpl_->request<GetPrinterListData>("getPrinters");
+    }
+
+    bool ElegooLinkClient::isPrinterConnected(const std::string &printerId) const
+    {
+        return pImpl_->request<bool>("isPrinterConnected", {{"printerId", printerId}}).data.value_or(false);
+    }
+
+#ifdef ENABLE_CLOUD_FEATURES
+    // ========== Network/Cloud Service Functions ==========
+
+    VoidResult ElegooLinkClient::setRegion(const SetRegionParams &params)
+    {
+        return pImpl_->request<std::monostate>("setRegion", params);
+    }
+
+    GetUserInfoResult ElegooLinkClient::getUserInfo(const GetUserInfoParams &params)
+    {
+        return pImpl_->request<UserInfo>("getUserInfo", params);
+    }
+
+    VoidResult ElegooLinkClient::setHttpCredential(const HttpCredential &credential)
+    {
+        return pImpl_->request<std::monostate>("setHttpCredential", credential);
+    }
+
+    BizResult<HttpCredential> ElegooLinkClient::getHttpCredential() const
+    {
+        return pImpl_->request<HttpCredential>("getHttpCredential");
+    }
+
+    BizResult<HttpCredential> ElegooLinkClient::refreshHttpCredential(const HttpCredential &credential)
+    {
+        return pImpl_->request<HttpCredential>("refreshHttpCredential", credential);
+    }
+
+    VoidResult ElegooLinkClient::clearHttpCredential()
+    {
+        return pImpl_->request<std::monostate>("clearHttpCredential");
+    }
+
+    VoidResult ElegooLinkClient::logout()
+    {
+        return pImpl_->request<std::monostate>("logout");
+    }
+
+    GetRtcTokenResult ElegooLinkClient::getRtcToken() const
+    {
+        return pImpl_->request<RtcTokenData>("getRtcToken");
+    }
+
+    VoidResult ElegooLinkClient::sendRtmMessage(const SendRtmMessageParams &params)
+    {
+        return pImpl_->request<std::monostate>("sendRtmMessage", params);
+    }
+
+    BindPrinterResult ElegooLinkClient::bindPrinter(const BindPrinterParams &params)
+    {
+        return pImpl_->request<BindPrinterData>("bindPrinter", params);
+    }
+
+    VoidResult ElegooLinkClient::cancelBindPrinter(const CancelBindPrinterParams &params)
+    {
+        return pImpl_->request<std::monostate>("cancelBindPrinter", params);
+    }
+
+    VoidResult ElegooLinkClient::unbindPrinter(const UnbindPrinterParams &params)
+    {
+        return pImpl_->request<std::monostate>("unbindPrinter", params);
+    }
+
+    GetLicenseExpiredDevicesResult ElegooLinkClient::getLicenseExpiredDevices()
+    {
+        return pImpl_->request<GetLicenseExpiredDevicesData>("getLicenseExpiredDevices");
+    }
+
+    RenewLicenseResult ElegooLinkClient::renewLicense(const RenewLicenseParams &params)
+    {
+        return pImpl_->request<std::monostate>("renewLicense", params);
+    }
+#endif
+
+    // ========== File Management ==========
+
+    GetFileListResult ElegooLinkClient::getFileList(const GetFileListParams &params)
+    {
+        return pImpl_->request<GetFileListData>("getFileList", params);
+    }
+
+    GetFileDetailResult ElegooLinkClient::getFileDetail(const GetFileDetailParams &params)
+    {
+        return pImpl_->request<FileDetail>("getFileDetail", params);
+    }
+
+    FileUploadResult ElegooLinkClient::uploadFile(const FileUploadParams &params, FileUploadProgressCallback progressCallback)
+    {
+        Impl::NotifyHandler notify;
+        if (progressCallback)
+        {
+            auto cancelled = std::make_shared<bool>(false);
+            notify = [impl = pImpl_.get(), progressCallback, cancelled](int64_t requestId, const nlohmann::json &progress)
+            {
+                impl->post([impl, progressCallback, cancelled, requestId, data = progress.get<FileUploadProgressData>()]()
+                           {
+                               if (!*cancelled && !progressCallback(data))
+                               {
+                                   *cancelled = true;
+                                   impl->send("cancel", {{"id", requestId}}, nullptr, [](const nlohmann::json &) {});
+                               }
+                           });
+            };
+        }
+        return parseResult<std::monostate>(pImpl_->call("uploadFile", params, std::move(notify)));
+    }
+
+    // ========== Print Task Management ==========
+
+    PrintTaskListResult ElegooLinkClient::getPrintTaskList(const PrintTaskListParams &params)
+    {
+        return pImpl_->request<PrintTaskListData>("getPrintTaskList", params);
+    }
+
+    DeletePrintTasksResult ElegooLinkClient::deletePrintTasks(const DeletePrintTasksParams &params)
+    {
+        return pImpl_->request<std::monostate>("deletePrintTasks", params);
+    }
+
+    StartPrintResult ElegooLinkClient::startPrint(const StartPrintParams &params)
+    {
+        return pImpl_->request<std::monostate>("startPrint", params);
+    }
+
+    VoidResult ElegooLinkClient::pausePrint(const PausePrintParams &params)
+    {
+        return pImpl_->request<std::monostate>("pausePrint", params);
+    }
+
+    VoidResult ElegooLinkClient::resumePrint(const ResumePrintParams &params)
+    {
+        return pImpl_->request<std::monostate>("resumePrint", params);
+    }
+
+    VoidResult ElegooLinkClient::stopPrint(const StopPrintParams &params)
+    {
+        return pImpl_->request<std::monostate>("stopPrint", params);
+    }
+
+    // ========== Printer Status and Control ==========
+
+    PrinterAttributesResult ElegooLinkClient::getPrinterAttributes(const PrinterAttributesParams &params, int timeout)
+    {
+        nlohmann::json request = params;
+        request["timeout"] = timeout;
+        return pImpl_->request<PrinterAttributesData>("getPrinterAttributes", request);
+    }
+
+    PrinterStatusResult ElegooLinkClient::getPrinterStatus(const PrinterStatusParams &params, int timeout)
+    {
+        nlohmann::json request = params;
+        request["timeout"] = timeout;
+        return pImpl_->request<PrinterStatusData>("getPrinterStatus", request);
+    }
+
+    StatusIfNewerResult ElegooLinkClient::getStatusIfNewer(const StatusIfNewerParams &params)
+    {
+        return pImpl_->request<StatusIfNewerData>("getStatusIfNewer", params);
+    }
+
+    VoidResult ElegooLinkClient::refreshPrinterAttributes(const PrinterAttributesParams &params)
+    {
+        return pImpl_->request<std::monostate>("refreshPrinterAttributes", params);
+    }
+
+    VoidResult ElegooLinkClient::refreshPrinterStatus(const PrinterStatusParams &params)
+    {
+        return pImpl_->request<std::monostate>("refreshPrinterStatus", params);
+    }
+
+    GetCanvasStatusResult ElegooLinkClient::getCanvasStatus(const GetCanvasStatusParams &params)
+    {
+        return pImpl_->request<CanvasStatus>("getCanvasStatus", params);
+    }
+
+    VoidResult ElegooLinkClient::setAutoRefill(const SetAutoRefillParams &params)
+    {
+        return pImpl_->request<std::monostate>("setAutoRefill", params);
+    }
+
+    VoidResult ElegooLinkClient::updatePrinterName(const UpdatePrinterNameParams &params)
+    {
+        return pImpl_->request<std::monostate>("updatePrinterName", params);
+    }
+
+    BizResult<std::string> ElegooLinkClient::getPrinterStatusRaw(const PrinterStatusParams &params)
+    {
+        return pImpl_->request<std::string>("getPrinterStatusRaw", params);
+    }
+
+    // ========== Event Management ==========
+
+    VoidResult ElegooLinkClient::subscribeEvents(const std::vector<std::string> &printerIds)
+    {
+        return pImpl_->request<std::monostate>("subscribeEvents", {{"printerIds", printerIds}});
+    }
+
+    VoidResult ElegooLinkClient::unsubscribeEvents()
+    {
+        return pImpl_->request<std::monostate>("unsubscribeEvents");
+    }
+
+    void ElegooLinkClient::clearAllEventSubscriptions()
+    {
+        eventBus_.clear();
+    }
+
+    // ========== Utility Functions ==========
+
+    std::string ElegooLinkClient::getVersion() const
+    {
+        return pImpl_->request<std::string>("getVersion").data.value_or(std::string());
+    }
+
+    std::vector<PrinterType> ElegooLinkClient::getSupportedPrinterTypes() const
+    {
+        return pImpl_->request<std::vector<PrinterType>>("getSupportedPrinterTypes").data.value_or(std::vector<PrinterType>());
+    }
+
+    bool ElegooLinkClient::isLocalServiceEnabled() const
+    {
+        return pImpl_->request<bool>("isLocalServiceEnabled").data.value_or(false);
+    }
+
+    bool ElegooLinkClient::isNetworkServiceEnabled() const
+    {
+        return pImpl_->request<bool>("isNetworkServiceEnabled").data.value_or(false);
+    }
+
+    // ========== Diagnostics ==========
+
+    VoidResult ElegooLinkClient::startTracing(const std::string &fileName, size_t maxEvents)
+    {
+        return pImpl_->request<std::monostate>("startTracing", {{"fileName", fileName}, {"maxEvents", maxEvents}});
+    }
+
+    VoidResult ElegooLinkClient::stopTracing()
+    {
+        return pImpl_->request<std::monostate>("stopTracing");
+    }
+
+    VoidResult ElegooLinkClient::startWireCapture(const std::string &directory)
+    {
+        return pImpl_->request<std::monostate>("startWireCapture", {{"directory", directory}});
+    }
+
+    VoidResult ElegooLinkClient::stopWireCapture()
+    {
+        return pImpl_->request<std::monostate>("stopWireCapture");
+    }
+
+    PrinterResourceStatsResult ElegooLinkClient::getPrinterResourceStats(const PrinterResourceStatsParams &params)
+    {
+        return pImpl_->request<PrinterResourceStats>("getPrinterResourceStats", params);
+    }
+
+    PrinterResourceStatsListResult ElegooLinkClient::getAllPrinterResourceStats()
+    {
+        return pImpl_->request<PrinterResourceStatsListData>("getAllPrinterResourceStats");
+    }
+
+    TelemetryQueryResult ElegooLinkClient::queryTelemetry(const TelemetryQueryParams &params)
+    {
+        return pImpl_->request<TelemetryQueryData>("queryTelemetry", params);
+    }
+
+    FleetQueryResult ElegooLinkClient::queryFleet(const FleetQueryParams &params)
+    {
+        return pImpl_->request<FleetQueryData>("queryFleet", params);
+    }
+
+    FleetWatchResult ElegooLinkClient::watchFleet(const FleetQueryParams &params)
+    {
+        return pImpl_->request<FleetWatchData>("watchFleet", params);
+    }
+
+    VoidResult ElegooLinkClient::unwatchFleet(const FleetUnwatchParams &params)
+    {
+        return pImpl_->request<std::monostate>("unwatchFleet", params);
+    }
+
+    FleetSummaryResult ElegooLinkClient::getFleetSummary()
+    {
+        return pImpl_->request<FleetSummaryData>("getFleetSummary");
+    }
+
+    VoidResult ElegooLinkClient::addAlertRule(const AlertRule &rule)
+    {
+        return pImpl_->request<std::monostate>("addAlertRule", rule);
+    }
+
+    VoidResult ElegooLinkClient::removeAlertRule(const AlertRuleParams &params)
+    {
+        return pImpl_->request<std::monostate>("removeAlertRule", params);
+    }
+
+    AlertRuleListResult ElegooLinkClient::getAlertRules()
+    {
+        return pImpl_->request<AlertRuleListData>("getAlertRules");
+    }
+
+    AlertListResult ElegooLinkClient::getActiveAlerts()
+    {
+        return pImpl_->request<AlertListData>("getActiveAlerts");
+    }
+
+} // namespace elink
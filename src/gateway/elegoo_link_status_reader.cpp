@@ -0,0 +1,313 @@
+#include "elegoo_link_status_reader.h"
+#include "gateway/status_segment.h"
+#include "types/internal/json_serializer.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <thread>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace elink
+{
+    namespace
+    {
+        // A writer that died inside an update leaves the sequence odd; give up instead of spinning forever
+        constexpr int MAX_READ_ATTEMPTS = 1000;
+
+        /**
+         * Run copy() under the slot's sequence lock
+         * @return false if no consistent copy was made
+         */
+        template <typename Copy>
+        bool readConsistent(const StatusSlotHeader *slot, Copy copy)
+        {
+            for (int attempt = 0; attempt < MAX_READ_ATTEMPTS; ++attempt)
+            {
+                uint32_t before = slot->sequence.load(std::memory_order_acquire);
+                if (before & 1)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                copy();
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot->sequence.load(std::memory_order_relaxed) == before)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+    } // namespace
+
+    std::string getDefaultStatusSegmentName()
+    {
+#ifdef _WIN32
+        return "/elegoo-link-status";
+#else
+        return "/elegoo-link-status-" + std::to_string(::getuid());
+#endif
+    }
+
+    // ========== Private Implementation Class ==========
+
+    class ElegooLinkStatusReader::Impl
+    {
+    public:
+        ~Impl()
+        {
+            close();
+        }
+
+        bool open(const std::string &segmentName)
+        {
+            close();
+#ifdef _WIN32
+            (void)segmentName;
+            return false;
+#else
+            std::string name = segmentName.empty() ? getDefaultStatusSegmentName() : segmentName;
+            if (name.front() != '/')
+            {
+                name.insert(name.begin(), '/');
+            }
+            int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+            if (fd < 0)
+            {
+                return false;
+            }
+            struct stat info;
+            if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < statusSegmentHeaderSize())
+            {
+                ::close(fd);
+                return false;
+            }
+            size_t size = static_cast<size_t>(info.st_size);
+            void *memory = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if (memory == MAP_FAILED)
+            {
+                return false;
+            }
+
+            auto *header = static_cast<const StatusSegmentHeader *>(memory);
+            if (header->magic.load(std::memory_order_acquire) != STATUS_SEGMENT_MAGIC ||
+                header->version != STATUS_SEGMENT_VERSION ||
+                header->slotSize < sizeof(StatusSlotHeader) ||
+                statusSegmentSize(header->slotCount, header->slotSize) > size)
+            {
+                ::munmap(memory, size);
+                return false;
+            }
+            segment_ = header;
+            segmentSize_ = size;
+            return true;
+#endif
+        }
+
+        void close()
+        {
+#ifndef _WIN32
+            if (segment_)
+            {
+                ::munmap(const_cast<StatusSegmentHeader *>(segment_), segmentSize_);
+            }
+#endif
+            segment_ = nullptr;
+            segmentSize_ = 0;
+            slots_.clear();
+            scannedSlots_ = 0;
+        }
+
+        bool isOpen() const { return segment_ != nullptr; }
+
+        bool isWriterActive() const
+        {
+#ifdef _WIN32
+            return false;
+#else
+            if (!segment_)
+            {
+                return false;
+            }
+            auto pid = static_cast<pid_t>(segment_->writerPid.load(std::memory_order_acquire));
+            return pid != 0 && (::kill(pid, 0) == 0 || errno == EPERM);
+#endif
+        }
+
+        std::vector<std::string> getPrinterIds()
+        {
+            std::vector<std::string> printerIds;
+            if (!segment_)
+            {
+                return printerIds;
+            }
+            scanSlots();
+            printerIds.reserve(slots_.size());
+            for (const auto &[printerId, index] : slots_)
+            {
+                printerIds.push_back(printerId);
+            }
+            return printerIds;
+        }
+
+        bool readSummary(const std::string &printerId, PrinterStatusSummary &summary)
+        {
+            const StatusSlotHeader *slot = findSlot(printerId);
+            StatusSlotData data;
+            if (!slot || !readConsistent(slot, [&]
+                                         { std::memcpy(&data, &slot->data, sizeof(data)); }) ||
+                data.updateCount == 0)
+            {
+                return false;
+            }
+
+            summary.state = static_cast<PrinterState>(data.state);
+            summary.subState = static_cast<PrinterSubState>(data.subState);
+            summary.progress = data.progress;
+            summary.printProgress = data.printProgress;
+            summary.currentLayer = data.currentLayer;
+            summary.totalLayer = data.totalLayer;
+            summary.estimatedTime = data.estimatedTime;
+            summary.extruderTemperature = data.extruderTemperature;
+            summary.extruderTarget = data.extruderTarget;
+            summary.heatedBedTemperature = data.heatedBedTemperature;
+            summary.heatedBedTarget = data.heatedBedTarget;
+            summary.chamberTemperature = data.chamberTemperature;
+            summary.updatedAtMs = data.updatedAtMs;
+            summary.updateCount = data.updateCount;
+            return true;
+        }
+
+        bool readStatus(const std::string &printerId, PrinterStatusData &status)
+        {
+            const StatusSlotHeader *slot = findSlot(printerId);
+            if (!slot)
+            {
+                return false;
+            }
+
+            const size_t capacity = segment_->slotSize - sizeof(StatusSlotHeader);
+            const char *source = reinterpret_cast<const char *>(slot) + sizeof(StatusSlotHeader);
+            uint32_t size = 0;
+            bool copied = readConsistent(slot, [&]
+                                         {
+                                             std::memcpy(&size, &slot->data.payloadSize, sizeof(size));
+                                             size = size <= capacity ? size : 0;
+                                             payload_.resize(size);
+                                             std::memcpy(payload_.data(), source, size);
+                                         });
+            if (!copied || size == 0)
+            {
+                return false;
+            }
+
+            // Decoded after the copy, so a long decode never races with the writer
+            auto json = nlohmann::json::from_msgpack(payload_, true, false);
+            if (json.is_discarded())
+            {
+                return false;
+            }
+            try
+            {
+                status = json.get<PrinterStatusData>();
+            }
+            catch (const std::exception &)
+            {
+                return false;
+            }
+            return true;
+        }
+
+    private:
+        const StatusSlotHeader *findSlot(const std::string &printerId)
+        {
+            if (!segment_)
+            {
+                return nullptr;
+            }
+            auto it = slots_.find(printerId);
+            if (it == slots_.end())
+            {
+                // Slots published since the last scan
+                scanSlots();
+                it = slots_.find(printerId);
+                if (it == slots_.end())
+                {
+                    return nullptr;
+                }
+            }
+            return statusSegmentSlot(segment_, segment_->slotSize, it->second);
+        }
+
+        void scanSlots()
+        {
+            uint32_t used = std::min(segment_->usedSlots.load(std::memory_order_acquire), segment_->slotCount);
+            for (; scannedSlots_ < used; ++scannedSlots_)
+            {
+                const StatusSlotHeader *slot = statusSegmentSlot(segment_, segment_->slotSize, scannedSlots_);
+                slots_.emplace(std::string(slot->printerId, strnlen(slot->printerId, STATUS_SLOT_PRINTER_ID_SIZE)),
+                               scannedSlots_);
+            }
+        }
+
+        const StatusSegmentHeader *segment_ = nullptr;
+        size_t segmentSize_ = 0;
+        std::unordered_map<std::string, uint32_t> slots_;
+        uint32_t scannedSlots_ = 0;
+        std::vector<uint8_t> payload_;
+    };
+
+    // ========== ElegooLinkStatusReader ==========
+
+    ElegooLinkStatusReader::ElegooLinkStatusReader() : pImpl_(std::make_unique<Impl>())
+    {
+    }
+
+    ElegooLinkStatusReader::~ElegooLinkStatusReader() = default;
+
+    bool ElegooLinkStatusReader::open(const std::string &segmentName)
+    {
+        return pImpl_->open(segmentName);
+    }
+
+    void ElegooLinkStatusReader::close()
+    {
+        pImpl_->close();
+    }
+
+    bool ElegooLinkStatusReader::isOpen() const
+    {
+        return pImpl_->isOpen();
+    }
+
+    bool ElegooLinkStatusReader::isWriterActive() const
+    {
+        return pImpl_->isWriterActive();
+    }
+
+    std::vector<std::string> ElegooLinkStatusReader::getPrinterIds()
+    {
+        return pImpl_->getPrinterIds();
+    }
+
+    bool ElegooLinkStatusReader::readSummary(const std::string &printerId, PrinterStatusSummary &summary)
+    {
+        return pImpl_->readSummary(printerId, summary);
+    }
+
+    bool ElegooLinkStatusReader::readStatus(const std::string &printerId, PrinterStatusData &status)
+    {
+        return pImpl_->readStatus(printerId, status);
+    }
+
+} // namespace elink
@@ -0,0 +1,420 @@
+#include "gateway/gateway_channel.h"
+#include "utils/logger.h"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <afunix.h>
+#include <io.h>
+#else
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace elink
+{
+    namespace
+    {
+#ifdef _WIN32
+        const GatewaySocketHandle INVALID_HANDLE = static_cast<GatewaySocketHandle>(INVALID_SOCKET);
+
+        bool initSockets()
+        {
+            static const bool initialized = []
+            {
+                WSADATA data;
+                return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+            }();
+            return initialized;
+        }
+
+        void closeHandle(GatewaySocketHandle handle) { closesocket(static_cast<SOCKET>(handle)); }
+        int removeFile(const std::string &path) { return _unlink(path.c_str()); }
+        int socketSend(GatewaySocketHandle handle, const char *data, size_t size)
+        {
+            return send(static_cast<SOCKET>(handle), data, static_cast<int>(size), 0);
+        }
+        int socketReceive(GatewaySocketHandle handle, char *data, size_t size)
+        {
+            return recv(static_cast<SOCKET>(handle), data, static_cast<int>(size), 0);
+        }
+        std::string lastErrorText() { return "error " + std::to_string(WSAGetLastError()); }
+#else
+        const GatewaySocketHandle INVALID_HANDLE = -1;
+
+        bool initSockets() { return true; }
+        void closeHandle(GatewaySocketHandle handle) { ::close(handle); }
+        int removeFile(const std::string &path) { return ::unlink(path.c_str()); }
+        ssize_t socketSend(GatewaySocketHandle handle, const char *data, size_t size)
+        {
+#ifdef MSG_NOSIGNAL
+            return ::send(handle, data, size, MSG_NOSIGNAL);
+#else
+            return ::send(handle, data, size, 0);
+#endif
+        }
+        ssize_t socketReceive(GatewaySocketHandle handle, char *data, size_t size)
+        {
+            return ::recv(handle, data, size, 0);
+        }
+        std::string lastErrorText() { return std::strerror(errno); }
+#endif
+
+        /**
+         * Whether the process on the other end runs as the current user
+         * Windows has no peer credentials for AF_UNIX; the socket file's ACL is relied on there.
+         */
+        bool isPeerCurrentUser(GatewaySocketHandle handle)
+        {
+#if defined(_WIN32)
+            (void)handle;
+            return true;
+#elif defined(SO_PEERCRED)
+            struct ucred credentials;
+            socklen_t length = sizeof(credentials);
+            return ::getsockopt(handle, SOL_SOCKET, SO_PEERCRED, &credentials, &length) == 0 &&
+                   credentials.uid == ::getuid();
+#else
+            uid_t uid = 0;
+            gid_t gid = 0;
+            return ::getpeereid(handle, &uid, &gid) == 0 && uid == ::getuid();
+#endif
+        }
+
+#ifndef _WIN32
+        /**
+         * Create the socket's parent directory if missing and make sure no other user can
+         * place or replace files in it
+         */
+        bool preparePrivateDirectory(const std::string &path, std::string &error)
+        {
+            auto slash = path.find_last_of('/');
+            std::string directory = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+
+            if (::mkdir(directory.c_str(), 0700) != 0 && errno != EEXIST)
+            {
+                error = "Failed to create " + directory + ": " + lastErrorText();
+                return false;
+            }
+
+            struct stat info;
+            if (::lstat(directory.c_str(), &info) != 0)
+            {
+                error = "Failed to inspect " + directory + ": " + lastErrorText();
+                return false;
+            }
+            if (!S_ISDIR(info.st_mode))
+            {
+                error = directory + " is not a directory";
+                return false;
+            }
+            if (info.st_uid != ::getuid() && info.st_uid != 0)
+            {
+                error = directory + " is owned by another user";
+                return false;
+            }
+            // Shared directories such as /tmp are fine only with the sticky bit set
+            if ((info.st_mode & (S_IWGRP | S_IWOTH)) != 0 && (info.st_mode & S_ISVTX) == 0)
+            {
+                error = directory + " is writable by other users";
+                return false;
+            }
+            return true;
+        }
+#endif
+
+        GatewaySocketHandle openSocket()
+        {
+            if (!initSockets())
+            {
+                return INVALID_HANDLE;
+            }
+            auto handle = static_cast<GatewaySocketHandle>(::socket(AF_UNIX, SOCK_STREAM, 0));
+#if defined(SO_NOSIGPIPE)
+            if (handle != INVALID_HANDLE)
+            {
+                int on = 1;
+                setsockopt(handle, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+            }
+#endif
+            return handle;
+        }
+
+        bool makeAddress(const std::string &path, sockaddr_un &address, std::string &error)
+        {
+            std::memset(&address, 0, sizeof(address));
+            address.sun_family = AF_UNIX;
+            if (path.empty() || path.size() >= sizeof(address.sun_path))
+            {
+                error = "Invalid socket path: " + path;
+                return false;
+            }
+            std::memcpy(address.sun_path, path.c_str(), path.size());
+            return true;
+        }
+
+        bool connectTo(GatewaySocketHandle handle, const sockaddr_un &address)
+        {
+#ifdef _WIN32
+            return ::connect(static_cast<SOCKET>(handle), reinterpret_cast<const sockaddr *>(&address), sizeof(address)) == 0;
+#else
+            return ::connect(handle, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) == 0;
+#endif
+        }
+    } // namespace
+
+    std::string getDefaultGatewaySocketPath()
+    {
+#ifdef _WIN32
+        const char *temp = std::getenv("TEMP");
+        return std::string(temp ? temp : ".") + "\\elegoo-link.sock";
+#else
+        const char *runtimeDir = std::getenv("XDG_RUNTIME_DIR");
+        if (runtimeDir && *runtimeDir)
+        {
+            return std::string(runtimeDir) + "/elegoo-link.sock";
+        }
+        const char *tempDir = std::getenv("TMPDIR");
+        std::string base = tempDir && *tempDir ? tempDir : "/tmp";
+        while (base.size() > 1 && base.back() == '/')
+        {
+            base.pop_back();
+        }
+        return base + "/elegoo-link-" + std::to_string(::getuid()) + "/gateway.sock";
+#endif
+    }
+
+    // ========== GatewayChannel ==========
+
+    GatewayChannel::GatewayChannel(GatewaySocketHandle handle) : handle_(handle)
+    {
+    }
+
+    GatewayChannel::~GatewayChannel()
+    {
+        closeHandle(handle_);
+    }
+
+    std::unique_ptr<GatewayChannel> GatewayChannel::connect(const std::string &path, std::string &error)
+    {
+        sockaddr_un address;
+        if (!makeAddress(path, address, error))
+        {
+            return nullptr;
+        }
+        GatewaySocketHandle handle = openSocket();
+        if (handle == INVALID_HANDLE)
+        {
+            error = "Failed to create socket";
+            return nullptr;
+        }
+        if (!connectTo(handle, address))
+        {
+            closeHandle(handle);
+            error = "No gateway listening on " + path;
+            return nullptr;
+        }
+        if (!isPeerCurrentUser(handle))
+        {
+            closeHandle(handle);
+            error = "Gateway on " + path + " belongs to another user";
+            return nullptr;
+        }
+        return std::make_unique<GatewayChannel>(handle);
+    }
+
+    bool GatewayChannel::sendFrame(const std::string &payload)
+    {
+        if (payload.size() > GATEWAY_MAX_FRAME_SIZE)
+        {
+            ELEGOO_LOG_ERROR("Gateway frame of {} bytes exceeds the limit", payload.size());
+            return false;
+        }
+        auto size = static_cast<uint32_t>(payload.size());
+        const char header[4] = {static_cast<char>(size >> 24), static_cast<char>(size >> 16),
+                                static_cast<char>(size >> 8), static_cast<char>(size)};
+
+        std::lock_guard<std::mutex> lock(sendMutex_);
+        return sendAll(header, sizeof(header)) && sendAll(payload.data(), payload.size());
+    }
+
+    bool GatewayChannel::receiveFrame(std::string &payload)
+    {
+        unsigned char header[4];
+        if (!receiveAll(reinterpret_cast<char *>(header), sizeof(header)))
+        {
+            return false;
+        }
+        uint32_t size = (static_cast<uint32_t>(header[0]) << 24) | (static_cast<uint32_t>(header[1]) << 16) |
+                        (static_cast<uint32_t>(header[2]) << 8) | static_cast<uint32_t>(header[3]);
+        if (size > GATEWAY_MAX_FRAME_SIZE)
+        {
+            ELEGOO_LOG_ERROR("Gateway frame of {} bytes exceeds the limit", size);
+            return false;
+        }
+        payload.resize(size);
+        return size == 0 || receiveAll(&payload[0], size);
+    }
+
+    void GatewayChannel::shutdown()
+    {
+#ifdef _WIN32
+        ::shutdown(static_cast<SOCKET>(handle_), SD_BOTH);
+#else
+        ::shutdown(handle_, SHUT_RDWR);
+#endif
+    }
+
+    bool GatewayChannel::sendAll(const char *data, size_t size)
+    {
+        while (size > 0)
+        {
+            auto sent = socketSend(handle_, data, size);
+            if (sent <= 0)
+            {
+                return false;
+            }
+            data += sent;
+            size -= static_cast<size_t>(sent);
+        }
+        return true;
+    }
+
+    bool GatewayChannel::receiveAll(char *data, size_t size)
+    {
+        while (size > 0)
+        {
+            auto received = socketReceive(handle_, data, size);
+            if (received <= 0)
+            {
+                return false;
+            }
+            data += received;
+            size -= static_cast<size_t>(received);
+        }
+        return true;
+    }
+
+    // ========== GatewayListener ==========
+
+    GatewayListener::~GatewayListener()
+    {
+        close();
+    }
+
+    bool GatewayListener::listen(const std::string &path, std::string &error)
+    {
+        close();
+
+        sockaddr_un address;
+        if (!makeAddress(path, address, error))
+        {
+            return false;
+        }
+#ifndef _WIN32
+        if (!preparePrivateDirectory(path, error))
+        {
+            return false;
+        }
+#endif
+
+        // A socket file nobody accepts on is left over from a crashed gateway
+        std::string probeError;
+        if (GatewayChannel::connect(path, probeError))
+        {
+            error = "Another gateway is already listening on " + path;
+            return false;
+        }
+        removeFile(path);
+
+        GatewaySocketHandle handle = openSocket();
+        if (handle == INVALID_HANDLE)
+        {
+            error = "Failed to create socket";
+            return false;
+        }
+
+#ifdef _WIN32
+        bool bound = ::bind(static_cast<SOCKET>(handle), reinterpret_cast<const sockaddr *>(&address), sizeof(address)) == 0 &&
+                     ::listen(static_cast<SOCKET>(handle), SOMAXCONN) == 0;
+#else
+        // Restrict the socket file before accepting anything: the gateway acts on the user's printers
+        bool bound = ::bind(handle, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) == 0 &&
+                     ::chmod(path.c_str(), 0600) == 0 &&
+                     ::listen(handle, SOMAXCONN) == 0;
+#endif
+        if (!bound)
+        {
+            closeHandle(handle);
+            error = "Failed to bind " + path + ": " + lastErrorText();
+            return false;
+        }
+
+        handle_ = handle;
+        path_ = path;
+        listening_ = true;
+        return true;
+    }
+
+    std::unique_ptr<GatewayChannel> GatewayListener::accept(int timeoutMs)
+    {
+        if (!listening_)
+        {
+            return nullptr;
+        }
+
+#ifdef _WIN32
+        WSAPOLLFD pollFd{static_cast<SOCKET>(handle_), POLLRDNORM, 0};
+        if (WSAPoll(&pollFd, 1, timeoutMs) <= 0)
+        {
+            return nullptr;
+        }
+        SOCKET client = ::accept(static_cast<SOCKET>(handle_), nullptr, nullptr);
+        if (client == INVALID_SOCKET)
+        {
+            return nullptr;
+        }
+        return std::make_unique<GatewayChannel>(static_cast<GatewaySocketHandle>(client));
+#else
+        pollfd pollFd{handle_, POLLIN, 0};
+        if (::poll(&pollFd, 1, timeoutMs) <= 0)
+        {
+            return nullptr;
+        }
+        int client = ::accept(handle_, nullptr, nullptr);
+        if (client < 0)
+        {
+            return nullptr;
+        }
+        if (!isPeerCurrentUser(client))
+        {
+            ELEGOO_LOG_WARN("Rejected gateway connection from another user");
+            closeHandle(client);
+            return nullptr;
+        }
+#if defined(SO_NOSIGPIPE)
+        int on = 1;
+        setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+        return std::make_unique<GatewayChannel>(client);
+#endif
+    }
+
+    void GatewayListener::close()
+    {
+        if (!listening_)
+        {
+            return;
+        }
+        closeHandle(handle_);
+        removeFile(path_);
+        listening_ = false;
+        path_.clear();
+    }
+
+} // namespace elink
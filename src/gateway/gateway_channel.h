@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace elink
+{
+#ifdef _WIN32
+    using GatewaySocketHandle = uintptr_t;
+#else
+    using GatewaySocketHandle = int;
+#endif
+
+    /**
+     * Gateway wire format
+     *
+     * Every frame is a 4-byte big-endian payload length followed by a UTF-8 JSON payload.
+     * Client to server:  {"id": <n>, "method": "<ElegooLink method>", "params": {...}}
+     * Server to client:  {"id": <n>, "result": {"code", "message", "data"}}      final response
+     *                    {"id": <n>, "notify": {...}}                             progress of request n
+     *                    {"event": <MethodType>, "data": {...}}                   subscribed event
+     * Responses carry the request id and may arrive in any order, so clients can pipeline.
+     */
+    constexpr uint32_t GATEWAY_MAX_FRAME_SIZE = 64 * 1024 * 1024;
+
+    /**
+     * Default gateway socket path
+     * $XDG_RUNTIME_DIR/elegoo-link.sock, else gateway.sock in a per-user 0700 directory under the temp directory
+     */
+    std::string getDefaultGatewaySocketPath();
+
+    /**
+     * One connected stream socket carrying gateway frames
+     * sendFrame() may be called from several threads; receiveFrame() from one reader thread.
+     */
+    class GatewayChannel
+    {
+    public:
+        explicit GatewayChannel(GatewaySocketHandle handle);
+        ~GatewayChannel();
+
+        GatewayChannel(const GatewayChannel &) = delete;
+        GatewayChannel &operator=(const GatewayChannel &) = delete;
+
+        /**
+         * Connect to a gateway socket
+         * The gateway process must run as the current user.
+         * @return nullptr on failure, with the reason in error
+         */
+        static std::unique_ptr<GatewayChannel> connect(const std::string &path, std::string &error);
+
+        bool sendFrame(const std::string &payload);
+
+        /**
+         * Block until a full frame arrives
+         * @return false when the peer closed, the frame is oversized or shutdown() was called
+         */
+        bool receiveFrame(std::string &payload);
+
+        /**
+         * Stop both directions; wakes a blocked receiveFrame()
+         */
+        void shutdown();
+
+    private:
+        bool sendAll(const char *data, size_t size);
+        bool receiveAll(char *data, size_t size);
+
+        GatewaySocketHandle handle_;
+        std::mutex sendMutex_;
+    };
+
+    /**
+     * Listening gateway socket
+     */
+    class GatewayListener
+    {
+    public:
+        GatewayListener() = default;
+        ~GatewayListener();
+
+        GatewayListener(const GatewayListener &) = delete;
+        GatewayListener &operator=(const GatewayListener &) = delete;
+
+        /**
+         * Bind and listen; the socket file is made accessible to the current user only
+         * The parent directory is created 0700 if missing and must not be writable by other users.
+         * Fails if another gateway is already serving the path, a stale socket file is replaced.
+         */
+        bool listen(const std::string &path, std::string &error);
+
+        /**
+         * Wait up to timeoutMs for a connection
+         * @return nullptr on timeout, when the listener is closed or the peer is another user
+         */
+        std::unique_ptr<GatewayChannel> accept(int timeoutMs);
+
+        /**
+         * Close the socket and remove the socket file
+         */
+        void close();
+
+        bool isListening() const { return listening_; }
+
+    private:
+        GatewaySocketHandle handle_ = 0;
+        bool listening_ = false;
+        std::string path_;
+    };
+
+} // namespace elink
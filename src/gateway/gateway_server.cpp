@@ -0,0 +1,684 @@
+#include "gateway/gateway_server.h"
+#include "elegoo_link.h"
+#include "types/internal/json_serializer.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <chrono>
+#include <future>
+
+namespace elink
+{
+    namespace
+    {
+        const int ACCEPT_POLL_MS = 200;
+
+        template <typename T>
+        nlohmann::json toResultJson(const BizResult<T> &result)
+        {
+            return result;
+        }
+
+        nlohmann::json errorResult(ELINK_ERROR_CODE code, const std::string &message)
+        {
+            return toResultJson(VoidResult::Error(code, message));
+        }
+
+        std::string printerIdOf(const nlohmann::json &data)
+        {
+            auto it = data.find("printerId");
+            return it != data.end() && it->is_string() ? it->get<std::string>() : std::string();
+        }
+    } // namespace
+
+    // ========== Connection ==========
+
+    class GatewayServer::Connection
+    {
+    public:
+        explicit Connection(std::unique_ptr<GatewayChannel> channel) : channel_(std::move(channel)) {}
+
+        /**
+         * Queue a message for the writer thread
+         * A client that lets MAX_PENDING_OUTBOUND_BYTES pile up is disconnected.
+         */
+        bool send(const nlohmann::json &message)
+        {
+            std::string frame = message.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (closed_)
+                {
+                    return false;
+                }
+                if (pendingBytes_ + frame.size() > MAX_PENDING_OUTBOUND_BYTES)
+                {
+                    ELEGOO_LOG_WARN("Gateway client is not reading, {} bytes pending, disconnecting", pendingBytes_);
+                    closeLocked();
+                    return false;
+                }
+                pendingBytes_ += frame.size();
+                outbound_.push_back(std::move(frame));
+            }
+            condition_.notify_one();
+            return true;
+        }
+
+        void close()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closeLocked();
+        }
+
+        bool isClosed() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return closed_;
+        }
+
+        void setSubscription(bool subscribed, std::set<std::string> printerIds)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            subscribed_ = subscribed;
+            eventPrinterIds_ = std::move(printerIds);
+        }
+
+        bool wantsEvent(const std::string &printerId) const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return subscribed_ && !closed_ &&
+                   (printerId.empty() || eventPrinterIds_.empty() || eventPrinterIds_.count(printerId) > 0);
+        }
+
+        void cancel(int64_t requestId)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cancelled_.insert(requestId);
+        }
+
+        bool isCancelled(int64_t requestId) const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return closed_ || cancelled_.count(requestId) > 0;
+        }
+
+        void forget(int64_t requestId)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cancelled_.erase(requestId);
+        }
+
+        void writeLoop()
+        {
+            while (true)
+            {
+                std::string frame;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    condition_.wait(lock, [this]
+                                    { return closed_ || !outbound_.empty(); });
+                    if (closed_)
+                    {
+                        return;
+                    }
+                    frame = std::move(outbound_.front());
+                    outbound_.pop_front();
+                    pendingBytes_ -= frame.size();
+                }
+                if (!channel_->sendFrame(frame))
+                {
+                    close();
+                    return;
+                }
+            }
+        }
+
+        void join()
+        {
+            if (reader_.joinable())
+            {
+                reader_.join();
+            }
+            if (writer_.joinable())
+            {
+                writer_.join();
+            }
+        }
+
+        GatewayChannel &channel() { return *channel_; }
+
+        std::thread reader_;
+        std::thread writer_;
+
+    private:
+        void closeLocked()
+        {
+            if (!closed_)
+            {
+                closed_ = true;
+                outbound_.clear();
+                pendingBytes_ = 0;
+                channel_->shutdown();
+                condition_.notify_all();
+            }
+        }
+
+        std::unique_ptr<GatewayChannel> channel_;
+        mutable std::mutex mutex_;
+        std::condition_variable condition_;
+        std::deque<std::string> outbound_;
+        size_t pendingBytes_ = 0;
+        bool closed_ = false;
+        bool subscribed_ = false;
+        std::set<std::string> eventPrinterIds_;
+        std::set<int64_t> cancelled_;
+    };
+
+    // ========== GatewayServer ==========
+
+    GatewayServer &GatewayServer::getInstance()
+    {
+        static GatewayServer instance;
+        return instance;
+    }
+
+    GatewayServer::GatewayServer()
+    {
+        registerHandlers();
+    }
+
+    GatewayServer::~GatewayServer()
+    {
+        stop();
+    }
+
+    bool GatewayServer::start(const std::string &socketPath, size_t workerThreads, std::string &error)
+    {
+        std::lock_guard<std::mutex> lifecycleLock(lifecycleMutex_);
+        if (running_)
+        {
+            error = "Gateway is already running on " + socketPath_;
+            return false;
+        }
+
+        std::string path = socketPath.empty() ? getDefaultGatewaySocketPath() : socketPath;
+        if (!listener_.listen(path, error))
+        {
+            return false;
+        }
+
+        if (workerThreads == 0)
+        {
+            workerThreads = std::max<size_t>(4, std::thread::hardware_concurrency());
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            workers_ = std::make_unique<ThreadPool>(workerThreads, 1000, ThreadPool::RejectionPolicy::THROW_EXCEPTION);
+            socketPath_ = path;
+        }
+        running_ = true;
+        // Outside mutex_: event handlers take it while the EventBus holds its own lock
+        subscribeEvents();
+        acceptThread_ = std::thread(&GatewayServer::acceptLoop, this);
+
+        ELEGOO_LOG_INFO("Gateway listening on {} with {} workers", path, workerThreads);
+        return true;
+    }
+
+    void GatewayServer::stop()
+    {
+        std::lock_guard<std::mutex> lifecycleLock(lifecycleMutex_);
+        if (!running_)
+        {
+            return;
+        }
+        running_ = false;
+
+        std::vector<std::shared_ptr<Connection>> connections;
+        std::unique_ptr<ThreadPool> workers;
+
+        if (acceptThread_.joinable())
+        {
+            acceptThread_.join();
+        }
+        unsubscribeEvents();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            listener_.close();
+            connections.swap(connections_);
+        }
+        for (auto &connection : connections)
+        {
+            connection->close();
+            connection->join();
+        }
+
+        // Readers are gone, nothing enqueues anymore; queued requests see their connection closed
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            workers = std::move(workers_);
+        }
+        workers.reset();
+
+        ELEGOO_LOG_INFO("Gateway stopped");
+    }
+
+    std::string GatewayServer::getSocketPath() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return socketPath_;
+    }
+
+    size_t GatewayServer::getClientCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return std::count_if(connections_.begin(), connections_.end(),
+                             [](const std::shared_ptr<Connection> &connection)
+                             { return !connection->isClosed(); });
+    }
+
+    void GatewayServer::acceptLoop()
+    {
+        while (running_)
+        {
+            auto channel = listener_.accept(ACCEPT_POLL_MS);
+            removeClosedConnections();
+            if (!channel)
+            {
+                continue;
+            }
+
+            auto connection = std::make_shared<Connection>(std::move(channel));
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                connections_.push_back(connection);
+                ELEGOO_LOG_DEBUG("Gateway client connected, {} clients", connections_.size());
+            }
+            connection->writer_ = std::thread(&Connection::writeLoop, connection.get());
+            connection->reader_ = std::thread(&GatewayServer::readLoop, this, connection);
+        }
+    }
+
+    void GatewayServer::removeClosedConnections()
+    {
+        std::vector<std::shared_ptr<Connection>> closed;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = std::stable_partition(connections_.begin(), connections_.end(),
+                                            [](const std::shared_ptr<Connection> &connection)
+                                            { return !connection->isClosed(); });
+            closed.assign(it, connections_.end());
+            connections_.erase(it, connections_.end());
+        }
+        for (auto &connection : closed)
+        {
+            connection->join();
+            ELEGOO_LOG_DEBUG("Gateway client disconnected");
+        }
+    }
+
+    void GatewayServer::readLoop(const std::shared_ptr<Connection> &connection)
+    {
+        std::string frame;
+        while (connection->channel().receiveFrame(frame))
+        {
+            handleFrame(connection, frame);
+        }
+        connection->close();
+    }
+
+    void GatewayServer::handleFrame(const std::shared_ptr<Connection> &connection, const std::string &frame)
+    {
+        int64_t requestId = 0;
+        std::string methodName;
+        nlohmann::json params;
+        try
+        {
+            auto request = nlohmann::json::parse(frame);
+            requestId = request.at("id").get<int64_t>();
+            methodName = request.at("method").get<std::string>();
+            params = request.value("params", nlohmann::json::object());
+        }
+        catch (const std::exception &e)
+        {
+            connection->send({{"id", nullptr},
+                              {"result", errorResult(ELINK_ERROR_CODE::INVALID_PARAMETER,
+                                                     std::string("Malformed request: ") + e.what())}});
+            return;
+        }
+
+        auto it = methods_.find(methodName);
+        if (it == methods_.end())
+        {
+            connection->send({{"id", requestId},
+                              {"result", errorResult(ELINK_ERROR_CODE::OPERATION_NOT_IMPLEMENTED,
+                                                     "Unknown method: " + methodName)}});
+            return;
+        }
+        if (it->second.runInline)
+        {
+            dispatch(connection, requestId, methodName, params);
+            return;
+        }
+
+        try
+        {
+            workers_->enqueue([this, connection, requestId, methodName, params]()
+                              {
+                                  if (!connection->isClosed())
+                                  {
+                                      dispatch(connection, requestId, methodName, params);
+                                  } });
+        }
+        catch (const std::exception &)
+        {
+            connection->send({{"id", requestId},
+                              {"result", errorResult(ELINK_ERROR_CODE::OPERATION_IN_PROGRESS,
+                                                     "Gateway is busy, too many queued requests")}});
+        }
+    }
+
+    void GatewayServer::dispatch(const std::shared_ptr<Connection> &connection, int64_t requestId,
+                                 const std::string &method, const nlohmann::json &params)
+    {
+        nlohmann::json result;
+        try
+        {
+            result = methods_.at(method).handler(connection, requestId, params);
+        }
+        catch (const nlohmann::json::exception &e)
+        {
+            result = errorResult(ELINK_ERROR_CODE::INVALID_PARAMETER, std::string("Invalid params: ") + e.what());
+        }
+        catch (const std::exception &e)
+        {
+            ELEGOO_LOG_ERROR("Gateway method {} failed: {}", method, e.what());
+            result = errorResult(ELINK_ERROR_CODE::UNKNOWN_ERROR, e.what());
+        }
+        connection->forget(requestId);
+        connection->send({{"id", requestId}, {"result", std::move(result)}});
+    }
+
+    // ========== Method table ==========
+
+    template <typename Result, typename Params>
+    void GatewayServer::bindMethod(const std::string &name, Result (ElegooLink::*method)(const Params &))
+    {
+        methods_[name].handler = [method](const std::shared_ptr<Connection> &, int64_t, const nlohmann::json &params)
+        {
+            return toResultJson((ElegooLink::getInstance().*method)(params.get<Params>()));
+        };
+    }
+
+    template <typename Result>
+    void GatewayServer::bindMethod(const std::string &name, Result (ElegooLink::*method)())
+    {
+        methods_[name].handler = [method](const std::shared_ptr<Connection> &, int64_t, const nlohmann::json &)
+        {
+            return toResultJson((ElegooLink::getInstance().*method)());
+        };
+    }
+
+    template <typename Result>
+    void GatewayServer::bindMethod(const std::string &name, Result (ElegooLink::*method)() const)
+    {
+        methods_[name].handler = [method](const std::shared_ptr<Connection> &, int64_t, const nlohmann::json &)
+        {
+            return toResultJson(BizResult<Result>::Ok((ElegooLink::getInstance().*method)()));
+        };
+    }
+
+    void GatewayServer::registerHandlers()
+    {
+        auto &link = ElegooLink::getInstance();
+
+        // Printer discovery
+        bindMethod("startPrinterDiscovery", &ElegooLink::startPrinterDiscovery);
+        bindMethod("stopPrinterDiscovery", &ElegooLink::stopPrinterDiscovery);
+        bindMethod("getDiscoveredPrinters", &ElegooLink::getDiscoveredPrinters);
+        methods_["startPrinterDiscoveryAsync"].handler =
+            [&link](const std::shared_ptr<Connection> &connection, int64_t requestId, const nlohmann::json &params)
+        {
+            // {"started"} and each {"printer"} found are notifications, the final response carries the full list
+            auto discoveryParams = params.get<PrinterDiscoveryParams>();
+            auto done = std::make_shared<std::promise<std::vector<PrinterInfo>>>();
+            auto future = done->get_future();
+            auto started = link.startPrinterDiscoveryAsync(
+                discoveryParams,
+                [connection, requestId](const PrinterInfo &printer)
+                { connection->send({{"id", requestId}, {"notify", {{"printer", printer}}}}); },
+                [done](const std::vector<PrinterInfo> &printers)
+                { done->set_value(printers); });
+            if (!started.isSuccess())
+            {
+                return toResultJson(started);
+            }
+            connection->send({{"id", requestId}, {"notify", {{"started", true}}}});
+            auto timeout = std::chrono::milliseconds(discoveryParams.timeoutMs) + std::chrono::seconds(5);
+            if (future.wait_for(timeout) != std::future_status::ready)
+            {
+                return errorResult(ELINK_ERROR_CODE::OPERATION_TIMEOUT, "Printer discovery did not complete");
+            }
+            PrinterDiscoveryData data;
+            data.printers = future.get();
+            return toResultJson(BizResult<PrinterDiscoveryData>::Ok(std::move(data)));
+        };
+
+        // Connection management
+        bindMethod("connectPrinter", &ElegooLink::connectPrinter);
+        bindMethod("getPrinters", &ElegooLink::getPrinters);
+        methods_["disconnectPrinter"].handler =
+            [&link](const std::shared_ptr<Connection> &, int64_t, const nlohmann::json &params)
+        { return toResultJson(link.disconnectPrinter(params.get<PrinterBaseParams>().printerId)); };
+        methods_["isPrinterConnected"].handler =
+            [&link](const std::shared_ptr<Connection> &, int64_t, const nlohmann::json &params)
+        {
+            return toResultJson(BizResult<bool>::Ok(link.isPrinterConnected(params.get<PrinterBaseParams>().printerId)));
+        };
+
+#ifdef ENABLE_CLOUD_FEATURES
+        // Cloud service
+        bindMethod("setRegion", &ElegooLink::setRegion);
+        bindMethod("getUserInfo", &ElegooLink::getUserInfo);
+        bindMethod("setHttpCredential", &ElegooLink::setHttpCredential);
+        methods_["getHttpCredential"].handler =
+            [&link](const std::shared_ptr<Connection> &, int64_t, const nlohmann::json &)
+        { return toResultJson(link.getHttpCredential()); };
+        bindMethod("refreshHttpCredential", &ElegooLink::refreshHttpCredential);
+        bindMethod("clearHttpCredential", &ElegooLink::clearHttpCredential);
+        bindMethod("logout", &ElegooLink::logout);
+        methods_["getRtcToken"].handler =
+            [&link](const std::shared_ptr<Connection> &, int64_t, const nlohmann::json &)
+        { return toResultJson(link.getRtcToken()); };
+        bindMethod("sendRtmMessage", &ElegooLink::sendRtmMessage);
+        bindMethod("bindPrinter", &ElegooLink::bindPrinter);
+        bindMethod("cancelBindPrinter", &ElegooLink::cancelBindPrinter);
+        bindMethod("unbindPrinter", &ElegooLink::unbindPrinter);
+        bindMethod("getLicenseExpiredDevices", &ElegooLink::getLicenseExpiredDevices);
+        bindMethod("renewLicense", &ElegooLink::renewLicense);
+#endif
+
+        // File management
+        bindMethod("getFileList", &ElegooLink::getFileList);
+        bindMethod("getFileDetail", &ElegooLink::getFileDetail);
+        methods_["uploadFile"].handler =
+            [&link](const std::shared_ptr<Connection> &connection, int64_t requestId, const nlohmann::json &params)
+        {
+            // Progress goes out as notifications; a "cancel" request or a disconnect aborts the upload
+            return toResultJson(link.uploadFile(
+                params.get<FileUploadParams>(),
+                [connection, requestId](const FileUploadProgressData &progress)
+                {
+                    connection->send({{"id", requestId}, {"notify", progress}});
+                    return !connection->isCancelled(requestId);
+                }));
+        };
+
+        // Print task management
+        bindMethod("getPrintTaskList", &ElegooLink::getPrintTaskList);
+        bindMethod("deletePrintTasks", &ElegooLink::deletePrintTasks);
+        bindMethod("startPrint", &ElegooLink::startPrint);
+        bindMethod("pausePrint", &ElegooLink::pausePrint);
+        bindMethod("resumePrint", &ElegooLink::resumePrint);
+        bindMethod("stopPrint", &ElegooLink::stopPrint);
+
+        // Printer status and control
+        methods_["getPrinterAttributes"].handler =
+            [&link](const std::shared_ptr<Connection> &, int64_t, const nlohmann::json &params)
+        { return toResultJson(link.getPrinterAttributes(params.get<PrinterAttributesParams>(), params.value("timeout", 3000))); };
+        methods_["getPrinterStatus"].handler =
+            [&link](const std::shared_ptr<Connection> &, int64_t, const nlohmann::json &params)
+        { return toResultJson(link.getPrinterStatus(params.get<PrinterStatusParams>(), params.value("timeout", 3000))); };
+        bindMethod("getStatusIfNewer", &ElegooLink::getStatusIfNewer);
+        bindMethod("refreshPrinterAttributes", &ElegooLink::refreshPrinterAttributes);
+        bindMethod("refreshPrinterStatus", &ElegooLink::refreshPrinterStatus);
+        bindMethod("getCanvasStatus", &ElegooLink::getCanvasStatus);
+        bindMethod("setAutoRefill", &ElegooLink::setAutoRefill);
+        bindMethod("updatePrinterName", &ElegooLink::updatePrinterName);
+        bindMethod("getPrinterStatusRaw", &ElegooLink::getPrinterStatusRaw);
+
+        // Utility
+        bindMethod("getVersion", &ElegooLink::getVersion);
+        bindMethod("getSupportedPrinterTypes", &ElegooLink::getSupportedPrinterTypes);
+        bindMethod("isLocalServiceEnabled", &ElegooLink::isLocalServiceEnabled);
+        bindMethod("isNetworkServiceEnabled", &ElegooLink::isNetworkServiceEnabled);
+
+        // Diagnostics
+        methods_["startTracing"].handler =
+            [&link](const std::shared_ptr<Connection> &, int64_t, const nlohmann::json &params)
+        {
+            return toResultJson(link.startTracing(params.at("fileName").get<std::string>(),
+                                                  params.value("maxEvents", static_cast<size_t>(1000000))));
+        };
+        bindMethod("stopTracing", &ElegooLink::stopTracing);
+        methods_["startWireCapture"].handler =
+            [&link](const std::shared_ptr<Connection> &, int64_t, const nlohmann::json &params)
+        { return toResultJson(link.startWireCapture(params.at("directory").get<std::string>())); };
+        bindMethod("stopWireCapture", &ElegooLink::stopWireCapture);
+        bindMethod("getPrinterResourceStats", &ElegooLink::getPrinterResourceStats);
+        bindMethod("getAllPrinterResourceStats", &ElegooLink::getAllPrinterResourceStats);
+        bindMethod("queryTelemetry", &ElegooLink::queryTelemetry);
+
+        // Fleet queries
+        bindMethod("queryFleet", &ElegooLink::queryFleet);
+        bindMethod("watchFleet", &ElegooLink::watchFleet);
+        bindMethod("unwatchFleet", &ElegooLink::unwatchFleet);
+        bindMethod("getFleetSummary", &ElegooLink::getFleetSummary);
+
+        // Alert rules
+        bindMethod("addAlertRule", &ElegooLink::addAlertRule);
+        bindMethod("removeAlertRule", &ElegooLink::removeAlertRule);
+        bindMethod("getAlertRules", &ElegooLink::getAlertRules);
+        bindMethod("getActiveAlerts", &ElegooLink::getActiveAlerts);
+
+        // Gateway control, answered in request order on the reader thread
+        methods_["subscribeEvents"] = {
+            [](const std::shared_ptr<Connection> &connection, int64_t, const nlohmann::json &params)
+            {
+                connection->setSubscription(true, params.value("printerIds", std::set<std::string>()));
+                return toResultJson(VoidResult::Success());
+            },
+            true};
+        methods_["unsubscribeEvents"] = {
+            [](const std::shared_ptr<Connection> &connection, int64_t, const nlohmann::json &)
+            {
+                connection->setSubscription(false, {});
+                return toResultJson(VoidResult::Success());
+            },
+            true};
+        methods_["cancel"] = {
+            [](const std::shared_ptr<Connection> &connection, int64_t, const nlohmann::json &params)
+            {
+                connection->cancel(params.at("id").get<int64_t>());
+                return toResultJson(VoidResult::Success());
+            },
+            true};
+    }
+
+    // ========== Event forwarding ==========
+
+    void GatewayServer::broadcastEvent(int method, const std::string &printerId, const nlohmann::json &data)
+    {
+        std::vector<std::shared_ptr<Connection>> targets;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto &connection : connections_)
+            {
+                if (connection->wantsEvent(printerId))
+                {
+                    targets.push_back(connection);
+                }
+            }
+        }
+        if (targets.empty())
+        {
+            return;
+        }
+        nlohmann::json message = {{"event", method}, {"data", data}};
+        for (const auto &connection : targets)
+        {
+            connection->send(message);
+        }
+    }
+
+    void GatewayServer::subscribeEvents()
+    {
+        auto &link = ElegooLink::getInstance();
+        auto forward = [this, &link](auto typeTag, MethodType method, auto toData)
+        {
+            using EventType = typename decltype(typeTag)::element_type;
+            auto id = link.subscribeEvent<EventType>(
+                [this, method, toData](const std::shared_ptr<EventType> &event)
+                {
+                    nlohmann::json data = toData(*event);
+                    broadcastEvent(static_cast<int>(method), printerIdOf(data), data);
+                });
+            eventUnsubscribers_.push_back([&link, id]()
+                                          { link.unsubscribeEvent<EventType>(id); });
+        };
+
+        forward(std::shared_ptr<PrinterConnectionEvent>(), MethodType::ON_CONNECTION_STATUS,
+                [](const PrinterConnectionEvent &event)
+                { return nlohmann::json(event.connectionStatus); });
+        forward(std::shared_ptr<PrinterStatusEvent>(), MethodType::ON_PRINTER_STATUS,
+                [](const PrinterStatusEvent &event)
+                { return nlohmann::json(event.status); });
+        forward(std::shared_ptr<PrinterAttributesEvent>(), MethodType::ON_PRINTER_ATTRIBUTES,
+                [](const PrinterAttributesEvent &event)
+                { return nlohmann::json(event.attributes); });
+        forward(std::shared_ptr<PrinterEventRawEvent>(), MethodType::ON_PRINTER_EVENT_RAW,
+                [](const PrinterEventRawEvent &event)
+                { return nlohmann::json(event.rawData); });
+        forward(std::shared_ptr<PrinterListChangedEvent>(), MethodType::ON_PRINTER_LIST_CHANGED,
+                [](const PrinterListChangedEvent &event)
+                { return nlohmann::json(event.change); });
+        forward(std::shared_ptr<RtmMessageEvent>(), MethodType::ON_RTM_MESSAGE,
+                [](const RtmMessageEvent &event)
+                { return nlohmann::json(event.message); });
+        forward(std::shared_ptr<RtcTokenEvent>(), MethodType::ON_RTC_TOKEN_CHANGED,
+                [](const RtcTokenEvent &event)
+                { return nlohmann::json(event.token); });
+        forward(std::shared_ptr<LoggedInElsewhereEvent>(), MethodType::ON_LOGGED_IN_ELSEWHERE,
+                [](const LoggedInElsewhereEvent &)
+                { return nlohmann::json::object(); });
+        forward(std::shared_ptr<OnlineStatusChangedEvent>(), MethodType::ON_ONLINE_STATUS_CHANGED,
+                [](const OnlineStatusChangedEvent &event)
+                { return nlohmann::json(OnlineStatusData{event.isOnline}); });
+        forward(std::shared_ptr<FleetQueryChangedEvent>(), MethodType::ON_FLEET_QUERY_CHANGED,
+                [](const FleetQueryChangedEvent &event)
+                { return nlohmann::json(event.change); });
+        forward(std::shared_ptr<AlertEvent>(), MethodType::ON_ALERT,
+                [](const AlertEvent &event)
+                { return nlohmann::json(event.alert); });
+    }
+
+    void GatewayServer::unsubscribeEvents()
+    {
+        for (auto &unsubscribe : eventUnsubscribers_)
+        {
+            unsubscribe();
+        }
+        eventUnsubscribers_.clear();
+    }
+
+} // namespace elink
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "gateway/gateway_channel.h"
+#include "utils/thread_pool.h"
+
+namespace elink
+{
+    class ElegooLink;
+
+    /**
+     * Serves the ElegooLink API of this process to other local processes
+     *
+     * The process running the gateway owns every printer connection; slicer plugins,
+     * dashboards and scripts connect with ElegooLinkClient instead of initializing their own
+     * SDK. Requests are executed on a worker pool so a client can pipeline many of them and
+     * a slow printer call does not hold up the others. Events are forwarded to clients that
+     * subscribed, each through its own bounded outbound queue: a client that stops reading is
+     * disconnected rather than stalling the event bus.
+     */
+    class GatewayServer
+    {
+    public:
+        static constexpr size_t MAX_PENDING_OUTBOUND_BYTES = 32 * 1024 * 1024;
+
+        static GatewayServer &getInstance();
+
+        ~GatewayServer();
+
+        GatewayServer(const GatewayServer &) = delete;
+        GatewayServer &operator=(const GatewayServer &) = delete;
+
+        /**
+         * Start listening
+         * @param socketPath Socket path, empty for getDefaultGatewaySocketPath()
+         * @param workerThreads Request worker threads, 0 for the default
+         * @return false if already running or the socket cannot be bound, with the reason in error
+         */
+        bool start(const std::string &socketPath, size_t workerThreads, std::string &error);
+
+        /**
+         * Disconnect all clients and remove the socket file
+         */
+        void stop();
+
+        bool isRunning() const { return running_; }
+        std::string getSocketPath() const;
+        size_t getClientCount() const;
+
+    private:
+        GatewayServer();
+
+        class Connection;
+
+        /**
+         * Runs one request; returns the {"code", "message", "data"} result
+         */
+        using Handler = std::function<nlohmann::json(const std::shared_ptr<Connection> &connection,
+                                                     int64_t requestId, const nlohmann::json &params)>;
+
+        struct Method
+        {
+            Handler handler;
+            bool runInline = false; // Run on the connection's reader thread, in request order
+        };
+
+        void registerHandlers();
+
+        template <typename Result, typename Params>
+        void bindMethod(const std::string &name, Result (ElegooLink::*method)(const Params &));
+        template <typename Result>
+        void bindMethod(const std::string &name, Result (ElegooLink::*method)());
+        template <typename Result>
+        void bindMethod(const std::string &name, Result (ElegooLink::*method)() const);
+
+        void acceptLoop();
+        void readLoop(const std::shared_ptr<Connection> &connection);
+        void handleFrame(const std::shared_ptr<Connection> &connection, const std::string &frame);
+        void dispatch(const std::shared_ptr<Connection> &connection, int64_t requestId,
+                      const std::string &method, const nlohmann::json &params);
+
+        void subscribeEvents();
+        void unsubscribeEvents();
+        void broadcastEvent(int method, const std::string &printerId, const nlohmann::json &data);
+
+        void removeClosedConnections();
+
+        std::unordered_map<std::string, Method> methods_;
+
+        std::mutex lifecycleMutex_; // Serializes start() and stop()
+        mutable std::mutex mutex_;  // Guards connections_, workers_ and socketPath_
+        std::atomic<bool> running_{false};
+        GatewayListener listener_;
+        std::string socketPath_;
+        std::thread acceptThread_;
+        std::unique_ptr<ThreadPool> workers_;
+        std::vector<std::shared_ptr<Connection>> connections_;
+        std::vector<std::function<void()>> eventUnsubscribers_;
+    };
+
+} // namespace elink
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace elink
+{
+    /**
+     * Shared-memory status segment layout
+     *
+     *   StatusSegmentHeader (padded to a cache line) | slotCount x (StatusSlotHeader | payload)
+     *
+     * One writer process, elected with a ProcessMutex, creates the segment and publishes the
+     * latest status of every printer into that printer's slot. Any number of reader processes
+     * map it read-only. Each slot is guarded by a sequence lock: the writer makes the sequence
+     * odd, writes the slot and makes it even again; a reader copies the slot and retries when
+     * the sequence was odd or changed during the copy. A slot is assigned to one printer for
+     * the life of the segment; its printer ID is written before usedSlots publishes the slot.
+     */
+    constexpr uint32_t STATUS_SEGMENT_MAGIC = 0x53534C45; // "ELSS"
+    constexpr uint32_t STATUS_SEGMENT_VERSION = 1;
+    constexpr size_t STATUS_SEGMENT_ALIGNMENT = 64;
+    constexpr size_t STATUS_SLOT_PRINTER_ID_SIZE = 64;
+
+    // Atomics in the segment are shared between processes, which requires lock-free atomics
+    static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<int64_t>::is_always_lock_free,
+                  "Status segment atomics must be lock-free");
+
+    struct StatusSegmentHeader
+    {
+        std::atomic<uint32_t> magic; // Stored last by the writer, once the header is complete
+        uint32_t version;
+        uint32_t slotCount;
+        uint32_t slotSize; // Bytes per slot, header included, a multiple of STATUS_SEGMENT_ALIGNMENT
+        std::atomic<uint32_t> usedSlots;
+        uint32_t reserved;
+        std::atomic<int64_t> writerPid; // Reset to 0 when the writer stops
+    };
+
+    /**
+     * Slot fields copied as a whole under the sequence lock
+     */
+    struct StatusSlotData
+    {
+        uint32_t payloadSize;  // MessagePack of the PrinterStatusData JSON; 0 if it did not fit
+        uint32_t reserved;
+        int64_t updatedAtMs;   // Unix time of the last update
+        uint64_t updateCount;  // Updates since the slot was assigned
+        int32_t state;         // PrinterState
+        int32_t subState;      // PrinterSubState
+        int32_t progress;      // PrinterStatus::progress
+        int32_t currentLayer;
+        int32_t totalLayer;
+        int32_t printProgress; // PrintStatus::progress
+        int64_t estimatedTime; // Remaining print time (seconds)
+        double extruderTemperature;
+        double extruderTarget;
+        double heatedBedTemperature;
+        double heatedBedTarget;
+        double chamberTemperature;
+    };
+
+    struct alignas(STATUS_SEGMENT_ALIGNMENT) StatusSlotHeader
+    {
+        std::atomic<uint32_t> sequence; // Odd while the writer updates the slot
+        uint32_t reserved;
+        char printerId[STATUS_SLOT_PRINTER_ID_SIZE]; // NUL-terminated, immutable once published
+        StatusSlotData data;
+    };
+
+    inline size_t statusSegmentHeaderSize()
+    {
+        return (sizeof(StatusSegmentHeader) + STATUS_SEGMENT_ALIGNMENT - 1) / STATUS_SEGMENT_ALIGNMENT * STATUS_SEGMENT_ALIGNMENT;
+    }
+
+    inline size_t statusSegmentSize(uint32_t slotCount, uint32_t slotSize)
+    {
+        return statusSegmentHeaderSize() + static_cast<size_t>(slotCount) * slotSize;
+    }
+
+    inline StatusSlotHeader *statusSegmentSlot(void *segment, uint32_t slotSize, uint32_t index)
+    {
+        return reinterpret_cast<StatusSlotHeader *>(static_cast<char *>(segment) + statusSegmentHeaderSize() +
+                                                    static_cast<size_t>(index) * slotSize);
+    }
+
+    inline const StatusSlotHeader *statusSegmentSlot(const void *segment, uint32_t slotSize, uint32_t index)
+    {
+        return statusSegmentSlot(const_cast<void *>(segment), slotSize, index);
+    }
+
+    inline char *statusSlotPayload(StatusSlotHeader *slot)
+    {
+        return reinterpret_cast<char *>(slot) + sizeof(StatusSlotHeader);
+    }
+
+    /**
+     * Default segment name, per user: /elegoo-link-status-<uid>
+     */
+    std::string getDefaultStatusSegmentName();
+
+} // namespace elink
@@ -0,0 +1,277 @@
+#include "gateway/status_segment_writer.h"
+#include "gateway/status_segment.h"
+#include "type.h"
+#include "types/internal/internal.h"
+#include "utils/logger.h"
+#include "utils/process_mutex.h"
+#include "utils/utils.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace elink
+{
+    std::atomic<bool> StatusSegmentWriter::enabled_{false};
+
+    namespace
+    {
+        template <typename T>
+        T numberAt(const nlohmann::json &object, const char *key, T fallback)
+        {
+            auto it = object.find(key);
+            return it != object.end() && it->is_number() ? it->get<T>() : fallback;
+        }
+
+        const nlohmann::json &objectAt(const nlohmann::json &object, const char *key)
+        {
+            static const nlohmann::json empty = nlohmann::json::object();
+            auto it = object.find(key);
+            return it != object.end() && it->is_object() ? *it : empty;
+        }
+
+        // Summary fields read from the PrinterStatusData JSON of a status event
+        StatusSlotData summarize(const nlohmann::json &status)
+        {
+            StatusSlotData data{};
+            const auto &printerStatus = objectAt(status, "printerStatus");
+            data.state = numberAt<int32_t>(printerStatus, "state", static_cast<int32_t>(PrinterState::UNKNOWN));
+            data.subState = numberAt<int32_t>(printerStatus, "subState", static_cast<int32_t>(PrinterSubState::NONE));
+            data.progress = numberAt<int32_t>(printerStatus, "progress", 0);
+
+            const auto &printStatus = objectAt(status, "printStatus");
+            data.currentLayer = numberAt<int32_t>(printStatus, "currentLayer", 0);
+            data.totalLayer = numberAt<int32_t>(printStatus, "totalLayer", 0);
+            data.printProgress = numberAt<int32_t>(printStatus, "progress", 0);
+            data.estimatedTime = numberAt<int64_t>(printStatus, "estimatedTime", 0);
+
+            const auto &temperatures = objectAt(status, "temperatureStatus");
+            const auto &extruder = objectAt(temperatures, ComponentKey(ComponentKey::EXTRUDER).name().c_str());
+            const auto &heatedBed = objectAt(temperatures, ComponentKey(ComponentKey::HEATED_BED).name().c_str());
+            const auto &chamber = objectAt(temperatures, ComponentKey(ComponentKey::CHAMBER).name().c_str());
+            data.extruderTemperature = numberAt<double>(extruder, "current", 0.0);
+            data.extruderTarget = numberAt<double>(extruder, "target", 0.0);
+            data.heatedBedTemperature = numberAt<double>(heatedBed, "current", 0.0);
+            data.heatedBedTarget = numberAt<double>(heatedBed, "target", 0.0);
+            data.chamberTemperature = numberAt<double>(chamber, "current", 0.0);
+            return data;
+        }
+
+        std::string electionName(const std::string &segmentName)
+        {
+            std::string name = segmentName;
+            name.erase(std::remove(name.begin(), name.end(), '/'), name.end());
+            return "status_" + name;
+        }
+    } // namespace
+
+    StatusSegmentWriter &StatusSegmentWriter::getInstance()
+    {
+        static StatusSegmentWriter instance;
+        return instance;
+    }
+
+    StatusSegmentWriter::~StatusSegmentWriter()
+    {
+        stop();
+    }
+
+    bool StatusSegmentWriter::start(const ElegooStatusShareConfig &config, std::string &error)
+    {
+#ifdef _WIN32
+        (void)config;
+        error = "Shared-memory status is not supported on Windows";
+        return false;
+#else
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (segment_)
+        {
+            error = "Status sharing is already running on " + segmentName_;
+            return false;
+        }
+
+        std::string name = config.segmentName.empty() ? getDefaultStatusSegmentName() : config.segmentName;
+        if (name.front() != '/')
+        {
+            name.insert(name.begin(), '/');
+        }
+        if (config.maxPrinters == 0 || config.maxPrinters > UINT32_MAX)
+        {
+            error = "Invalid printer slot count";
+            return false;
+        }
+
+        auto election = std::make_unique<ProcessMutex>(electionName(name));
+        if (!election->tryLock())
+        {
+            error = "Another process is already publishing status to " + name;
+            return false;
+        }
+
+        size_t slotSize = sizeof(StatusSlotHeader) + config.slotPayloadBytes;
+        slotSize = (slotSize + STATUS_SEGMENT_ALIGNMENT - 1) / STATUS_SEGMENT_ALIGNMENT * STATUS_SEGMENT_ALIGNMENT;
+        if (slotSize > UINT32_MAX)
+        {
+            error = "Status slot payload is too large";
+            return false;
+        }
+        auto slotCount = static_cast<uint32_t>(config.maxPrinters);
+        size_t size = statusSegmentSize(slotCount, static_cast<uint32_t>(slotSize));
+
+        // The election guarantees a segment under this name belongs to a writer that is gone
+        ::shm_unlink(name.c_str());
+        int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0)
+        {
+            error = "Failed to create shared memory " + name + ": " + std::strerror(errno);
+            return false;
+        }
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+        {
+            error = "Failed to size shared memory " + name + ": " + std::strerror(errno);
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            return false;
+        }
+        void *memory = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (memory == MAP_FAILED)
+        {
+            error = "Failed to map shared memory " + name + ": " + std::strerror(errno);
+            ::shm_unlink(name.c_str());
+            return false;
+        }
+
+        // ftruncate zero-fills the segment, which is a valid empty state for every field
+        auto *header = static_cast<StatusSegmentHeader *>(memory);
+        header->version = STATUS_SEGMENT_VERSION;
+        header->slotCount = slotCount;
+        header->slotSize = static_cast<uint32_t>(slotSize);
+        header->usedSlots.store(0, std::memory_order_relaxed);
+        header->writerPid.store(static_cast<int64_t>(::getpid()), std::memory_order_relaxed);
+        header->magic.store(STATUS_SEGMENT_MAGIC, std::memory_order_release);
+
+        election_ = std::move(election);
+        segmentName_ = name;
+        segment_ = header;
+        segmentSize_ = size;
+        slotCount_ = slotCount;
+        slotSize_ = static_cast<uint32_t>(slotSize);
+        payloadCapacity_ = slotSize - sizeof(StatusSlotHeader);
+        slots_.clear();
+        usedSlots_ = 0;
+        fullLogged_ = false;
+        enabled_ = true;
+        ELEGOO_LOG_INFO("Status sharing started, {} slots of {} bytes in {}", slotCount_, slotSize_, segmentName_);
+        return true;
+#endif
+    }
+
+    void StatusSegmentWriter::stop()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!segment_)
+        {
+            return;
+        }
+        enabled_ = false;
+        ELEGOO_LOG_INFO("Status sharing stopped, {} printers published to {}", usedSlots_, segmentName_);
+        release();
+    }
+
+    void StatusSegmentWriter::release()
+    {
+#ifndef _WIN32
+        // Readers keep their mapping of the removed segment and see that no writer updates it
+        segment_->writerPid.store(0, std::memory_order_release);
+        ::munmap(segment_, segmentSize_);
+        ::shm_unlink(segmentName_.c_str());
+#endif
+        segment_ = nullptr;
+        segmentSize_ = 0;
+        slots_.clear();
+        election_.reset();
+    }
+
+    void StatusSegmentWriter::publish(const BizEvent &event)
+    {
+        if (event.method != MethodType::ON_PRINTER_STATUS || !event.data.is_object())
+        {
+            return;
+        }
+        auto printerId = event.data.find("printerId");
+        if (printerId == event.data.end() || !printerId->is_string())
+        {
+            return;
+        }
+
+        // Encoded before taking the lock, which only covers the copy into the slot
+        thread_local std::vector<uint8_t> payload;
+        payload.clear();
+        StatusSlotData data = summarize(event.data);
+        nlohmann::json::to_msgpack(event.data, payload);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!segment_)
+        {
+            return;
+        }
+        int64_t index = findOrAssignSlot(printerId->get_ref<const std::string &>());
+        if (index < 0)
+        {
+            return;
+        }
+
+        StatusSlotHeader *slot = statusSegmentSlot(segment_, slotSize_, static_cast<uint32_t>(index));
+        data.payloadSize = payload.size() <= payloadCapacity_ ? static_cast<uint32_t>(payload.size()) : 0;
+        data.updatedAtMs = TimeUtils::getCurrentTimestamp();
+        data.updateCount = slot->data.updateCount + 1;
+
+        uint32_t sequence = slot->sequence.load(std::memory_order_relaxed);
+        slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot->data = data;
+        std::memcpy(statusSlotPayload(slot), payload.data(), data.payloadSize);
+        slot->sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    int64_t StatusSegmentWriter::findOrAssignSlot(const std::string &printerId)
+    {
+        auto it = slots_.find(printerId);
+        if (it != slots_.end())
+        {
+            return it->second;
+        }
+        if (printerId.size() >= STATUS_SLOT_PRINTER_ID_SIZE)
+        {
+            ELEGOO_LOG_WARN("Printer ID {} is too long for the status segment", StringUtils::maskString(printerId));
+            slots_.emplace(printerId, -1);
+            return -1;
+        }
+        uint32_t index = usedSlots_;
+        if (index >= slotCount_)
+        {
+            if (!fullLogged_)
+            {
+                ELEGOO_LOG_WARN("Status segment {} is full, {} printers", segmentName_, slotCount_);
+                fullLogged_ = true;
+            }
+            return -1;
+        }
+
+        StatusSlotHeader *slot = statusSegmentSlot(segment_, slotSize_, index);
+        std::memcpy(slot->printerId, printerId.c_str(), printerId.size() + 1);
+        usedSlots_ = index + 1;
+        segment_->usedSlots.store(usedSlots_, std::memory_order_release);
+        slots_.emplace(printerId, index);
+        return index;
+    }
+
+} // namespace elink
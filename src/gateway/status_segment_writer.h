@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "config.h"
+#include "elegoo_export.h"
+
+namespace elink
+{
+    struct BizEvent;
+    struct StatusSegmentHeader;
+    class ProcessMutex;
+
+    /**
+     * Publishes the latest status of every printer into the shared-memory status segment
+     *
+     * Only one process per segment name writes; the writer is elected with a ProcessMutex, so
+     * a second SDK instance fails to start instead of corrupting the segment. The segment is
+     * recreated on start, which also discards one left behind by a crashed writer. While the
+     * writer is off, publish() is skipped at the call site after a single relaxed atomic load.
+     */
+    class ELEGOO_LINK_API StatusSegmentWriter
+    {
+    public:
+        static StatusSegmentWriter &getInstance();
+
+        /**
+         * Create the segment and become its writer
+         * @param error Reason on failure
+         * @return false if already running, another process writes the segment, or it cannot be created
+         */
+        bool start(const ElegooStatusShareConfig &config, std::string &error);
+
+        /**
+         * Mark the segment as abandoned for readers and remove it
+         */
+        void stop();
+
+        static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+        /**
+         * Write a status event into its printer's slot; other events are ignored
+         */
+        void publish(const BizEvent &event);
+
+        const std::string &getSegmentName() const { return segmentName_; }
+
+    private:
+        StatusSegmentWriter() = default;
+        ~StatusSegmentWriter();
+        StatusSegmentWriter(const StatusSegmentWriter &) = delete;
+        StatusSegmentWriter &operator=(const StatusSegmentWriter &) = delete;
+
+        // Slot of printerId, assigned on first use; mutex_ must be held
+        int64_t findOrAssignSlot(const std::string &printerId);
+        void release();
+
+        static std::atomic<bool> enabled_;
+
+        std::mutex mutex_;
+        std::unique_ptr<ProcessMutex> election_;
+        std::string segmentName_;
+        StatusSegmentHeader *segment_ = nullptr;
+        size_t segmentSize_ = 0;
+        uint32_t slotCount_ = 0;
+        uint32_t slotSize_ = 0;
+        size_t payloadCapacity_ = 0;
+        std::unordered_map<std::string, int64_t> slots_; // Printer ID -> slot, -1 for IDs that do not fit
+        uint32_t usedSlots_ = 0;
+        bool fullLogged_ = false;
+    };
+
+} // namespace elink
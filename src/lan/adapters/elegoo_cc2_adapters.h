@@ -28,6 +28,22 @@
 namespace elink
 {
 
+    /**
+     * Capabilities of the CC2 models
+     *
+     * Built once from a static table keyed by model and minimum firmware version. Every printer
+     * of the same model and firmware gets the same immutable object, so attribute messages
+     * only look it up when the model or firmware changes.
+     */
+    class ElegooFdmCC2Capabilities
+    {
+    public:
+        /**
+         * @return Capabilities of the most specific row matching the model and firmware, never nullptr
+         */
+        static std::shared_ptr<const PrinterCapabilities> lookup(const std::string &model, const std::string &firmwareVersion);
+    };
+
     /**
      * Elegoo FDM V1 Printer Adapter
      * Supports message conversion for Elegoo FDM V1 series 3D printers
@@ -35,7 +51,7 @@ namespace elink
     class ElegooFdmCC2MessageAdapter : public BaseMessageAdapter
     {
     public:
-        explicit ElegooFdmCC2MessageAdapter(const PrinterInfo &printerInfo);
+        explicit ElegooFdmCC2MessageAdapter(std::shared_ptr<SharedPrinterInfo> printerInfo);
 
         // Implement interface methods
         PrinterBizRequest<std::string> convertRequest(MethodType method, const nlohmann::json &request, std::chrono::milliseconds timeout) override;
@@ -68,6 +84,8 @@ namespace elink
             return cachedFullStatusJson_;
         }
         void clearStatusCache() override;
+        bool hasLiveStatusCache() const override;
+        size_t getStatusCacheMemoryUsage() const override;
     private:
         // Command mapping related data - optimized unified management
         static const std::vector<std::pair<MethodType, int>> COMMAND_MAPPING_TABLE;
@@ -78,18 +96,24 @@ namespace elink
         ELINK_ERROR_CODE convertRequestErrorToElegooError(int code) const;
 
         std::optional<PrinterStatusData> handlePrinterStatus(MethodType method, const nlohmann::json &printerJson);
-        std::optional<PrinterAttributesData> handlePrinterAttributes(const nlohmann::json &printerJson);
+        /**
+         * Apply the identity fields of an attributes message and build the attributes
+         * @param onlyIfChanged Return nothing if neither the printer information nor the capabilities
+         *                      changed since the attributes were last built with this flag
+         */
+        std::optional<PrinterAttributesData> handlePrinterAttributes(const nlohmann::json &printerJson, bool onlyIfChanged = false);
         std::optional<CanvasStatus> handleCanvasStatus(const nlohmann::json &result);
 
         // Status event continuity check related methods
         bool checkStatusEventContinuity(int currentId);
         // sendMessageToPrinter method inherited from base class
 
+    protected:
         // Status cache and differential update related methods
         void cacheFullPrinterStatusJson(const nlohmann::json &fullStatusResult);
         nlohmann::json mergeStatusUpdateJson(const nlohmann::json &deltaStatusResult);
-        
 
+    private:
         // Status event continuity monitoring related member variables
         mutable std::mutex statusSequenceMutex_;
         long long lastStatusEventId_ = -1; // ID of the last status event
@@ -103,6 +127,14 @@ namespace elink
         mutable std::mutex statusCacheMutex_;
         nlohmann::json cachedFullStatusJson_; // Cached full status original JSON (content of the result field)
         bool hasFullStatusCache_ = false;     // Whether there is a valid full status cache
+
+        // Capabilities from ElegooFdmCC2Capabilities and what the last attributes event carried
+        std::mutex attributesMutex_;
+        std::shared_ptr<const PrinterCapabilities> capabilities_;
+        std::string capabilitiesModel_;
+        std::string capabilitiesFirmware_;
+        uint64_t publishedInfoVersion_ = 0; // SharedPrinterInfo version, 0 until published
+        std::shared_ptr<const PrinterCapabilities> publishedCapabilities_;
     };
     /**
      * Elegoo Printer Discovery Strategy
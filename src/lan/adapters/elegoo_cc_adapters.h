@@ -15,7 +15,7 @@ namespace elink
     class ElegooFdmCCMessageAdapter : public BaseMessageAdapter
     {
     public:
-        explicit ElegooFdmCCMessageAdapter(const PrinterInfo &printerInfo);
+        explicit ElegooFdmCCMessageAdapter(std::shared_ptr<SharedPrinterInfo> printerInfo);
 
         // Implement interface methods
         PrinterBizRequest<std::string> convertRequest(MethodType method, const nlohmann::json &request, std::chrono::milliseconds timeout) override;
@@ -64,8 +64,8 @@ namespace elink
 
     // ========== ElegooFdmCCMessageAdapter Implementation ==========
 
-    ElegooFdmCCMessageAdapter::ElegooFdmCCMessageAdapter(const PrinterInfo &printerInfo)
-        : BaseMessageAdapter(printerInfo)
+    ElegooFdmCCMessageAdapter::ElegooFdmCCMessageAdapter(std::shared_ptr<SharedPrinterInfo> printerInfo)
+        : BaseMessageAdapter(std::move(printerInfo))
     {
     }
 
@@ -85,7 +85,7 @@ namespace elink
 
             // V1 printer message format
             printerMessage["RequestID"] = printerRequestId;
-            printerMessage["MainboardID"] = request.value("printerId", printerInfo_.printerId);
+            printerMessage["MainboardID"] = request.value("printerId", printerId_);
             printerMessage["TimeStamp"] = std::chrono::duration_cast<std::chrono::milliseconds>(
                                               std::chrono::steady_clock::now().time_since_epoch())
                                               .count();
@@ -250,7 +250,8 @@ namespace elink
             {
                 auto nameData = request.get<UpdatePrinterNameParams>();
                 // Update local printer info
-                printerInfo_.name = nameData.printerName;
+                printerInfo_->update([&](PrinterInfo &info)
+                                     { info.name = nameData.printerName; });
 
                 bizRequest.code = ELINK_ERROR_CODE::OPERATION_NOT_IMPLEMENTED;
                 bizRequest.message = "Command not implemented";
@@ -286,7 +287,8 @@ namespace elink
         {
 
             MethodType method = MethodType::UNKNOWN;
-            auto printerJson = parseJson(printerResponse);
+            auto printerDocument = parseMessage(printerResponse);
+            const nlohmann::json &printerJson = *printerDocument;
             if (printerJson.empty())
             {
                 return PrinterBizResponse<nlohmann::json>::error(ELINK_ERROR_CODE::PRINTER_INVALID_RESPONSE, "Invalid printer response format");
@@ -338,20 +340,17 @@ namespace elink
                 return PrinterBizResponse<nlohmann::json>::error(ELINK_ERROR_CODE::PRINTER_INVALID_RESPONSE, "No request mapping found for printer response");
             }
 
-            if (printerJson.contains("Data") && printerJson["Data"].is_object())
-            {
-                printerJson = printerJson["Data"];
-            }
-            else
+            if (!printerJson.contains("Data") || !printerJson["Data"].is_object())
             {
                 return PrinterBizResponse<nlohmann::json>::error(ELINK_ERROR_CODE::PRINTER_INVALID_RESPONSE, "No Data field in printer response");
             }
+            const nlohmann::json &dataJson = printerJson["Data"];
 
             // Try to extract ID from printer response and find corresponding standard request ID
             std::string printerResponseId = "";
-            if (printerJson.contains("RequestID"))
+            if (dataJson.contains("RequestID"))
             {
-                printerResponseId = JsonUtils::safeGetString(printerJson, "RequestID", "");
+                printerResponseId = JsonUtils::safeGetString(dataJson, "RequestID", "");
             }
 
             if (printerResponseId.empty())
@@ -382,9 +381,9 @@ namespace elink
                 return PrinterBizResponse<nlohmann::json>::error(ELINK_ERROR_CODE::PRINTER_INVALID_RESPONSE, "No request mapping found for printer response");
             }
 
-            if (printerJson.contains("Data") && printerJson["Data"].is_object())
+            if (dataJson.contains("Data") && dataJson["Data"].is_object())
             {
-                auto result = printerJson["Data"];
+                auto result = dataJson["Data"];
                 // if(!result.contains("Ack") ){
                 //     result["Ack"] = 0;
                 // }
@@ -464,7 +463,8 @@ namespace elink
     {
         try
         {
-            auto printerJson = parseJson(printerMessage);
+            auto printerDocument = parseMessage(printerMessage);
+            const nlohmann::json &printerJson = *printerDocument;
             if (printerJson.empty())
             {
                 ELEGOO_LOG_ERROR("Invalid printer event format: {}", printerMessage);
@@ -474,7 +474,7 @@ namespace elink
             PrinterBizEvent event;
             event.method = MethodType::UNKNOWN;
             nlohmann::json data;
-            data["printerId"] = printerInfo_.printerId;
+            data["printerId"] = printerId_;
 
             // V1 printer event message parsing
             if (printerJson.contains("Status"))
@@ -503,7 +503,8 @@ namespace elink
         std::vector<std::string> messageTypes;
         try
         {
-            auto json = parseJson(printerMessage);
+            auto document = parseMessage(printerMessage);
+            const nlohmann::json &json = *document;
             if (json.contains("Topic"))
             {
                 std::string type = json["Topic"];
@@ -561,7 +562,7 @@ namespace elink
     }
     PrinterStatusData ElegooFdmCCMessageAdapter::handlePrinterStatus(const nlohmann::json &printerJson) const
     {
-        PrinterStatusData printerStatusData(printerInfo_.printerId);
+        PrinterStatusData printerStatusData(printerId_);
         if (!printerJson.contains("Status") || !printerJson["Status"].is_object())
         {
             ELEGOO_LOG_ERROR("Invalid printer status format: {}", printerJson.dump());
@@ -799,34 +800,34 @@ namespace elink
         if (statusJson.contains("CurrentFanSpeed") && statusJson["CurrentFanSpeed"].is_object())
         {
             auto currentFanSpeed = statusJson["CurrentFanSpeed"];
-            printerStatusData.fanStatus["model"].speed = JsonUtils::safeGetInt(currentFanSpeed, "ModelFan", 0);
-            printerStatusData.fanStatus["aux"].speed = JsonUtils::safeGetInt(currentFanSpeed, "AuxiliaryFan", 0);
-            printerStatusData.fanStatus["chassis"].speed = JsonUtils::safeGetInt(currentFanSpeed, "BoxFan", 0);
+            printerStatusData.fanStatus[ComponentKey::FAN_MODEL].speed = JsonUtils::safeGetInt(currentFanSpeed, "ModelFan", 0);
+            printerStatusData.fanStatus[ComponentKey::FAN_AUX].speed = JsonUtils::safeGetInt(currentFanSpeed, "AuxiliaryFan", 0);
+            printerStatusData.fanStatus[ComponentKey::FAN_CHASSIS].speed = JsonUtils::safeGetInt(currentFanSpeed, "BoxFan", 0);
         }
         if (statusJson.contains("LightStatus") && statusJson["LightStatus"].is_object())
         {
             auto lightStatus = statusJson["LightStatus"];
-            printerStatusData.lightStatus["main"].brightness = JsonUtils::safeGetInt(lightStatus, "MainLight", 0); // Main light brightness
-            printerStatusData.lightStatus["main"].connected = true;
+            printerStatusData.lightStatus[ComponentKey::LIGHT_MAIN].brightness = JsonUtils::safeGetInt(lightStatus, "MainLight", 0); // Main light brightness
+            printerStatusData.lightStatus[ComponentKey::LIGHT_MAIN].connected = true;
         }
 
-        printerStatusData.temperatureStatus["heatedBed"].current = JsonUtils::safeGetDouble(statusJson, "TempOfHotbed", 0.0f);
-        printerStatusData.temperatureStatus["heatedBed"].target = JsonUtils::safeGetDouble(statusJson, "TempTargetHotbed", 0.0f);
+        printerStatusData.temperatureStatus[ComponentKey::HEATED_BED].current = JsonUtils::safeGetDouble(statusJson, "TempOfHotbed", 0.0f);
+        printerStatusData.temperatureStatus[ComponentKey::HEATED_BED].target = JsonUtils::safeGetDouble(statusJson, "TempTargetHotbed", 0.0f);
 
-        printerStatusData.temperatureStatus["extruder"].current = JsonUtils::safeGetDouble(statusJson, "TempOfNozzle", 0.0f);
-        printerStatusData.temperatureStatus["extruder"].target = JsonUtils::safeGetDouble(statusJson, "TempTargetNozzle", 0.0f);
+        printerStatusData.temperatureStatus[ComponentKey::EXTRUDER].current = JsonUtils::safeGetDouble(statusJson, "TempOfNozzle", 0.0f);
+        printerStatusData.temperatureStatus[ComponentKey::EXTRUDER].target = JsonUtils::safeGetDouble(statusJson, "TempTargetNozzle", 0.0f);
 
-        printerStatusData.temperatureStatus["chamber"].current = JsonUtils::safeGetDouble(statusJson, "TempOfBox", 0.0f);
-        printerStatusData.temperatureStatus["chamber"].target = JsonUtils::safeGetDouble(statusJson, "TempTargetBox", 0.0f);
+        printerStatusData.temperatureStatus[ComponentKey::CHAMBER].current = JsonUtils::safeGetDouble(statusJson, "TempOfBox", 0.0f);
+        printerStatusData.temperatureStatus[ComponentKey::CHAMBER].target = JsonUtils::safeGetDouble(statusJson, "TempTargetBox", 0.0f);
 
-        printerStatusData.storageStatus["local"].connected = true; // Local storage is always available
+        printerStatusData.storageStatus[ComponentKey::STORAGE_LOCAL].connected = true; // Local storage is always available
         printerStatusData.printerStatus.progress = printerStatusData.printStatus.progress;
         printerStatusData.printerStatus.supportProgress = false;
         return printerStatusData;
     }
     PrinterAttributesData ElegooFdmCCMessageAdapter::handlePrinterAttributes(const nlohmann::json &printerJson) const
     {
-        PrinterAttributesData attributesEvent(printerInfo_);
+        PrinterAttributesData attributesEvent(*printerInfo_->get());
         if (printerJson.contains("Attributes") == false || printerJson["Attributes"].is_object() == false)
         {
             ELEGOO_LOG_ERROR("Invalid printer attributes format: {}", printerJson.dump());
@@ -885,8 +886,10 @@ namespace elink
         attributesEvent.capabilities.printCapabilities.supportsFilamentMapping = supportsMultiFilament;
         attributesEvent.capabilities.systemCapabilities.supportsMultiFilament = supportsMultiFilament;
 
-        printerInfo_.mainboardId = mainboardId; // Update mainboard ID
-        printerInfo_.firmwareVersion = attributesEvent.firmwareVersion;
+        printerInfo_->update([&](PrinterInfo &info)
+                             {
+                                 info.mainboardId = mainboardId; // Update mainboard ID
+                                 info.firmwareVersion = attributesEvent.firmwareVersion; });
         return attributesEvent;
     }
     std::optional<CanvasStatus> ElegooFdmCCMessageAdapter::handleCanvasStatus(const nlohmann::json &result) const
@@ -1004,7 +1007,7 @@ namespace elink
         // },
         // "Topic": "sdcp/request/${MainboardID}"  // Message type
         nlohmann::json body;
-        body["Id"] = printerInfo_.mainboardId; // Printer ID
+        body["Id"] = printerInfo_->get()->mainboardId; // Printer ID
         body["Topic"] = "";
         body["Data"] = nlohmann::json::object();
         return body;
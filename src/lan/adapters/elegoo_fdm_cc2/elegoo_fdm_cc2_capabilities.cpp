@@ -0,0 +1,121 @@
+#include "adapters/elegoo_cc2_adapters.h"
+#include <cstdlib>
+#include <vector>
+
+namespace elink
+{
+    namespace
+    {
+        // Capabilities shared by the CC2 models released so far
+        PrinterCapabilities baseCapabilities()
+        {
+            PrinterCapabilities capabilities;
+            capabilities.cameraCapabilities.supportsCamera = true;
+            capabilities.cameraCapabilities.supportsTimeLapse = true;
+            capabilities.fanComponents = {
+                {"model", true, 0, 100, true},
+                {"chamber", true, 0, 100, true},
+                {"aux", true, 0, 100, true}};
+
+            auto temperature = [](const char *name, double maxTemperature)
+            {
+                TemperatureComponent component;
+                component.name = name;
+                component.controllable = true;
+                component.supportsTemperatureReading = true;
+                component.minTemperature = 0.0;
+                component.maxTemperature = maxTemperature;
+                return component;
+            };
+            capabilities.temperatureComponents = {
+                temperature("extruder", 300.0),
+                temperature("heatedBed", 120.0),
+                temperature("chamber", 100.0)};
+
+            capabilities.lightComponents = {
+                {"main", "singleColor", 0, 1},
+            };
+            capabilities.storageComponents = {
+                {"local", false},
+                {"udisk", true},
+                {"sdcard", true}};
+
+            capabilities.systemCapabilities.canGetDiskInfo = true;
+            capabilities.systemCapabilities.canSetPrinterName = true;
+            capabilities.systemCapabilities.supportsMultiFilament = true;
+            capabilities.printCapabilities.supportsAutoBedLeveling = true;
+            capabilities.printCapabilities.supportsTimeLapse = true;
+            capabilities.printCapabilities.supportsHeatedBedSwitching = true;
+            capabilities.printCapabilities.supportsFilamentMapping = true;
+            capabilities.printCapabilities.supportsAutoRefill = true;
+            return capabilities;
+        }
+
+        struct CapabilitiesRow
+        {
+            std::string model;       // Empty for any model
+            std::string minFirmware; // Empty for any firmware
+            std::shared_ptr<const PrinterCapabilities> capabilities;
+        };
+
+        /**
+         * Rows are matched most specific first: a model row before an any-model row, and among
+         * those the highest minimum firmware the printer has reached. Add a row when a model or
+         * firmware release changes what the printer supports.
+         */
+        const std::vector<CapabilitiesRow> &capabilitiesTable()
+        {
+            static const std::vector<CapabilitiesRow> table = {
+                {"", "", std::make_shared<const PrinterCapabilities>(baseCapabilities())},
+            };
+            return table;
+        }
+
+        /**
+         * Compare dotted numeric versions, e.g. "1.1.25.3"; missing parts count as 0
+         */
+        int compareVersions(const std::string &a, const std::string &b)
+        {
+            const char *pa = a.c_str();
+            const char *pb = b.c_str();
+            while (*pa || *pb)
+            {
+                char *endA;
+                char *endB;
+                unsigned long partA = std::strtoul(pa, &endA, 10);
+                unsigned long partB = std::strtoul(pb, &endB, 10);
+                if (partA != partB)
+                {
+                    return partA < partB ? -1 : 1;
+                }
+                pa = *endA == '.' ? endA + 1 : endA + (*endA ? 1 : 0);
+                pb = *endB == '.' ? endB + 1 : endB + (*endB ? 1 : 0);
+            }
+            return 0;
+        }
+    } // namespace
+
+    std::shared_ptr<const PrinterCapabilities> ElegooFdmCC2Capabilities::lookup(const std::string &model,
+                                                                               const std::string &firmwareVersion)
+    {
+        const CapabilitiesRow *best = nullptr;
+        for (const auto &row : capabilitiesTable())
+        {
+            if (!row.model.empty() && row.model != model)
+            {
+                continue;
+            }
+            if (!row.minFirmware.empty() && compareVersions(firmwareVersion, row.minFirmware) < 0)
+            {
+                continue;
+            }
+            if (!best || (best->model.empty() && !row.model.empty()) ||
+                (best->model.empty() == row.model.empty() && compareVersions(row.minFirmware, best->minFirmware) > 0))
+            {
+                best = &row;
+            }
+        }
+        return best ? best->capabilities : capabilitiesTable().front().capabilities;
+    }
+
+} // namespace elink
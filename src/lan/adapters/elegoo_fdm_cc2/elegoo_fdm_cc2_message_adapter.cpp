@@ -11,8 +11,8 @@ namespace elink
 {
     // ========== ElegooFdmCC2MessageAdapter Implementation ==========
 
-    ElegooFdmCC2MessageAdapter::ElegooFdmCC2MessageAdapter(const PrinterInfo &printerInfo)
-        : BaseMessageAdapter(printerInfo)
+    ElegooFdmCC2MessageAdapter::ElegooFdmCC2MessageAdapter(std::shared_ptr<SharedPrinterInfo> printerInfo)
+        : BaseMessageAdapter(std::move(printerInfo))
     {
     }
 
@@ -237,7 +237,8 @@ namespace elink
         try
         {
             MethodType method = MethodType::UNKNOWN;
-            auto printerJson = parseJson(printerResponse);
+            auto printerDocument = parseMessage(printerResponse);
+            const nlohmann::json &printerJson = *printerDocument;
             if (printerJson.empty())
             {
                 return PrinterBizResponse<nlohmann::json>::error(ELINK_ERROR_CODE::PRINTER_INVALID_RESPONSE, "Invalid printer response format");
@@ -299,7 +300,7 @@ namespace elink
                             {
                                 response.code = ELINK_ERROR_CODE::PRINTER_INVALID_RESPONSE; // Default error
                                 response.message = "Failed to parse printer status";
-                                ELEGOO_LOG_WARN("Failed to handle printer status for printer {}", StringUtils::maskString(printerInfo_.printerId));
+                                ELEGOO_LOG_WARN("Failed to handle printer status for printer {}", StringUtils::maskString(printerId_));
                             }
                             break;
                         }
@@ -314,7 +315,7 @@ namespace elink
                             {
                                 response.code = ELINK_ERROR_CODE::PRINTER_INVALID_RESPONSE; // Default error
                                 response.message = "No canvas_info in response";
-                                ELEGOO_LOG_WARN("No canvas_info in response for printer {}", StringUtils::maskString(printerInfo_.printerId));
+                                ELEGOO_LOG_WARN("No canvas_info in response for printer {}", StringUtils::maskString(printerId_));
                             }
                             break;
                         }
@@ -361,7 +362,8 @@ namespace elink
     {
         try
         {
-            auto printerJson = parseJson(printerMessage);
+            auto printerDocument = parseMessage(printerMessage);
+            const nlohmann::json &printerJson = *printerDocument;
             if (printerJson.empty())
             {
                 return PrinterBizEvent();
@@ -389,20 +391,20 @@ namespace elink
                 }
                 else
                 {
-                    ELEGOO_LOG_WARN("Failed to handle printer status for printer {}", StringUtils::maskString(printerInfo_.printerId));
+                    ELEGOO_LOG_WARN("Failed to handle printer status for printer {}", StringUtils::maskString(printerId_));
                 }
                 break;
             }
             case MethodType::GET_PRINTER_ATTRIBUTES:
-            {
-                event.method = MethodType::ON_PRINTER_ATTRIBUTES;
-                event.data = handlePrinterAttributes(printerJson);
-                break;
-            }
             case MethodType::ON_PRINTER_ATTRIBUTES:
             {
-                event.method = MethodType::ON_PRINTER_ATTRIBUTES;
-                event.data = handlePrinterAttributes(printerJson);
+                // Attributes repeat unchanged on every request and push; only changes become events
+                auto attributes = handlePrinterAttributes(printerJson, true);
+                if (attributes.has_value())
+                {
+                    event.method = MethodType::ON_PRINTER_ATTRIBUTES;
+                    event.data = attributes.value();
+                }
                 break;
             }
             default:
@@ -422,7 +424,8 @@ namespace elink
         std::vector<std::string> messageTypes;
         try
         {
-            auto json = parseJson(printerMessage);
+            auto document = parseMessage(printerMessage);
+            const nlohmann::json &json = *document;
             if (json.contains("method"))
             {
                 int method = json.value("method", -1);
@@ -450,82 +453,62 @@ namespace elink
         }
         return messageTypes;
     }
-    std::optional<PrinterAttributesData> ElegooFdmCC2MessageAdapter::handlePrinterAttributes(const nlohmann::json &printerJson)
+    std::optional<PrinterAttributesData> ElegooFdmCC2MessageAdapter::handlePrinterAttributes(const nlohmann::json &printerJson, bool onlyIfChanged)
     {
-        PrinterAttributesData printerAttributes(printerInfo_);
-        // Printer status update event
-        if (printerJson.contains("result"))
+        auto info = printerInfo_->get();
+        if (printerJson.contains("result") && printerJson["result"].is_object())
         {
-            nlohmann::json result = printerJson["result"];
-            if (result.contains("machine_model"))
+            const nlohmann::json &result = printerJson["result"];
+            std::string model = JsonUtils::safeGet(result, "machine_model", info->model);
+            std::string firmwareVersion = info->firmwareVersion;
+            auto softwareVersion = result.find("software_version");
+            if (softwareVersion != result.end() && softwareVersion->is_object() && softwareVersion->contains("ota_version"))
             {
-                printerAttributes.model = JsonUtils::safeGet(result, "machine_model", printerInfo_.model);
+                firmwareVersion = JsonUtils::safeGet(*softwareVersion, "ota_version", std::string());
             }
-            
-            if (result.contains("software_version"))
+            std::string serialNumber = result.contains("sn") ? JsonUtils::safeGet(result, "sn", std::string()) : info->serialNumber;
+            std::string mainboardId = result.contains("sn") ? serialNumber : info->mainboardId;
+            std::string name = result.contains("hostname") ? JsonUtils::safeGet(result, "hostname", std::string()) : info->name;
+
+            // Per-printer fields; publishing a new snapshot only when they differ keeps its version stable
+            if (model != info->model || firmwareVersion != info->firmwareVersion || serialNumber != info->serialNumber ||
+                mainboardId != info->mainboardId || name != info->name)
             {
-                auto software_version = result["software_version"];
-                if (software_version.is_object())
-                {
-                    if (software_version.contains("ota_version"))
-                    {
-                        printerAttributes.firmwareVersion = JsonUtils::safeGet(software_version, "ota_version", std::string());
-                    }
-                }
+                printerInfo_->update([&](PrinterInfo &printerInfo)
+                                     {
+                                         printerInfo.name = name;
+                                         printerInfo.serialNumber = serialNumber;
+                                         printerInfo.firmwareVersion = firmwareVersion;
+                                         printerInfo.mainboardId = mainboardId;
+                                         printerInfo.model = model; });
+                info = printerInfo_->get();
             }
+        }
+        uint64_t infoVersion = printerInfo_->getVersion();
 
-            if (result.contains("sn"))
+        std::shared_ptr<const PrinterCapabilities> capabilities;
+        {
+            std::lock_guard<std::mutex> lock(attributesMutex_);
+            if (!capabilities_ || capabilitiesModel_ != info->model || capabilitiesFirmware_ != info->firmwareVersion)
             {
-                printerAttributes.serialNumber = JsonUtils::safeGet(result, "sn", std::string());
-                printerAttributes.mainboardId = printerAttributes.serialNumber;
+                capabilities_ = ElegooFdmCC2Capabilities::lookup(info->model, info->firmwareVersion);
+                capabilitiesModel_ = info->model;
+                capabilitiesFirmware_ = info->firmwareVersion;
             }
-
-            if (result.contains("hostname"))
+            capabilities = capabilities_;
+            if (onlyIfChanged)
             {
-                printerAttributes.name = JsonUtils::safeGet(result, "hostname", std::string());
+                if (infoVersion == publishedInfoVersion_ && capabilities == publishedCapabilities_)
+                {
+                    return std::nullopt;
+                }
+                publishedInfoVersion_ = infoVersion;
+                publishedCapabilities_ = capabilities;
             }
-
-            printerInfo_.name = printerAttributes.name;
-            printerInfo_.serialNumber = printerAttributes.serialNumber;
-            printerInfo_.firmwareVersion = printerAttributes.firmwareVersion;
-            printerInfo_.mainboardId = printerAttributes.mainboardId;
-            printerInfo_.model = printerAttributes.model;
         }
-        printerAttributes.capabilities.cameraCapabilities.supportsCamera = true;    // Assume printer supports camera
-        printerAttributes.capabilities.cameraCapabilities.supportsTimeLapse = true; // Assume printer
-        printerAttributes.capabilities.fanComponents = {
-            {"model", true, 0, 100, true},
-            // {"heatsink", true, 0, 100, true},
-            // {"controller", true, 0, 100, true},
-            {"chamber", true, 0, 100, true},
-            {"aux", true, 0, 100, true}};
-        printerAttributes.capabilities.temperatureComponents = {
-            {"extruder", true, 0, 300, true},
-            {"heatedBed", true, 0, 120, true},
-            {"chamber", true, 0, 100, true}};
-
-        printerAttributes.capabilities.lightComponents = {
-            {"main", "singleColor", 0, 1},
-        };
-        printerAttributes.capabilities.storageComponents = {
-            {"local", false},
-            {
-                "udisk",
-                true,
-            },
-            {
-                "sdcard",
-                true,
-            }};
-
-        printerAttributes.capabilities.systemCapabilities.canGetDiskInfo = true;
-        printerAttributes.capabilities.systemCapabilities.canSetPrinterName = true;
-        printerAttributes.capabilities.systemCapabilities.supportsMultiFilament = true;
-        printerAttributes.capabilities.printCapabilities.supportsAutoBedLeveling = true;
-        printerAttributes.capabilities.printCapabilities.supportsTimeLapse = true;
-        printerAttributes.capabilities.printCapabilities.supportsHeatedBedSwitching = true;
-        printerAttributes.capabilities.printCapabilities.supportsFilamentMapping = true;
-        printerAttributes.capabilities.printCapabilities.supportsAutoRefill = true;
+
+        PrinterAttributesData printerAttributes(*info);
+        printerAttributes.capabilities = *capabilities;
         return printerAttributes;
     }
 
@@ -562,7 +545,7 @@ namespace elink
         }
 
         // Parse printer status from merged JSON
-        PrinterStatusData finalStatus(printerInfo_.printerId);
+        PrinterStatusData finalStatus(printerId_);
         bool isFullStatusUpdate = false;
 
         // Determine if it is a full status update
@@ -615,11 +598,11 @@ namespace elink
                 if (!hasFullStatusCache_)
                 {
                     // If no cached full status, return empty BizEvent
-                    ELEGOO_LOG_WARN("No cached full status available, cannot merge with delta update for printer {}", StringUtils::maskString(printerInfo_.printerId));
+                    ELEGOO_LOG_WARN("No cached full status available, cannot merge with delta update for printer {}", StringUtils::maskString(printerId_));
                     return std::optional<PrinterStatusData>();
                 }
                 finalResult = mergeStatusUpdateJson(result);
-                ELEGOO_LOG_TRACE("Merged delta status JSON with cached full status for printer {}", StringUtils::maskString(printerInfo_.printerId));
+                ELEGOO_LOG_TRACE("Merged delta status JSON with cached full status for printer {}", StringUtils::maskString(printerId_));
             }
             // Parse machine status
             if (finalResult.contains("machine_status") && finalResult["machine_status"].is_object())
@@ -970,7 +953,7 @@ namespace elink
                 TemperatureStatus extruderTemp;
                 extruderTemp.current = JsonUtils::safeGet(extruder, "temperature", 0.0f);
                 extruderTemp.target = JsonUtils::safeGet(extruder, "target", 0.0f);
-                finalStatus.temperatureStatus["extruder"] = extruderTemp;
+                finalStatus.temperatureStatus[ComponentKey::EXTRUDER] = extruderTemp;
             }
 
             if (finalResult.contains("heater_bed") && finalResult["heater_bed"].is_object())
@@ -979,7 +962,7 @@ namespace elink
                 TemperatureStatus bedTemp;
                 bedTemp.current = JsonUtils::safeGet(heaterBed, "temperature", 0.0f);
                 bedTemp.target = JsonUtils::safeGet(heaterBed, "target", 0.0f);
-                finalStatus.temperatureStatus["heatedBed"] = bedTemp;
+                finalStatus.temperatureStatus[ComponentKey::HEATED_BED] = bedTemp;
             }
 
             if (finalResult.contains("ztemperature_sensor") && finalResult["ztemperature_sensor"].is_object())
@@ -989,7 +972,7 @@ namespace elink
                 sensorTemp.current = JsonUtils::safeGet(zSensor, "temperature", 0.0f);
                 sensorTemp.highest = JsonUtils::safeGet(zSensor, "measured_max_temperature", 0.0f);
                 sensorTemp.lowest = JsonUtils::safeGet(zSensor, "measured_min_temperature", 0.0f);
-                finalStatus.temperatureStatus["chamber"] = sensorTemp;
+                finalStatus.temperatureStatus[ComponentKey::CHAMBER] = sensorTemp;
             }
 
             // Parse fan info
@@ -1002,7 +985,7 @@ namespace elink
                     FanStatus fanStatus;
                     fanStatus.speed = JsonUtils::safeGet(fan, "speed", 0);
                     fanStatus.rpm = JsonUtils::safeGet(fan, "rpm", 0);
-                    finalStatus.fanStatus["model"] = fanStatus;
+                    finalStatus.fanStatus[ComponentKey::FAN_MODEL] = fanStatus;
                 }
 
                 if (fans.contains("heater_fan") && fans["heater_fan"].is_object())
@@ -1011,7 +994,7 @@ namespace elink
                     FanStatus fanStatus;
                     fanStatus.speed = JsonUtils::safeGet(heaterFan, "speed", 0);
                     fanStatus.rpm = JsonUtils::safeGet(heaterFan, "rpm", 0);
-                    finalStatus.fanStatus["heatsink"] = fanStatus;
+                    finalStatus.fanStatus[ComponentKey::FAN_HEATSINK] = fanStatus;
                 }
 
                 if (fans.contains("controller_fan") && fans["controller_fan"].is_object())
@@ -1020,7 +1003,7 @@ namespace elink
                     FanStatus fanStatus;
                     fanStatus.speed = JsonUtils::safeGet(controllerFan, "speed", 0);
                     fanStatus.rpm = JsonUtils::safeGet(controllerFan, "rpm", 0);
-                    finalStatus.fanStatus["controller"] = fanStatus;
+                    finalStatus.fanStatus[ComponentKey::FAN_CONTROLLER] = fanStatus;
                 }
 
                 if (fans.contains("box_fan") && fans["box_fan"].is_object())
@@ -1029,7 +1012,7 @@ namespace elink
                     FanStatus fanStatus;
                     fanStatus.speed = JsonUtils::safeGet(boxFan, "speed", 0);
                     fanStatus.rpm = JsonUtils::safeGet(boxFan, "rpm", 0);
-                    finalStatus.fanStatus["chassis"] = fanStatus;
+                    finalStatus.fanStatus[ComponentKey::FAN_CHASSIS] = fanStatus;
                 }
 
                 if (fans.contains("aux_fan") && fans["aux_fan"].is_object())
@@ -1038,15 +1021,15 @@ namespace elink
                     FanStatus fanStatus;
                     fanStatus.speed = JsonUtils::safeGet(auxFan, "speed", 0);
                     fanStatus.rpm = JsonUtils::safeGet(auxFan, "rpm", 0);
-                    finalStatus.fanStatus["aux"] = fanStatus;
+                    finalStatus.fanStatus[ComponentKey::FAN_AUX] = fanStatus;
                 }
             }
 
             if (finalResult.contains("led") && finalResult["led"].is_object())
             {
                 auto led = finalResult["led"];
-                finalStatus.lightStatus["main"].brightness = JsonUtils::safeGet(led, "status", 0);
-                finalStatus.lightStatus["main"].connected = true; // Assume main light is always connected
+                finalStatus.lightStatus[ComponentKey::LIGHT_MAIN].brightness = JsonUtils::safeGet(led, "status", 0);
+                finalStatus.lightStatus[ComponentKey::LIGHT_MAIN].connected = true; // Assume main light is always connected
             }
 
             // Parse movement and axis info
@@ -1198,7 +1181,7 @@ namespace elink
         std::lock_guard<std::mutex> lock(statusCacheMutex_);
         cachedFullStatusJson_ = fullStatusResult;
         hasFullStatusCache_ = true;
-        ELEGOO_LOG_TRACE("Cached full printer status JSON for printer {}", StringUtils::maskString(printerInfo_.printerId));
+        ELEGOO_LOG_TRACE("Cached full printer status JSON for printer {}", StringUtils::maskString(printerId_));
     }
 
     nlohmann::json ElegooFdmCC2MessageAdapter::mergeStatusUpdateJson(const nlohmann::json &deltaStatusResult)
@@ -1246,7 +1229,24 @@ namespace elink
         std::lock_guard<std::mutex> lock(statusCacheMutex_);
         hasFullStatusCache_ = false;
         cachedFullStatusJson_ = nlohmann::json::object();
-        ELEGOO_LOG_DEBUG("Cleared status cache for printer {}", StringUtils::maskString(printerInfo_.printerId));
+        ELEGOO_LOG_DEBUG("Cleared status cache for printer {}", StringUtils::maskString(printerId_));
+
+        // Publish the attributes again after a reconnect
+        std::lock_guard<std::mutex> attributesLock(attributesMutex_);
+        publishedInfoVersion_ = 0;
+        publishedCapabilities_ = nullptr;
+    }
+
+    bool ElegooFdmCC2MessageAdapter::hasLiveStatusCache() const
+    {
+        std::lock_guard<std::mutex> lock(statusCacheMutex_);
+        return hasFullStatusCache_;
+    }
+
+    size_t ElegooFdmCC2MessageAdapter::getStatusCacheMemoryUsage() const
+    {
+        std::lock_guard<std::mutex> lock(statusCacheMutex_);
+        return JsonUtils::estimateMemoryUsage(cachedFullStatusJson_);
     }
 
     int ElegooFdmCC2MessageAdapter::mapCommandType(MethodType command)
@@ -1276,7 +1276,7 @@ namespace elink
     nlohmann::json ElegooFdmCC2MessageAdapter::createStandardBody() const
     {
         nlohmann::json body;
-        body["id"] = printerInfo_.printerId; // Printer ID
+        body["id"] = printerId_; // Printer ID
         return body;
     }
 
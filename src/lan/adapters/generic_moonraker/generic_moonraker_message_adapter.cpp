@@ -12,8 +12,8 @@
 namespace elink
 {
 
-    GenericMoonrakerMessageAdapter::GenericMoonrakerMessageAdapter(const PrinterInfo &printerInfo)
-        : BaseMessageAdapter(printerInfo)
+    GenericMoonrakerMessageAdapter::GenericMoonrakerMessageAdapter(std::shared_ptr<SharedPrinterInfo> printerInfo)
+        : BaseMessageAdapter(std::move(printerInfo))
     {
     }
 
@@ -90,7 +90,8 @@ namespace elink
             {
                 auto nameData = request.get<UpdatePrinterNameParams>();
                 // Update local printer info
-                printerInfo_.name = nameData.printerName;
+                printerInfo_->update([&](PrinterInfo &info)
+                                     { info.name = nameData.printerName; });
 
                 bizRequest.code = ELINK_ERROR_CODE::OPERATION_NOT_IMPLEMENTED;
                 bizRequest.message = "Command not implemented";
@@ -121,7 +122,8 @@ namespace elink
         try
         {
             MethodType method = MethodType::UNKNOWN;
-            auto printerJson = parseJson(printerResponse);
+            auto printerDocument = parseMessage(printerResponse);
+            const nlohmann::json &printerJson = *printerDocument;
             if (printerJson.empty())
             {
                 return PrinterBizResponse<nlohmann::json>::error(ELINK_ERROR_CODE::PRINTER_INVALID_RESPONSE, "Invalid printer response format");
@@ -200,7 +202,7 @@ namespace elink
                             {
                                 response.code = ELINK_ERROR_CODE::PRINTER_INVALID_RESPONSE; // Default error
                                 response.message = "Failed to parse printer attributes";
-                                ELEGOO_LOG_WARN("Failed to handle printer attributes for printer {}", StringUtils::maskString(printerInfo_.printerId));
+                                ELEGOO_LOG_WARN("Failed to handle printer attributes for printer {}", StringUtils::maskString(printerId_));
                             }
                             break;
                         }
@@ -215,7 +217,7 @@ namespace elink
                             {
                                 response.code = ELINK_ERROR_CODE::PRINTER_INVALID_RESPONSE; // Default error
                                 response.message = "Failed to parse printer status";
-                                ELEGOO_LOG_WARN("Failed to handle printer status for printer {}", StringUtils::maskString(printerInfo_.printerId));
+                                ELEGOO_LOG_WARN("Failed to handle printer status for printer {}", StringUtils::maskString(printerId_));
                             }
                             break;
                         }
@@ -247,7 +249,8 @@ namespace elink
     {
         try
         {
-            auto printerJson = parseJson(printerMessage);
+            auto printerDocument = parseMessage(printerMessage);
+            const nlohmann::json &printerJson = *printerDocument;
             if (printerJson.empty())
             {
                 return PrinterBizEvent();
@@ -287,7 +290,7 @@ namespace elink
                 }
                 else
                 {
-                    ELEGOO_LOG_WARN("Failed to handle printer status for printer {}", StringUtils::maskString(printerInfo_.printerId));
+                    ELEGOO_LOG_WARN("Failed to handle printer status for printer {}", StringUtils::maskString(printerId_));
                 }
                 break;
             }
@@ -301,7 +304,7 @@ namespace elink
                 }
                 else
                 {
-                    ELEGOO_LOG_WARN("Failed to handle printer attributes for printer {}", StringUtils::maskString(printerInfo_.printerId));
+                    ELEGOO_LOG_WARN("Failed to handle printer attributes for printer {}", StringUtils::maskString(printerId_));
                 }
                 break;
             }
@@ -319,7 +322,7 @@ namespace elink
 
     std::optional<PrinterAttributesData> GenericMoonrakerMessageAdapter::handlePrinterAttributes(const nlohmann::json &printerJson)
     {
-        PrinterAttributesData printerAttributes(printerInfo_);
+        PrinterAttributesData printerAttributes(*printerInfo_->get());
         if (printerJson.contains("result"))
         {
             auto result = printerJson["result"];
@@ -377,7 +380,7 @@ namespace elink
     std::optional<PrinterStatusData> GenericMoonrakerMessageAdapter::handlePrinterStatus(MethodType method, const nlohmann::json &printerJson)
     {
         // Parse printer status from merged JSON
-        PrinterStatusData finalStatus(printerInfo_.printerId);
+        PrinterStatusData finalStatus(printerId_);
         bool isFullStatusUpdate = false;
 
         // Determine if it is a full status update
@@ -405,7 +408,7 @@ namespace elink
                 }
                 else
                 {
-                    ELEGOO_LOG_WARN("Received empty or invalid status array for printer {}", StringUtils::maskString(printerInfo_.printerId));
+                    ELEGOO_LOG_WARN("Received empty or invalid status array for printer {}", StringUtils::maskString(printerId_));
                     return std::optional<PrinterStatusData>();
                 }
             }
@@ -434,11 +437,11 @@ namespace elink
                 if (!hasFullStatusCache_)
                 {
                     // If no cached full status, return empty BizEvent
-                    ELEGOO_LOG_WARN("No cached full status available, cannot merge with delta update for printer {}", StringUtils::maskString(printerInfo_.printerId));
+                    ELEGOO_LOG_WARN("No cached full status available, cannot merge with delta update for printer {}", StringUtils::maskString(printerId_));
                     return std::optional<PrinterStatusData>();
                 }
                 finalResult = mergeStatusUpdateJson(statusJson);
-                ELEGOO_LOG_TRACE("Merged delta status JSON with cached full status for printer {}", StringUtils::maskString(printerInfo_.printerId));
+                ELEGOO_LOG_TRACE("Merged delta status JSON with cached full status for printer {}", StringUtils::maskString(printerId_));
             }
 
             // Parse print status info
@@ -558,7 +561,7 @@ namespace elink
                     else
                     {
                         ELEGOO_LOG_WARN("Received invalid position data for printer {}, expected at least 4 values, got {}",
-                                        printerInfo_.printerId, pos.size());
+                                        printerId_, pos.size());
                     }
                 }
             }
@@ -569,7 +572,7 @@ namespace elink
                 TemperatureStatus extruderTemp;
                 extruderTemp.current = JsonUtils::safeGet(extruder, "temperature", 0.0f);
                 extruderTemp.target = JsonUtils::safeGet(extruder, "target", 0.0f);
-                finalStatus.temperatureStatus["extruder"] = extruderTemp;
+                finalStatus.temperatureStatus[ComponentKey::EXTRUDER] = extruderTemp;
             }
 
             if (finalResult.contains("heater_bed") && finalResult["heater_bed"].is_object())
@@ -578,7 +581,7 @@ namespace elink
                 TemperatureStatus bedTemp;
                 bedTemp.current = JsonUtils::safeGet(heaterBed, "temperature", 0.0f);
                 bedTemp.target = JsonUtils::safeGet(heaterBed, "target", 0.0f);
-                finalStatus.temperatureStatus["heatedBed"] = bedTemp;
+                finalStatus.temperatureStatus[ComponentKey::HEATED_BED] = bedTemp;
             }
         }
         return finalStatus;
@@ -590,7 +593,7 @@ namespace elink
         std::lock_guard<std::mutex> lock(statusCacheMutex_);
         cachedFullStatusJson_ = fullStatusResult;
         hasFullStatusCache_ = true;
-        ELEGOO_LOG_TRACE("Cached full printer status JSON for printer {}", StringUtils::maskString(printerInfo_.printerId));
+        ELEGOO_LOG_TRACE("Cached full printer status JSON for printer {}", StringUtils::maskString(printerId_));
     }
 
     nlohmann::json GenericMoonrakerMessageAdapter::mergeStatusUpdateJson(const nlohmann::json &deltaStatusResult)
@@ -638,7 +641,19 @@ namespace elink
         std::lock_guard<std::mutex> lock(statusCacheMutex_);
         hasFullStatusCache_ = false;
         cachedFullStatusJson_ = nlohmann::json::object();
-        ELEGOO_LOG_DEBUG("Cleared status cache for printer {}", printerInfo_.printerId);
+        ELEGOO_LOG_DEBUG("Cleared status cache for printer {}", printerId_);
+    }
+
+    bool GenericMoonrakerMessageAdapter::hasLiveStatusCache() const
+    {
+        std::lock_guard<std::mutex> lock(statusCacheMutex_);
+        return hasFullStatusCache_;
+    }
+
+    size_t GenericMoonrakerMessageAdapter::getStatusCacheMemoryUsage() const
+    {
+        std::lock_guard<std::mutex> lock(statusCacheMutex_);
+        return JsonUtils::estimateMemoryUsage(cachedFullStatusJson_);
     }
 
     std::vector<std::string> GenericMoonrakerMessageAdapter::parseMessageType(const std::string &printerMessage)
@@ -646,7 +661,8 @@ namespace elink
         std::vector<std::string> messageTypes;
         try
         {
-            auto json = parseJson(printerMessage);
+            auto document = parseMessage(printerMessage);
+            const nlohmann::json &json = *document;
             if (json.contains("method"))
             {
                 std::string method = JsonUtils::safeGetString(json, "method", "");
@@ -14,7 +14,7 @@ namespace elink
     class GenericMoonrakerMessageAdapter : public BaseMessageAdapter
     {
     public:
-        explicit GenericMoonrakerMessageAdapter(const PrinterInfo &printerInfo);
+        explicit GenericMoonrakerMessageAdapter(std::shared_ptr<SharedPrinterInfo> printerInfo);
 
         // Implement interface methods
         PrinterBizRequest<std::string> convertRequest(MethodType method, const nlohmann::json &request, std::chrono::milliseconds timeout) override;
@@ -47,6 +47,8 @@ namespace elink
             return cachedFullStatusJson_;
         }
         void clearStatusCache() override;
+        bool hasLiveStatusCache() const override;
+        size_t getStatusCacheMemoryUsage() const override;
     private:
         // Command mapping related data - optimized unified management
         static const std::vector<std::pair<MethodType, std::string>> COMMAND_MAPPING_TABLE;
@@ -56,13 +58,14 @@ namespace elink
         std::optional<PrinterStatusData> handlePrinterStatus(MethodType method, const nlohmann::json &printerJson);
         std::optional<PrinterAttributesData> handlePrinterAttributes(const nlohmann::json &printerJson);
 
-    private:
+    protected:
         // sendMessageToPrinter method inherited from base class
 
         // Status cache and differential update related methods
         void cacheFullPrinterStatusJson(const nlohmann::json &fullStatusResult);
         nlohmann::json mergeStatusUpdateJson(const nlohmann::json &deltaStatusResult);
 
+    private:
         // Status cache related member variables (cache original JSON data)
         mutable std::mutex statusCacheMutex_;
         nlohmann::json cachedFullStatusJson_; // Cached full status original JSON (content of the result field)
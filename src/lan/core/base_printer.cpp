@@ -6,6 +6,9 @@
 #include "types/printer.h"
 #include "utils/utils.h"
 #include "utils/logger.h"
+#include "utils/tracer.h"
+#include "utils/clock.h"
+#include "core/wire_capture.h"
 #include <iostream>
 #include <chrono>
 #include <algorithm>
@@ -18,21 +21,26 @@
 namespace elink
 {
     BasePrinter::BasePrinter(const PrinterInfo &printerInfo)
-        : printerInfo_(printerInfo),
+        : printerInfo_(SharedPrinterInfo::create(printerInfo)),
+          printerId_(printerInfo.printerId),
+          printerType_(printerInfo.printerType),
           isConnected_(false),
           connectionStatus_(ConnectionStatus::DISCONNECTED),
+          trafficCounters_(std::make_shared<TrafficCounters>()),
           statusPollingRunning_(false)
     {
+        statsStartTime_ = Clock::now();
+        eventWindowStart_ = statsStartTime_;
         ELEGOO_LOG_INFO("Creating printer {} (Type: {})",
-                        StringUtils::maskString(printerInfo_.printerId),
-                        printerTypeToString(printerInfo_.printerType));
+                        StringUtils::maskString(printerId_),
+                        printerTypeToString(printerType_));
     }
 
     void BasePrinter::initialize()
     {
         ELEGOO_LOG_INFO("Initializing printer {} (Type: {})",
-                        StringUtils::maskString(printerInfo_.printerId),
-                        printerTypeToString(printerInfo_.printerType));
+                        StringUtils::maskString(printerId_),
+                        printerTypeToString(printerType_));
 
         // Create protocol and adapter using virtual methods
         protocol_ = createProtocol();
@@ -42,7 +50,7 @@ namespace elink
         if (!protocol_)
         {
             std::string error = "Failed to create protocol for printer type: " +
-                                printerTypeToString(printerInfo_.printerType);
+                                printerTypeToString(printerType_);
             ELEGOO_LOG_ERROR("{}", error);
             throw std::runtime_error(error);
         }
@@ -50,26 +58,18 @@ namespace elink
         if (!adapter_)
         {
             std::string error = "Failed to create message adapter for printer type: " +
-                                printerTypeToString(printerInfo_.printerType);
+                                printerTypeToString(printerType_);
             ELEGOO_LOG_ERROR("{}", error);
             throw std::runtime_error(error);
         }
 
-        // Get protocol type for logging
-        protocolType_ = protocol_->getProtocolType();
-
-        // Set protocol callbacks
-        protocol_->setConnectStatusCallback([this](bool connected)
-                                            { onProtocolStatusChanged(connected); });
-
-        protocol_->setMessageCallback([this](const std::string &messageData)
-                                      { onMessage(messageData); });
+        bindProtocol();
 
         if (!fileUploader_)
         {
             ELEGOO_LOG_WARN("File uploader not available for printer {} (type: {})",
-                            StringUtils::maskString(printerInfo_.printerId),
-                            printerTypeToString(printerInfo_.printerType));
+                            StringUtils::maskString(printerId_),
+                            printerTypeToString(printerType_));
         }
 
         // Set message sending callback
@@ -78,11 +78,41 @@ namespace elink
             adapter_->setMessageSendCallback([this](const PrinterBizRequest<std::string> &request)
                                              { this->sendPrinterRequest(request); });
             ELEGOO_LOG_DEBUG("Message send callback set for printer {}",
-                             StringUtils::maskString(printerInfo_.printerId));
+                             StringUtils::maskString(printerId_));
         }
 
         ELEGOO_LOG_INFO("Printer {} initialized successfully",
-                        StringUtils::maskString(printerInfo_.printerId));
+                        StringUtils::maskString(printerId_));
+    }
+
+    void BasePrinter::bindProtocol()
+    {
+        // Get protocol type for logging
+        protocolType_ = protocol_->getProtocolType();
+
+        // Set protocol callbacks
+        protocol_->setConnectStatusCallback([this](bool connected)
+                                            { onProtocolStatusChanged(connected); });
+
+        protocol_->setMessageCallback([this](const PayloadBuffer &payload)
+                                      { onMessage(payload); });
+    }
+
+    void BasePrinter::replaceProtocol(std::unique_ptr<IProtocol> protocol)
+    {
+        if (!protocol)
+        {
+            throw std::invalid_argument("Protocol must not be null");
+        }
+        if (protocol_)
+        {
+            protocol_->setMessageCallback(nullptr);
+            protocol_->setConnectStatusCallback(nullptr);
+        }
+        protocol_ = std::move(protocol);
+        bindProtocol();
+        ELEGOO_LOG_DEBUG("Protocol of printer {} replaced with {}",
+                         StringUtils::maskString(printerId_), protocolType_);
     }
 
     BasePrinter::~BasePrinter()
@@ -103,7 +133,7 @@ namespace elink
         cleanupPendingRequests("Printer destroyed");
         // Stop status polling thread first
         stopStatusPolling();
-        ELEGOO_LOG_INFO("Printer {} destroyed", StringUtils::maskString(printerInfo_.printerId));
+        ELEGOO_LOG_INFO("Printer {} destroyed", StringUtils::maskString(printerId_));
     }
 
     // ========== Connection Management ==========
@@ -113,7 +143,7 @@ namespace elink
         if (isConnected_)
         {
             ELEGOO_LOG_INFO("Printer {} is already connected",
-                            StringUtils::maskString(printerInfo_.printerId));
+                            StringUtils::maskString(printerId_));
             return BizResult<nlohmann::json>::Success();
         }
 
@@ -125,7 +155,7 @@ namespace elink
             if (!protocol_)
             {
                 std::string detailedError = "Protocol not initialized for printer type: " +
-                                            printerTypeToString(printerInfo_.printerType);
+                                            printerTypeToString(printerType_);
                 ELEGOO_LOG_ERROR("{}", detailedError);
                 return BizResult<nlohmann::json>{ELINK_ERROR_CODE::UNKNOWN_ERROR, detailedError};
             }
@@ -134,14 +164,14 @@ namespace elink
             if (!adapter_)
             {
                 std::string detailedError = "Message adapter not initialized for printer type: " +
-                                            printerTypeToString(printerInfo_.printerType);
+                                            printerTypeToString(printerType_);
                 ELEGOO_LOG_ERROR("{}", detailedError);
                 return BizResult<nlohmann::json>{ELINK_ERROR_CODE::UNKNOWN_ERROR, detailedError};
             }
 
             // Check printer info integrity
             std::string printerInfoError;
-            if (printerInfo_.printerId.empty())
+            if (printerId_.empty())
             {
                 printerInfoError = "Printer ID is empty";
             }
@@ -152,14 +182,14 @@ namespace elink
             if (!printerInfoError.empty())
             {
                 ELEGOO_LOG_ERROR("Invalid printer info for printer {}: {}",
-                                 StringUtils::maskString(printerInfo_.printerId), printerInfoError);
+                                 StringUtils::maskString(printerId_), printerInfoError);
                 return BizResult<nlohmann::json>{
                     ELINK_ERROR_CODE::INVALID_PARAMETER, "Invalid printer info: " + printerInfoError};
             }
 
             // Try to connect protocol
             ELEGOO_LOG_INFO("Attempting to connect to printer {} at {}",
-                            StringUtils::maskString(printerInfo_.printerId),
+                            StringUtils::maskString(printerId_),
                             params.host);
 
             VoidResult connectionResult = protocol_->connect(params, params.autoReconnect);
@@ -168,7 +198,7 @@ namespace elink
             {
                 connectionStatus_ = ConnectionStatus::DISCONNECTED;
                 ELEGOO_LOG_ERROR("Protocol connection failed for printer {}: {}",
-                                 StringUtils::maskString(printerInfo_.printerId),
+                                 StringUtils::maskString(printerId_),
                                  connectionResult.message);
                 return BizResult<nlohmann::json>{connectionResult.code, connectionResult.message};
             }
@@ -210,12 +240,12 @@ namespace elink
                 {
                     fileUploader_->setAuthCredentials(credentials);
                     ELEGOO_LOG_DEBUG("Set auth credentials for file uploader for printer {}",
-                                     StringUtils::maskString(printerInfo_.printerId));
+                                     StringUtils::maskString(printerId_));
                 }
             }
 
             ELEGOO_LOG_INFO("Printer {} connected successfully via {} protocol",
-                            StringUtils::maskString(printerInfo_.printerId),
+                            StringUtils::maskString(printerId_),
                             protocolType_);
             return BizResult<nlohmann::json>::Success();
         }
@@ -223,11 +253,11 @@ namespace elink
         {
             connectionStatus_ = ConnectionStatus::DISCONNECTED;
             std::string detailedError = "Connection exception: " + std::string(e.what()) +
-                                        " (Printer: " + StringUtils::maskString(printerInfo_.printerId) +
+                                        " (Printer: " + StringUtils::maskString(printerId_) +
                                         ", Protocol: " + protocolType_ + ")";
 
             ELEGOO_LOG_ERROR("Exception connecting printer {}: {}",
-                             StringUtils::maskString(printerInfo_.printerId), detailedError);
+                             StringUtils::maskString(printerId_), detailedError);
             return BizResult<nlohmann::json>{ELINK_ERROR_CODE::UNKNOWN_ERROR, detailedError};
         }
     }
@@ -237,7 +267,7 @@ namespace elink
         std::lock_guard<std::mutex> lock(statusMutex_);
 
         ELEGOO_LOG_INFO("Attempting to disconnect printer {} via {} protocol",
-                        StringUtils::maskString(printerInfo_.printerId),
+                        StringUtils::maskString(printerId_),
                         protocolType_);
 
         // Call subclass hook before disconnection
@@ -248,12 +278,12 @@ namespace elink
             protocol_->disconnect();
             ELEGOO_LOG_INFO("Protocol {} disconnected for printer {}",
                             protocolType_,
-                            StringUtils::maskString(printerInfo_.printerId));
+                            StringUtils::maskString(printerId_));
         }
         else
         {
             ELEGOO_LOG_WARN("Protocol not available during disconnect for printer {}",
-                            StringUtils::maskString(printerInfo_.printerId));
+                            StringUtils::maskString(printerId_));
         }
 
         // Update connection status
@@ -261,7 +291,7 @@ namespace elink
         connectionStatus_ = ConnectionStatus::DISCONNECTED;
 
         ELEGOO_LOG_INFO("Printer {} disconnected successfully",
-                        StringUtils::maskString(printerInfo_.printerId));
+                        StringUtils::maskString(printerId_));
         return BizResult<nlohmann::json>::Success();
     }
 
@@ -282,7 +312,7 @@ namespace elink
         const BizRequest &request,
         std::chrono::milliseconds timeout)
     {
-        ELEGOO_LOG_DEBUG("[{}] Request details: {}", printerInfo_.host, request.params.dump());
+        ELEGOO_LOG_DEBUG("[{}] Request details: {}", printerInfo_->get()->host, request.params.dump());
 
         if (!isConnected())
         {
@@ -295,7 +325,7 @@ namespace elink
         if (!adapter_ || !protocol_)
         {
             ELEGOO_LOG_ERROR("[{}] Printer not ready for request: {}",
-                             printerInfo_.host, StringUtils::maskString(printerInfo_.printerId));
+                             printerInfo_->get()->host, StringUtils::maskString(printerId_));
             return BizResult<nlohmann::json>{
                 ELINK_ERROR_CODE::UNKNOWN_ERROR, "protocol not available"};
         }
@@ -355,7 +385,7 @@ namespace elink
     {
         // Base class doesn't create protocol - subclasses must override
         ELEGOO_LOG_ERROR("createProtocol() not implemented for printer type: {}",
-                         static_cast<int>(printerInfo_.printerType));
+                         static_cast<int>(printerType_));
         return nullptr;
     }
 
@@ -363,7 +393,7 @@ namespace elink
     {
         // Base class doesn't create adapter - subclasses must override
         ELEGOO_LOG_ERROR("createMessageAdapter() not implemented for printer type: {}",
-                         static_cast<int>(printerInfo_.printerType));
+                         static_cast<int>(printerType_));
         return nullptr;
     }
 
@@ -375,23 +405,39 @@ namespace elink
 
     // ========== Protected Helper Methods ==========
 
-    void BasePrinter::onMessage(const std::string &messageData)
+    void BasePrinter::onMessage(const PayloadBuffer &payload)
     {
+        const std::string &messageData = payload.str();
+        ELEGOO_TRACE_SCOPE_ARGS("message", "BasePrinter::onMessage",
+                                {{"printer", printerId_}, {"bytes", std::to_string(messageData.size())}});
+        trafficCounters_->messagesReceived++;
+        trafficCounters_->bytesReceived += messageData.size();
+        if (WireCapture::isEnabled())
+        {
+            WireCapture::getInstance().record(*printerInfo_->get(), WireDirection::INBOUND, messageData);
+        }
         try
         {
             if (!adapter_)
             {
                 ELEGOO_LOG_ERROR("No adapter available for printer {}",
-                                 StringUtils::maskString(printerInfo_.printerId));
+                                 StringUtils::maskString(printerId_));
                 return;
             }
 
+            // The adapter calls below share one parse of the message
+            MessageParseScope parseScope(messageData);
+
             // Parse message type
-            std::vector<std::string> parsedMessageTypes = adapter_->parseMessageType(messageData);
+            std::vector<std::string> parsedMessageTypes;
+            {
+                ELEGOO_TRACE_SCOPE("message", "adapter.parseMessageType");
+                parsedMessageTypes = adapter_->parseMessageType(messageData);
+            }
             if (parsedMessageTypes.empty())
             {
                 ELEGOO_LOG_ERROR("Failed to parse message type for printer {}: {}",
-                                 StringUtils::maskString(printerInfo_.printerId), messageData);
+                                 StringUtils::maskString(printerId_), messageData);
                 return;
             }
 
@@ -401,7 +447,11 @@ namespace elink
                 if (parsedMessageType == "response")
                 {
                     // Convert printer response to standard response format
-                    PrinterBizResponse standardResponse = adapter_->convertToResponse(messageData);
+                    PrinterBizResponse<nlohmann::json> standardResponse;
+                    {
+                        ELEGOO_TRACE_SCOPE("message", "adapter.convertToResponse");
+                        standardResponse = adapter_->convertToResponse(messageData);
+                    }
                     if (!standardResponse.isValid())
                     {
                         if (standardResponse.code == ELINK_ERROR_CODE::SUCCESS)
@@ -411,20 +461,21 @@ namespace elink
                         if (standardResponse.message.find("No request mapping found") != std::string::npos)
                         {
                             ELEGOO_LOG_DEBUG("No request mapping found for printer {}",
-                                             StringUtils::maskString(printerInfo_.printerId));
+                                             StringUtils::maskString(printerId_));
                             continue;
                         }
 
                         std::string maskedContent = messageData;
-                        if (!printerInfo_.serialNumber.empty() &&
-                            maskedContent.find(printerInfo_.serialNumber) != std::string::npos)
+                        auto info = printerInfo_->get();
+                        if (!info->serialNumber.empty() &&
+                            maskedContent.find(info->serialNumber) != std::string::npos)
                         {
-                            std::string maskSn = StringUtils::maskString(printerInfo_.serialNumber);
+                            std::string maskSn = StringUtils::maskString(info->serialNumber);
                             maskedContent = StringUtils::replaceAll(maskedContent,
-                                                                    printerInfo_.serialNumber, maskSn);
+                                                                    info->serialNumber, maskSn);
                         }
 
-                        std::string mainboardId = adapter_->getPrinterInfo().mainboardId;
+                        const std::string &mainboardId = info->mainboardId;
                         if (!mainboardId.empty() && maskedContent.find(mainboardId) != std::string::npos)
                         {
                             std::string maskId = StringUtils::maskString(mainboardId);
@@ -432,7 +483,7 @@ namespace elink
                         }
 
                         ELEGOO_LOG_WARN("Invalid response message for printer {}: {}",
-                                        StringUtils::maskString(printerInfo_.printerId), maskedContent);
+                                        StringUtils::maskString(printerId_), maskedContent);
                         continue;
                     }
                     handleResponseMessage(standardResponse.requestId, standardResponse.code,
@@ -441,16 +492,30 @@ namespace elink
                 else if (parsedMessageType == "event")
                 {
                     // Convert printer event to standard event format
-                    PrinterBizEvent data = adapter_->convertToEvent(messageData);
+                    PrinterBizEvent data;
+                    {
+                        ELEGOO_TRACE_SCOPE("message", "adapter.convertToEvent");
+                        data = adapter_->convertToEvent(messageData);
+                    }
                     if (data.isValid())
                     {
                         BizEvent bizEvent;
                         bizEvent.method = data.method;
-                        bizEvent.data = data.data.value();
+                        bizEvent.data = std::move(data.data.value());
+                        uint64_t statusVersion = 0;
+                        if (bizEvent.method == MethodType::ON_PRINTER_STATUS)
+                        {
+                            statusVersion = stampStatus(bizEvent.data);
+                        }
                         ELEGOO_LOG_DEBUG("Received event from printer {}: {}",
-                                         StringUtils::maskString(printerInfo_.printerId),
+                                         StringUtils::maskString(printerId_),
                                          bizEvent.data.dump());
                         handleEventMessage(bizEvent);
+                        if (statusVersion != 0)
+                        {
+                            // Delivered, so the event's JSON becomes the snapshot without a copy
+                            storeStatus(std::move(bizEvent.data), statusVersion);
+                        }
                     }
                 }
             }
@@ -458,7 +523,7 @@ namespace elink
         catch (const std::exception &e)
         {
             ELEGOO_LOG_ERROR("Error processing message for printer {}: {}",
-                             StringUtils::maskString(printerInfo_.printerId), e.what());
+                             StringUtils::maskString(printerId_), e.what());
         }
     }
 
@@ -468,8 +533,10 @@ namespace elink
         std::string message,
         const std::optional<nlohmann::json> &result)
     {
+        ELEGOO_TRACE_SCOPE_ARGS("message", "BasePrinter::handleResponseMessage", {{"requestId", requestId}});
         if (!requestId.empty())
         {
+            ELEGOO_TRACE_FLOW_END("request", "request", requestId);
             std::lock_guard<std::mutex> lock(requestsMutex_);
             auto it = pendingRequests_.find(requestId);
             if (it != pendingRequests_.end())
@@ -499,12 +566,27 @@ namespace elink
         else
         {
             ELEGOO_LOG_WARN("Received response without request ID from printer {}",
-                            StringUtils::maskString(printerInfo_.printerId));
+                            StringUtils::maskString(printerId_));
         }
     }
 
     void BasePrinter::handleEventMessage(const BizEvent &event)
     {
+        ELEGOO_TRACE_SCOPE_ARGS("message", "BasePrinter::handleEventMessage",
+                                {{"method", std::to_string(static_cast<int>(event.method))}});
+        trafficCounters_->eventsReceived++;
+        {
+            std::lock_guard<std::mutex> lock(eventRateMutex_);
+            auto now = Clock::now();
+            std::chrono::duration<double> elapsed = now - eventWindowStart_;
+            if (elapsed >= EVENT_RATE_WINDOW)
+            {
+                lastEventRate_ = eventWindowCount_ / elapsed.count();
+                eventWindowStart_ = now;
+                eventWindowCount_ = 0;
+            }
+            eventWindowCount_++;
+        }
         std::lock_guard<std::mutex> lock(callbackMutex_);
         if (eventCallback_)
         {
@@ -523,7 +605,7 @@ namespace elink
 
         int cleanedCount = static_cast<int>(pendingRequests_.size());
         ELEGOO_LOG_INFO("Cleaning up {} pending requests for printer {}: {}",
-                        cleanedCount, StringUtils::maskString(printerInfo_.printerId), reason);
+                        cleanedCount, StringUtils::maskString(printerId_), reason);
 
         for (auto &pair : pendingRequests_)
         {
@@ -548,7 +630,7 @@ namespace elink
         if (connected == isConnected_)
         {
             ELEGOO_LOG_DEBUG("Connection status for printer {} unchanged: {}",
-                             StringUtils::maskString(printerInfo_.printerId),
+                             StringUtils::maskString(printerId_),
                              connected ? "Connected" : "Disconnected");
             return;
         }
@@ -556,16 +638,16 @@ namespace elink
         isConnected_ = connected;
         connectionStatus_ = connected ? ConnectionStatus::CONNECTED : ConnectionStatus::DISCONNECTED;
         ELEGOO_LOG_INFO("Printer {} connection status changed: {}",
-                        StringUtils::maskString(printerInfo_.printerId),
+                        StringUtils::maskString(printerId_),
                         (connected ? "Connected" : "Disconnected"));
 
         BizEvent statusEvent;
         statusEvent.method = MethodType::ON_CONNECTION_STATUS;
         statusEvent.data = ConnectionStatusData{
-            printerInfo_.printerId,
+            printerId_,
             connected ? ConnectionStatus::CONNECTED : ConnectionStatus::DISCONNECTED};
         ELEGOO_LOG_DEBUG("Connection status for printer {}: {}",
-                         StringUtils::maskString(printerInfo_.printerId), statusEvent.data.dump());
+                         StringUtils::maskString(printerId_), statusEvent.data.dump());
 
         std::lock_guard<std::mutex> lock(callbackMutex_);
         if (eventCallback_)
@@ -577,21 +659,23 @@ namespace elink
         {
             adapter_->clearStatusCache();
             statusEvent.method = MethodType::ON_PRINTER_STATUS;
-            PrinterStatusData printerStatusEvent(printerInfo_.printerId);
+            PrinterStatusData printerStatusEvent(printerId_);
             printerStatusEvent.printerStatus.state = PrinterState::OFFLINE;
             statusEvent.data = printerStatusEvent;
+            uint64_t statusVersion = stampStatus(statusEvent.data);
             ELEGOO_LOG_DEBUG("Printer status for printer {}: {}",
-                             StringUtils::maskString(printerInfo_.printerId), statusEvent.data.dump());
+                             StringUtils::maskString(printerId_), statusEvent.data.dump());
             if (eventCallback_)
             {
                 eventCallback_(statusEvent);
             }
+            storeStatus(std::move(statusEvent.data), statusVersion);
         }
         else
         {
             // Start status polling thread when connected
             ELEGOO_LOG_DEBUG("Starting status polling for printer {}",
-                             StringUtils::maskString(printerInfo_.printerId));
+                             StringUtils::maskString(printerId_));
             startStatusPolling();
         }
     }
@@ -601,20 +685,33 @@ namespace elink
         if (!protocol_ || !isConnected_)
         {
             ELEGOO_LOG_WARN("Cannot send request to printer: printer {} not ready",
-                            StringUtils::maskString(printerInfo_.printerId));
+                            StringUtils::maskString(printerId_));
             return;
         }
 
-        auto printerId = printerInfo_.printerId;
+        auto printerId = printerId_;
         try
         {
             std::weak_ptr<elink::IProtocol> weakProtocol = protocol_;
             // Send asynchronously
-            std::thread([weakProtocol, request, printerId]()
+            std::weak_ptr<TrafficCounters> weakCounters = trafficCounters_;
+            auto captureInfo = WireCapture::isEnabled() ? printerInfo_->get() : nullptr;
+            std::thread([weakProtocol, weakCounters, captureInfo, request, printerId]()
                         {
                 if (auto protocol = weakProtocol.lock())
                 {
+                    ELEGOO_TRACE_SCOPE_ARGS("request", "BasePrinter::sendPrinterRequest",
+                                            {{"printer", printerId}, {"method", std::to_string(static_cast<int>(request.method))}});
                     bool result = protocol->sendCommand(request.data);
+                    if (auto counters = weakCounters.lock(); counters && result)
+                    {
+                        counters->messagesSent++;
+                        counters->bytesSent += request.data.size();
+                    }
+                    if (captureInfo && result)
+                    {
+                        WireCapture::getInstance().record(*captureInfo, WireDirection::OUTBOUND, request.data);
+                    }
                     if (!result)
                     {
                         ELEGOO_LOG_ERROR("Failed to send command (method: {}) to printer: {}", 
@@ -642,10 +739,15 @@ namespace elink
         const BizRequest &request,
         std::chrono::milliseconds timeout)
     {
-        ELEGOO_LOG_DEBUG("[{}] Request details: {}", printerInfo_.host, request.params.dump());
+        ELEGOO_TRACE_SCOPE_ARGS("request", "BasePrinter::handleRequest",
+                                {{"printer", printerId_}, {"method", std::to_string(static_cast<int>(request.method))}});
+        ELEGOO_LOG_DEBUG("[{}] Request details: {}", printerInfo_->get()->host, request.params.dump());
         // Use adapter to convert standard request to printer-specific format
-        PrinterBizRequest printerBizRequest = adapter_->convertRequest(
-            request.method, request.params, timeout);
+        PrinterBizRequest<std::string> printerBizRequest;
+        {
+            ELEGOO_TRACE_SCOPE("request", "adapter.convertRequest");
+            printerBizRequest = adapter_->convertRequest(request.method, request.params, timeout);
+        }
         if (!printerBizRequest.isValid())
         {
             return BizResult<nlohmann::json>::Error(
@@ -663,7 +765,21 @@ namespace elink
         auto future = promise->get_future();
 
         // Send command
-        bool result = protocol_->sendCommand(printerBizRequest.data);
+        bool result = false;
+        {
+            ELEGOO_TRACE_SCOPE_ARGS("request", "protocol.sendCommand", {{"requestId", printerBizRequest.requestId}});
+            ELEGOO_TRACE_FLOW_BEGIN("request", "request", printerBizRequest.requestId);
+            result = protocol_->sendCommand(printerBizRequest.data);
+        }
+        if (result)
+        {
+            trafficCounters_->messagesSent++;
+            trafficCounters_->bytesSent += printerBizRequest.data.size();
+            if (WireCapture::isEnabled())
+            {
+                WireCapture::getInstance().record(*printerInfo_->get(), WireDirection::OUTBOUND, printerBizRequest.data);
+            }
+        }
         if (!result)
         {
             {
@@ -672,7 +788,7 @@ namespace elink
             }
 
             ELEGOO_LOG_ERROR("Failed to send command for printer {}",
-                             StringUtils::maskString(printerInfo_.printerId));
+                             StringUtils::maskString(printerId_));
 
             try
             {
@@ -688,13 +804,15 @@ namespace elink
         }
 
         ELEGOO_LOG_DEBUG("Command sent for printer {}, waiting for response (timeout: {}ms)",
-                         StringUtils::maskString(printerInfo_.printerId), timeout.count());
+                         StringUtils::maskString(printerId_), timeout.count());
 
         // Wait for response with timeout
+        ELEGOO_TRACE_SCOPE("request", "wait response");
         if (timeout.count() > 0)
         {
-            if (future.wait_for(timeout) == std::future_status::timeout)
+            if (Clock::waitFor(future, timeout) == std::future_status::timeout)
             {
+                ELEGOO_TRACE_INSTANT("request", "request timeout", {{"requestId", printerBizRequest.requestId}});
                 {
                     std::lock_guard<std::mutex> lock(requestsMutex_);
                     auto it = pendingRequests_.find(printerBizRequest.requestId);
@@ -716,7 +834,7 @@ namespace elink
                 }
                 ELEGOO_LOG_WARN("Request {} for printer {} timed out after {}ms",
                                 printerBizRequest.requestId,
-                                StringUtils::maskString(printerInfo_.printerId),
+                                StringUtils::maskString(printerId_),
                                 timeout.count());
             }
         }
@@ -733,7 +851,7 @@ namespace elink
         pendingRequests_[requestId] = {
             requestId,
             promise,
-            std::chrono::steady_clock::now()};
+            Clock::now()};
 
         return promise;
     }
@@ -796,11 +914,112 @@ namespace elink
 
     PrinterStatusResult BasePrinter::getPrinterStatus(const PrinterStatusParams &params, int timeout)
     {
-        return executeRequest<PrinterStatusData>(
+        if (params.readMode == StatusReadMode::CACHED && isConnected_ && adapter_ && adapter_->hasLiveStatusCache())
+        {
+            std::shared_ptr<const nlohmann::json> snapshot;
+            std::chrono::steady_clock::time_point updatedAt;
+            {
+                std::lock_guard<std::mutex> lock(statusSnapshotMutex_);
+                snapshot = statusSnapshot_;
+                updatedAt = statusUpdatedAt_;
+            }
+            if (snapshot)
+            {
+                return PrinterStatusResult::Ok(decodeStatusSnapshot(snapshot, updatedAt));
+            }
+        }
+
+        uint64_t versionBefore;
+        {
+            std::lock_guard<std::mutex> lock(statusSnapshotMutex_);
+            versionBefore = statusVersion_;
+        }
+        auto result = executeRequest<PrinterStatusData>(
             MethodType::GET_PRINTER_STATUS,
             params,
             "Getting printer status",
             std::chrono::milliseconds(timeout));
+        if (result.isSuccess() && result.data.has_value())
+        {
+            // A status pushed while the request was in flight is at least as recent as the response
+            result.data->statusVersion = storeStatusIfUnchanged(result.data.value(), versionBefore);
+        }
+        return result;
+    }
+
+    StatusIfNewerResult BasePrinter::getStatusIfNewer(const StatusIfNewerParams &params) const
+    {
+        StatusIfNewerData data;
+        std::shared_ptr<const nlohmann::json> snapshot;
+        std::chrono::steady_clock::time_point updatedAt;
+        {
+            std::lock_guard<std::mutex> lock(statusSnapshotMutex_);
+            data.statusVersion = snapshotVersion_;
+            // Compared for inequality so a version from before a restart does not hide newer status
+            if (snapshotVersion_ != params.knownVersion)
+            {
+                snapshot = statusSnapshot_;
+                updatedAt = statusUpdatedAt_;
+            }
+        }
+        if (snapshot)
+        {
+            data.changed = true;
+            data.status = decodeStatusSnapshot(snapshot, updatedAt);
+        }
+        return StatusIfNewerResult::Ok(std::move(data));
+    }
+
+    uint64_t BasePrinter::stampStatus(nlohmann::json &status)
+    {
+        std::lock_guard<std::mutex> lock(statusSnapshotMutex_);
+        status["statusVersion"] = ++statusVersion_;
+        return statusVersion_;
+    }
+
+    void BasePrinter::storeStatus(nlohmann::json &&status, uint64_t version)
+    {
+        auto snapshot = std::make_shared<const nlohmann::json>(std::move(status));
+        std::lock_guard<std::mutex> lock(statusSnapshotMutex_);
+        if (version > snapshotVersion_)
+        {
+            statusSnapshot_ = std::move(snapshot);
+            snapshotVersion_ = version;
+            statusUpdatedAt_ = Clock::now();
+        }
+    }
+
+    uint64_t BasePrinter::storeStatusIfUnchanged(const PrinterStatusData &status, uint64_t ifVersion)
+    {
+        {
+            std::lock_guard<std::mutex> lock(statusSnapshotMutex_);
+            if (ifVersion != statusVersion_)
+            {
+                return snapshotVersion_;
+            }
+        }
+        // Serialized outside the lock; a push stamped meanwhile wins below
+        nlohmann::json json = status;
+        auto snapshot = std::make_shared<nlohmann::json>(std::move(json));
+        std::lock_guard<std::mutex> lock(statusSnapshotMutex_);
+        if (ifVersion != statusVersion_)
+        {
+            return snapshotVersion_;
+        }
+        (*snapshot)["statusVersion"] = ++statusVersion_;
+        statusSnapshot_ = std::move(snapshot);
+        snapshotVersion_ = statusVersion_;
+        statusUpdatedAt_ = Clock::now();
+        return snapshotVersion_;
+    }
+
+    PrinterStatusData BasePrinter::decodeStatusSnapshot(const std::shared_ptr<const nlohmann::json> &snapshot,
+                                                        std::chrono::steady_clock::time_point updatedAt) const
+    {
+        // Decoded outside the lock; the snapshot is immutable
+        auto data = snapshot->get<PrinterStatusData>();
+        data.statusAgeMs = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - updatedAt).count();
+        return data;
     }
 
     GetCanvasStatusResult BasePrinter::getCanvasStatus(const GetCanvasStatusParams &params)
@@ -821,6 +1040,63 @@ namespace elink
             std::chrono::milliseconds(3000));
     }
 
+    // ========== Resource Accounting ==========
+
+    PrinterResourceStats BasePrinter::getResourceStats() const
+    {
+        auto now = Clock::now();
+
+        PrinterResourceStats stats;
+        stats.printerId = printerId_;
+        stats.transport = protocolType_;
+        stats.messagesReceived = trafficCounters_->messagesReceived;
+        stats.bytesReceived = trafficCounters_->bytesReceived;
+        stats.messagesSent = trafficCounters_->messagesSent;
+        stats.bytesSent = trafficCounters_->bytesSent;
+        stats.eventsReceived = trafficCounters_->eventsReceived;
+        stats.collectionDurationMs = std::chrono::duration_cast<std::chrono::milliseconds>(now - statsStartTime_).count();
+
+        if (fileUploader_)
+        {
+            stats.bytesUploaded = fileUploader_->getBytesUploaded();
+            stats.bytesDownloaded = fileUploader_->getBytesDownloaded();
+        }
+
+        if (adapter_)
+        {
+            stats.statusCacheBytes = adapter_->getStatusCacheMemoryUsage();
+            stats.pendingRequestBytes = adapter_->getRequestTrackingMemoryUsage();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(requestsMutex_);
+            stats.pendingRequests = pendingRequests_.size();
+            for (const auto &[requestId, pending] : pendingRequests_)
+            {
+                // std::map node, both copies of the ID and the promise shared state
+                stats.pendingRequestBytes += 4 * sizeof(void *) + sizeof(std::string) + sizeof(PendingRequest);
+                stats.pendingRequestBytes += requestId.capacity() + pending.requestId.capacity();
+                stats.pendingRequestBytes += sizeof(std::promise<BizResult<nlohmann::json>>) + sizeof(BizResult<nlohmann::json>);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(eventRateMutex_);
+            std::chrono::duration<double> elapsed = now - eventWindowStart_;
+            if (elapsed >= EVENT_RATE_WINDOW || (lastEventRate_ < 0 && elapsed >= std::chrono::seconds(1)))
+            {
+                // No window completed recently (events stopped) or none yet: use the current one
+                stats.eventsPerSecond = eventWindowCount_ / elapsed.count();
+            }
+            else
+            {
+                stats.eventsPerSecond = lastEventRate_ < 0 ? 0.0 : lastEventRate_;
+            }
+        }
+
+        return stats;
+    }
+
     // ========== Status Polling Thread Methods ==========
 
     void BasePrinter::startStatusPolling()
@@ -832,7 +1108,7 @@ namespace elink
             if (statusPollingRunning_)
             {
                 ELEGOO_LOG_DEBUG("Status polling already running for printer {}",
-                                 StringUtils::maskString(printerInfo_.printerId));
+                                 StringUtils::maskString(printerId_));
                 return;
             }
         }
@@ -851,7 +1127,7 @@ namespace elink
         statusPollingThread_ = std::thread(&BasePrinter::statusPollingThreadFunc, this);
 
         ELEGOO_LOG_INFO("Status polling thread started for printer {}",
-                        StringUtils::maskString(printerInfo_.printerId));
+                        StringUtils::maskString(printerId_));
     }
 
     void BasePrinter::stopStatusPolling()
@@ -869,14 +1145,14 @@ namespace elink
         {
             statusPollingThread_.join();
             ELEGOO_LOG_INFO("Status polling thread stopped for printer {}",
-                            StringUtils::maskString(printerInfo_.printerId));
+                            StringUtils::maskString(printerId_));
         }
     }
 
     void BasePrinter::statusPollingThreadFunc()
     {
         ELEGOO_LOG_DEBUG("Status polling thread running for printer {}",
-                         StringUtils::maskString(printerInfo_.printerId));
+                         StringUtils::maskString(printerId_));
 
         const int retryIntervalMs = 2000; // Poll every 2 seconds
         const int maxRetries = 99999;        // Maximum 30 attempts (60 seconds total)
@@ -888,7 +1164,7 @@ namespace elink
             if (!isConnected_)
             {
                 ELEGOO_LOG_DEBUG("Printer {} disconnected, stopping status polling",
-                                 StringUtils::maskString(printerInfo_.printerId));
+                                 StringUtils::maskString(printerId_));
                 break;
             }
 
@@ -897,12 +1173,12 @@ namespace elink
             {
                 ELEGOO_LOG_DEBUG("[Retry {}] Polling status for printer {}",
                                  retryCount + 1,
-                                 StringUtils::maskString(printerInfo_.printerId));
+                                 StringUtils::maskString(printerId_));
 
                 try
                 {
                     PrinterStatusParams params;
-                    params.printerId = printerInfo_.printerId;
+                    params.printerId = printerId_;
 
                     // Send status request with timeout
                     auto result = getPrinterStatus(params, 3000);
@@ -910,14 +1186,14 @@ namespace elink
                     if (result.isSuccess())
                     {
                         ELEGOO_LOG_INFO("Successfully obtained printer status for {}, stopping polling",
-                                        StringUtils::maskString(printerInfo_.printerId));
+                                        StringUtils::maskString(printerId_));
                         // Success, stop polling
                         break;
                     }
                     else
                     {
                         ELEGOO_LOG_WARN("Failed to get printer status for {} (attempt {}/{}): {}",
-                                        StringUtils::maskString(printerInfo_.printerId),
+                                        StringUtils::maskString(printerId_),
                                         retryCount + 1,
                                         maxRetries,
                                         result.message);
@@ -926,7 +1202,7 @@ namespace elink
                 catch (const std::exception &e)
                 {
                     ELEGOO_LOG_ERROR("Exception while polling status for printer {}: {}",
-                                     StringUtils::maskString(printerInfo_.printerId),
+                                     StringUtils::maskString(printerId_),
                                      e.what());
                 }
             }
@@ -937,9 +1213,9 @@ namespace elink
             if (statusPollingRunning_ && retryCount < maxRetries)
             {
                 std::unique_lock<std::mutex> lock(statusPollingMutex_);
-                statusPollingCV_.wait_for(lock, std::chrono::milliseconds(retryIntervalMs),
-                                          [this]
-                                          { return !statusPollingRunning_; });
+                Clock::waitFor(lock, statusPollingCV_, std::chrono::milliseconds(retryIntervalMs),
+                               [this]
+                               { return !statusPollingRunning_; });
             }
         }
 
@@ -947,13 +1223,13 @@ namespace elink
         {
             ELEGOO_LOG_WARN("Status polling reached maximum retries ({}) for printer {}",
                             maxRetries,
-                            StringUtils::maskString(printerInfo_.printerId));
+                            StringUtils::maskString(printerId_));
         }
 
         std::lock_guard<std::mutex> lock(statusPollingMutex_);
         statusPollingRunning_ = false;
         ELEGOO_LOG_DEBUG("Status polling thread exiting for printer {}",
-                         StringUtils::maskString(printerInfo_.printerId));
+                         StringUtils::maskString(printerId_));
     }
 
 } // namespace elink
@@ -15,6 +15,8 @@
 #include "utils/logger.h"
 #include "utils/utils.h"
 #include "types/internal/json_serializer.h"
+#include "core/shared_printer_info.h"
+#include "protocols/payload_buffer.h"
 namespace elink
 {
     // Forward declarations
@@ -51,6 +53,13 @@ namespace elink
          */
         void initialize();
 
+        /**
+         * Replace the protocol created by initialize(), e.g. with a replay transport
+         * Must be called before connect()
+         * @param protocol Protocol instance
+         */
+        void replaceProtocol(std::unique_ptr<IProtocol> protocol);
+
         // Disable copy constructor and assignment
         BasePrinter(const BasePrinter &) = delete;
         BasePrinter &operator=(const BasePrinter &) = delete;
@@ -60,12 +69,12 @@ namespace elink
         /**
          * Get printer ID
          */
-        const std::string &getId() const { return printerInfo_.printerId; }
+        const std::string &getId() const { return printerId_; }
 
         /**
          * Get printer information
          */
-        const PrinterInfo &getPrinterInfo() const { return printerInfo_; }
+        PrinterInfoPtr getPrinterInfo() const { return printerInfo_->get(); }
 
         // ========== Connection Management ==========
 
@@ -172,6 +181,13 @@ namespace elink
          */
         virtual PrinterStatusResult getPrinterStatus(const PrinterStatusParams &params, int timeout = 3000);
 
+        /**
+         * Get the latest recorded status if its version differs from the caller's, answered from memory
+         * @param params Printer ID and the statusVersion the caller already has
+         * @return Unchanged (changed = false) when the caller is up to date
+         */
+        StatusIfNewerResult getStatusIfNewer(const StatusIfNewerParams &params) const;
+
         /**
          * Get canvas status
          * @param params Canvas status parameters
@@ -186,6 +202,14 @@ namespace elink
          */
         virtual VoidResult updatePrinterName(const UpdatePrinterNameParams &params);
 
+        // ========== Resource Accounting ==========
+
+        /**
+         * Get transport traffic, file transfer, cache memory and event rate counters
+         * @return Counters accumulated since the printer was created
+         */
+        PrinterResourceStats getResourceStats() const;
+
     protected:
         // ========== Virtual Methods for Subclass Customization ==========
 
@@ -236,10 +260,16 @@ namespace elink
 
         // ========== Protected Helper Methods ==========
 
+        /**
+         * Route protocol status changes and messages to this printer
+         */
+        void bindProtocol();
+
         /**
          * Handle incoming message from protocol
+         * @param payload Received message, shared with the transport; retain() it to keep it past this call
          */
-        void onMessage(const std::string &messageData);
+        void onMessage(const PayloadBuffer &payload);
 
         /**
          * Handle protocol status change
@@ -265,6 +295,24 @@ namespace elink
          */
         void handleEventMessage(const BizEvent &event);
 
+        /**
+         * Stamp a pushed status with the next version, before it is delivered
+         * @param status PrinterStatusData JSON, its statusVersion is set
+         * @return The new version
+         */
+        uint64_t stampStatus(nlohmann::json &status);
+
+        /**
+         * Keep a stamped status as the snapshot, taking over its JSON, unless a later one is stored
+         */
+        void storeStatus(nlohmann::json &&status, uint64_t version);
+
+        /**
+         * Keep a status response as the snapshot if no status was stamped since ifVersion
+         * @return The version of the stored snapshot, which is the current one if a push won the race
+         */
+        uint64_t storeStatusIfUnchanged(const PrinterStatusData &status, uint64_t ifVersion);
+
         /**
          * Cleanup pending requests
          */
@@ -299,7 +347,7 @@ namespace elink
             const std::string &actionName,
             std::chrono::milliseconds timeout)
         {
-            ELEGOO_LOG_INFO("[{}] {}", StringUtils::maskString(printerInfo_.printerId), actionName);
+            ELEGOO_LOG_INFO("[{}] {}", StringUtils::maskString(printerId_), actionName);
             
             BizRequest request;
             request.method = method;
@@ -349,10 +397,13 @@ namespace elink
         };
 
         std::map<std::string, PendingRequest> pendingRequests_;
-        std::mutex requestsMutex_;
+        mutable std::mutex requestsMutex_;
 
         // Printer information and components
-        PrinterInfo printerInfo_;
+        // Shared with the message adapter, which updates it as the printer reports its details
+        std::shared_ptr<SharedPrinterInfo> printerInfo_;
+        const std::string printerId_;
+        const PrinterType printerType_;
         std::shared_ptr<IProtocol> protocol_;
         std::unique_ptr<IMessageAdapter> adapter_;
         std::shared_ptr<IHttpFileTransfer> fileUploader_;
@@ -368,6 +419,38 @@ namespace elink
 
         std::string protocolType_; // Protocol type for logging
 
+        // Transport counters, shared with detached send threads that may outlive the printer
+        struct TrafficCounters
+        {
+            std::atomic<uint64_t> messagesReceived{0};
+            std::atomic<uint64_t> bytesReceived{0};
+            std::atomic<uint64_t> messagesSent{0};
+            std::atomic<uint64_t> bytesSent{0};
+            std::atomic<uint64_t> eventsReceived{0};
+        };
+        std::shared_ptr<TrafficCounters> trafficCounters_;
+        std::chrono::steady_clock::time_point statsStartTime_;
+
+        // Event rate, measured over fixed windows
+        mutable std::mutex eventRateMutex_;
+        std::chrono::steady_clock::time_point eventWindowStart_;
+        uint64_t eventWindowCount_ = 0;
+        double lastEventRate_ = -1.0; // Rate of the last completed window, negative until one completed
+        static constexpr std::chrono::seconds EVENT_RATE_WINDOW{10};
+
+        // Latest full status (PrinterStatusData JSON) from events and responses, with its version
+        mutable std::mutex statusSnapshotMutex_;
+        std::shared_ptr<const nlohmann::json> statusSnapshot_;
+        uint64_t statusVersion_ = 0;   // Last version stamped
+        uint64_t snapshotVersion_ = 0; // Version of statusSnapshot_, behind statusVersion_ while a push is delivered
+        std::chrono::steady_clock::time_point statusUpdatedAt_;
+
+        /**
+         * Decode the recorded status and set its age
+         */
+        PrinterStatusData decodeStatusSnapshot(const std::shared_ptr<const nlohmann::json> &snapshot,
+                                               std::chrono::steady_clock::time_point updatedAt) const;
+
         // Status polling thread management
         std::atomic<bool> statusPollingRunning_;
         std::thread statusPollingThread_;
@@ -43,12 +43,12 @@ namespace elink
             {
                 elegooAdapter->resetStatusSequence();
                 ELEGOO_LOG_DEBUG("Reset status event sequence for ElegooFdmCC2 printer {}", 
-                               StringUtils::maskString(printerInfo_.printerId));
+                               StringUtils::maskString(printerId_));
             }
             else
             {
                 ELEGOO_LOG_WARN("Failed to cast adapter to ElegooFdmCC2MessageAdapter for printer {}", 
-                              StringUtils::maskString(printerInfo_.printerId));
+                              StringUtils::maskString(printerId_));
             }
         }
     }
@@ -2,6 +2,7 @@
 #include "core/base_printer.h"
 #include "core/printer_factory.h"
 #include "protocols/protocol_interface.h"
+#include "types/internal/json_serializer.h"
 #include "utils/utils.h"
 #include "utils/logger.h"
 #include <iostream>
@@ -11,7 +12,7 @@ namespace elink
 {
 
     PrinterManager::PrinterManager()
-        : initialized_(false)
+        : registry_(std::make_shared<PrinterRegistry>()), initialized_(false)
     {
     }
 
@@ -55,7 +56,7 @@ namespace elink
             // Clean up printers
             {
                 std::lock_guard<std::mutex> lock(printersMutex_);
-                printers_.clear();
+                std::atomic_store(&registry_, PrinterRegistryPtr(std::make_shared<PrinterRegistry>()));
             }
 
             initialized_ = false;
@@ -75,10 +76,10 @@ namespace elink
         std::lock_guard<std::mutex> lock(printersMutex_);
 
         // Check if printer already exists
-        if (printers_.find(printerInfo.printerId) != printers_.end())
+        if (auto existing = getPrinter(printerInfo.printerId))
         {
             ELEGOO_LOG_INFO("Printer {} already exists", StringUtils::maskString(printerInfo.printerId));
-            return printers_[printerInfo.printerId];
+            return existing;
         }
 
         try
@@ -100,7 +101,7 @@ namespace elink
                 }
             }
 
-            printers_[printerInfo.printerId] = printer;
+            publish(printerInfo.printerId, printer);
 
             ELEGOO_LOG_INFO("Printer {} created successfully", StringUtils::maskString(printerInfo.printerId));
             return printer;
@@ -112,34 +113,50 @@ namespace elink
         }
     }
 
-    PrinterPtr PrinterManager::getPrinter(const std::string &printerId)
+    PrinterPtr PrinterManager::getPrinter(const std::string &printerId) const
     {
-        std::lock_guard<std::mutex> lock(printersMutex_);
-
-        auto it = printers_.find(printerId);
-        return it != printers_.end() ? it->second : nullptr;
+        auto registry = getRegistry();
+        auto it = registry->byId.find(printerId);
+        return it != registry->byId.end() ? it->second : nullptr;
     }
 
     bool PrinterManager::removePrinter(const std::string &printerId)
     {
-        std::lock_guard<std::mutex> lock(printersMutex_);
-
-        auto it = printers_.find(printerId);
-        if (it == printers_.end())
         {
-            ELEGOO_LOG_ERROR("Printer {} not found", StringUtils::maskString(printerId));
-            return false;
+            std::lock_guard<std::mutex> lock(printersMutex_);
+
+            auto printer = getPrinter(printerId);
+            if (!printer)
+            {
+                ELEGOO_LOG_ERROR("Printer {} not found", StringUtils::maskString(printerId));
+                return false;
+            }
+
+            // Disconnect printer connection
+            if (printer->isConnected())
+            {
+                (void)printer->disconnect(); // Ignore return value
+            }
+
+            publish(printerId, nullptr);
+            ELEGOO_LOG_INFO("Printer {} removed from manager", StringUtils::maskString(printerId));
         }
 
-        // Disconnect printer connection
-        auto printer = it->second;
-        if (printer && printer->isConnected())
+        // Consumers keeping per-printer state drop it on this event
+        std::function<void(const BizEvent &)> callback;
         {
-            (void)printer->disconnect(); // Ignore return value
+            std::lock_guard<std::mutex> lock(callbackMutex_);
+            callback = eventCallback;
+        }
+        if (callback)
+        {
+            PrinterListChangedData change;
+            change.removedPrinterIds.push_back(printerId);
+            BizEvent event;
+            event.method = MethodType::ON_PRINTER_LIST_CHANGED;
+            event.data = change;
+            callback(event);
         }
-
-        printers_.erase(it);
-        ELEGOO_LOG_INFO("Printer {} removed from manager", StringUtils::maskString(printerId));
         return true;
     }
 
@@ -155,7 +172,7 @@ namespace elink
         const std::string &printerId = printer->getId();
 
         // Check if printer already exists
-        if (printers_.find(printerId) != printers_.end())
+        if (getPrinter(printerId))
         {
             ELEGOO_LOG_INFO("Printer {} already exists in manager, replacing it", StringUtils::maskString(printerId));
         }
@@ -169,38 +186,75 @@ namespace elink
             }
         }
 
-        printers_[printerId] = printer;
+        publish(printerId, printer);
         ELEGOO_LOG_DEBUG("Printer {} added to manager", StringUtils::maskString(printerId));
         return true;
     }
 
-    std::vector<PrinterPtr> PrinterManager::getAllPrinters()
+    PrinterListPtr PrinterManager::getAllPrinters() const
     {
-        std::lock_guard<std::mutex> lock(printersMutex_);
+        auto registry = getRegistry();
+        return PrinterListPtr(registry, &registry->printers);
+    }
+
+    std::vector<PrinterPtr> PrinterManager::getConnectedPrinters() const
+    {
+        auto registry = getRegistry();
 
-        std::vector<PrinterPtr> printers;
-        for (const auto &[printer_id, printer] : printers_)
+        std::vector<PrinterPtr> connected_printers;
+        for (const auto &printer : registry->printers)
         {
-            printers.push_back(printer);
+            if (printer->isConnected())
+            {
+                connected_printers.push_back(printer);
+            }
         }
 
-        return printers;
+        return connected_printers;
     }
 
-    std::vector<PrinterPtr> PrinterManager::getConnectedPrinters()
+    PrinterRegistryPtr PrinterManager::getRegistry() const
     {
-        std::lock_guard<std::mutex> lock(printersMutex_);
+        return std::atomic_load(&registry_);
+    }
 
-        std::vector<PrinterPtr> connected_printers;
-        for (const auto &[printer_id, printer] : printers_)
+    void PrinterManager::publish(const std::string &printerId, PrinterPtr printer)
+    {
+        auto current = getRegistry();
+        if (!printer && current->byId.find(printerId) == current->byId.end())
+        {
+            return;
+        }
+
+        auto registry = std::make_shared<PrinterRegistry>(*current);
+
+        // printers stays sorted, so only the changed entry moves instead of re-sorting the list
+        auto pos = std::lower_bound(registry->printers.begin(), registry->printers.end(), printerId,
+                                    [](const PrinterPtr &entry, const std::string &id)
+                                    { return entry->getId() < id; });
+        bool found = pos != registry->printers.end() && (*pos)->getId() == printerId;
+        if (printer)
         {
-            if (printer && printer->isConnected())
+            registry->byId[printerId] = printer;
+            if (found)
             {
-                connected_printers.push_back(printer);
+                *pos = std::move(printer);
+            }
+            else
+            {
+                registry->printers.insert(pos, std::move(printer));
+            }
+        }
+        else
+        {
+            registry->byId.erase(printerId);
+            if (found)
+            {
+                registry->printers.erase(pos);
             }
         }
 
-        return connected_printers;
+        std::atomic_store(&registry_, PrinterRegistryPtr(std::move(registry)));
     }
 
     // ========== Batch Operations ==========
@@ -209,9 +263,9 @@ namespace elink
     {
         auto printers = getAllPrinters();
 
-        for (auto &printer : printers)
+        for (const auto &printer : *printers)
         {
-            if (printer && printer->isConnected())
+            if (printer->isConnected())
             {
                 printer->setEventCallback(nullptr); // Clear printer status callback
                 (void)printer->disconnect();        // Ignore return value
@@ -220,17 +274,15 @@ namespace elink
 
         ELEGOO_LOG_INFO("Disconnected all printers");
     }
-    std::vector<PrinterInfo> PrinterManager::getCachedPrinters() const
+    std::vector<PrinterInfoPtr> PrinterManager::getPrinterInfos() const
     {
-        std::lock_guard<std::mutex> lock(printersMutex_);
+        auto registry = getRegistry();
 
-        std::vector<PrinterInfo> printerInfos;
-        for (const auto &[printer_id, printer] : printers_)
+        std::vector<PrinterInfoPtr> printerInfos;
+        printerInfos.reserve(registry->printers.size());
+        for (const auto &printer : registry->printers)
         {
-            if (printer)
-            {
-                printerInfos.push_back(printer->getPrinterInfo());
-            }
+            printerInfos.push_back(printer->getPrinterInfo());
         }
 
         return printerInfos;
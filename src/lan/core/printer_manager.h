@@ -1,8 +1,9 @@
 #pragma once
 
 #include <string>
-#include <map>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 #include <mutex>
 #include <atomic>
 #include <thread>
@@ -13,6 +14,20 @@
 #include "types/internal/internal.h"
 namespace elink 
 {
+    /**
+     * Immutable view of the registered printers
+     * Writers build a new registry and publish it atomically; readers keep the one they
+     * loaded for as long as they hold it, without blocking or being blocked by writers.
+     */
+    struct PrinterRegistry
+    {
+        std::unordered_map<std::string, PrinterPtr> byId; // Registered printers by printer id
+        std::vector<PrinterPtr> printers;                  // Registered printers ordered by printer id
+    };
+
+    using PrinterRegistryPtr = std::shared_ptr<const PrinterRegistry>;
+    using PrinterListPtr = std::shared_ptr<const std::vector<PrinterPtr>>;
+
     /**
      * Printer Manager (Redesigned)
      * Responsibilities:
@@ -52,7 +67,7 @@ namespace elink
          * @param printerId Printer ID
          * @return Smart pointer to the printer, returns nullptr if not found
          */
-        PrinterPtr getPrinter(const std::string &printerId);
+        PrinterPtr getPrinter(const std::string &printerId) const;
 
         /**
          * Remove a printer instance
@@ -70,15 +85,21 @@ namespace elink
 
         /**
          * Get all printers
-         * @return List of smart pointers to printers
+         * @return Shared immutable list of printers ordered by printer id; not affected by later changes
          */
-        std::vector<PrinterPtr> getAllPrinters();
+        PrinterListPtr getAllPrinters() const;
 
         /**
          * Get connected printers
          * @return List of smart pointers to connected printers
          */
-        std::vector<PrinterPtr> getConnectedPrinters();
+        std::vector<PrinterPtr> getConnectedPrinters() const;
+
+        /**
+         * Get the current registry
+         * @return Shared immutable registry; not affected by later changes
+         */
+        PrinterRegistryPtr getRegistry() const;
 
         // ========== Batch Operations ==========
 
@@ -100,10 +121,21 @@ namespace elink
          */
         void setPrinterEventCallback(std::function<void(const BizEvent &)> callback);
 
-        std::vector<PrinterInfo> getCachedPrinters() const;
+        /**
+         * Get the information of all printers without copying it
+         * @return Shared snapshots, ordered by printer id
+         */
+        std::vector<PrinterInfoPtr> getPrinterInfos() const;
     private:
-        // Printer mapping table
-        std::map<std::string, PrinterPtr> printers_;
+        /**
+         * Publish a copy of the current registry with printerId set to printer (nullptr removes it)
+         * Must be called with printersMutex_ held.
+         */
+        void publish(const std::string &printerId, PrinterPtr printer);
+
+        // Current registry, replaced as a whole on every change and read without printersMutex_
+        PrinterRegistryPtr registry_;
+        // Serializes writers
         mutable std::mutex printersMutex_;
 
         // Global callback functions
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include "type.h"
+
+namespace elink
+{
+    /**
+     * Printer information shared by a printer and its message adapter
+     *
+     * Readers get an immutable snapshot that stays valid while they hold it; enumerating
+     * printers or attaching the information to an event copies a pointer instead of the
+     * strings. Updates copy the current snapshot, apply the change and publish the copy with a
+     * new version, so readers never see a half-written PrinterInfo.
+     */
+    class SharedPrinterInfo
+    {
+    public:
+        explicit SharedPrinterInfo(const PrinterInfo &printerInfo)
+            : info_(std::make_shared<const PrinterInfo>(printerInfo))
+        {
+        }
+
+        static std::shared_ptr<SharedPrinterInfo> create(const PrinterInfo &printerInfo)
+        {
+            return std::make_shared<SharedPrinterInfo>(printerInfo);
+        }
+
+        SharedPrinterInfo(const SharedPrinterInfo &) = delete;
+        SharedPrinterInfo &operator=(const SharedPrinterInfo &) = delete;
+
+        /**
+         * Current snapshot
+         */
+        PrinterInfoPtr get() const
+        {
+            return std::atomic_load(&info_);
+        }
+
+        /**
+         * Version of the current snapshot, starting at 1 and incremented by every update
+         */
+        uint64_t getVersion() const
+        {
+            return version_.load(std::memory_order_acquire);
+        }
+
+        /**
+         * Copy-on-write update
+         * @param modifier Called with a private copy of the current information
+         * @return Version of the published snapshot
+         */
+        template <typename Modifier>
+        uint64_t update(Modifier &&modifier)
+        {
+            std::lock_guard<std::mutex> lock(writeMutex_);
+            auto next = std::make_shared<PrinterInfo>(*get());
+            std::forward<Modifier>(modifier)(*next);
+            std::atomic_store(&info_, PrinterInfoPtr(std::move(next)));
+            return version_.fetch_add(1, std::memory_order_acq_rel) + 1;
+        }
+
+    private:
+        PrinterInfoPtr info_;
+        std::atomic<uint64_t> version_{1};
+        std::mutex writeMutex_;
+    };
+
+} // namespace elink
@@ -0,0 +1,305 @@
+#include "core/wire_capture.h"
+#include "types/internal/json_serializer.h"
+#include "utils/logger.h"
+#include "utils/utils.h"
+#include <nlohmann/json.hpp>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+
+namespace elink
+{
+    std::atomic<bool> WireCapture::enabled_{false};
+
+    namespace
+    {
+        // Guards the reader against allocating for a corrupt length
+        constexpr uint64_t MAX_RECORD_SIZE = 64 * 1024 * 1024;
+
+        void writeU16(std::ostream &out, uint16_t value)
+        {
+            char bytes[2] = {static_cast<char>(value & 0xFF), static_cast<char>(value >> 8)};
+            out.write(bytes, sizeof(bytes));
+        }
+
+        void writeU32(std::ostream &out, uint32_t value)
+        {
+            char bytes[4];
+            for (int i = 0; i < 4; ++i)
+            {
+                bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+            }
+            out.write(bytes, sizeof(bytes));
+        }
+
+        void writeU64(std::ostream &out, uint64_t value)
+        {
+            char bytes[8];
+            for (int i = 0; i < 8; ++i)
+            {
+                bytes[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+            }
+            out.write(bytes, sizeof(bytes));
+        }
+
+        void writeVarint(std::ostream &out, uint64_t value)
+        {
+            char bytes[10];
+            size_t size = 0;
+            while (value >= 0x80)
+            {
+                bytes[size++] = static_cast<char>((value & 0x7F) | 0x80);
+                value >>= 7;
+            }
+            bytes[size++] = static_cast<char>(value);
+            out.write(bytes, static_cast<std::streamsize>(size));
+        }
+
+        bool readLittleEndian(std::istream &in, size_t size, uint64_t &value)
+        {
+            unsigned char bytes[8] = {};
+            if (!in.read(reinterpret_cast<char *>(bytes), static_cast<std::streamsize>(size)))
+            {
+                return false;
+            }
+            value = 0;
+            for (size_t i = 0; i < size; ++i)
+            {
+                value |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+            }
+            return true;
+        }
+
+        bool readVarint(std::istream &in, uint64_t &value)
+        {
+            value = 0;
+            for (int shift = 0; shift < 64; shift += 7)
+            {
+                int byte = in.get();
+                if (byte == std::char_traits<char>::eof())
+                {
+                    return false;
+                }
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::string sanitizeFileName(const std::string &name)
+        {
+            std::string result = name;
+            for (auto &c : result)
+            {
+                if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '_')
+                {
+                    c = '_';
+                }
+            }
+            return result.empty() ? "printer" : result;
+        }
+    } // namespace
+
+    // ========== WireCapture ==========
+
+    WireCapture &WireCapture::getInstance()
+    {
+        static WireCapture instance;
+        return instance;
+    }
+
+    WireCapture::~WireCapture()
+    {
+        stop();
+    }
+
+    bool WireCapture::start(const std::string &directory)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (enabled_)
+        {
+            ELEGOO_LOG_WARN("Wire capture is already running, writing to {}", directory_);
+            return false;
+        }
+
+        std::error_code ec;
+        std::filesystem::create_directories(std::filesystem::u8path(directory), ec);
+        if (ec)
+        {
+            ELEGOO_LOG_ERROR("Failed to create wire capture directory {}: {}", directory, ec.message());
+            return false;
+        }
+
+        directory_ = directory;
+        sessionTag_ = TimeUtils::getCurrentTimeString("%Y%m%d-%H%M%S");
+        writers_.clear();
+        enabled_ = true;
+        ELEGOO_LOG_INFO("Wire capture started, directory: {}", directory_);
+        return true;
+    }
+
+    void WireCapture::stop()
+    {
+        std::map<std::string, std::shared_ptr<Writer>> writers;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!enabled_)
+            {
+                return;
+            }
+            enabled_ = false;
+            writers.swap(writers_);
+        }
+
+        uint64_t records = 0;
+        for (auto &[printerId, writer] : writers)
+        {
+            std::lock_guard<std::mutex> lock(writer->mutex);
+            records += writer->records;
+            writer->out.close();
+        }
+        ELEGOO_LOG_INFO("Wire capture stopped, {} messages from {} printers", records, writers.size());
+    }
+
+    std::shared_ptr<WireCapture::Writer> WireCapture::getWriter(const PrinterInfo &printerInfo)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!enabled_)
+        {
+            return nullptr;
+        }
+
+        auto it = writers_.find(printerInfo.printerId);
+        if (it != writers_.end())
+        {
+            return it->second;
+        }
+
+        auto writer = std::make_shared<Writer>();
+        std::string fileName = (std::filesystem::u8path(directory_) /
+                                std::filesystem::u8path(sanitizeFileName(printerInfo.printerId) + "_" + sessionTag_ + WIRE_CAPTURE_EXTENSION))
+                                   .u8string();
+        writer->out = PathUtils::openOutputStream(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!writer->out.is_open())
+        {
+            ELEGOO_LOG_ERROR("Failed to open wire capture file {}", fileName);
+        }
+        else
+        {
+            std::string info = nlohmann::json(printerInfo).dump();
+            writer->out.write(WIRE_CAPTURE_MAGIC, sizeof(WIRE_CAPTURE_MAGIC));
+            writeU16(writer->out, WIRE_CAPTURE_VERSION);
+            writeU16(writer->out, 0);
+            writeU64(writer->out, static_cast<uint64_t>(TimeUtils::getCurrentTimestamp()));
+            writeU32(writer->out, static_cast<uint32_t>(info.size()));
+            writer->out.write(info.data(), static_cast<std::streamsize>(info.size()));
+            ELEGOO_LOG_DEBUG("Wire capture file opened: {}", fileName);
+        }
+        writer->lastRecordTime = std::chrono::steady_clock::now();
+
+        // A failed file stays registered so the open is not retried for every message
+        writers_[printerInfo.printerId] = writer;
+        return writer;
+    }
+
+    void WireCapture::record(const PrinterInfo &printerInfo, WireDirection direction, const std::string &data)
+    {
+        auto writer = getWriter(printerInfo);
+        if (!writer)
+        {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(writer->mutex);
+        if (!writer->out.is_open())
+        {
+            return;
+        }
+        auto now = std::chrono::steady_clock::now();
+        auto deltaUs = std::chrono::duration_cast<std::chrono::microseconds>(now - writer->lastRecordTime).count();
+        writer->lastRecordTime = now;
+
+        writer->out.put(static_cast<char>(direction));
+        writeVarint(writer->out, static_cast<uint64_t>(deltaUs > 0 ? deltaUs : 0));
+        writeVarint(writer->out, data.size());
+        writer->out.write(data.data(), static_cast<std::streamsize>(data.size()));
+        writer->records++;
+    }
+
+    // ========== WireCaptureReader ==========
+
+    bool WireCaptureReader::open(const std::string &fileName)
+    {
+        in_ = PathUtils::openInputStream(fileName, std::ios::in | std::ios::binary);
+        if (!in_.is_open())
+        {
+            ELEGOO_LOG_ERROR("Failed to open wire capture file {}", fileName);
+            return false;
+        }
+
+        char magic[sizeof(WIRE_CAPTURE_MAGIC)];
+        uint64_t version = 0, reserved = 0, startTime = 0, infoSize = 0;
+        if (!in_.read(magic, sizeof(magic)) || std::memcmp(magic, WIRE_CAPTURE_MAGIC, sizeof(magic)) != 0 ||
+            !readLittleEndian(in_, 2, version) || !readLittleEndian(in_, 2, reserved) ||
+            !readLittleEndian(in_, 8, startTime) || !readLittleEndian(in_, 4, infoSize))
+        {
+            ELEGOO_LOG_ERROR("{} is not a wire capture file", fileName);
+            return false;
+        }
+        if (version > WIRE_CAPTURE_VERSION)
+        {
+            ELEGOO_LOG_ERROR("Unsupported wire capture version {} in {}", version, fileName);
+            return false;
+        }
+
+        std::string info(infoSize, '\0');
+        if (!in_.read(&info[0], static_cast<std::streamsize>(infoSize)))
+        {
+            ELEGOO_LOG_ERROR("Truncated wire capture header in {}", fileName);
+            return false;
+        }
+        try
+        {
+            printerInfo_ = nlohmann::json::parse(info).get<PrinterInfo>();
+        }
+        catch (const std::exception &e)
+        {
+            ELEGOO_LOG_ERROR("Invalid printer information in {}: {}", fileName, e.what());
+            return false;
+        }
+
+        startTimeMs_ = static_cast<int64_t>(startTime);
+        timestampUs_ = 0;
+        return true;
+    }
+
+    bool WireCaptureReader::next(WireRecord &record)
+    {
+        int direction = in_.get();
+        if (direction == std::char_traits<char>::eof())
+        {
+            return false;
+        }
+
+        uint64_t deltaUs = 0, size = 0;
+        if (!readVarint(in_, deltaUs) || !readVarint(in_, size) || size > MAX_RECORD_SIZE)
+        {
+            return false;
+        }
+        std::string data(size, '\0');
+        if (size > 0 && !in_.read(&data[0], static_cast<std::streamsize>(size)))
+        {
+            return false;
+        }
+        record.data = PayloadBuffer(std::move(data));
+
+        timestampUs_ += deltaUs;
+        record.direction = static_cast<WireDirection>(direction);
+        record.timestampUs = timestampUs_;
+        return true;
+    }
+
+} // namespace elink
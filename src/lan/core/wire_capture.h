@@ -0,0 +1,128 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "type.h"
+#include "protocols/payload_buffer.h"
+#include "elegoo_export.h"
+
+namespace elink
+{
+    /**
+     * Direction of a captured message, seen from the SDK
+     */
+    enum class WireDirection : uint8_t
+    {
+        INBOUND = 0,  // Printer -> SDK
+        OUTBOUND = 1, // SDK -> printer
+    };
+
+    /**
+     * One captured message
+     */
+    struct WireRecord
+    {
+        WireDirection direction = WireDirection::INBOUND;
+        uint64_t timestampUs = 0; // Microseconds since the capture started
+        PayloadBuffer data;       // Handed to the replayed printer as is
+    };
+
+    /**
+     * Wire capture file format (.elwc), one file per printer, little-endian:
+     *
+     *   header: "ELWC" | u16 version | u16 reserved | u64 start time (unix ms) | u32 length | PrinterInfo JSON
+     *   record: u8 direction | varint delta us since previous record | varint length | payload
+     */
+    constexpr char WIRE_CAPTURE_MAGIC[4] = {'E', 'L', 'W', 'C'};
+    constexpr uint16_t WIRE_CAPTURE_VERSION = 1;
+    constexpr const char *WIRE_CAPTURE_EXTENSION = ".elwc";
+
+    /**
+     * Records every inbound and outbound printer message with timestamps
+     *
+     * Opt-in; while stopped, record() costs a single relaxed atomic load at the call site.
+     * Captures contain the raw printer traffic, including any credentials sent in it.
+     */
+    class ELEGOO_LINK_API WireCapture
+    {
+    public:
+        static WireCapture &getInstance();
+
+        /**
+         * Start capturing into one file per printer
+         * @param directory Output directory, created if missing
+         * @return false if already capturing or the directory cannot be created
+         */
+        bool start(const std::string &directory);
+
+        /**
+         * Stop capturing and close all files
+         */
+        void stop();
+
+        static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+        /**
+         * Append a message to the printer's capture file
+         */
+        void record(const PrinterInfo &printerInfo, WireDirection direction, const std::string &data);
+
+    private:
+        struct Writer
+        {
+            std::mutex mutex;
+            std::ofstream out;
+            std::chrono::steady_clock::time_point lastRecordTime;
+            uint64_t records = 0;
+        };
+
+        WireCapture() = default;
+        ~WireCapture();
+        WireCapture(const WireCapture &) = delete;
+        WireCapture &operator=(const WireCapture &) = delete;
+
+        std::shared_ptr<Writer> getWriter(const PrinterInfo &printerInfo);
+
+        static std::atomic<bool> enabled_;
+
+        std::mutex mutex_;
+        std::string directory_;
+        std::string sessionTag_;
+        std::map<std::string, std::shared_ptr<Writer>> writers_;
+    };
+
+    /**
+     * Sequential reader of a wire capture file
+     */
+    class ELEGOO_LINK_API WireCaptureReader
+    {
+    public:
+        /**
+         * Open a capture file and read its header
+         * @return false if the file cannot be read or is not a wire capture
+         */
+        bool open(const std::string &fileName);
+
+        /**
+         * Read the next record
+         * @return false at the end of the file or on a truncated record
+         */
+        bool next(WireRecord &record);
+
+        const PrinterInfo &getPrinterInfo() const { return printerInfo_; }
+        int64_t getStartTimeMs() const { return startTimeMs_; }
+
+    private:
+        std::ifstream in_;
+        PrinterInfo printerInfo_;
+        int64_t startTimeMs_ = 0;
+        uint64_t timestampUs_ = 0;
+    };
+
+} // namespace elink
@@ -0,0 +1,211 @@
+#include "core/wire_replay.h"
+#include "core/base_printer.h"
+#include "core/printer_factory.h"
+#include "protocols/protocol_interface.h"
+#include "utils/logger.h"
+#include "utils/utils.h"
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+namespace elink
+{
+    namespace
+    {
+        /**
+         * Transport delivering captured messages instead of talking to a printer
+         */
+        class ReplayProtocol : public IProtocol
+        {
+        public:
+            VoidResult connect(const ConnectPrinterParams &connectParams, bool autoReconnect = true) override
+            {
+                (void)connectParams;
+                (void)autoReconnect;
+                connected_ = true;
+                notifyStatus(true);
+                return VoidResult::Success();
+            }
+
+            void disconnect() override
+            {
+                connected_ = false;
+                notifyStatus(false);
+            }
+
+            bool isConnected() const override { return connected_; }
+
+            bool sendCommand(const std::string &data = "") override
+            {
+                (void)data;
+                commandsSent_++;
+                return true;
+            }
+
+            void setMessageCallback(std::function<void(const PayloadBuffer &)> callback) override
+            {
+                std::lock_guard<std::mutex> lock(callbackMutex_);
+                messageCallback_ = callback;
+            }
+
+            void setConnectStatusCallback(std::function<void(bool)> callback) override
+            {
+                std::lock_guard<std::mutex> lock(callbackMutex_);
+                statusCallback_ = callback;
+            }
+
+            std::string getProtocolType() const override { return "replay"; }
+
+            void deliver(const PayloadBuffer &message)
+            {
+                std::function<void(const PayloadBuffer &)> callback;
+                {
+                    std::lock_guard<std::mutex> lock(callbackMutex_);
+                    callback = messageCallback_;
+                }
+                if (callback)
+                {
+                    callback(message);
+                }
+            }
+
+            uint64_t getCommandsSent() const { return commandsSent_; }
+
+        private:
+            void notifyStatus(bool connected)
+            {
+                std::function<void(bool)> callback;
+                {
+                    std::lock_guard<std::mutex> lock(callbackMutex_);
+                    callback = statusCallback_;
+                }
+                if (callback)
+                {
+                    callback(connected);
+                }
+            }
+
+            std::atomic<bool> connected_{false};
+            std::atomic<uint64_t> commandsSent_{0};
+            std::mutex callbackMutex_;
+            std::function<void(const PayloadBuffer &)> messageCallback_;
+            std::function<void(bool)> statusCallback_;
+        };
+    } // namespace
+
+    bool WireReplay::load(const std::string &fileName)
+    {
+        WireCaptureReader reader;
+        if (!reader.open(fileName))
+        {
+            return false;
+        }
+
+        printerInfo_ = reader.getPrinterInfo();
+        records_.clear();
+        // A stop() before run() still cancels the replay, so it is only cleared for a new capture
+        stopRequested_ = false;
+        WireRecord record;
+        while (reader.next(record))
+        {
+            records_.push_back(std::move(record));
+            record = WireRecord();
+        }
+        ELEGOO_LOG_INFO("Loaded {} captured messages of printer {} from {}",
+                        records_.size(), StringUtils::maskString(printerInfo_.printerId), fileName);
+        return true;
+    }
+
+    WireReplayStats WireReplay::run(const WireReplayOptions &options,
+                                    std::function<void(const BizEvent &)> eventCallback)
+    {
+        WireReplayStats stats;
+        if (records_.empty())
+        {
+            return stats;
+        }
+
+        auto printer = PrinterFactory::createPrinter(printerInfo_);
+        if (!printer)
+        {
+            ELEGOO_LOG_ERROR("Cannot replay capture: unsupported printer type {}",
+                             printerTypeToString(printerInfo_.printerType));
+            return stats;
+        }
+
+        auto protocol = std::make_unique<ReplayProtocol>();
+        ReplayProtocol *replayProtocol = protocol.get();
+        printer->replaceProtocol(std::move(protocol));
+
+        std::atomic<uint64_t> eventsDelivered{0};
+        printer->setEventCallback([&eventsDelivered, eventCallback](const BizEvent &event)
+                                  {
+                                      eventsDelivered++;
+                                      if (eventCallback)
+                                      {
+                                          eventCallback(event);
+                                      }
+                                  });
+
+        // BasePrinter drops messages and requests while disconnected
+        ConnectPrinterParams connectParams;
+        connectParams.printerId = printerInfo_.printerId;
+        connectParams.printerType = printerInfo_.printerType;
+        connectParams.brand = printerInfo_.brand;
+        connectParams.name = printerInfo_.name;
+        connectParams.model = printerInfo_.model;
+        connectParams.host = printerInfo_.host.empty() ? "replay" : printerInfo_.host;
+        connectParams.serialNumber = printerInfo_.serialNumber;
+        connectParams.authMode = printerInfo_.authMode;
+        auto connectResult = printer->connect(connectParams);
+        if (connectResult.isError())
+        {
+            ELEGOO_LOG_ERROR("Cannot replay capture: connecting the replayed printer failed: {}",
+                             connectResult.message);
+            printer->setEventCallback(nullptr);
+            return stats;
+        }
+
+        const uint64_t capturedDurationUs = records_.back().timestampUs;
+        stats.capturedDurationSec = capturedDurationUs / 1e6;
+        const bool paced = options.speed > 0.0;
+        auto start = std::chrono::steady_clock::now();
+
+        for (int loop = 0; loop < std::max(options.loops, 1) && !stopRequested_; ++loop)
+        {
+            const uint64_t loopOffsetUs = static_cast<uint64_t>(loop) * capturedDurationUs;
+            for (const auto &record : records_)
+            {
+                if (stopRequested_)
+                {
+                    break;
+                }
+                if (record.direction == WireDirection::OUTBOUND)
+                {
+                    stats.outboundMessages++;
+                    continue;
+                }
+
+                if (paced)
+                {
+                    auto dueUs = static_cast<int64_t>((loopOffsetUs + record.timestampUs) / options.speed);
+                    std::this_thread::sleep_until(start + std::chrono::microseconds(dueUs));
+                }
+                replayProtocol->deliver(record.data);
+                stats.inboundMessages++;
+                stats.inboundBytes += record.data.size();
+            }
+        }
+
+        stats.durationSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        stats.commandsSent = replayProtocol->getCommandsSent();
+        stats.eventsDelivered = eventsDelivered;
+        stats.stopped = stopRequested_;
+
+        printer->disconnect();
+        printer->setEventCallback(nullptr);
+        return stats;
+    }
+
+} // namespace elink
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "core/wire_capture.h"
+#include "types/internal/internal.h"
+
+namespace elink
+{
+    /**
+     * Replay pacing options
+     */
+    struct WireReplayOptions
+    {
+        double speed = 1.0; // Playback speed multiplier (1 = captured timing, 10 = 10x); 0 replays as fast as possible
+        int loops = 1;      // Number of passes over the capture
+    };
+
+    /**
+     * Replay results
+     */
+    struct WireReplayStats
+    {
+        uint64_t inboundMessages = 0;  // Captured printer messages fed to the printer
+        uint64_t inboundBytes = 0;     // Payload bytes of those messages
+        uint64_t outboundMessages = 0; // Captured SDK messages (skipped, the replayed printer sends its own)
+        uint64_t commandsSent = 0;     // Messages the replayed printer tried to send
+        uint64_t eventsDelivered = 0;  // Events emitted by the printer pipeline
+        double capturedDurationSec = 0.0;
+        double durationSec = 0.0;      // Wall time of the replay
+        bool stopped = false;          // Replay interrupted by stop()
+    };
+
+    /**
+     * Feeds a wire capture back through the real message adapter and BasePrinter pipeline
+     *
+     * The printer is created by PrinterFactory from the captured PrinterInfo; its transport is
+     * replaced by one that delivers the captured inbound messages. Responses to requests of the
+     * original session do not correlate with anything during replay and are dropped as unknown.
+     */
+    class ELEGOO_LINK_API WireReplay
+    {
+    public:
+        /**
+         * Load a capture file into memory, so disk reads do not skew the replay timing
+         * @return false if the file cannot be read
+         */
+        bool load(const std::string &fileName);
+
+        const PrinterInfo &getPrinterInfo() const { return printerInfo_; }
+        size_t getRecordCount() const { return records_.size(); }
+
+        /**
+         * Run the replay on the calling thread
+         * @param options Pacing options
+         * @param eventCallback Receives every event the printer emits, as LanService would
+         * @return Replay results
+         */
+        WireReplayStats run(const WireReplayOptions &options,
+                            std::function<void(const BizEvent &)> eventCallback = nullptr);
+
+        /**
+         * Interrupt the replay (thread-safe); a stop before run() cancels it until the next load()
+         */
+        void stop() { stopRequested_ = true; }
+
+    private:
+        PrinterInfo printerInfo_;
+        std::vector<WireRecord> records_;
+        std::atomic<bool> stopRequested_{false};
+    };
+
+} // namespace elink
@@ -128,6 +128,11 @@ namespace elink
                 // 6. Initialize static web server if enabled
                 pImpl_->server_ = std::make_unique<StaticWebServer>(config.webServerPort);
                 pImpl_->server_->setStaticPath(s_staticWebPath);
+                pImpl_->server_->enableStatusPush(eventBus_);
+                if (config.webServerThreads > 0)
+                {
+                    pImpl_->server_->setWorkerThreads(static_cast<size_t>(config.webServerThreads));
+                }
                 if (pImpl_->server_->start())
                 {
                     ELEGOO_LOG_INFO("Static web server started on port {}", config.webServerPort);
@@ -483,24 +488,46 @@ namespace elink
                 "Printer manager is not available"};
         }
 
-        auto printers = pImpl_->printerManager_->getAllPrinters();
+        auto printerInfos = pImpl_->printerManager_->getPrinterInfos();
         GetPrinterListResult response;
         response.code = ELINK_ERROR_CODE::SUCCESS;
 
-        std::vector<PrinterInfo> printerInfos;
-        for (const auto &printer : printers)
+        // The result is handed to the caller by value, so each printer is copied here once
+        response.data = GetPrinterListData();
+        auto &printers = response.data.value().printers;
+        printers.reserve(printerInfos.size());
+        for (const auto &printerInfo : printerInfos)
         {
-            if (printer)
-            {
-                printerInfos.push_back(printer->getPrinterInfo());
-            }
+            printers.push_back(*printerInfo);
         }
-        response.data = GetPrinterListData();
-        response.data.value().printers = printerInfos;
 
         return response;
     }
 
+    PrinterResourceStatsResult LanService::getPrinterResourceStats(const PrinterResourceStatsParams &params)
+    {
+        VALIDATE_AND_GET_PRINTER(params.printerId, printer, PrinterResourceStatsResult)
+        return PrinterResourceStatsResult::Ok(printer->getResourceStats());
+    }
+
+    PrinterResourceStatsListResult LanService::getAllPrinterResourceStats()
+    {
+        if (!pImpl_->initialized_ || !pImpl_->printerManager_)
+        {
+            ELEGOO_LOG_ERROR("LanService is not initialized");
+            return PrinterResourceStatsListResult::Error(
+                ELINK_ERROR_CODE::NOT_INITIALIZED,
+                "LanService is not initialized");
+        }
+
+        PrinterResourceStatsListData data;
+        for (const auto &printer : *pImpl_->printerManager_->getAllPrinters())
+        {
+            data.printers.push_back(printer->getResourceStats());
+        }
+        return PrinterResourceStatsListResult::Ok(std::move(data));
+    }
+
     std::shared_ptr<Printer> LanService::getPrinter(const std::string &printerId)
     {
         if (!pImpl_->initialized_ || !pImpl_->printerManager_)
@@ -548,7 +575,7 @@ namespace elink
             PrinterType::GENERIC_FDM_KLIPPER};
     }
 
-    std::vector<PrinterInfo> LanService::getCachedPrinters() const
+    std::vector<PrinterInfoPtr> LanService::getCachedPrinters() const
     {
         if (!pImpl_->initialized_)
         {
@@ -560,7 +587,7 @@ namespace elink
             ELEGOO_LOG_ERROR("Printer manager is not available");
             return {};
         }
-        return pImpl_->printerManager_->getCachedPrinters();
+        return pImpl_->printerManager_->getPrinterInfos();
     }
 
     // ========== Private Method Implementation ==========
@@ -618,7 +645,7 @@ namespace elink
             result.message = "Printer already connected";
 
             ConnectPrinterData connectResult;
-            connectResult.printerInfo = existingPrinter->getPrinterInfo();
+            connectResult.printerInfo = *existingPrinter->getPrinterInfo();
             connectResult.isConnected = true;
             result.data = connectResult;
             return result;
@@ -760,7 +787,7 @@ namespace elink
         }
 
         ConnectPrinterData connectResult;
-        connectResult.printerInfo = printer->getPrinterInfo();
+        connectResult.printerInfo = *printer->getPrinterInfo();
         connectResult.isConnected = (connectResponse.code == ELINK_ERROR_CODE::SUCCESS);
         result.data = connectResult;
 
@@ -819,7 +846,7 @@ namespace elink
 
         // Directly call uploadFile and get the result
         auto result = fileUploader->uploadFile(
-            printer->getPrinterInfo(),
+            *printer->getPrinterInfo(),
             params,
             [progressCallback](const FileUploadProgressData &progressData) -> bool
             {
@@ -887,6 +914,12 @@ namespace elink
         return printer->getPrinterStatus(params, timeout);
     }
 
+    StatusIfNewerResult LanService::getStatusIfNewer(const StatusIfNewerParams &params)
+    {
+        VALIDATE_AND_GET_PRINTER(params.printerId, printer, StatusIfNewerResult)
+        return printer->getStatusIfNewer(params);
+    }
+
     VoidResult LanService::refreshPrinterAttributes(const PrinterAttributesParams &params)
     {
         // Fire and forget - use very short timeout (1ms) to return immediately
@@ -37,13 +37,14 @@ namespace elink
          */
         struct Config
         {
-            Config() :enableWebServer(false), webServerPort(32538) {}
+            Config() :enableWebServer(false), webServerPort(32538), webServerThreads(0) {}
             // Web server configuration
             // Whether to enable static web server, if enabled, the static web server will serve the Vue compiled web pages
             // This is useful for displaying the SDK's web interface in the software
             bool enableWebServer;      // Whether to enable static web server
             int webServerPort;         // Static web server port
             std::string staticWebPath; // Path to static web files, if empty, no static web server will be started
+            int webServerThreads;      // Static web server worker threads, 0 for the httplib default
         };
 
         /**
@@ -223,6 +224,12 @@ namespace elink
          */
         PrinterStatusResult getPrinterStatus(const PrinterStatusParams &params, int timeout = 3000);
 
+        /**
+         * Get the latest recorded printer status if it is newer than the caller's, without a request
+         * @param params Printer ID and known status version
+         */
+        StatusIfNewerResult getStatusIfNewer(const StatusIfNewerParams &params);
+
         /**
          * Refresh printer attributes, The result will be notified through events
          * @param params Printer attributes parameters
@@ -277,6 +284,21 @@ namespace elink
 
         VoidResult setAutoRefill(const SetAutoRefillParams &params);
 
+        // ========== Resource accounting ==========
+
+        /**
+         * Get traffic, transfer, cache memory and event rate counters of a printer
+         * @param params Printer base parameters
+         * @return Printer resource counters
+         */
+        PrinterResourceStatsResult getPrinterResourceStats(const PrinterResourceStatsParams &params);
+
+        /**
+         * Get resource counters of all registered printers
+         * @return Resource counters, one entry per printer
+         */
+        PrinterResourceStatsListResult getAllPrinterResourceStats();
+
         // ========== Callback management ==========
         /**
          * General strongly-typed event subscription method
@@ -323,7 +345,11 @@ namespace elink
          */
         std::vector<PrinterType> getSupportedPrinterTypes() const;
 
-        std::vector<PrinterInfo> getCachedPrinters() const;
+        /**
+         * Get the information of all registered printers without copying it
+         * @return Shared snapshots, ordered by printer id
+         */
+        std::vector<PrinterInfoPtr> getCachedPrinters() const;
 
         VoidResult updatePrinterName(const UpdatePrinterNameParams &params);
     private:
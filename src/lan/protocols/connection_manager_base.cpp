@@ -1,4 +1,5 @@
 #include "protocols/connection_manager_base.h"
+#include "utils/clock.h"
 #include <future>
 namespace elink
 {
@@ -205,8 +206,8 @@ namespace elink
             // Wait for 5 seconds, can be interrupted
             {
                 std::unique_lock<std::mutex> lock(reconnectMutex_);
-                if (reconnectCondition_.wait_for(lock, std::chrono::milliseconds(5000), [this]
-                                                 { return !shouldReconnect_.load(); }))
+                if (Clock::waitFor(lock, reconnectCondition_, std::chrono::milliseconds(5000), [this]
+                                   { return !shouldReconnect_.load(); }))
                 {
                     break; // Interrupted, exit loop
                 }
@@ -254,7 +255,7 @@ namespace elink
         delayedReconnectTimer_ = std::thread([this, delayMs]()
                                              {
         std::unique_lock<std::mutex> lock(delayedReconnectMutex_);
-        if (delayedReconnectCondition_.wait_for(lock, std::chrono::milliseconds(delayMs), [this] { 
+        if (Clock::waitFor(lock, delayedReconnectCondition_, std::chrono::milliseconds(delayMs), [this] { 
             return !shouldStartDelayedReconnect_.load(); 
         })) {
             // Interrupted (connection may have recovered), do not start reconnect
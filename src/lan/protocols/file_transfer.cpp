@@ -27,6 +27,39 @@
 
 namespace elink 
 {
+    namespace
+    {
+        /**
+         * Accumulates the bytes of one transfer into a counter from cumulative progress reports
+         */
+        class TransferByteCounter
+        {
+        public:
+            explicit TransferByteCounter(std::atomic<uint64_t> &total) : total_(total) {}
+
+            void onProgress(uint64_t transferred, uint64_t size)
+            {
+                if (transferred > reported_)
+                {
+                    total_ += transferred - reported_;
+                    reported_ = transferred;
+                }
+                size_ = size;
+            }
+
+            // Progress is throttled by some transfers; count the remainder once the transfer succeeded
+            void onCompleted()
+            {
+                onProgress(size_, size_);
+            }
+
+        private:
+            std::atomic<uint64_t> &total_;
+            uint64_t reported_ = 0;
+            uint64_t size_ = 0;
+        };
+    } // namespace
+
 
     // ========== BaseHttpFileTransfer implementation ==========
 
@@ -58,8 +91,18 @@ namespace elink
             uploadCancelled_ = false;
         }
 
-        // Directly call the subclass implementation
-        return doUpload(printerInfo, params, progressCallback);
+        auto counter = std::make_shared<TransferByteCounter>(bytesUploaded_);
+        auto result = doUpload(printerInfo, params,
+                               [counter, progressCallback](const FileUploadProgressData &progress) -> bool
+                               {
+                                   counter->onProgress(progress.uploadedBytes, progress.totalBytes);
+                                   return progressCallback ? progressCallback(progress) : true;
+                               });
+        if (result.isSuccess())
+        {
+            counter->onCompleted();
+        }
+        return result;
     }
 
     VoidResult BaseHttpFileTransfer::cancelFileUpload()
@@ -81,7 +124,17 @@ namespace elink
         const FileDownloadParams &params,
         FileDownloadProgressCallback progressCallback)
     {
-        // Directly call the subclass implementation
-        return doDownload(printerInfo, params, progressCallback);
+        auto counter = std::make_shared<TransferByteCounter>(bytesDownloaded_);
+        auto result = doDownload(printerInfo, params,
+                                 [counter, progressCallback](const FileDownloadProgressData &progress) -> bool
+                                 {
+                                     counter->onProgress(progress.downloadedBytes, progress.totalBytes);
+                                     return progressCallback ? progressCallback(progress) : true;
+                                 });
+        if (result.isSuccess())
+        {
+            counter->onCompleted();
+        }
+        return result;
     }
 } // namespace elink
@@ -5,6 +5,8 @@
 #include <vector>
 #include <map>
 #include <mutex>
+#include <atomic>
+#include <cstdint>
 #include <optional>
 #include "type.h"
 #include "types/internal/internal.h"
@@ -87,6 +89,16 @@ namespace elink
          * Get uploader name/description
          */
         virtual std::string getUploaderInfo() const = 0;
+
+        /**
+         * Total file bytes uploaded by this transfer instance
+         */
+        virtual uint64_t getBytesUploaded() const = 0;
+
+        /**
+         * Total file bytes downloaded by this transfer instance
+         */
+        virtual uint64_t getBytesDownloaded() const = 0;
     };
 
     /**
@@ -117,6 +129,9 @@ namespace elink
             const FileDownloadParams &params,
             FileDownloadProgressCallback progressCallback = nullptr) override;
 
+        uint64_t getBytesUploaded() const override { return bytesUploaded_.load(); }
+        uint64_t getBytesDownloaded() const override { return bytesDownloaded_.load(); }
+
     protected:
         /**
          * Perform the actual file upload - Subclasses need to implement specific upload logic
@@ -158,6 +173,11 @@ namespace elink
         // Upload cancellation flag for current operation
         bool uploadCancelled_ = false;
         mutable std::mutex uploadCancellationMutex_;
+
+    private:
+        // Transferred bytes, accumulated from progress reports
+        std::atomic<uint64_t> bytesUploaded_{0};
+        std::atomic<uint64_t> bytesDownloaded_{0};
     };
 
 
@@ -1,6 +1,7 @@
 #include "protocols/message_adapter.h"
 #include "utils/utils.h"
 #include "utils/logger.h"
+#include "utils/clock.h"
 #include <iostream>
 #include <sstream>
 #include <random>
@@ -12,11 +13,57 @@
 #include "types/internal/internal.h"
 namespace elink 
 {
+    namespace
+    {
+        thread_local MessageParseScope *currentParseScope = nullptr;
+
+        JsonDocumentPtr parseDocument(const std::string &text)
+        {
+            try
+            {
+                return std::make_shared<const nlohmann::json>(nlohmann::json::parse(text));
+            }
+            catch (const std::exception &e)
+            {
+                ELEGOO_LOG_ERROR("JSON parse error: {}", e.what());
+                return std::make_shared<const nlohmann::json>();
+            }
+        }
+    } // namespace
+
+    // ========== MessageParseScope Implementation ==========
+
+    MessageParseScope::MessageParseScope(const std::string &message)
+        : message_(&message), previous_(currentParseScope)
+    {
+        currentParseScope = this;
+    }
+
+    MessageParseScope::~MessageParseScope()
+    {
+        currentParseScope = previous_;
+    }
+
+    JsonDocumentPtr MessageParseScope::parse(const std::string &text)
+    {
+        // Compared by address: the scope's message outlives the scope, so no other string can take its place
+        MessageParseScope *scope = currentParseScope;
+        if (!scope || scope->message_ != &text)
+        {
+            return parseDocument(text);
+        }
+        if (!scope->document_)
+        {
+            scope->document_ = parseDocument(text);
+        }
+        return scope->document_;
+    }
+
 
     // ========== BaseMessageAdapter Implementation ==========
 
-    BaseMessageAdapter::BaseMessageAdapter(const PrinterInfo &printerInfo)
-        : printerInfo_(printerInfo), shouldStopCleanup_(false)
+    BaseMessageAdapter::BaseMessageAdapter(std::shared_ptr<SharedPrinterInfo> printerInfo)
+        : printerInfo_(std::move(printerInfo)), printerId_(printerInfo_->get()->printerId), shouldStopCleanup_(false)
     {
         startCleanupTimer();
     }
@@ -63,6 +110,11 @@ namespace elink
         }
     }
 
+    JsonDocumentPtr BaseMessageAdapter::parseMessage(const std::string &printerMessage) const
+    {
+        return MessageParseScope::parse(printerMessage);
+    }
+
     bool BaseMessageAdapter::isValidJson(const std::string &str) const
     {
         try
@@ -85,7 +137,7 @@ namespace elink
         record.standardMessageId = standardMessageId;
         record.printerRequestId = printerRequestId;
         record.method = command;
-        record.timestamp = std::chrono::steady_clock::now();
+        record.timestamp = Clock::now();
 
         pendingRequests_[printerRequestId] = record;
 
@@ -144,7 +196,7 @@ namespace elink
     {
         std::lock_guard<std::mutex> lock(requestTrackingMutex_);
 
-        auto now = std::chrono::steady_clock::now();
+        auto now = Clock::now();
         int cleanedCount = 0;
         
         for (auto it = pendingRequests_.begin(); it != pendingRequests_.end();)
@@ -166,7 +218,7 @@ namespace elink
         if (cleanedCount > 0)
         {
             ELEGOO_LOG_INFO("Cleaned up {} expired adapter requests for printer {}",
-                           cleanedCount, StringUtils::maskString(printerInfo_.printerId));
+                           cleanedCount, StringUtils::maskString(printerId_));
         }
     }
 
@@ -188,12 +240,12 @@ namespace elink
             }
             catch (const std::exception &e)
             {
-                ELEGOO_LOG_ERROR("Error converting message for printer {}: {}", StringUtils::maskString(printerInfo_.printerId), e.what());
+                ELEGOO_LOG_ERROR("Error converting message for printer {}: {}", StringUtils::maskString(printerId_), e.what());
             }
         }
         else
         {
-            ELEGOO_LOG_WARN("Message send callback not set, cannot send message to printer {}", StringUtils::maskString(printerInfo_.printerId));
+            ELEGOO_LOG_WARN("Message send callback not set, cannot send message to printer {}", StringUtils::maskString(printerId_));
         }
     }
 
@@ -240,7 +292,7 @@ namespace elink
         shouldStopCleanup_ = false;
         cleanupThread_ = std::thread([this]()
         {
-            ELEGOO_LOG_DEBUG("Adapter cleanup timer started for printer {}", StringUtils::maskString(printerInfo_.printerId));
+            ELEGOO_LOG_DEBUG("Adapter cleanup timer started for printer {}", StringUtils::maskString(printerId_));
             
             while (!shouldStopCleanup_)
             {
@@ -248,7 +300,7 @@ namespace elink
                 {
                     // Wait for specified interval or until notified to stop
                     std::unique_lock<std::mutex> lock(cleanupMutex_);
-                    if (cleanupCondition_.wait_for(lock, CLEANUP_INTERVAL, [this] { return shouldStopCleanup_.load(); }))
+                    if (Clock::waitFor(lock, cleanupCondition_, CLEANUP_INTERVAL, [this] { return shouldStopCleanup_.load(); }))
                     {
                         // If exiting wait due to stop signal, exit loop directly
                         break;
@@ -263,13 +315,13 @@ namespace elink
                 catch (const std::exception& e)
                 {
                     ELEGOO_LOG_ERROR("Exception in adapter cleanup timer for printer {}: {}", 
-                                    StringUtils::maskString(printerInfo_.printerId), e.what());
+                                    StringUtils::maskString(printerId_), e.what());
                     // Add slight delay when exception occurs to avoid too frequent errors
                     std::this_thread::sleep_for(std::chrono::milliseconds(5000));
                 }
             }
             
-            ELEGOO_LOG_DEBUG("Adapter cleanup timer stopped for printer {}", StringUtils::maskString(printerInfo_.printerId));
+            ELEGOO_LOG_DEBUG("Adapter cleanup timer stopped for printer {}", StringUtils::maskString(printerId_));
         });
     }
 
@@ -277,7 +329,7 @@ namespace elink
     {
         if (cleanupThread_.joinable())
         {
-            ELEGOO_LOG_DEBUG("Stopping adapter cleanup timer for printer {}", StringUtils::maskString(printerInfo_.printerId));
+            ELEGOO_LOG_DEBUG("Stopping adapter cleanup timer for printer {}", StringUtils::maskString(printerId_));
 
             {
                 std::lock_guard<std::mutex> lock(cleanupMutex_);
@@ -287,18 +339,31 @@ namespace elink
 
             cleanupThread_.join();
 
-            ELEGOO_LOG_DEBUG("Adapter cleanup timer stopped for printer {}", StringUtils::maskString(printerInfo_.printerId));
+            ELEGOO_LOG_DEBUG("Adapter cleanup timer stopped for printer {}", StringUtils::maskString(printerId_));
         }
     }
 
     void BaseMessageAdapter::cleanupTimerCallback()
     {
         ELEGOO_LOG_DEBUG("Running periodic adapter cleanup for printer {} (interval: {}ms)",
-                         StringUtils::maskString(printerInfo_.printerId), CLEANUP_INTERVAL.count());
+                         StringUtils::maskString(printerId_), CLEANUP_INTERVAL.count());
 
         cleanupExpiredRequests();
     }
 
     void BaseMessageAdapter::clearStatusCache() {
     }
+
+    size_t BaseMessageAdapter::getRequestTrackingMemoryUsage() const
+    {
+        std::lock_guard<std::mutex> lock(requestTrackingMutex_);
+        size_t total = 0;
+        for (const auto &[responseId, record] : pendingRequests_)
+        {
+            // std::map node plus the heap part of the three strings
+            total += 4 * sizeof(void *) + sizeof(std::string) + sizeof(RequestRecord);
+            total += responseId.capacity() + record.standardMessageId.capacity() + record.printerRequestId.capacity();
+        }
+        return total;
+    }
 } // namespace elink
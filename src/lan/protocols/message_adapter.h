@@ -8,6 +8,7 @@
 #include <nlohmann/json.hpp>
 #include "type.h"
 #include "types/internal/internal.h"
+#include "core/shared_printer_info.h"
 #include <mutex>
 #include <thread>
 #include <atomic>
@@ -63,6 +64,38 @@ namespace elink
         }
     };
 
+    using JsonDocumentPtr = std::shared_ptr<const nlohmann::json>;
+
+    /**
+     * Parses an inbound printer message at most once on the current thread
+     *
+     * The adapter calls for one message (parseMessageType, then convertToResponse or
+     * convertToEvent) each need its JSON. While a scope is open for a message, the first
+     * BaseMessageAdapter::parseMessage() of that message parses it and the others share the
+     * document. The document is dropped when the scope ends unless a caller still holds it;
+     * results that outlive the message, such as the status cache, copy what they keep.
+     */
+    class MessageParseScope
+    {
+    public:
+        explicit MessageParseScope(const std::string &message);
+        ~MessageParseScope();
+
+        MessageParseScope(const MessageParseScope &) = delete;
+        MessageParseScope &operator=(const MessageParseScope &) = delete;
+
+        /**
+         * Document of text, shared with the open scope when text is its message
+         * @return Parsed document, a null document if text is not valid JSON
+         */
+        static JsonDocumentPtr parse(const std::string &text);
+
+    private:
+        const std::string *message_;
+        JsonDocumentPtr document_;
+        MessageParseScope *previous_;
+    };
+
     /**
      * Message Adapter Interface - Converts standard messages to printer-specific messages
      * Responsible for converting SDK's standard RequestMessage to a format supported by the printer
@@ -139,8 +172,31 @@ namespace elink
         virtual void sendMessageToPrinter(MethodType methodType, const nlohmann::json &request = nlohmann::json::object()) = 0;
 
         virtual nlohmann::json getCachedFullStatusJson() const = 0;
-        virtual PrinterInfo getPrinterInfo() const = 0;
+        /**
+         * Current printer information, including details the adapter learned from the printer
+         */
+        virtual PrinterInfoPtr getPrinterInfo() const = 0;
         virtual void clearStatusCache() = 0;
+
+        /**
+         * Whether pushed status updates keep the cached full status current
+         * @return false if the current status has to be requested from the printer
+         */
+        virtual bool hasLiveStatusCache() const = 0;
+
+        // ========== Resource Accounting ==========
+
+        /**
+         * Approximate memory held by the cached full status
+         * @return Bytes, 0 if the adapter keeps no status cache
+         */
+        virtual size_t getStatusCacheMemoryUsage() const = 0;
+
+        /**
+         * Approximate memory held by request tracking records
+         * @return Bytes
+         */
+        virtual size_t getRequestTrackingMemoryUsage() const = 0;
     };
 
     /**
@@ -149,7 +205,10 @@ namespace elink
     class BaseMessageAdapter : public IMessageAdapter
     {
     public:
-        explicit BaseMessageAdapter(const PrinterInfo &printerInfo);
+        /**
+         * @param printerInfo Printer information, shared with the printer that owns the adapter
+         */
+        explicit BaseMessageAdapter(std::shared_ptr<SharedPrinterInfo> printerInfo);
         virtual ~BaseMessageAdapter();
 
         /**
@@ -171,17 +230,18 @@ namespace elink
          */
         virtual void sendMessageToPrinter(MethodType methodType, const nlohmann::json &request = nlohmann::json::object()) override;
 
-        void setPrinterInfo(const PrinterInfo &printerInfo)
-        {
-            printerInfo_ = printerInfo;
-        }
-        virtual PrinterInfo getPrinterInfo() const override
+        virtual PrinterInfoPtr getPrinterInfo() const override
         {
-            return printerInfo_;
+            return printerInfo_->get();
         }
         virtual void clearStatusCache() override;
+        virtual bool hasLiveStatusCache() const override { return false; }
+
+        virtual size_t getStatusCacheMemoryUsage() const override { return 0; }
+        virtual size_t getRequestTrackingMemoryUsage() const override;
     protected:
-        mutable PrinterInfo printerInfo_;
+        std::shared_ptr<SharedPrinterInfo> printerInfo_;
+        const std::string printerId_; // Never changes, kept out of printerInfo_ for cheap access
 
         // Request tracking structure
         struct RequestRecord
@@ -217,6 +277,10 @@ namespace elink
         std::string generateMessageId() const;
         std::string generatePrinterRequestId() const;
         nlohmann::json parseJson(const std::string &jsonStr) const;
+        /**
+         * Parse an inbound printer message, reusing the document of the open MessageParseScope
+         */
+        JsonDocumentPtr parseMessage(const std::string &printerMessage) const;
         bool isValidJson(const std::string &str) const;
 
         // Request tracking methods
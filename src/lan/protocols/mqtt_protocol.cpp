@@ -3,6 +3,8 @@
 #include "protocols/connection_manager_base.h"
 #include "protocols/error_handler.h"
 #include "utils/logger.h"
+#include "utils/tracer.h"
+#include "utils/clock.h"
 #include "utils/utils.h"
 // Prevent Windows headers from defining max/min macros
 #ifdef WIN32
@@ -45,7 +47,7 @@ namespace elink
     public:
         Impl(MqttProtocol *parent) : ConnectionManagerBase("MQTT"),
                                      parent_(parent), client_(nullptr), isRegistering_(false), registrationSuccess_(false),
-                                     heartbeatRunning_(false), lastPongReceived_(std::chrono::steady_clock::now()) {}
+                                     heartbeatRunning_(false), lastPongReceived_(Clock::now()) {}
 
         ~Impl()
         {
@@ -64,6 +66,7 @@ namespace elink
                 return false;
             }
 
+            ELEGOO_TRACE_SCOPE_ARGS("transport", "mqtt.sendCommand", {{"bytes", std::to_string(data.size())}});
             try
             {
                 std::string topic = parent_->getCommandTopic(lastConnectParams_);
@@ -76,6 +79,8 @@ namespace elink
                     ELEGOO_LOG_ERROR("[{}] MQTT client unavailable during send", lastConnectParams_.host);
                     return false;
                 }
+                // Separate span so time spent waiting for clientMutex_ shows up
+                ELEGOO_TRACE_SCOPE("transport", "mqtt.publish");
                 auto token = client_->publish(topic, data, 1, false);
                 return token->wait_for(std::chrono::seconds(2));
             }
@@ -89,7 +94,7 @@ namespace elink
         /**
          * @brief Set message receive callback function
          */
-        void setMessageCallback(std::function<void(const std::string &)> callback)
+        void setMessageCallback(std::function<void(const PayloadBuffer &)> callback)
         {
             std::lock_guard<std::mutex> lock(messageCallbackMutex_);
             messageCallback_ = callback;
@@ -407,7 +412,10 @@ namespace elink
             try
             {
                 std::string topic = msg->get_topic();
-                std::string payload = msg->to_string();
+                // Share the payload with paho's message instead of copying it
+                PayloadBuffer payloadBuffer = PayloadBuffer::fromOwner(msg, msg->get_payload());
+                const std::string &payload = payloadBuffer.str();
+                ELEGOO_TRACE_SCOPE_ARGS("transport", "mqtt.receive", {{"bytes", std::to_string(payload.size())}});
                 ELEGOO_LOG_DEBUG("[{}] MQTT message arrived from topic {}: {}", lastConnectParams_.host, StringUtils::maskString(topic), payload);
 
                 // Check if this is a registration response
@@ -447,7 +455,7 @@ namespace elink
                 if (parent_->isHeartbeatEnabled() && parent_->handleHeartbeatResponse(payload))
                 {
                     std::lock_guard<std::mutex> lock(heartbeatMutex_);
-                    lastPongReceived_ = std::chrono::steady_clock::now();
+                    lastPongReceived_ = Clock::now();
                     ELEGOO_LOG_DEBUG("[{}] MQTT heartbeat response received", lastConnectParams_.host);
                     return; // Don't pass heartbeat messages to business layer
                 }
@@ -456,7 +464,7 @@ namespace elink
                 parent_->handleMessage(topic, payload);
 
                 // Also call the callback function for backward compatibility
-                std::function<void(const std::string &)> callback;
+                std::function<void(const PayloadBuffer &)> callback;
                 {
                     std::lock_guard<std::mutex> lock(messageCallbackMutex_);
                     callback = messageCallback_;
@@ -465,7 +473,7 @@ namespace elink
                 // Call callback function outside of lock to avoid deadlock
                 if (callback)
                 {
-                    callback(payload);
+                    callback(payloadBuffer);
                 }
             }
             catch (const std::exception &e)
@@ -493,7 +501,7 @@ namespace elink
             if (!heartbeatRunning_)
             {
                 heartbeatRunning_ = true;
-                lastPongReceived_ = std::chrono::steady_clock::now();
+                lastPongReceived_ = Clock::now();
                 heartbeatThread_ = std::thread(&Impl::heartbeatLoop, this);
                 ELEGOO_LOG_DEBUG("[{}] MQTT heartbeat started", lastConnectParams_.host);
             }
@@ -508,6 +516,7 @@ namespace elink
                 std::lock_guard<std::mutex> lock(heartbeatMutex_);
                 heartbeatRunning_ = false;
             }
+            heartbeatCondition_.notify_all();
 
             if (heartbeatThread_.joinable())
             {
@@ -525,9 +534,10 @@ namespace elink
             {
                 // Wait for the configured interval
                 int intervalSeconds = parent_->getHeartbeatIntervalSeconds();
-                for (int i = 0; i < intervalSeconds * 10 && heartbeatRunning_; ++i) // intervalSeconds * 10 * 100ms = intervalSeconds seconds
                 {
-                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                    std::unique_lock<std::mutex> lock(heartbeatMutex_);
+                    Clock::waitFor(lock, heartbeatCondition_, std::chrono::seconds(intervalSeconds), [this]
+                                   { return !heartbeatRunning_; });
                 }
 
                 if (!heartbeatRunning_)
@@ -550,7 +560,7 @@ namespace elink
                 }
 
                 // Check heartbeat response timeout
-                auto now = std::chrono::steady_clock::now();
+                auto now = Clock::now();
                 auto timeSinceLastResponse = std::chrono::duration_cast<std::chrono::seconds>(
                     now - lastPongReceived_);
 
@@ -627,7 +637,7 @@ namespace elink
         mutable std::mutex clientMutex_; // Protect client_ access
 
         // ============ Callback functions ============
-        std::function<void(const std::string &)> messageCallback_;
+        std::function<void(const PayloadBuffer &)> messageCallback_;
         std::mutex messageCallbackMutex_;
 
         // ============ Printer registration related ============
@@ -643,6 +653,7 @@ namespace elink
         std::thread heartbeatThread_;
         std::chrono::steady_clock::time_point lastPongReceived_;
         mutable std::mutex heartbeatMutex_;
+        std::condition_variable heartbeatCondition_;
     };
 
     // ============ MqttProtocol public interface implementation ============
@@ -673,7 +684,7 @@ namespace elink
         return impl_->sendCommand(data);
     }
 
-    void MqttProtocol::setMessageCallback(std::function<void(const std::string &)> callback)
+    void MqttProtocol::setMessageCallback(std::function<void(const PayloadBuffer &)> callback)
     {
         impl_->setMessageCallback(callback);
     }
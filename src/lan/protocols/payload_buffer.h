@@ -0,0 +1,89 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace elink
+{
+    /**
+     * Immutable, reference-counted payload of a received printer message
+     *
+     * Carries a message from the transport through IProtocol and BasePrinter to the message
+     * adapter, wire capture and replay without copying the text. Copying a PayloadBuffer copies a
+     * pointer; every copy refers to the same bytes.
+     *
+     * A buffer either owns its text (shares ownership of it, possibly through the transport's own
+     * message object) or borrows it from a transport that only lends its receive buffer for the
+     * duration of a callback. Code that keeps a payload beyond the callback it was handed to must
+     * keep retain() instead of the buffer itself; retain() copies borrowed text once and is free
+     * for owned text.
+     */
+    class PayloadBuffer
+    {
+    public:
+        PayloadBuffer() = default;
+
+        /**
+         * Take ownership of text
+         */
+        explicit PayloadBuffer(std::string text)
+            : text_(std::make_shared<const std::string>(std::move(text)))
+        {
+        }
+
+        /**
+         * Share text owned by another object, such as the transport's message
+         * @param owner Object that keeps text alive
+         * @param text String inside owner
+         */
+        template <typename Owner>
+        static PayloadBuffer fromOwner(std::shared_ptr<Owner> owner, const std::string &text)
+        {
+            PayloadBuffer buffer;
+            buffer.text_ = std::shared_ptr<const std::string>(std::move(owner), &text);
+            return buffer;
+        }
+
+        /**
+         * Refer to text without owning it; valid only while the caller keeps text alive
+         */
+        static PayloadBuffer borrow(const std::string &text)
+        {
+            PayloadBuffer buffer;
+            buffer.text_ = std::shared_ptr<const std::string>(std::shared_ptr<const std::string>(), &text);
+            buffer.borrowed_ = true;
+            return buffer;
+        }
+
+        /**
+         * Buffer that stays valid after the current callback returns
+         */
+        PayloadBuffer retain() const
+        {
+            return borrowed_ ? PayloadBuffer(*text_) : *this;
+        }
+
+        const std::string &str() const { return text_ ? *text_ : emptyText(); }
+        std::string_view view() const { return str(); }
+        const char *data() const { return str().data(); }
+        size_t size() const { return text_ ? text_->size() : 0; }
+        bool empty() const { return size() == 0; }
+        bool isBorrowed() const { return borrowed_; }
+
+        // Lets a buffer be handed to the many helpers that take the message as a string
+        operator const std::string &() const { return str(); }
+
+    private:
+        static const std::string &emptyText()
+        {
+            static const std::string empty;
+            return empty;
+        }
+
+        std::shared_ptr<const std::string> text_;
+        bool borrowed_ = false;
+    };
+
+} // namespace elink
@@ -7,6 +7,7 @@
 #include <vector>
 #include "type.h"
 #include "types/internal/internal.h"
+#include "protocols/payload_buffer.h"
 namespace elink 
 {
 
@@ -47,9 +48,9 @@ namespace elink
 
         /**
          * Set the message reception callback
-         * @param callback Callback function
+         * @param callback Callback function, receives the payload without copying it; see PayloadBuffer
          */
-        virtual void setMessageCallback(std::function<void(const std::string &)> callback) = 0;
+        virtual void setMessageCallback(std::function<void(const PayloadBuffer &)> callback) = 0;
 
         /**
          * Set the connection status callback
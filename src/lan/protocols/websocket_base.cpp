@@ -2,6 +2,8 @@
 #include "protocols/connection_manager_base.h"
 #include "protocols/error_handler.h"
 #include "utils/logger.h"
+#include "utils/tracer.h"
+#include "utils/clock.h"
 #include "utils/utils.h"
 // Prevent Windows headers from defining max/min macros
 #ifdef max
@@ -33,7 +35,7 @@ namespace elink
               connectionError_(),
               connectionFailed_(false),
               heartbeatRunning_(false),
-              lastPongReceived_(std::chrono::steady_clock::now())
+              lastPongReceived_(Clock::now())
         {
             ix::initNetSystem();
         }
@@ -60,10 +62,13 @@ namespace elink
             }
 
             ELEGOO_LOG_DEBUG("[{}] Sending command: {}", lastConnectParams_.host, data);
+            ELEGOO_TRACE_SCOPE_ARGS("transport", "websocket.sendCommand", {{"bytes", std::to_string(data.size())}});
 
             try
             {
                 std::lock_guard<std::mutex> lock(websocketMutex_);
+                // Separate span so time spent waiting for websocketMutex_ shows up
+                ELEGOO_TRACE_SCOPE("transport", "websocket.send");
                 auto result = websocket_.send(data);
                 return result.success;
             }
@@ -95,7 +100,7 @@ namespace elink
         /**
          * @brief Set message receive callback function
          */
-        void setMessageCallback(std::function<void(const std::string &)> callback)
+        void setMessageCallback(std::function<void(const PayloadBuffer &)> callback)
         {
             std::lock_guard<std::mutex> lock(messageMutex_);
             messageCallback_ = callback;
@@ -262,7 +267,7 @@ namespace elink
             if (!heartbeatRunning_)
             {
                 heartbeatRunning_ = true;
-                lastPongReceived_ = std::chrono::steady_clock::now();
+                lastPongReceived_ = Clock::now();
                 heartbeatThread_ = std::thread(&Impl::heartbeatLoop, this);
                 ELEGOO_LOG_DEBUG("[{}] WebSocket heartbeat started", lastConnectParams_.host);
             }
@@ -277,6 +282,7 @@ namespace elink
                 std::lock_guard<std::mutex> lock(heartbeatMutex_);
                 heartbeatRunning_ = false;
             }
+            heartbeatCondition_.notify_all();
 
             if (heartbeatThread_.joinable())
             {
@@ -294,9 +300,10 @@ namespace elink
             {
                 // Wait for the configured interval
                 int intervalSeconds = parent_->getHeartbeatIntervalSeconds();
-                for (int i = 0; i < intervalSeconds * 10 && heartbeatRunning_; ++i) // intervalSeconds * 10 * 100ms = intervalSeconds seconds
                 {
-                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                    std::unique_lock<std::mutex> lock(heartbeatMutex_);
+                    Clock::waitFor(lock, heartbeatCondition_, std::chrono::seconds(intervalSeconds), [this]
+                                   { return !heartbeatRunning_; });
                 }
 
                 if (!heartbeatRunning_)
@@ -398,7 +405,7 @@ namespace elink
                         if (parent_->isHeartbeatEnabled() && parent_->handleHeartbeatResponse(msg->str))
                         {
                             std::lock_guard<std::mutex> lock(heartbeatMutex_);
-                            lastPongReceived_ = std::chrono::steady_clock::now();
+                            lastPongReceived_ = Clock::now();
                             ELEGOO_LOG_DEBUG("[{}] WebSocket heartbeat response received", lastConnectParams_.host);
                             return; // Don't pass heartbeat messages to business layer
                         }
@@ -456,10 +463,12 @@ namespace elink
                     return;
                 }
 
+                ELEGOO_TRACE_SCOPE_ARGS("transport", "websocket.receive", {{"bytes", std::to_string(message.size())}});
                 std::lock_guard<std::mutex> lock(messageMutex_);
                 if (messageCallback_)
                 {
-                    messageCallback_(message);
+                    // ixwebsocket only lends its receive buffer for the duration of this callback
+                    messageCallback_(PayloadBuffer::borrow(message));
                 }
             }
             catch (const std::exception &e)
@@ -481,9 +490,10 @@ namespace elink
         std::thread heartbeatThread_;
         std::chrono::steady_clock::time_point lastPongReceived_;
         mutable std::mutex heartbeatMutex_;
+        std::condition_variable heartbeatCondition_;
 
         // ============ Callback functions ============
-        std::function<void(const std::string &)> messageCallback_;
+        std::function<void(const PayloadBuffer &)> messageCallback_;
         std::mutex messageMutex_;
     };
 
@@ -515,7 +525,7 @@ namespace elink
         return impl_->sendCommand(data);
     }
 
-    void WebSocketBase::setMessageCallback(std::function<void(const std::string &)> callback)
+    void WebSocketBase::setMessageCallback(std::function<void(const PayloadBuffer &)> callback)
     {
         impl_->setMessageCallback(callback);
     }
@@ -31,7 +31,7 @@ namespace elink
         void disconnect() override;
         bool isConnected() const override;
         bool sendCommand(const std::string &data) override;
-        void setMessageCallback(std::function<void(const std::string &)> callback) override;
+        void setMessageCallback(std::function<void(const PayloadBuffer &)> callback) override;
         void setConnectStatusCallback(std::function<void(bool)> callback) override;
         std::string getProtocolType() const override { return "websocket"; }
 
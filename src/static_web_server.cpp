@@ -1,13 +1,114 @@
 #include "static_web_server.h"
+#include "status_push_hub.h"
 #include "utils/logger.h"
 #include <filesystem>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
 #include <regex>
+#include <cctype>
+#include <cstdio>
+#include <mutex>
 #include "utils/utils.h"
 namespace elink 
 {
+    namespace
+    {
+        // How long a cached asset is served without checking its mtime again
+        constexpr int64_t ASSET_REVALIDATE_INTERVAL_MS = 1000;
+
+        constexpr const char* DEFAULT_IMMUTABLE_ASSET_PATTERN = R"(^.+[.-](?=[A-Za-z0-9_-]*[0-9])[A-Za-z0-9_-]{8,}\.[A-Za-z0-9]+$)";
+
+        int64_t steadyNowMs()
+        {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        std::string makeEtag(const std::string& content)
+        {
+            // FNV-1a, content based so it stays stable across restarts and file copies
+            uint64_t hash = 0xcbf29ce484222325ULL;
+            for (unsigned char c : content) {
+                hash ^= c;
+                hash *= 0x100000001b3ULL;
+            }
+            char buffer[40];
+            std::snprintf(buffer, sizeof(buffer), "\"%zx-%016llx\"", content.size(), static_cast<unsigned long long>(hash));
+            return buffer;
+        }
+
+        std::string makeFileEtag(uintmax_t size, std::filesystem::file_time_type mtime)
+        {
+            char buffer[48];
+            std::snprintf(buffer, sizeof(buffer), "\"%llx-%llx\"", static_cast<unsigned long long>(size),
+                          static_cast<unsigned long long>(mtime.time_since_epoch().count()));
+            return buffer;
+        }
+
+        std::string trim(const std::string& value)
+        {
+            size_t begin = value.find_first_not_of(" \t");
+            if (begin == std::string::npos) {
+                return "";
+            }
+            size_t end = value.find_last_not_of(" \t");
+            return value.substr(begin, end - begin + 1);
+        }
+
+        /**
+         * Whether an Accept-Encoding header accepts a coding with non-zero quality
+         */
+        bool acceptsEncoding(const std::string& acceptEncoding, const std::string& coding)
+        {
+            std::stringstream stream(acceptEncoding);
+            std::string item;
+            while (std::getline(stream, item, ',')) {
+                std::string token = trim(item.substr(0, item.find(';')));
+                std::transform(token.begin(), token.end(), token.begin(), ::tolower);
+                if (token != coding && token != "*") {
+                    continue;
+                }
+                size_t q = item.find("q=");
+                return q == std::string::npos || std::atof(item.c_str() + q + 2) > 0.0;
+            }
+            return false;
+        }
+
+        /**
+         * Whether an If-None-Match header matches an entity tag (weak comparison, as RFC 9110 requires)
+         */
+        bool etagMatches(const std::string& ifNoneMatch, const std::string& etag)
+        {
+            if (trim(ifNoneMatch) == "*") {
+                return true;
+            }
+            std::stringstream stream(ifNoneMatch);
+            std::string item;
+            while (std::getline(stream, item, ',')) {
+                std::string candidate = trim(item);
+                if (candidate.rfind("W/", 0) == 0) {
+                    candidate = candidate.substr(2);
+                }
+                if (candidate == etag) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::shared_ptr<const std::string> readFile(const std::string& path)
+        {
+            auto file = PathUtils::openInputStream(path, std::ios::binary);
+            if (!file.is_open()) {
+                return nullptr;
+            }
+            std::stringstream buffer;
+            buffer << file.rdbuf();
+            return std::make_shared<const std::string>(buffer.str());
+        }
+    } // namespace
+
     // Default MIME types mapping
     const std::unordered_map<std::string, std::string> StaticWebServer::defaultMimeTypes_ = {
         {".html", "text/html; charset=utf-8"},
@@ -35,7 +136,9 @@ namespace elink
     };
 
     StaticWebServer::StaticWebServer(int port, const std::string& host)
-        : port_(port), host_(host), running_(false), directoryListing_(false)
+        : port_(port), host_(host), running_(false), directoryListing_(false), workerThreads_(0),
+          immutableAssetPattern_(DEFAULT_IMMUTABLE_ASSET_PATTERN), statusPushEventBus_(nullptr),
+          maxCachedFileSize_(2 * 1024 * 1024), maxCacheSize_(64 * 1024 * 1024), cacheSize_(0), serveCounter_(0)
     {
         // Default index files
         indexFiles_ = {"index.html", "index.htm", "default.html", "default.htm","index"};
@@ -72,6 +175,15 @@ namespace elink
         }
 
         server_ = std::make_unique<httplib::Server>();
+        if (workerThreads_ > 0) {
+            size_t threads = workerThreads_;
+            server_->new_task_queue = [threads] { return new httplib::ThreadPool(threads); };
+        }
+        if (statusPushEventBus_) {
+            statusPush_ = std::make_shared<StatusPushHub>(*statusPushEventBus_);
+            size_t threads = workerThreads_ > 0 ? workerThreads_ : static_cast<size_t>(CPPHTTPLIB_THREAD_POOL_COUNT);
+            statusPush_->setMaxClients(std::max<size_t>(1, threads / 2));
+        }
         setupRoutes();
 
         running_.store(true);
@@ -91,6 +203,11 @@ namespace elink
         }
 
         running_.store(false);
+
+        // Release the worker threads held by push clients before waiting for the server
+        if (statusPush_) {
+            statusPush_->shutdown();
+        }
         
         if (server_) {
             server_->stop();
@@ -102,6 +219,13 @@ namespace elink
 
         server_.reset();
         serverThread_.reset();
+        statusPush_.reset();
+
+        {
+            std::unique_lock<std::shared_mutex> lock(cacheMutex_);
+            assetCache_.clear();
+            cacheSize_ = 0;
+        }
 
         ELEGOO_LOG_INFO("StaticWebServer stopped");
     }
@@ -139,8 +263,68 @@ namespace elink
         ELEGOO_LOG_DEBUG("Index files updated");
     }
 
+    void StaticWebServer::setWorkerThreads(size_t threads)
+    {
+        workerThreads_ = threads;
+        ELEGOO_LOG_DEBUG("Worker threads set to {}", threads);
+    }
+
+    void StaticWebServer::setAssetCacheLimits(size_t maxFileSize, size_t maxTotalSize)
+    {
+        std::unique_lock<std::shared_mutex> lock(cacheMutex_);
+        maxCachedFileSize_ = maxFileSize;
+        maxCacheSize_ = maxTotalSize;
+        trimAssetCache();
+        ELEGOO_LOG_DEBUG("Asset cache limits set: {} bytes per file, {} bytes total", maxFileSize, maxTotalSize);
+    }
+
+    void StaticWebServer::setImmutableAssetPattern(const std::string& pattern)
+    {
+        immutableAssetPattern_ = std::regex(pattern);
+        ELEGOO_LOG_DEBUG("Immutable asset pattern set to: {}", pattern);
+    }
+
+    void StaticWebServer::enableStatusPush(EventBus& eventBus, const std::string& path)
+    {
+        statusPushEventBus_ = &eventBus;
+        statusPushPath_ = path;
+        ELEGOO_LOG_DEBUG("Status push enabled on {}", path);
+    }
+
     void StaticWebServer::setupRoutes()
     {
+        // Status push stream, registered before the catch-all route so it takes precedence
+        if (statusPush_) {
+            std::shared_ptr<StatusPushHub> hub = statusPush_;
+            server_->Get(statusPushPath_, [hub](const httplib::Request& req, httplib::Response& res) {
+                auto client = hub->addClient(StatusPushHub::parseOptions(req.params));
+                if (!client) {
+                    res.status = 503;
+                    res.set_header("Retry-After", "5");
+                    res.set_content("Too many status push clients", "text/plain");
+                    return;
+                }
+
+                res.set_header("Cache-Control", "no-cache");
+                res.set_header("X-Accel-Buffering", "no");
+                res.set_chunked_content_provider(
+                    "text/event-stream",
+                    [hub, client](size_t offset, httplib::DataSink& sink) {
+                        std::string data = hub->waitForUpdates(client);
+                        if (data.empty()) {
+                            // Hub shut down
+                            sink.done();
+                            return true;
+                        }
+                        if (offset == 0) {
+                            data.insert(0, "retry: 3000\n\n");
+                        }
+                        return sink.write(data.data(), data.size());
+                    },
+                    [hub, client](bool) { hub->removeClient(client); });
+            });
+        }
+
         // Handle all requests with a catch-all route
         server_->Get(R"(.*)", [this](const httplib::Request& req, httplib::Response& res) {
             std::string requestPath = sanitizePath(req.path);
@@ -166,33 +350,9 @@ namespace elink
                     }
 
                     if (PathUtils::isRegularFile(fullPath)) {
-                        // Read file content using PathUtils for UTF-8 support
-                        auto file = PathUtils::openInputStream(fullPath, std::ios::binary);
-                        if (file.is_open()) {
-                            std::stringstream buffer;
-                            buffer << file.rdbuf();
-                            std::string content = buffer.str();
-                            
-                            // Set appropriate MIME type
-                            std::string filename = fullPath.substr(fullPath.find_last_of("/\\") + 1);
-                            std::string extension = getFileExtension(filename);
-                            std::string mimeType = getMimeType(extension);
-                            
-                            res.set_content(content, mimeType);
-                            
-                            // Set cache headers for static files
-                            if (extension != ".html" && extension != ".htm") {
-                                res.set_header("Cache-Control", "public, max-age=3600");
-                            }
-                            
-                            ELEGOO_LOG_DEBUG("Served file: {} ({})", fullPath, mimeType);
-                            return;
-                        } else {
-                            ELEGOO_LOG_ERROR("Failed to open file: {}", fullPath);
-                            res.status = 500;
-                            res.set_content("<h1>500 Internal Server Error</h1><p>Failed to open file.</p>", "text/html");
-                            return;
-                        }
+                        std::string filename = fullPath.substr(fullPath.find_last_of("/\\") + 1);
+                        serveFile(req, res, fullPath, getMimeType(getFileExtension(filename)));
+                        return;
                     }
                 }
 
@@ -201,16 +361,9 @@ namespace elink
                     // Try to serve index.html for Vue client-side routing
                     std::string indexPath = findIndexFile(staticPath_);
                     if (!indexPath.empty()) {
-                        // Use PathUtils for UTF-8 support
-                        auto file = PathUtils::openInputStream(indexPath, std::ios::binary);
-                        if (file.is_open()) {
-                            std::stringstream buffer;
-                            buffer << file.rdbuf();
-                            std::string content = buffer.str();
-                            res.set_content(content, "text/html; charset=utf-8");
-                            ELEGOO_LOG_DEBUG("Served index.html for Vue route: {}", requestPath);
-                            return;
-                        }
+                        serveFile(req, res, indexPath, "text/html; charset=utf-8");
+                        ELEGOO_LOG_DEBUG("Served index.html for Vue route: {}", requestPath);
+                        return;
                     }
                 }
                 
@@ -227,7 +380,7 @@ namespace elink
         });
 
         // Add CORS headers for API compatibility
-        server_->set_pre_routing_handler([](const httplib::Request& req, httplib::Response& res) {
+        server_->set_pre_routing_handler([](const httplib::Request&, httplib::Response& res) {
             res.set_header("Access-Control-Allow-Origin", "*");
             res.set_header("Access-Control-Allow-Methods", "GET, POST, PUT, DELETE, OPTIONS");
             res.set_header("Access-Control-Allow-Headers", "Content-Type, Authorization");
@@ -240,6 +393,224 @@ namespace elink
         });
     }
 
+    void StaticWebServer::serveFile(const httplib::Request& req, httplib::Response& res,
+                                    const std::string& fullPath, const std::string& mimeType)
+    {
+        auto asset = getCachedAsset(fullPath, mimeType);
+        if (!asset) {
+            // Too large to cache: stream from a memory mapping of the file
+            std::error_code ec;
+            auto fsPath = std::filesystem::u8path(fullPath);
+            auto size = std::filesystem::file_size(fsPath, ec);
+            auto mtime = std::filesystem::last_write_time(fsPath, ec);
+            if (ec) {
+                ELEGOO_LOG_ERROR("Failed to open file: {}", fullPath);
+                res.status = 500;
+                res.set_content("<h1>500 Internal Server Error</h1><p>Failed to open file.</p>", "text/html");
+                return;
+            }
+
+            std::string filename = fullPath.substr(fullPath.find_last_of("/\\") + 1);
+            std::string etag = makeFileEtag(size, mtime);
+            res.set_header("ETag", etag);
+            res.set_header("Cache-Control", getCacheControl(filename, getFileExtension(filename)));
+            if (etagMatches(req.get_header_value("If-None-Match"), etag)) {
+                res.status = 304;
+                return;
+            }
+            res.set_file_content(fullPath, mimeType);
+            ELEGOO_LOG_DEBUG("Streamed file: {} ({}, {} bytes)", fullPath, mimeType, size);
+            return;
+        }
+
+        asset->lastServed.store(++serveCounter_, std::memory_order_relaxed);
+
+        // Pick the smallest representation the client accepts
+        const CachedAsset::Variant* variant = &asset->identity;
+        std::string contentEncoding;
+        const std::string acceptEncoding = req.get_header_value("Accept-Encoding");
+        if (asset->brotli.present && acceptsEncoding(acceptEncoding, "br")) {
+            variant = &asset->brotli;
+            contentEncoding = "br";
+        } else if (asset->gzip.present && acceptsEncoding(acceptEncoding, "gzip")) {
+            variant = &asset->gzip;
+            contentEncoding = "gzip";
+        }
+
+        res.set_header("ETag", variant->etag);
+        res.set_header("Cache-Control", asset->cacheControl);
+        if (asset->gzip.present || asset->brotli.present) {
+            res.set_header("Vary", "Accept-Encoding");
+        }
+        if (etagMatches(req.get_header_value("If-None-Match"), variant->etag)) {
+            res.status = 304;
+            return;
+        }
+        if (!contentEncoding.empty()) {
+            res.set_header("Content-Encoding", contentEncoding);
+        }
+
+        // Write straight from the shared cache buffer, which outlives the response through the capture
+        auto content = variant->content;
+        res.set_content_provider(content->size(), mimeType,
+                                 [content](size_t offset, size_t length, httplib::DataSink& sink) {
+                                     return sink.write(content->data() + offset, length);
+                                 });
+        ELEGOO_LOG_DEBUG("Served file: {} ({}{}{})", fullPath, mimeType,
+                         contentEncoding.empty() ? "" : ", ", contentEncoding);
+    }
+
+    std::shared_ptr<const StaticWebServer::CachedAsset> StaticWebServer::getCachedAsset(const std::string& fullPath,
+                                                                                       const std::string& mimeType)
+    {
+        const int64_t nowMs = steadyNowMs();
+        std::shared_ptr<CachedAsset> cached;
+        {
+            std::shared_lock<std::shared_mutex> lock(cacheMutex_);
+            auto it = assetCache_.find(fullPath);
+            if (it != assetCache_.end()) {
+                cached = it->second;
+            }
+        }
+        if (cached && cached->mimeType == mimeType &&
+            nowMs - cached->lastValidatedMs.load(std::memory_order_relaxed) < ASSET_REVALIDATE_INTERVAL_MS) {
+            return cached;
+        }
+        if (cached && cached->mimeType == mimeType && isAssetCurrent(fullPath, *cached)) {
+            cached->lastValidatedMs.store(nowMs, std::memory_order_relaxed);
+            return cached;
+        }
+
+        std::error_code ec;
+        auto fsPath = std::filesystem::u8path(fullPath);
+        auto size = std::filesystem::file_size(fsPath, ec);
+        auto mtime = std::filesystem::last_write_time(fsPath, ec);
+        size_t maxFileSize = 0;
+        {
+            std::shared_lock<std::shared_mutex> lock(cacheMutex_);
+            maxFileSize = maxCachedFileSize_;
+        }
+
+        std::shared_ptr<CachedAsset> asset;
+        if (!ec && size <= maxFileSize) {
+            asset = loadAsset(fullPath, mimeType, mtime, size);
+        }
+
+        std::unique_lock<std::shared_mutex> lock(cacheMutex_);
+        auto it = assetCache_.find(fullPath);
+        if (it != assetCache_.end()) {
+            cacheSize_ -= it->second->memoryUsage();
+            assetCache_.erase(it);
+        }
+        if (asset) {
+            asset->lastValidatedMs.store(nowMs, std::memory_order_relaxed);
+            // Count the load as a use, otherwise the trim below evicts the new entry first
+            asset->lastServed.store(++serveCounter_, std::memory_order_relaxed);
+            cacheSize_ += asset->memoryUsage();
+            assetCache_[fullPath] = asset;
+            trimAssetCache();
+            ELEGOO_LOG_DEBUG("Cached asset {} ({} bytes{}{})", fullPath, size,
+                             asset->gzip.present ? ", gzip" : "", asset->brotli.present ? ", br" : "");
+        }
+        return asset;
+    }
+
+    std::shared_ptr<StaticWebServer::CachedAsset> StaticWebServer::loadAsset(const std::string& fullPath,
+                                                                             const std::string& mimeType,
+                                                                             std::filesystem::file_time_type mtime,
+                                                                             uintmax_t size) const
+    {
+        auto content = readFile(fullPath);
+        if (!content) {
+            return nullptr;
+        }
+
+        auto asset = std::make_shared<CachedAsset>();
+        asset->mimeType = mimeType;
+        std::string filename = fullPath.substr(fullPath.find_last_of("/\\") + 1);
+        asset->cacheControl = getCacheControl(filename, getFileExtension(filename));
+        asset->mtime = mtime;
+        asset->size = size;
+        asset->identity.content = content;
+        asset->identity.etag = makeEtag(*content);
+        asset->identity.mtime = mtime;
+        asset->identity.present = true;
+
+        // Precompressed siblings produced by the web build (e.g. vite-plugin-compression)
+        auto loadVariant = [&fullPath](CachedAsset::Variant& variant, const char* suffix) {
+            std::error_code ec;
+            auto variantPath = fullPath + suffix;
+            auto variantMtime = std::filesystem::last_write_time(std::filesystem::u8path(variantPath), ec);
+            if (ec) {
+                return;
+            }
+            variant.mtime = variantMtime;
+            variant.content = readFile(variantPath);
+            if (variant.content) {
+                variant.etag = makeEtag(*variant.content);
+                variant.present = true;
+            }
+        };
+        loadVariant(asset->gzip, ".gz");
+        loadVariant(asset->brotli, ".br");
+        return asset;
+    }
+
+    bool StaticWebServer::isAssetCurrent(const std::string& fullPath, const CachedAsset& asset) const
+    {
+        std::error_code ec;
+        auto fsPath = std::filesystem::u8path(fullPath);
+        auto mtime = std::filesystem::last_write_time(fsPath, ec);
+        if (ec || mtime != asset.mtime || std::filesystem::file_size(fsPath, ec) != asset.size || ec) {
+            return false;
+        }
+
+        auto variantCurrent = [&fullPath](const CachedAsset::Variant& variant, const char* suffix) {
+            std::error_code variantEc;
+            auto variantMtime = std::filesystem::last_write_time(std::filesystem::u8path(fullPath + suffix), variantEc);
+            return variantEc ? !variant.present : (variant.present && variantMtime == variant.mtime);
+        };
+        return variantCurrent(asset.gzip, ".gz") && variantCurrent(asset.brotli, ".br");
+    }
+
+    void StaticWebServer::trimAssetCache()
+    {
+        while (cacheSize_ > maxCacheSize_ && !assetCache_.empty()) {
+            auto oldest = assetCache_.begin();
+            for (auto it = assetCache_.begin(); it != assetCache_.end(); ++it) {
+                if (it->second->lastServed.load(std::memory_order_relaxed) <
+                    oldest->second->lastServed.load(std::memory_order_relaxed)) {
+                    oldest = it;
+                }
+            }
+            cacheSize_ -= oldest->second->memoryUsage();
+            assetCache_.erase(oldest);
+        }
+    }
+
+    size_t StaticWebServer::CachedAsset::memoryUsage() const
+    {
+        size_t total = sizeof(CachedAsset);
+        for (const auto* variant : {&identity, &gzip, &brotli}) {
+            if (variant->content) {
+                total += variant->content->size();
+            }
+        }
+        return total;
+    }
+
+    std::string StaticWebServer::getCacheControl(const std::string& filename, const std::string& extension) const
+    {
+        if (extension == ".html" || extension == ".htm") {
+            // Entry documents revalidate every time so new builds are picked up; the ETag makes that a 304
+            return "no-cache";
+        }
+        if (std::regex_match(filename, immutableAssetPattern_)) {
+            return "public, max-age=31536000, immutable";
+        }
+        return "public, max-age=3600";
+    }
+
     std::string StaticWebServer::getMimeType(const std::string& extension) const
     {
         // Check custom MIME types first
@@ -4,11 +4,18 @@
 #include <memory>
 #include <thread>
 #include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <regex>
+#include <shared_mutex>
 #include <unordered_map>
 #include <httplib.h>
 
 namespace elink 
 {
+    class EventBus;
+    class StatusPushHub;
+
     /**
      * Static web server class using httplib to serve static files (Vue compiled web pages)
      */
@@ -81,6 +88,100 @@ namespace elink
          */
         void setIndexFiles(const std::vector<std::string>& indexFiles);
 
+        /**
+         * Set the number of request worker threads (takes effect on the next start())
+         * @param threads Worker thread count, 0 for the httplib default
+         */
+        void setWorkerThreads(size_t threads);
+
+        /**
+         * Set in-memory asset cache limits
+         * Files larger than maxFileSize are streamed from a memory mapping instead of cached.
+         * @param maxFileSize Largest file kept in memory (default: 2 MB)
+         * @param maxTotalSize Total cache size; the least recently served assets are evicted first (default: 64 MB)
+         */
+        void setAssetCacheLimits(size_t maxFileSize, size_t maxTotalSize);
+
+        /**
+         * Set the pattern identifying content-hashed file names, served with immutable caching headers
+         * @param pattern ECMAScript regex matched against the file name (default matches Vite/webpack names such as index-BfE4Mj2x.js)
+         */
+        void setImmutableAssetPattern(const std::string& pattern);
+
+        /**
+         * Serve printer status, attribute and connection changes as Server-Sent Events (takes effect on the next start())
+         * Query parameters: printers=id1,id2 (default all), events=status,attributes,connection (default all),
+         * interval=<ms> minimum time between pushes. Each SSE connection holds one worker thread, so at most
+         * half of the worker threads are given to push clients.
+         * @param eventBus Event bus to subscribe to, must outlive the server
+         * @param path Endpoint path (default: /api/events)
+         */
+        void enableStatusPush(EventBus& eventBus, const std::string& path = "/api/events");
+
+    private:
+        /**
+         * File contents with precompressed variants, kept in memory between requests
+         */
+        struct CachedAsset
+        {
+            struct Variant
+            {
+                std::shared_ptr<const std::string> content;
+                std::string etag;
+                std::filesystem::file_time_type mtime;
+                bool present = false;
+            };
+
+            std::string mimeType;
+            std::string cacheControl;
+            std::filesystem::file_time_type mtime;
+            uintmax_t size = 0;
+            Variant identity;
+            Variant gzip;
+            Variant brotli;
+            mutable std::atomic<int64_t> lastValidatedMs{0}; // Steady clock time of the last mtime check
+            mutable std::atomic<uint64_t> lastServed{0};     // Serve counter value, for LRU eviction
+
+            size_t memoryUsage() const;
+        };
+
+        /**
+         * Serve a regular file, from the asset cache when it fits
+         * @param req Request (Accept-Encoding, If-None-Match)
+         * @param res Response
+         * @param fullPath File path on disk
+         * @param mimeType Content type of the file
+         */
+        void serveFile(const httplib::Request& req, httplib::Response& res,
+                       const std::string& fullPath, const std::string& mimeType);
+
+        /**
+         * Get the cached asset for a file, loading or reloading it when the file changed on disk
+         * @return Cached asset, nullptr if the file is too large to cache or cannot be read
+         */
+        std::shared_ptr<const CachedAsset> getCachedAsset(const std::string& fullPath, const std::string& mimeType);
+
+        /**
+         * Read a file and its .gz/.br siblings into a new cache entry
+         */
+        std::shared_ptr<CachedAsset> loadAsset(const std::string& fullPath, const std::string& mimeType,
+                                               std::filesystem::file_time_type mtime, uintmax_t size) const;
+
+        /**
+         * Whether a cached asset still matches the files on disk
+         */
+        bool isAssetCurrent(const std::string& fullPath, const CachedAsset& asset) const;
+
+        /**
+         * Evict least recently served assets until the cache fits maxCacheSize_ (cacheMutex_ held)
+         */
+        void trimAssetCache();
+
+        /**
+         * Cache-Control header value for a file
+         */
+        std::string getCacheControl(const std::string& filename, const std::string& extension) const;
+
     private:
         /**
          * Initialize server routes and handlers
@@ -154,6 +255,21 @@ namespace elink
         bool directoryListing_;
         std::vector<std::string> indexFiles_;
         std::unordered_map<std::string, std::string> customMimeTypes_;
+        size_t workerThreads_;
+        std::regex immutableAssetPattern_;
+
+        // Status push
+        EventBus* statusPushEventBus_;
+        std::string statusPushPath_;
+        std::shared_ptr<StatusPushHub> statusPush_;
+
+        // Asset cache
+        size_t maxCachedFileSize_;
+        size_t maxCacheSize_;
+        size_t cacheSize_;
+        mutable std::shared_mutex cacheMutex_;
+        std::unordered_map<std::string, std::shared_ptr<CachedAsset>> assetCache_;
+        std::atomic<uint64_t> serveCounter_;
         
         // Default MIME types
         static const std::unordered_map<std::string, std::string> defaultMimeTypes_;
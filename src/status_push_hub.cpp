@@ -0,0 +1,366 @@
+#include "status_push_hub.h"
+#include "types/event.h"
+#include "types/internal/json_serializer.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <sstream>
+
+namespace elink
+{
+    namespace
+    {
+        const char *const CHANNEL_STATUS = "status";
+        const char *const CHANNEL_ATTRIBUTES = "attributes";
+        const char *const CHANNEL_CONNECTION = "connection";
+
+        std::set<std::string> splitList(const std::string &value)
+        {
+            std::set<std::string> items;
+            std::stringstream stream(value);
+            std::string item;
+            while (std::getline(stream, item, ','))
+            {
+                if (!item.empty())
+                {
+                    items.insert(item);
+                }
+            }
+            return items;
+        }
+
+        bool containsNull(const nlohmann::json &value)
+        {
+            if (value.is_null())
+            {
+                return true;
+            }
+            if (value.is_structured())
+            {
+                for (const auto &item : value)
+                {
+                    if (containsNull(item))
+                    {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+    } // namespace
+
+    StatusPushHub::StatusPushHub(EventBus &eventBus) : eventBus_(eventBus)
+    {
+        statusSubscription_ = eventBus_.subscribe<PrinterStatusEvent>(
+            [this](const std::shared_ptr<PrinterStatusEvent> &event)
+            { update(event->status.printerId, CHANNEL_STATUS, event->status); });
+        attributesSubscription_ = eventBus_.subscribe<PrinterAttributesEvent>(
+            [this](const std::shared_ptr<PrinterAttributesEvent> &event)
+            { update(event->attributes.printerId, CHANNEL_ATTRIBUTES, event->attributes); });
+        connectionSubscription_ = eventBus_.subscribe<PrinterConnectionEvent>(
+            [this](const std::shared_ptr<PrinterConnectionEvent> &event)
+            { update(event->connectionStatus.printerId, CHANNEL_CONNECTION, event->connectionStatus); });
+        listSubscription_ = eventBus_.subscribe<PrinterListChangedEvent>(
+            [this](const std::shared_ptr<PrinterListChangedEvent> &event)
+            {
+                for (const auto &printerId : event->change.removedPrinterIds)
+                {
+                    removePrinter(printerId);
+                }
+            });
+    }
+
+    StatusPushHub::~StatusPushHub()
+    {
+        eventBus_.unsubscribe<PrinterStatusEvent>(statusSubscription_);
+        eventBus_.unsubscribe<PrinterAttributesEvent>(attributesSubscription_);
+        eventBus_.unsubscribe<PrinterConnectionEvent>(connectionSubscription_);
+        eventBus_.unsubscribe<PrinterListChangedEvent>(listSubscription_);
+        shutdown();
+    }
+
+    StatusPushHub::ClientOptions StatusPushHub::parseOptions(const std::multimap<std::string, std::string> &params)
+    {
+        ClientOptions options;
+        auto it = params.find("printers");
+        if (it != params.end())
+        {
+            options.printerIds = splitList(it->second);
+        }
+        it = params.find("events");
+        if (it != params.end())
+        {
+            options.channels = splitList(it->second);
+        }
+        it = params.find("interval");
+        if (it != params.end())
+        {
+            try
+            {
+                options.minInterval = std::chrono::milliseconds(std::max(0, std::stoi(it->second)));
+            }
+            catch (const std::exception &)
+            {
+                // Ignore malformed values and push without throttling
+            }
+        }
+        return options;
+    }
+
+    std::shared_ptr<StatusPushHub::Client> StatusPushHub::addClient(ClientOptions options)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (shutdown_ || clients_.size() >= maxClients_)
+        {
+            return nullptr;
+        }
+
+        auto client = std::make_shared<Client>(std::move(options));
+        for (const auto &[key, state] : latest_)
+        {
+            if (wants(client->options_, key.first, key.second))
+            {
+                client->dirty_.insert(key);
+            }
+        }
+        clients_.insert(client);
+        ELEGOO_LOG_DEBUG("Status push client connected, {} clients", clients_.size());
+        return client;
+    }
+
+    void StatusPushHub::removeClient(const std::shared_ptr<Client> &client)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        client->closed_ = true;
+        clients_.erase(client);
+        ELEGOO_LOG_DEBUG("Status push client disconnected, {} clients", clients_.size());
+    }
+
+    size_t StatusPushHub::getClientCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return clients_.size();
+    }
+
+    void StatusPushHub::shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            shutdown_ = true;
+            for (const auto &client : clients_)
+            {
+                client->closed_ = true;
+            }
+            clients_.clear();
+        }
+        condition_.notify_all();
+    }
+
+    void StatusPushHub::update(const std::string &printerId, const std::string &channel, nlohmann::json state)
+    {
+        if (printerId.empty())
+        {
+            return;
+        }
+
+        bool notify = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            Client::Key key{printerId, channel};
+            latest_[key] = std::move(state);
+            for (const auto &client : clients_)
+            {
+                if (wants(client->options_, printerId, channel))
+                {
+                    // Only the key is queued: a client behind on writing picks up the latest state once
+                    client->dirty_.insert(key);
+                    notify = true;
+                }
+            }
+        }
+        if (notify)
+        {
+            condition_.notify_all();
+        }
+    }
+
+    void StatusPushHub::removePrinter(const std::string &printerId)
+    {
+        bool notify = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto first = latest_.lower_bound(Client::Key{printerId, ""});
+            auto last = first;
+            while (last != latest_.end() && last->first.first == printerId)
+            {
+                ++last;
+            }
+            if (first == last)
+            {
+                return;
+            }
+            latest_.erase(first, last);
+
+            for (const auto &client : clients_)
+            {
+                for (auto it = client->dirty_.begin(); it != client->dirty_.end();)
+                {
+                    it = it->first == printerId ? client->dirty_.erase(it) : std::next(it);
+                }
+                bool sent = false;
+                for (auto it = client->lastSent_.begin(); it != client->lastSent_.end();)
+                {
+                    if (it->first.first == printerId)
+                    {
+                        it = client->lastSent_.erase(it);
+                        sent = true;
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+                // Clients that never received the printer have nothing to drop
+                if (sent)
+                {
+                    client->removed_.insert(printerId);
+                    notify = true;
+                }
+            }
+        }
+        if (notify)
+        {
+            condition_.notify_all();
+        }
+    }
+
+    bool StatusPushHub::wants(const ClientOptions &options, const std::string &printerId, const std::string &channel)
+    {
+        return (options.printerIds.empty() || options.printerIds.count(printerId) > 0) &&
+               (options.channels.empty() || options.channels.count(channel) > 0);
+    }
+
+    std::string StatusPushHub::waitForUpdates(const std::shared_ptr<Client> &client)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        const auto keepaliveDeadline = std::chrono::steady_clock::now() + KEEPALIVE_INTERVAL;
+        while (true)
+        {
+            if (shutdown_ || client->closed_)
+            {
+                return "";
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            if (!client->dirty_.empty() || !client->removed_.empty())
+            {
+                auto due = client->lastFlush_ + client->options_.minInterval;
+                if (now >= due)
+                {
+                    break;
+                }
+                condition_.wait_until(lock, std::min(due, keepaliveDeadline));
+                continue;
+            }
+            if (now >= keepaliveDeadline)
+            {
+                return ": keepalive\n\n";
+            }
+            condition_.wait_until(lock, keepaliveDeadline);
+        }
+
+        std::string output;
+        for (const auto &printerId : client->removed_)
+        {
+            nlohmann::json message = {{"printerId", printerId}};
+            output += "event: removed\ndata: ";
+            output += message.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+            output += "\n\n";
+        }
+        client->removed_.clear();
+
+        for (const auto &key : client->dirty_)
+        {
+            auto latest = latest_.find(key);
+            if (latest == latest_.end())
+            {
+                continue;
+            }
+
+            nlohmann::json message = {{"printerId", key.first}};
+            auto sent = client->lastSent_.find(key);
+            if (sent == client->lastSent_.end())
+            {
+                message["snapshot"] = latest->second;
+                client->lastSent_.emplace(key, latest->second);
+            }
+            else
+            {
+                bool representable = true;
+                nlohmann::json patch = createMergePatch(sent->second, latest->second, representable);
+                if (patch.is_null())
+                {
+                    continue;
+                }
+                if (representable)
+                {
+                    message["patch"] = std::move(patch);
+                }
+                else
+                {
+                    message["snapshot"] = latest->second;
+                }
+                sent->second = latest->second;
+            }
+
+            output += "event: ";
+            output += key.second;
+            output += "\ndata: ";
+            output += message.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+            output += "\n\n";
+        }
+        client->dirty_.clear();
+        client->lastFlush_ = std::chrono::steady_clock::now();
+
+        // Changes that cancelled out still count as activity; send a keepalive so the caller always writes
+        return output.empty() ? ": keepalive\n\n" : output;
+    }
+
+    nlohmann::json StatusPushHub::createMergePatch(const nlohmann::json &source, const nlohmann::json &target,
+                                                   bool &representable)
+    {
+        if (!source.is_object() || !target.is_object())
+        {
+            if (source == target)
+            {
+                return nlohmann::json();
+            }
+            // Applying a patch drops null members, so a replacement holding nulls would lose them
+            representable = representable && !containsNull(target);
+            return target;
+        }
+
+        nlohmann::json patch = nlohmann::json::object();
+        for (auto it = source.begin(); it != source.end(); ++it)
+        {
+            if (!target.contains(it.key()))
+            {
+                patch[it.key()] = nullptr;
+            }
+        }
+        for (auto it = target.begin(); it != target.end(); ++it)
+        {
+            auto sourceIt = source.find(it.key());
+            if (sourceIt == source.end())
+            {
+                representable = representable && !containsNull(it.value());
+                patch[it.key()] = it.value();
+            }
+            else if (*sourceIt != it.value())
+            {
+                patch[it.key()] = createMergePatch(*sourceIt, it.value(), representable);
+            }
+        }
+        return patch.empty() ? nlohmann::json() : patch;
+    }
+
+} // namespace elink
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <nlohmann/json.hpp>
+#include "events/event_system.h"
+
+namespace elink
+{
+    /**
+     * Streams printer status, attribute and connection changes to browsers
+     *
+     * Subscribes to the EventBus once and keeps the latest state of every printer. Each
+     * connected client first receives a full snapshot of the printers it selected, then only
+     * JSON merge patches (RFC 7386) against what it was last sent. In a patch a null member
+     * means the member was removed; a change that sets a value to null cannot be expressed
+     * that way, so that state is sent as a new snapshot instead. Updates arriving while a
+     * client is still writing are coalesced, so a slow client gets the latest state rather
+     * than a backlog. When a printer is removed its state is dropped and clients receive a
+     * "removed" event for it.
+     */
+    class StatusPushHub
+    {
+    public:
+        /**
+         * Client subscription options
+         */
+        struct ClientOptions
+        {
+            std::set<std::string> printerIds; // Printers to stream, empty for all
+            std::set<std::string> channels;   // "status", "attributes", "connection"; empty for all
+            std::chrono::milliseconds minInterval{0}; // Minimum time between flushes to this client
+        };
+
+        /**
+         * One connected client
+         */
+        class Client
+        {
+        public:
+            explicit Client(ClientOptions options) : options_(std::move(options)) {}
+
+        private:
+            friend class StatusPushHub;
+
+            using Key = std::pair<std::string, std::string>; // printerId, channel
+
+            ClientOptions options_;
+            std::set<Key> dirty_;                      // Keys changed since the last flush
+            std::set<std::string> removed_;            // Printers removed since the last flush
+            std::map<Key, nlohmann::json> lastSent_;   // What the client currently holds
+            std::chrono::steady_clock::time_point lastFlush_;
+            bool closed_ = false;
+        };
+
+        static constexpr std::chrono::seconds KEEPALIVE_INTERVAL{15};
+
+        explicit StatusPushHub(EventBus &eventBus);
+        ~StatusPushHub();
+
+        StatusPushHub(const StatusPushHub &) = delete;
+        StatusPushHub &operator=(const StatusPushHub &) = delete;
+
+        /**
+         * Parse client options from a query string map
+         * Parameters: printers=id1,id2  events=status,attributes,connection  interval=<ms>
+         */
+        static ClientOptions parseOptions(const std::multimap<std::string, std::string> &params);
+
+        /**
+         * Register a client; it starts with every matching printer marked dirty (the snapshot)
+         * @return nullptr if maxClients are already connected or the hub is shutting down
+         */
+        std::shared_ptr<Client> addClient(ClientOptions options);
+
+        /**
+         * Unregister a client
+         */
+        void removeClient(const std::shared_ptr<Client> &client);
+
+        /**
+         * Wait until the client has updates or the keepalive interval passes, and format them
+         * @return Server-Sent Events text to write (a keepalive comment if nothing changed), empty once the hub shut down
+         */
+        std::string waitForUpdates(const std::shared_ptr<Client> &client);
+
+        /**
+         * Wake and close all clients; later addClient() calls fail
+         */
+        void shutdown();
+
+        void setMaxClients(size_t maxClients) { maxClients_ = maxClients; }
+        size_t getClientCount() const;
+
+    private:
+        void update(const std::string &printerId, const std::string &channel, nlohmann::json state);
+        void removePrinter(const std::string &printerId);
+        static bool wants(const ClientOptions &options, const std::string &printerId, const std::string &channel);
+
+        /**
+         * RFC 7386 merge patch turning source into target; null when they are equal
+         * @param representable Set to false if target holds a null the patch would turn into a removal
+         */
+        static nlohmann::json createMergePatch(const nlohmann::json &source, const nlohmann::json &target,
+                                               bool &representable);
+
+        EventBus &eventBus_;
+        EventBus::EventId statusSubscription_ = 0;
+        EventBus::EventId attributesSubscription_ = 0;
+        EventBus::EventId connectionSubscription_ = 0;
+        EventBus::EventId listSubscription_ = 0;
+
+        mutable std::mutex mutex_;
+        std::condition_variable condition_;
+        std::map<Client::Key, nlohmann::json> latest_;
+        std::set<std::shared_ptr<Client>> clients_;
+        size_t maxClients_ = 8;
+        bool shutdown_ = false;
+    };
+
+} // namespace elink
@@ -0,0 +1,293 @@
+#include "telemetry/gorilla_codec.h"
+#include <algorithm>
+#include <cstring>
+
+namespace elink
+{
+    namespace
+    {
+        // Raw first sample, then at most a 64-bit delta-of-delta and a full XOR window
+        constexpr size_t FIRST_SAMPLE_BITS = 64 + 64;
+        constexpr size_t MAX_SAMPLE_BITS = (4 + 64) + (2 + 5 + 6 + 64);
+
+        // Delta-of-delta buckets: control bits, value bits, value range [-(2^(n-1)-1), 2^(n-1)]
+        struct DeltaBucket
+        {
+            uint64_t control;
+            int controlBits;
+            int valueBits;
+        };
+
+        constexpr DeltaBucket DELTA_BUCKETS[] = {
+            {0b10, 2, 7},
+            {0b110, 3, 9},
+            {0b1110, 4, 12},
+        };
+
+        int64_t bucketOffset(int valueBits)
+        {
+            return (int64_t(1) << (valueBits - 1)) - 1;
+        }
+
+        uint64_t doubleBits(double value)
+        {
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        double bitsDouble(uint64_t bits)
+        {
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        // x must not be 0
+        int leadingZeros(uint64_t x)
+        {
+            int n = 0;
+            for (int shift = 32; shift > 0; shift /= 2)
+            {
+                if (!(x >> (64 - shift)))
+                {
+                    n += shift;
+                    x <<= shift;
+                }
+            }
+            return n;
+        }
+
+        // x must not be 0
+        int trailingZeros(uint64_t x)
+        {
+            int n = 0;
+            for (int shift = 32; shift > 0; shift /= 2)
+            {
+                if (!(x << (64 - shift)))
+                {
+                    n += shift;
+                    x >>= shift;
+                }
+            }
+            return n;
+        }
+    } // namespace
+
+    // ========== GorillaEncoder ==========
+
+    GorillaEncoder::GorillaEncoder(size_t capacityBytes)
+        : bytes_(capacityBytes, 0), capacityBits_(capacityBytes * 8)
+    {
+    }
+
+    bool GorillaEncoder::append(int64_t timestampMs, double value)
+    {
+        uint64_t bits = doubleBits(value);
+        if (count_ == 0)
+        {
+            if (capacityBits_ < FIRST_SAMPLE_BITS)
+            {
+                return false;
+            }
+            writeBits(static_cast<uint64_t>(timestampMs), 64);
+            writeBits(bits, 64);
+            previousTimestamp_ = timestampMs;
+            previousDelta_ = 0;
+            previousValue_ = bits;
+            count_ = 1;
+            return true;
+        }
+        if (bitCount_ + MAX_SAMPLE_BITS > capacityBits_)
+        {
+            return false;
+        }
+
+        int64_t delta = timestampMs - previousTimestamp_;
+        int64_t deltaOfDelta = delta - previousDelta_;
+        if (deltaOfDelta == 0)
+        {
+            writeBits(0, 1);
+        }
+        else
+        {
+            bool written = false;
+            for (const auto &bucket : DELTA_BUCKETS)
+            {
+                int64_t offset = bucketOffset(bucket.valueBits);
+                if (deltaOfDelta >= -offset && deltaOfDelta <= offset + 1)
+                {
+                    writeBits(bucket.control, bucket.controlBits);
+                    writeBits(static_cast<uint64_t>(deltaOfDelta + offset), bucket.valueBits);
+                    written = true;
+                    break;
+                }
+            }
+            if (!written)
+            {
+                writeBits(0b1111, 4);
+                writeBits(static_cast<uint64_t>(deltaOfDelta), 64);
+            }
+        }
+        previousTimestamp_ = timestampMs;
+        previousDelta_ = delta;
+
+        uint64_t x = bits ^ previousValue_;
+        previousValue_ = bits;
+        if (x == 0)
+        {
+            writeBits(0, 1);
+        }
+        else
+        {
+            int leading = std::min(leadingZeros(x), 31);
+            int trailing = trailingZeros(x);
+            if (previousLeading_ >= 0 && leading >= previousLeading_ && trailing >= previousTrailing_)
+            {
+                // Changed bits fit the previous window
+                writeBits(0b10, 2);
+                writeBits(x >> previousTrailing_, 64 - previousLeading_ - previousTrailing_);
+            }
+            else
+            {
+                int length = 64 - leading - trailing;
+                writeBits(0b11, 2);
+                writeBits(static_cast<uint64_t>(leading), 5);
+                writeBits(static_cast<uint64_t>(length - 1), 6);
+                writeBits(x >> trailing, length);
+                previousLeading_ = leading;
+                previousTrailing_ = trailing;
+            }
+        }
+        ++count_;
+        return true;
+    }
+
+    std::vector<uint8_t> GorillaEncoder::release()
+    {
+        std::vector<uint8_t> bytes = std::move(bytes_);
+        bytes.resize((bitCount_ + 7) / 8);
+        bytes.shrink_to_fit();
+
+        bytes_.assign(capacityBits_ / 8, 0);
+        bitCount_ = 0;
+        count_ = 0;
+        previousLeading_ = -1;
+        previousTrailing_ = 0;
+        return bytes;
+    }
+
+    void GorillaEncoder::writeBits(uint64_t value, int bits)
+    {
+        while (bits > 0)
+        {
+            int free = 8 - static_cast<int>(bitCount_ & 7);
+            int take = std::min(free, bits);
+            auto chunk = static_cast<uint8_t>((value >> (bits - take)) & ((1u << take) - 1));
+            bytes_[bitCount_ >> 3] |= static_cast<uint8_t>(chunk << (free - take));
+            bitCount_ += take;
+            bits -= take;
+        }
+    }
+
+    // ========== GorillaDecoder ==========
+
+    GorillaDecoder::GorillaDecoder(const uint8_t *data, size_t bitCount, uint32_t count)
+        : data_(data), byteCount_((bitCount + 7) / 8), remaining_(count)
+    {
+    }
+
+    bool GorillaDecoder::next(int64_t &timestampMs, double &value)
+    {
+        if (remaining_ == 0)
+        {
+            return false;
+        }
+
+        if (index_ == 0)
+        {
+            timestamp_ = static_cast<int64_t>(readBits(64));
+            value_ = readBits(64);
+        }
+        else
+        {
+            int64_t deltaOfDelta = 0;
+            if (readBit())
+            {
+                bool matched = false;
+                for (const auto &bucket : DELTA_BUCKETS)
+                {
+                    if (!readBit())
+                    {
+                        deltaOfDelta = static_cast<int64_t>(readBits(bucket.valueBits)) - bucketOffset(bucket.valueBits);
+                        matched = true;
+                        break;
+                    }
+                }
+                if (!matched)
+                {
+                    deltaOfDelta = static_cast<int64_t>(readBits(64));
+                }
+            }
+            delta_ += deltaOfDelta;
+            timestamp_ += delta_;
+
+            if (readBit())
+            {
+                if (readBit())
+                {
+                    leading_ = static_cast<int>(readBits(5));
+                    int length = static_cast<int>(readBits(6)) + 1;
+                    trailing_ = 64 - leading_ - length;
+                }
+                value_ ^= readBits(64 - leading_ - trailing_) << trailing_;
+            }
+        }
+
+        // A block cut short (corrupt count) ends instead of reading past its bytes
+        if (overrun_)
+        {
+            remaining_ = 0;
+            return false;
+        }
+        ++index_;
+        --remaining_;
+        timestampMs = timestamp_;
+        value = bitsDouble(value_);
+        return true;
+    }
+
+    uint64_t GorillaDecoder::readBits(int bits)
+    {
+        // The buffer holds at most 64 bits, so wide fields are read in two halves
+        if (bits > 32)
+        {
+            uint64_t high = readBits(bits - 32);
+            return (high << 32) | readBits(32);
+        }
+        if (bufferBits_ < bits)
+        {
+            // Refill the buffer, left-aligned, a byte at a time
+            while (bufferBits_ <= 56 && nextByte_ < byteCount_)
+            {
+                buffer_ |= static_cast<uint64_t>(data_[nextByte_++]) << (56 - bufferBits_);
+                bufferBits_ += 8;
+            }
+            if (bufferBits_ < bits)
+            {
+                overrun_ = true;
+                return 0;
+            }
+        }
+        uint64_t value = buffer_ >> (64 - bits);
+        buffer_ <<= bits;
+        bufferBits_ -= bits;
+        return value;
+    }
+
+    bool GorillaDecoder::readBit()
+    {
+        return readBits(1) != 0;
+    }
+
+} // namespace elink
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace elink
+{
+    /**
+     * Gorilla time series compression (Pelkonen et al., VLDB 2015) into a fixed-size block
+     *
+     * The first sample is stored raw. Later timestamps are stored as the delta of their delta,
+     * in 1 bit when samples arrive at a steady rate; later values as the XOR with the previous
+     * value, in 1 bit when unchanged and in the changed bits otherwise. Timestamps are unix
+     * milliseconds, so delta-of-deltas use wider buckets than the paper's seconds.
+     */
+    class GorillaEncoder
+    {
+    public:
+        /**
+         * @param capacityBytes Block size; append() fails once a sample might not fit
+         */
+        explicit GorillaEncoder(size_t capacityBytes);
+
+        /**
+         * Append a sample; timestamps must not decrease
+         * @return false if the block is full, the sample is not written
+         */
+        bool append(int64_t timestampMs, double value);
+
+        uint32_t count() const { return count_; }
+        size_t bitCount() const { return bitCount_; }
+        const std::vector<uint8_t> &bytes() const { return bytes_; }
+
+        /**
+         * Move the encoded bytes out, trimmed to their size; the encoder is reset
+         */
+        std::vector<uint8_t> release();
+
+    private:
+        void writeBits(uint64_t value, int bits);
+
+        std::vector<uint8_t> bytes_;
+        size_t capacityBits_;
+        size_t bitCount_ = 0;
+        uint32_t count_ = 0;
+        int64_t previousTimestamp_ = 0;
+        int64_t previousDelta_ = 0;
+        uint64_t previousValue_ = 0;
+        int previousLeading_ = -1; // Leading zeros of the last stored XOR window, -1 before the first
+        int previousTrailing_ = 0;
+    };
+
+    /**
+     * Reads the samples of a block written by GorillaEncoder
+     */
+    class GorillaDecoder
+    {
+    public:
+        GorillaDecoder(const uint8_t *data, size_t bitCount, uint32_t count);
+
+        /**
+         * @return false after the last sample
+         */
+        bool next(int64_t &timestampMs, double &value);
+
+    private:
+        uint64_t readBits(int bits); // 1 to 64 bits
+        bool readBit();
+
+        const uint8_t *data_;
+        size_t byteCount_;
+        size_t nextByte_ = 0;
+        uint64_t buffer_ = 0; // Unread bits, left-aligned
+        int bufferBits_ = 0;
+        bool overrun_ = false;
+        uint32_t remaining_;
+        uint32_t index_ = 0;
+        int64_t timestamp_ = 0;
+        int64_t delta_ = 0;
+        uint64_t value_ = 0;
+        int leading_ = 0;
+        int trailing_ = 0;
+    };
+
+} // namespace elink
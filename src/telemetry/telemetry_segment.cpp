@@ -0,0 +1,435 @@
+#include "telemetry/telemetry_segment.h"
+#include "telemetry/telemetry_store.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace elink
+{
+    namespace
+    {
+        // Files grow in steps of this size, and are trimmed to their contents when finished
+        constexpr size_t GROWTH_BYTES = 1024 * 1024;
+        constexpr uint32_t MAX_PARTS_PER_DAY = 10000;
+
+        size_t align8(size_t size)
+        {
+            return (size + 7) & ~size_t(7);
+        }
+
+        size_t blockBytes(const TelemetryIndexEntry &entry)
+        {
+            return (static_cast<size_t>(entry.bitCount) + 7) / 8;
+        }
+
+        uint32_t fnv1a(const uint8_t *data, size_t size, uint32_t hash = 2166136261u)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= data[i];
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
+        uint32_t entryChecksum(const TelemetryIndexEntry &entry, const uint8_t *block)
+        {
+            TelemetryIndexEntry copy = entry;
+            copy.checksum = 0;
+            uint32_t hash = fnv1a(reinterpret_cast<const uint8_t *>(&copy), sizeof(copy));
+            return fnv1a(block, blockBytes(entry), hash);
+        }
+
+        // YYYYMMDD of a UTC day, without the platform's gmtime variants
+        std::string formatDay(int64_t dayStartMs)
+        {
+            int64_t days = dayStartMs / TELEMETRY_SEGMENT_DAY_MS + 719468;
+            int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+            int64_t dayOfEra = days - era * 146097;
+            int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+            int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+            int64_t monthIndex = (5 * dayOfYear + 2) / 153;
+            int64_t day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+            int64_t month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+            int64_t year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%04lld%02lld%02lld", static_cast<long long>(year),
+                          static_cast<long long>(month), static_cast<long long>(day));
+            return buffer;
+        }
+
+        std::string segmentPath(const std::string &directory, const std::string &name, const char *extension)
+        {
+            return (std::filesystem::u8path(directory) / std::filesystem::u8path(name + extension)).u8string();
+        }
+    } // namespace
+
+    std::shared_ptr<TelemetrySegment> TelemetrySegment::create(const std::string &directory, int64_t dayStartMs,
+                                                               size_t maxBytes, std::string &error)
+    {
+#ifdef _WIN32
+        (void)directory;
+        (void)dayStartMs;
+        (void)maxBytes;
+        error = "Telemetry segment files are not supported on Windows";
+        return nullptr;
+#else
+        std::shared_ptr<TelemetrySegment> segment(new TelemetrySegment());
+        segment->directory_ = directory;
+        segment->dayStartMs_ = dayStartMs;
+        segment->writable_ = true;
+
+        std::string day = formatDay(dayStartMs);
+        std::error_code ec;
+        for (uint32_t part = 0; part < MAX_PARTS_PER_DAY; ++part)
+        {
+            char suffix[16];
+            std::snprintf(suffix, sizeof(suffix), "-%04u", part);
+            std::string name = "telemetry-" + day + suffix;
+            if (!std::filesystem::exists(std::filesystem::u8path(segmentPath(directory, name, ".idx")), ec) &&
+                !std::filesystem::exists(std::filesystem::u8path(segmentPath(directory, name, ".dat")), ec))
+            {
+                segment->name_ = name;
+                break;
+            }
+        }
+        if (segment->name_.empty())
+        {
+            error = "Too many telemetry segments for " + day;
+            return nullptr;
+        }
+
+        auto createFile = [&](Mapping &mapping, const char *extension, size_t mappedSize, TelemetrySegmentFile kind)
+        {
+            std::string path = segmentPath(directory, segment->name_, extension);
+            mapping.fd = ::open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+            if (mapping.fd < 0)
+            {
+                error = "Failed to create " + path + ": " + std::strerror(errno);
+                return false;
+            }
+            // The whole size limit is mapped once, so block pointers survive the file growing
+            void *memory = ::mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, mapping.fd, 0);
+            if (memory == MAP_FAILED)
+            {
+                error = "Failed to map " + path + ": " + std::strerror(errno);
+                return false;
+            }
+            mapping.base = static_cast<uint8_t *>(memory);
+            mapping.mappedSize = mappedSize;
+            if (!segment->reserve(mapping, TELEMETRY_SEGMENT_HEADER_SIZE))
+            {
+                error = "Failed to size " + path + ": " + std::strerror(errno);
+                return false;
+            }
+            auto *header = reinterpret_cast<TelemetrySegmentHeader *>(mapping.base);
+            header->magic = TELEMETRY_SEGMENT_MAGIC;
+            header->version = TELEMETRY_SEGMENT_VERSION;
+            header->kind = static_cast<uint32_t>(kind);
+            header->dayStartMs = dayStartMs;
+            header->entryCount.store(0, std::memory_order_relaxed);
+            mapping.used = TELEMETRY_SEGMENT_HEADER_SIZE;
+            return true;
+        };
+        if (!createFile(segment->data_, ".dat", maxBytes, TelemetrySegmentFile::DATA) ||
+            !createFile(segment->index_, ".idx", std::max(maxBytes / 4, TELEMETRY_SEGMENT_HEADER_SIZE + sizeof(TelemetryIndexEntry)),
+                        TelemetrySegmentFile::INDEX))
+        {
+            segment->remove();
+            return nullptr;
+        }
+        return segment;
+#endif
+    }
+
+    std::shared_ptr<TelemetrySegment> TelemetrySegment::open(const std::string &indexPath, std::string &error)
+    {
+#ifdef _WIN32
+        (void)indexPath;
+        error = "Telemetry segment files are not supported on Windows";
+        return nullptr;
+#else
+        std::shared_ptr<TelemetrySegment> segment(new TelemetrySegment());
+        std::filesystem::path path = std::filesystem::u8path(indexPath);
+        segment->directory_ = path.parent_path().u8string();
+        segment->name_ = path.stem().u8string();
+
+        auto mapFile = [&](Mapping &mapping, const char *extension, TelemetrySegmentFile kind)
+        {
+            std::string filePath = segmentPath(segment->directory_, segment->name_, extension);
+            int fd = ::open(filePath.c_str(), O_RDONLY);
+            if (fd < 0)
+            {
+                error = "Failed to open " + filePath + ": " + std::strerror(errno);
+                return false;
+            }
+            struct stat info;
+            if (::fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < TELEMETRY_SEGMENT_HEADER_SIZE)
+            {
+                ::close(fd);
+                error = filePath + " is not a telemetry segment";
+                return false;
+            }
+            auto size = static_cast<size_t>(info.st_size);
+            void *memory = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if (memory == MAP_FAILED)
+            {
+                error = "Failed to map " + filePath + ": " + std::strerror(errno);
+                return false;
+            }
+            mapping.base = static_cast<uint8_t *>(memory);
+            mapping.mappedSize = size;
+            mapping.fileSize = size;
+            mapping.used = size;
+
+            const auto *header = reinterpret_cast<const TelemetrySegmentHeader *>(mapping.base);
+            if (header->magic != TELEMETRY_SEGMENT_MAGIC || header->version != TELEMETRY_SEGMENT_VERSION ||
+                header->kind != static_cast<uint32_t>(kind))
+            {
+                error = filePath + " is not a telemetry segment of version " + std::to_string(TELEMETRY_SEGMENT_VERSION);
+                return false;
+            }
+            return true;
+        };
+        if (!mapFile(segment->index_, ".idx", TelemetrySegmentFile::INDEX) ||
+            !mapFile(segment->data_, ".dat", TelemetrySegmentFile::DATA))
+        {
+            return nullptr;
+        }
+        segment->dayStartMs_ = segment->indexHeader()->dayStartMs;
+        if (reinterpret_cast<const TelemetrySegmentHeader *>(segment->data_.base)->dayStartMs != segment->dayStartMs_)
+        {
+            error = segment->name_ + " has index and data files of different days";
+            return nullptr;
+        }
+
+        // Entries past the last one whose bytes match its checksum were cut short
+        size_t count = std::min<uint64_t>(segment->indexHeader()->entryCount.load(std::memory_order_acquire),
+                                          (segment->index_.fileSize - TELEMETRY_SEGMENT_HEADER_SIZE) / sizeof(TelemetryIndexEntry));
+        size_t committed = count;
+        while (count > 0 && !segment->validEntry(segment->entry(count - 1), true))
+        {
+            --count;
+        }
+        // Earlier entries are only bounds-checked, which keeps a damaged file from being read past its end
+        int64_t maxEndMs = INT64_MIN;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto &entry = segment->entry(i);
+            if (!segment->validEntry(entry, false) || entry.maxEndMs < maxEndMs)
+            {
+                count = i;
+                break;
+            }
+            maxEndMs = entry.maxEndMs;
+        }
+        if (count < committed)
+        {
+            error = segment->name_ + ": dropped " + std::to_string(committed - count) + " damaged entries";
+        }
+        segment->entryCount_ = count;
+        segment->lastEndMs_ = maxEndMs;
+        return segment;
+#endif
+    }
+
+    TelemetrySegment::~TelemetrySegment()
+    {
+        release();
+    }
+
+    const uint8_t *TelemetrySegment::appendBlock(const std::string &printerId, TelemetryMetric metric, const TelemetryBlock &block)
+    {
+        if (!writable_ || printerId.size() > TELEMETRY_SERIES_MAX_PRINTER_ID_SIZE)
+        {
+            return nullptr;
+        }
+
+        std::string key = std::to_string(static_cast<int>(metric)) + ":" + printerId;
+        auto series = seriesOffsets_.find(key);
+        size_t seriesBytes = series == seriesOffsets_.end() ? align8(sizeof(TelemetrySeriesRecord) + printerId.size()) : 0;
+        size_t bytes = (block.bitCount + 7) / 8;
+        size_t dataEnd = data_.used + seriesBytes + align8(bytes);
+        size_t indexEnd = index_.used + sizeof(TelemetryIndexEntry);
+        if (!reserve(data_, dataEnd) || !reserve(index_, indexEnd))
+        {
+            return nullptr;
+        }
+
+        uint64_t seriesOffset;
+        if (series == seriesOffsets_.end())
+        {
+            seriesOffset = data_.used;
+            TelemetrySeriesRecord record{TELEMETRY_SERIES_MAGIC, static_cast<uint16_t>(metric), static_cast<uint16_t>(printerId.size())};
+            std::memcpy(data_.base + seriesOffset, &record, sizeof(record));
+            std::memcpy(data_.base + seriesOffset + sizeof(record), printerId.data(), printerId.size());
+            seriesOffsets_.emplace(std::move(key), seriesOffset);
+        }
+        else
+        {
+            seriesOffset = series->second;
+        }
+        uint8_t *stored = data_.base + data_.used + seriesBytes;
+        std::memcpy(stored, block.data(), bytes);
+
+        TelemetryIndexEntry entry{};
+        entry.startMs = block.startMs;
+        entry.endMs = block.endMs;
+        entry.maxEndMs = std::max(block.endMs, lastEndMs_);
+        entry.dataOffset = static_cast<uint64_t>(stored - data_.base);
+        entry.seriesOffset = seriesOffset;
+        entry.min = block.min;
+        entry.max = block.max;
+        entry.sum = block.sum;
+        entry.count = block.count;
+        entry.bitCount = static_cast<uint32_t>(block.bitCount);
+        entry.checksum = entryChecksum(entry, stored);
+        std::memcpy(index_.base + index_.used, &entry, sizeof(entry));
+
+        data_.used = dataEnd;
+        index_.used = indexEnd;
+        lastEndMs_ = entry.maxEndMs;
+        indexHeader()->entryCount.store(++entryCount_, std::memory_order_release);
+        return stored;
+    }
+
+    void TelemetrySegment::finish()
+    {
+#ifndef _WIN32
+        if (!writable_)
+        {
+            return;
+        }
+        writable_ = false;
+        for (Mapping *mapping : {&data_, &index_})
+        {
+            ::msync(mapping->base, mapping->used, MS_SYNC);
+            if (::ftruncate(mapping->fd, static_cast<off_t>(mapping->used)) == 0)
+            {
+                mapping->fileSize = mapping->used;
+            }
+            ::close(mapping->fd);
+            mapping->fd = -1;
+        }
+#endif
+    }
+
+    void TelemetrySegment::remove()
+    {
+        std::error_code ec;
+        std::filesystem::remove(std::filesystem::u8path(segmentPath(directory_, name_, ".idx")), ec);
+        std::filesystem::remove(std::filesystem::u8path(segmentPath(directory_, name_, ".dat")), ec);
+    }
+
+    const TelemetryIndexEntry &TelemetrySegment::entry(size_t index) const
+    {
+        return *reinterpret_cast<const TelemetryIndexEntry *>(index_.base + TELEMETRY_SEGMENT_HEADER_SIZE +
+                                                              index * sizeof(TelemetryIndexEntry));
+    }
+
+    size_t TelemetrySegment::seek(int64_t timestampMs) const
+    {
+        size_t low = 0;
+        size_t high = entryCount_;
+        while (low < high)
+        {
+            size_t middle = low + (high - low) / 2;
+            if (entry(middle).maxEndMs < timestampMs)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        return low;
+    }
+
+    bool TelemetrySegment::readSeries(uint64_t offset, std::string &printerId, TelemetryMetric &metric) const
+    {
+        if (offset < TELEMETRY_SEGMENT_HEADER_SIZE || offset > data_.fileSize ||
+            data_.fileSize - offset < sizeof(TelemetrySeriesRecord))
+        {
+            return false;
+        }
+        TelemetrySeriesRecord record;
+        std::memcpy(&record, data_.base + offset, sizeof(record));
+        if (record.magic != TELEMETRY_SERIES_MAGIC || record.metric >= TELEMETRY_METRIC_COUNT ||
+            data_.fileSize - offset - sizeof(record) < record.printerIdSize)
+        {
+            return false;
+        }
+        printerId.assign(reinterpret_cast<const char *>(data_.base + offset + sizeof(record)), record.printerIdSize);
+        metric = static_cast<TelemetryMetric>(record.metric);
+        return true;
+    }
+
+    bool TelemetrySegment::reserve(Mapping &mapping, size_t size)
+    {
+#ifdef _WIN32
+        (void)mapping;
+        (void)size;
+        return false;
+#else
+        if (size <= mapping.fileSize)
+        {
+            return true;
+        }
+        if (size > mapping.mappedSize)
+        {
+            return false;
+        }
+        size_t fileSize = std::min((size + GROWTH_BYTES - 1) / GROWTH_BYTES * GROWTH_BYTES, mapping.mappedSize);
+        if (::ftruncate(mapping.fd, static_cast<off_t>(fileSize)) != 0)
+        {
+            return false;
+        }
+        mapping.fileSize = fileSize;
+        return true;
+#endif
+    }
+
+    bool TelemetrySegment::validEntry(const TelemetryIndexEntry &entry, bool verifyChecksum) const
+    {
+        size_t bytes = blockBytes(entry);
+        if (entry.count == 0 || entry.startMs > entry.endMs || entry.endMs > entry.maxEndMs ||
+            entry.dataOffset < TELEMETRY_SEGMENT_HEADER_SIZE || entry.dataOffset > data_.fileSize ||
+            data_.fileSize - entry.dataOffset < bytes ||
+            entry.seriesOffset < TELEMETRY_SEGMENT_HEADER_SIZE || entry.seriesOffset >= entry.dataOffset)
+        {
+            return false;
+        }
+        return !verifyChecksum || entryChecksum(entry, blockData(entry)) == entry.checksum;
+    }
+
+    void TelemetrySegment::release()
+    {
+#ifndef _WIN32
+        for (Mapping *mapping : {&data_, &index_})
+        {
+            if (mapping->base)
+            {
+                ::munmap(mapping->base, mapping->mappedSize);
+                mapping->base = nullptr;
+            }
+            if (mapping->fd >= 0)
+            {
+                ::close(mapping->fd);
+                mapping->fd = -1;
+            }
+        }
+#endif
+    }
+
+} // namespace elink
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "type.h"
+
+namespace elink
+{
+    struct TelemetryBlock;
+
+    /**
+     * Telemetry segment files
+     *
+     * Sealed telemetry blocks are appended to a pair of files per UTC day, in a directory:
+     *
+     *   telemetry-YYYYMMDD-PPPP.dat  header | series records and block bytes, 8-byte aligned
+     *   telemetry-YYYYMMDD-PPPP.idx  header | TelemetryIndexEntry per block, in append order
+     *
+     * Every process run starts a new part of the day, and a part that reaches its size limit
+     * continues in the next one. A block is committed by writing its bytes and its index entry,
+     * then storing the new entry count in the index header. On reopen, trailing entries whose
+     * checksum does not match their bytes (a tail cut short by a crash) are dropped; earlier
+     * entries are used as they are, and their blocks are decoded straight from the mapping.
+     */
+    constexpr uint32_t TELEMETRY_SEGMENT_MAGIC = 0x53544C45; // "ELTS"
+    constexpr uint32_t TELEMETRY_SEGMENT_VERSION = 1;
+    constexpr uint32_t TELEMETRY_SERIES_MAGIC = 0x52534C45;  // "ELSR"
+    constexpr size_t TELEMETRY_SEGMENT_HEADER_SIZE = 64;
+    constexpr size_t TELEMETRY_SERIES_MAX_PRINTER_ID_SIZE = 1024;
+    constexpr int64_t TELEMETRY_SEGMENT_DAY_MS = 24 * 60 * 60 * 1000;
+
+    enum class TelemetrySegmentFile : uint32_t
+    {
+        DATA = 1,
+        INDEX = 2,
+    };
+
+    struct TelemetrySegmentHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t kind; // TelemetrySegmentFile
+        uint32_t reserved;
+        int64_t dayStartMs;              // UTC midnight of the day the segment holds
+        std::atomic<uint64_t> entryCount; // Index file: committed entries
+    };
+    static_assert(sizeof(TelemetrySegmentHeader) <= TELEMETRY_SEGMENT_HEADER_SIZE, "Telemetry segment header is too large");
+
+    /**
+     * Names the series of the blocks that refer to it; followed by the printer ID
+     */
+    struct TelemetrySeriesRecord
+    {
+        uint32_t magic;
+        uint16_t metric; // TelemetryMetric
+        uint16_t printerIdSize;
+    };
+
+    struct TelemetryIndexEntry
+    {
+        int64_t startMs;
+        int64_t endMs;
+        int64_t maxEndMs;      // Largest endMs of this and the earlier entries, for time seeks
+        uint64_t dataOffset;   // Block bytes in the data file
+        uint64_t seriesOffset; // TelemetrySeriesRecord in the data file
+        double min;
+        double max;
+        double sum;
+        uint32_t count;
+        uint32_t bitCount;
+        uint32_t checksum; // FNV-1a of the entry, with this field 0, and of the block bytes
+        uint32_t reserved;
+    };
+    static_assert(sizeof(TelemetryIndexEntry) == 80, "Telemetry index entries are fixed-size records");
+
+    /**
+     * One part of a day: a writable segment appends blocks, an opened one is read-only
+     *
+     * Both files stay mapped for the life of the object, so block bytes handed out by
+     * appendBlock() and blockData() remain valid while the segment is referenced.
+     */
+    class TelemetrySegment
+    {
+    public:
+        /**
+         * Create the next part of a day in a directory
+         * @param maxBytes Size limit of the data file; the index file is limited to a quarter of it
+         */
+        static std::shared_ptr<TelemetrySegment> create(const std::string &directory, int64_t dayStartMs,
+                                                        size_t maxBytes, std::string &error);
+
+        /**
+         * Map an existing segment read-only and drop its torn tail
+         * @param indexPath The .idx file; the .dat file is next to it
+         */
+        static std::shared_ptr<TelemetrySegment> open(const std::string &indexPath, std::string &error);
+
+        ~TelemetrySegment();
+
+        /**
+         * Append a sealed block
+         * @return The stored block bytes, or nullptr if the segment is full or cannot grow
+         */
+        const uint8_t *appendBlock(const std::string &printerId, TelemetryMetric metric, const TelemetryBlock &block);
+
+        /**
+         * Trim a writable segment's files to their contents and flush them
+         */
+        void finish();
+
+        /**
+         * Delete the files; the mapping stays valid until the segment is released
+         */
+        void remove();
+
+        size_t entryCount() const { return entryCount_; }
+        const TelemetryIndexEntry &entry(size_t index) const;
+
+        /**
+         * Index of the first entry that ends at or after a time
+         */
+        size_t seek(int64_t timestampMs) const;
+
+        const uint8_t *blockData(const TelemetryIndexEntry &entry) const { return data_.base + entry.dataOffset; }
+
+        /**
+         * @return false if the series record is damaged
+         */
+        bool readSeries(uint64_t offset, std::string &printerId, TelemetryMetric &metric) const;
+
+        int64_t dayStartMs() const { return dayStartMs_; }
+        int64_t lastEndMs() const { return lastEndMs_; }
+        const std::string &getName() const { return name_; }
+
+    private:
+        struct Mapping
+        {
+            int fd = -1;
+            uint8_t *base = nullptr;
+            size_t mappedSize = 0; // Address space reserved for the file
+            size_t fileSize = 0;
+            size_t used = 0;
+        };
+
+        TelemetrySegment() = default;
+        TelemetrySegment(const TelemetrySegment &) = delete;
+        TelemetrySegment &operator=(const TelemetrySegment &) = delete;
+
+        bool reserve(Mapping &mapping, size_t size);
+        bool validEntry(const TelemetryIndexEntry &entry, bool verifyChecksum) const;
+        TelemetrySegmentHeader *indexHeader() const { return reinterpret_cast<TelemetrySegmentHeader *>(index_.base); }
+        void release();
+
+        std::string directory_;
+        std::string name_; // File name without extension
+        int64_t dayStartMs_ = 0;
+        int64_t lastEndMs_ = INT64_MIN;
+        bool writable_ = false;
+        Mapping data_;
+        Mapping index_;
+        size_t entryCount_ = 0;
+        std::unordered_map<std::string, uint64_t> seriesOffsets_; // Writer: "metric:printerId" -> record
+    };
+
+    /**
+     * UTC midnight of the day a time falls on
+     */
+    inline int64_t telemetrySegmentDay(int64_t timestampMs)
+    {
+        int64_t remainder = timestampMs % TELEMETRY_SEGMENT_DAY_MS;
+        return timestampMs - (remainder < 0 ? remainder + TELEMETRY_SEGMENT_DAY_MS : remainder);
+    }
+
+} // namespace elink
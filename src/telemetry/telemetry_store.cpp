@@ -0,0 +1,792 @@
+#include "telemetry/telemetry_store.h"
+#include "telemetry/telemetry_segment.h"
+#include "types/internal/internal.h"
+#include "utils/logger.h"
+#include "utils/process_mutex.h"
+#include "utils/utils.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <limits>
+
+namespace elink
+{
+    std::atomic<bool> TelemetryStore::enabled_{false};
+
+    namespace
+    {
+        // Bounds the per-series scratch a single query allocates
+        constexpr int64_t MAX_QUERY_BUCKETS = 100000;
+        // Room for the raw first sample and a few compressed ones
+        constexpr size_t MIN_BLOCK_BYTES = 64;
+        constexpr size_t MIN_SEGMENT_BYTES = 1024 * 1024;
+        constexpr const char *SEGMENT_INDEX_EXTENSION = ".idx";
+        // Series that stop receiving samples are only trimmed by the sweep
+        constexpr int64_t SWEEP_INTERVAL_MS = 60 * 1000;
+
+        const nlohmann::json *objectAt(const nlohmann::json &object, const char *key)
+        {
+            auto it = object.find(key);
+            return it != object.end() && it->is_object() ? &*it : nullptr;
+        }
+
+        bool numberAt(const nlohmann::json *object, const char *key, double &value)
+        {
+            if (!object)
+            {
+                return false;
+            }
+            auto it = object->find(key);
+            if (it == object->end() || !it->is_number())
+            {
+                return false;
+            }
+            value = it->get<double>();
+            return true;
+        }
+
+        struct BucketAggregate
+        {
+            double min = std::numeric_limits<double>::infinity();
+            double max = -std::numeric_limits<double>::infinity();
+            double sum = 0.0;
+            uint32_t count = 0;
+
+            void add(double value)
+            {
+                min = std::min(min, value);
+                max = std::max(max, value);
+                sum += value;
+                ++count;
+            }
+
+            void merge(const TelemetryBlock &block)
+            {
+                min = std::min(min, block.min);
+                max = std::max(max, block.max);
+                sum += block.sum;
+                count += block.count;
+            }
+        };
+    } // namespace
+
+    TelemetryStore &TelemetryStore::getInstance()
+    {
+        static TelemetryStore instance;
+        return instance;
+    }
+
+    TelemetryStore::~TelemetryStore()
+    {
+        stop();
+    }
+
+    bool TelemetryStore::start(const ElegooTelemetryConfig &config, std::string &error)
+    {
+        std::lock_guard<std::mutex> lock(lifecycleMutex_);
+        if (enabled_)
+        {
+            error = "Telemetry history is already recording";
+            return false;
+        }
+        {
+            std::unique_lock<std::shared_mutex> historiesLock(historiesMutex_);
+            histories_.clear();
+            retentionMs_ = static_cast<int64_t>(std::max(config.telemetryRetentionMinutes, 1)) * 60 * 1000;
+            blockBytes_ = std::max(config.telemetryBlockBytes, MIN_BLOCK_BYTES);
+            lastSweepMs_ = TimeUtils::getCurrentTimestamp();
+        }
+        if (!config.telemetryPath.empty() && !openSegments(config, error))
+        {
+            closeSegments();
+            std::unique_lock<std::shared_mutex> historiesLock(historiesMutex_);
+            histories_.clear();
+            return false;
+        }
+        enabled_ = true;
+        ELEGOO_LOG_INFO("Telemetry history started, retention {} minutes, {} byte blocks{}",
+                        retentionMs_ / 60000, blockBytes_, segmentPath_.empty() ? "" : ", persisted to " + segmentPath_);
+        return true;
+    }
+
+    void TelemetryStore::stop()
+    {
+        std::lock_guard<std::mutex> lock(lifecycleMutex_);
+        if (!enabled_)
+        {
+            return;
+        }
+        enabled_ = false;
+
+        std::vector<std::pair<std::string, std::shared_ptr<PrinterHistory>>> histories;
+        {
+            std::shared_lock<std::shared_mutex> historiesLock(historiesMutex_);
+            histories.assign(histories_.begin(), histories_.end());
+        }
+        // Open blocks are sealed so that a restart finds every sample recorded so far
+        bool persisted;
+        {
+            std::lock_guard<std::mutex> segmentLock(segmentMutex_);
+            persisted = !segmentPath_.empty();
+        }
+        if (persisted)
+        {
+            for (const auto &[printerId, history] : histories)
+            {
+                std::lock_guard<std::mutex> historyLock(history->mutex);
+                for (size_t i = 0; i < TELEMETRY_METRIC_COUNT; ++i)
+                {
+                    if (history->series[i] && history->series[i]->open.count() > 0)
+                    {
+                        seal(printerId, static_cast<TelemetryMetric>(i), *history->series[i]);
+                    }
+                }
+            }
+        }
+
+        ELEGOO_LOG_INFO("Telemetry history stopped, {} bytes released", getMemoryUsage());
+        closeSegments();
+        std::unique_lock<std::shared_mutex> historiesLock(historiesMutex_);
+        histories_.clear();
+    }
+
+    void TelemetryStore::record(const BizEvent &event)
+    {
+        if (event.method != MethodType::ON_PRINTER_STATUS || !event.data.is_object())
+        {
+            return;
+        }
+        auto printerIdIt = event.data.find("printerId");
+        if (printerIdIt == event.data.end() || !printerIdIt->is_string())
+        {
+            return;
+        }
+        int64_t now = TimeUtils::getCurrentTimestamp();
+        sweep(now);
+
+        // The status sent on disconnect carries defaults, not readings
+        const auto *printerStatus = objectAt(event.data, "printerStatus");
+        double state = 0;
+        if (numberAt(printerStatus, "state", state) && static_cast<int>(state) == static_cast<int>(PrinterState::OFFLINE))
+        {
+            return;
+        }
+
+        const auto *temperatures = objectAt(event.data, "temperatureStatus");
+        const auto *fans = objectAt(event.data, "fanStatus");
+        const nlohmann::json *extruder = temperatures ? objectAt(*temperatures, ComponentKey(ComponentKey::EXTRUDER).name().c_str()) : nullptr;
+        const nlohmann::json *heatedBed = temperatures ? objectAt(*temperatures, ComponentKey(ComponentKey::HEATED_BED).name().c_str()) : nullptr;
+        const nlohmann::json *chamber = temperatures ? objectAt(*temperatures, ComponentKey(ComponentKey::CHAMBER).name().c_str()) : nullptr;
+        const nlohmann::json *modelFan = fans ? objectAt(*fans, ComponentKey(ComponentKey::FAN_MODEL).name().c_str()) : nullptr;
+        const nlohmann::json *auxFan = fans ? objectAt(*fans, ComponentKey(ComponentKey::FAN_AUX).name().c_str()) : nullptr;
+        const nlohmann::json *chassisFan = fans ? objectAt(*fans, ComponentKey(ComponentKey::FAN_CHASSIS).name().c_str()) : nullptr;
+
+        std::array<std::pair<bool, double>, TELEMETRY_METRIC_COUNT> samples{};
+        auto sample = [&samples](TelemetryMetric metric, const nlohmann::json *object, const char *key)
+        {
+            auto &entry = samples[static_cast<size_t>(metric)];
+            entry.first = numberAt(object, key, entry.second);
+        };
+        sample(TelemetryMetric::EXTRUDER_TEMPERATURE, extruder, "current");
+        sample(TelemetryMetric::EXTRUDER_TARGET, extruder, "target");
+        sample(TelemetryMetric::HEATED_BED_TEMPERATURE, heatedBed, "current");
+        sample(TelemetryMetric::HEATED_BED_TARGET, heatedBed, "target");
+        sample(TelemetryMetric::CHAMBER_TEMPERATURE, chamber, "current");
+        sample(TelemetryMetric::MODEL_FAN_SPEED, modelFan, "speed");
+        sample(TelemetryMetric::AUX_FAN_SPEED, auxFan, "speed");
+        sample(TelemetryMetric::CHASSIS_FAN_SPEED, chassisFan, "speed");
+        sample(TelemetryMetric::PRINT_PROGRESS, objectAt(event.data, "printStatus"), "progress");
+
+        auto [history, lock] = lockHistory(printerIdIt->get_ref<const std::string &>());
+        for (size_t i = 0; i < TELEMETRY_METRIC_COUNT; ++i)
+        {
+            if (!samples[i].first)
+            {
+                continue;
+            }
+            auto &series = history->series[i];
+            if (!series)
+            {
+                series = std::make_unique<Series>(blockBytes_);
+            }
+            append(printerIdIt->get_ref<const std::string &>(), static_cast<TelemetryMetric>(i), *series, now, samples[i].second);
+        }
+    }
+
+    void TelemetryStore::record(const std::string &printerId, TelemetryMetric metric, int64_t timestampMs, double value)
+    {
+        sweep(TimeUtils::getCurrentTimestamp());
+        auto [history, lock] = lockHistory(printerId);
+        auto &series = history->series[static_cast<size_t>(metric)];
+        if (!series)
+        {
+            series = std::make_unique<Series>(blockBytes_);
+        }
+        append(printerId, metric, *series, timestampMs, value);
+    }
+
+    std::pair<std::shared_ptr<TelemetryStore::PrinterHistory>, std::unique_lock<std::mutex>>
+    TelemetryStore::lockHistory(const std::string &printerId)
+    {
+        while (true)
+        {
+            auto history = getOrCreateHistory(printerId);
+            std::unique_lock<std::mutex> lock(history->mutex);
+            if (!history->removed)
+            {
+                return {std::move(history), std::move(lock)};
+            }
+        }
+    }
+
+    std::shared_ptr<TelemetryStore::PrinterHistory> TelemetryStore::getOrCreateHistory(const std::string &printerId)
+    {
+        {
+            std::shared_lock<std::shared_mutex> lock(historiesMutex_);
+            auto it = histories_.find(printerId);
+            if (it != histories_.end())
+            {
+                return it->second;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(historiesMutex_);
+        auto &history = histories_[printerId];
+        if (!history)
+        {
+            history = std::make_shared<PrinterHistory>();
+        }
+        return history;
+    }
+
+    void TelemetryStore::append(const std::string &printerId, TelemetryMetric metric, Series &series, int64_t timestampMs, double value)
+    {
+        // Samples keep their order if the wall clock steps back
+        if (series.open.count() > 0)
+        {
+            timestampMs = std::max(timestampMs, series.openEndMs);
+        }
+        else if (!series.sealed.empty())
+        {
+            timestampMs = std::max(timestampMs, series.sealed.back()->endMs);
+        }
+
+        if (!series.open.append(timestampMs, value))
+        {
+            seal(printerId, metric, series);
+            while (!series.sealed.empty() && series.sealed.front()->endMs < timestampMs - retentionMs_)
+            {
+                series.sealed.pop_front();
+            }
+            series.open.append(timestampMs, value);
+        }
+
+        if (series.open.count() == 1)
+        {
+            series.openStartMs = timestampMs;
+            series.openMin = value;
+            series.openMax = value;
+            series.openSum = value;
+        }
+        else
+        {
+            series.openMin = std::min(series.openMin, value);
+            series.openMax = std::max(series.openMax, value);
+            series.openSum += value;
+        }
+        series.openEndMs = timestampMs;
+    }
+
+    void TelemetryStore::seal(const std::string &printerId, TelemetryMetric metric, Series &series)
+    {
+        auto block = std::make_shared<TelemetryBlock>();
+        block->startMs = series.openStartMs;
+        block->endMs = series.openEndMs;
+        block->count = series.open.count();
+        block->min = series.openMin;
+        block->max = series.openMax;
+        block->sum = series.openSum;
+        block->bitCount = series.open.bitCount();
+        block->bytes = series.open.release();
+        persist(printerId, metric, *block);
+        series.sealed.push_back(std::move(block));
+    }
+
+    void TelemetryStore::sweep(int64_t nowMs)
+    {
+        int64_t lastSweepMs = lastSweepMs_.load(std::memory_order_relaxed);
+        if (nowMs - lastSweepMs < SWEEP_INTERVAL_MS ||
+            !lastSweepMs_.compare_exchange_strong(lastSweepMs, nowMs, std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        std::vector<std::pair<std::string, std::shared_ptr<PrinterHistory>>> histories;
+        int64_t cutoffMs;
+        {
+            std::shared_lock<std::shared_mutex> lock(historiesMutex_);
+            histories.assign(histories_.begin(), histories_.end());
+            cutoffMs = nowMs - retentionMs_;
+        }
+
+        std::vector<std::string> emptied;
+        for (const auto &[printerId, history] : histories)
+        {
+            std::lock_guard<std::mutex> lock(history->mutex);
+            bool empty = true;
+            for (auto &series : history->series)
+            {
+                if (!series)
+                {
+                    continue;
+                }
+                while (!series->sealed.empty() && series->sealed.front()->endMs < cutoffMs)
+                {
+                    series->sealed.pop_front();
+                }
+                if (series->open.count() > 0 && series->openEndMs < cutoffMs)
+                {
+                    series->open.release();
+                }
+                if (series->sealed.empty() && series->open.count() == 0)
+                {
+                    series.reset();
+                }
+                else
+                {
+                    empty = false;
+                }
+            }
+            if (empty)
+            {
+                emptied.push_back(printerId);
+            }
+        }
+        if (emptied.empty())
+        {
+            return;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(historiesMutex_);
+        for (const auto &printerId : emptied)
+        {
+            auto it = histories_.find(printerId);
+            if (it == histories_.end())
+            {
+                continue;
+            }
+            // A sample may have arrived since the history was trimmed
+            std::lock_guard<std::mutex> historyLock(it->second->mutex);
+            if (std::all_of(it->second->series.begin(), it->second->series.end(),
+                            [](const auto &series)
+                            { return !series; }))
+            {
+                it->second->removed = true;
+                histories_.erase(it);
+            }
+        }
+    }
+
+    TelemetryQueryResult TelemetryStore::query(const TelemetryQueryParams &params) const
+    {
+        int64_t startMs = params.startMs;
+        int64_t endMs = params.endMs > 0 ? params.endMs : TimeUtils::getCurrentTimestamp() + 1;
+        if (params.bucketMs <= 0 || endMs <= startMs)
+        {
+            return TelemetryQueryResult::Error(ELINK_ERROR_CODE::INVALID_PARAMETER, "Invalid telemetry time range or bucket width");
+        }
+        int64_t bucketCount = (endMs - startMs - 1) / params.bucketMs + 1;
+        if (bucketCount > MAX_QUERY_BUCKETS)
+        {
+            return TelemetryQueryResult::Error(ELINK_ERROR_CODE::INVALID_PARAMETER,
+                                               "Too many telemetry buckets, use a wider bucket or a shorter range");
+        }
+
+        std::vector<TelemetryMetric> metrics = params.metrics;
+        if (metrics.empty())
+        {
+            for (size_t i = 0; i < TELEMETRY_METRIC_COUNT; ++i)
+            {
+                metrics.push_back(static_cast<TelemetryMetric>(i));
+            }
+        }
+
+        std::vector<std::pair<std::string, std::shared_ptr<PrinterHistory>>> histories;
+        // Samples before the retention window may not be swept yet; bucket bounds keep following startMs
+        int64_t visibleStartMs;
+        {
+            std::shared_lock<std::shared_mutex> lock(historiesMutex_);
+            visibleStartMs = std::max<int64_t>(startMs, TimeUtils::getCurrentTimestamp() - retentionMs_);
+            if (params.printerIds.empty())
+            {
+                histories.assign(histories_.begin(), histories_.end());
+                std::sort(histories.begin(), histories.end(),
+                          [](const auto &a, const auto &b)
+                          { return a.first < b.first; });
+            }
+            else
+            {
+                for (const auto &printerId : params.printerIds)
+                {
+                    auto it = histories_.find(printerId);
+                    if (it != histories_.end())
+                    {
+                        histories.emplace_back(*it);
+                    }
+                }
+            }
+        }
+
+        TelemetryQueryData data;
+        std::vector<std::shared_ptr<const TelemetryBlock>> blocks;
+        std::vector<BucketAggregate> buckets(static_cast<size_t>(bucketCount));
+        for (const auto &[printerId, history] : histories)
+        {
+            for (TelemetryMetric metric : metrics)
+            {
+                auto index = static_cast<size_t>(metric);
+                if (index >= TELEMETRY_METRIC_COUNT)
+                {
+                    continue;
+                }
+
+                // Collect the overlapping blocks under the lock, decode them after it
+                blocks.clear();
+                {
+                    std::lock_guard<std::mutex> lock(history->mutex);
+                    const auto &series = history->series[index];
+                    if (!series)
+                    {
+                        continue;
+                    }
+                    // Block times increase along a series, so the range starts at a binary search
+                    auto first = std::partition_point(series->sealed.begin(), series->sealed.end(),
+                                                      [visibleStartMs](const auto &block)
+                                                      { return block->endMs < visibleStartMs; });
+                    for (auto it = first; it != series->sealed.end() && (*it)->startMs < endMs; ++it)
+                    {
+                        blocks.push_back(*it);
+                    }
+                    if (series->open.count() > 0 && series->openEndMs >= visibleStartMs && series->openStartMs < endMs)
+                    {
+                        auto open = std::make_shared<TelemetryBlock>();
+                        open->startMs = series->openStartMs;
+                        open->endMs = series->openEndMs;
+                        open->count = series->open.count();
+                        open->min = series->openMin;
+                        open->max = series->openMax;
+                        open->sum = series->openSum;
+                        open->bitCount = series->open.bitCount();
+                        open->bytes.assign(series->open.bytes().begin(),
+                                           series->open.bytes().begin() + (open->bitCount + 7) / 8);
+                        blocks.push_back(std::move(open));
+                    }
+                }
+                if (blocks.empty())
+                {
+                    continue;
+                }
+
+                std::fill(buckets.begin(), buckets.end(), BucketAggregate());
+                for (const auto &block : blocks)
+                {
+                    if (block->startMs >= visibleStartMs && block->endMs < endMs &&
+                        (block->startMs - startMs) / params.bucketMs == (block->endMs - startMs) / params.bucketMs)
+                    {
+                        buckets[static_cast<size_t>((block->startMs - startMs) / params.bucketMs)].merge(*block);
+                        continue;
+                    }
+                    GorillaDecoder decoder(block->data(), block->bitCount, block->count);
+                    int64_t timestampMs;
+                    double value;
+                    // Samples are ordered, so the bucket only needs a division when a sample leaves it
+                    size_t bucketIndex = 0;
+                    int64_t bucketEndMs = startMs;
+                    while (decoder.next(timestampMs, value))
+                    {
+                        if (timestampMs >= endMs)
+                        {
+                            break;
+                        }
+                        if (timestampMs < visibleStartMs)
+                        {
+                            continue;
+                        }
+                        if (timestampMs >= bucketEndMs)
+                        {
+                            bucketIndex = static_cast<size_t>((timestampMs - startMs) / params.bucketMs);
+                            bucketEndMs = startMs + static_cast<int64_t>(bucketIndex + 1) * params.bucketMs;
+                        }
+                        buckets[bucketIndex].add(value);
+                    }
+                }
+
+                TelemetrySeries result;
+                result.printerId = printerId;
+                result.metric = metric;
+                for (size_t i = 0; i < buckets.size(); ++i)
+                {
+                    const auto &bucket = buckets[i];
+                    if (bucket.count == 0)
+                    {
+                        continue;
+                    }
+                    TelemetryBucket out;
+                    out.startMs = startMs + static_cast<int64_t>(i) * params.bucketMs;
+                    out.min = bucket.min;
+                    out.max = bucket.max;
+                    out.avg = bucket.sum / bucket.count;
+                    out.count = bucket.count;
+                    result.buckets.push_back(out);
+                }
+                if (!result.buckets.empty())
+                {
+                    data.series.push_back(std::move(result));
+                }
+            }
+        }
+        return TelemetryQueryResult::Ok(std::move(data));
+    }
+
+    size_t TelemetryStore::getMemoryUsage() const
+    {
+        std::vector<std::shared_ptr<PrinterHistory>> histories;
+        {
+            std::shared_lock<std::shared_mutex> lock(historiesMutex_);
+            for (const auto &[printerId, history] : histories_)
+            {
+                histories.push_back(history);
+            }
+        }
+
+        size_t bytes = 0;
+        for (const auto &history : histories)
+        {
+            std::lock_guard<std::mutex> lock(history->mutex);
+            for (const auto &series : history->series)
+            {
+                if (!series)
+                {
+                    continue;
+                }
+                bytes += series->open.bytes().capacity();
+                for (const auto &block : series->sealed)
+                {
+                    bytes += sizeof(TelemetryBlock) + block->bytes.capacity();
+                }
+            }
+        }
+        return bytes;
+    }
+
+    // ========== Segment files ==========
+
+    bool TelemetryStore::openSegments(const ElegooTelemetryConfig &config, std::string &error)
+    {
+#ifdef _WIN32
+        (void)config;
+        error = "Telemetry segment files are not supported on Windows";
+        return false;
+#else
+        std::error_code ec;
+        std::filesystem::path directory = std::filesystem::u8path(config.telemetryPath);
+        std::filesystem::create_directories(directory, ec);
+        if (ec)
+        {
+            error = "Failed to create telemetry directory " + config.telemetryPath + ": " + ec.message();
+            return false;
+        }
+
+        // A second process appending to the same directory would delete the other's segments
+        std::string absolute = std::filesystem::absolute(directory, ec).u8string();
+        auto lock = std::make_unique<ProcessMutex>("telemetry_" + CryptoUtils::calculateMD5(absolute));
+        if (!lock->tryLock())
+        {
+            error = "Another process is recording telemetry to " + config.telemetryPath;
+            return false;
+        }
+
+        std::vector<std::string> indexPaths;
+        for (std::filesystem::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec))
+        {
+            const auto &path = it->path();
+            if (path.extension() == SEGMENT_INDEX_EXTENSION && path.filename().u8string().rfind("telemetry-", 0) == 0)
+            {
+                indexPaths.push_back(path.u8string());
+            }
+        }
+        // Names sort by day, then by part
+        std::sort(indexPaths.begin(), indexPaths.end());
+
+        int64_t cutoffMs = TimeUtils::getCurrentTimestamp() - retentionMs_;
+        std::vector<std::shared_ptr<TelemetrySegment>> segments;
+        size_t blocks = 0;
+        for (const auto &path : indexPaths)
+        {
+            std::string segmentError;
+            auto segment = TelemetrySegment::open(path, segmentError);
+            if (!segment)
+            {
+                ELEGOO_LOG_WARN("Skipping telemetry segment: {}", segmentError);
+                continue;
+            }
+            if (!segmentError.empty())
+            {
+                ELEGOO_LOG_WARN("Telemetry segment recovered, {}", segmentError);
+            }
+            if (segment->lastEndMs() < cutoffMs)
+            {
+                segment->remove();
+                continue;
+            }
+            blocks += segment->entryCount() - segment->seek(cutoffMs);
+            loadSegment(segment, cutoffMs);
+            segments.push_back(std::move(segment));
+        }
+
+        std::lock_guard<std::mutex> segmentLock(segmentMutex_);
+        segmentPath_ = config.telemetryPath;
+        segmentBytes_ = std::max(config.telemetrySegmentBytes, MIN_SEGMENT_BYTES);
+        segmentLock_ = std::move(lock);
+        segments_ = std::move(segments);
+        ELEGOO_LOG_INFO("Telemetry history loaded {} blocks from {} segments", blocks, segments_.size());
+        return true;
+#endif
+    }
+
+    void TelemetryStore::loadSegment(const std::shared_ptr<TelemetrySegment> &segment, int64_t cutoffMs)
+    {
+        struct LoadedSeries
+        {
+            std::shared_ptr<PrinterHistory> history;
+            size_t metric = 0;
+        };
+        std::unordered_map<uint64_t, LoadedSeries> seriesByOffset;
+
+        for (size_t i = segment->seek(cutoffMs); i < segment->entryCount(); ++i)
+        {
+            const auto &entry = segment->entry(i);
+            if (entry.endMs < cutoffMs)
+            {
+                continue;
+            }
+            auto it = seriesByOffset.find(entry.seriesOffset);
+            if (it == seriesByOffset.end())
+            {
+                LoadedSeries loaded;
+                std::string printerId;
+                TelemetryMetric metric;
+                if (segment->readSeries(entry.seriesOffset, printerId, metric))
+                {
+                    loaded.history = getOrCreateHistory(printerId);
+                    loaded.metric = static_cast<size_t>(metric);
+                }
+                it = seriesByOffset.emplace(entry.seriesOffset, std::move(loaded)).first;
+            }
+            if (!it->second.history)
+            {
+                continue;
+            }
+
+            auto block = std::make_shared<TelemetryBlock>();
+            block->startMs = entry.startMs;
+            block->endMs = entry.endMs;
+            block->count = entry.count;
+            block->min = entry.min;
+            block->max = entry.max;
+            block->sum = entry.sum;
+            block->bitCount = entry.bitCount;
+            block->mapped = segment->blockData(entry);
+            block->segment = segment;
+
+            std::lock_guard<std::mutex> lock(it->second.history->mutex);
+            auto &series = it->second.history->series[it->second.metric];
+            if (!series)
+            {
+                series = std::make_unique<Series>(blockBytes_);
+            }
+            series->sealed.push_back(std::move(block));
+        }
+    }
+
+    void TelemetryStore::persist(const std::string &printerId, TelemetryMetric metric, TelemetryBlock &block)
+    {
+        std::lock_guard<std::mutex> lock(segmentMutex_);
+        if (segmentPath_.empty() || printerId.size() > TELEMETRY_SERIES_MAX_PRINTER_ID_SIZE)
+        {
+            return;
+        }
+        int64_t dayStartMs = telemetrySegmentDay(block.endMs);
+        if ((!writer_ || dayStartMs > writer_->dayStartMs()) && !rotateSegment(dayStartMs))
+        {
+            return;
+        }
+
+        const uint8_t *stored = writer_->appendBlock(printerId, metric, block);
+        if (!stored && rotateSegment(writer_->dayStartMs()))
+        {
+            // The part was full
+            stored = writer_->appendBlock(printerId, metric, block);
+        }
+        if (!stored)
+        {
+            if (writer_)
+            {
+                ELEGOO_LOG_ERROR("Failed to write telemetry segment {}, history is kept in memory only", writer_->getName());
+                writer_->finish();
+                writer_.reset();
+            }
+            segmentPath_.clear();
+            return;
+        }
+        block.mapped = stored;
+        block.segment = writer_;
+        block.bytes.clear();
+        block.bytes.shrink_to_fit();
+    }
+
+    bool TelemetryStore::rotateSegment(int64_t dayStartMs)
+    {
+        if (writer_)
+        {
+            writer_->finish();
+        }
+        std::string error;
+        writer_ = TelemetrySegment::create(segmentPath_, dayStartMs, segmentBytes_, error);
+        if (!writer_)
+        {
+            ELEGOO_LOG_ERROR("Failed to create telemetry segment, history is kept in memory only: {}", error);
+            segmentPath_.clear();
+            return false;
+        }
+
+        // Segments whose every block has left the retention window are deleted as days roll over
+        int64_t cutoffMs = dayStartMs - retentionMs_;
+        segments_.erase(std::remove_if(segments_.begin(), segments_.end(),
+                                       [cutoffMs](const std::shared_ptr<TelemetrySegment> &segment)
+                                       {
+                                           if (segment->lastEndMs() >= cutoffMs)
+                                           {
+                                               return false;
+                                           }
+                                           segment->remove();
+                                           return true;
+                                       }),
+                        segments_.end());
+        segments_.push_back(writer_);
+        return true;
+    }
+
+    void TelemetryStore::closeSegments()
+    {
+        std::lock_guard<std::mutex> lock(segmentMutex_);
+        if (writer_)
+        {
+            writer_->finish();
+            writer_.reset();
+        }
+        segments_.clear();
+        segmentPath_.clear();
+        segmentLock_.reset();
+    }
+
+} // namespace elink
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "config.h"
+#include "type.h"
+#include "telemetry/gorilla_codec.h"
+
+namespace elink
+{
+    struct BizEvent;
+    class ProcessMutex;
+    class TelemetrySegment;
+
+    constexpr size_t TELEMETRY_METRIC_COUNT = static_cast<size_t>(TelemetryMetric::PRINT_PROGRESS) + 1;
+
+    /**
+     * A sealed block of one series, immutable once shared with queries
+     */
+    struct TelemetryBlock
+    {
+        int64_t startMs = 0; // First sample
+        int64_t endMs = 0;   // Last sample
+        uint32_t count = 0;
+        double min = 0.0;
+        double max = 0.0;
+        double sum = 0.0;
+        size_t bitCount = 0;
+        std::vector<uint8_t> bytes;                      // GorillaEncoder output, empty once persisted
+        const uint8_t *mapped = nullptr;                 // The bytes in a segment file
+        std::shared_ptr<const TelemetrySegment> segment; // Keeps the mapped bytes mapped
+
+        const uint8_t *data() const { return mapped ? mapped : bytes.data(); }
+    };
+
+    /**
+     * In-memory history of the status values dashboards chart, per printer
+     *
+     * Every status event adds one sample to each metric the status carries. A series appends
+     * to an open Gorilla block until it is full; the block is then sealed with its min, max and
+     * sum. History older than the retention window is dropped by a periodic sweep on the
+     * record path, which also forgets printers left without samples, and queries never return
+     * samples older than the window. Queries reduce the
+     * samples of a time range to min/max/avg buckets. A sealed block that lies inside a single
+     * bucket contributes its stored aggregates without being decoded, so queries over long
+     * ranges with wide buckets touch only the blocks at bucket boundaries.
+     *
+     * Sealed blocks are shared with queries through shared_ptr, so a query holds a printer's
+     * lock only to collect them and to copy the open block.
+     *
+     * With a telemetry path, sealed blocks are also appended to day segment files (see
+     * TelemetrySegment) and read back from the file mapping instead of the heap. Start maps the
+     * segments of the retention window and indexes their blocks without decoding them, so the
+     * history of earlier runs can be queried at once; stop seals the open blocks to keep them.
+     */
+    class TelemetryStore
+    {
+    public:
+        static TelemetryStore &getInstance();
+
+        /**
+         * Start recording, clearing any previous history and loading persisted history
+         * @return false if already recording or the telemetry path cannot be used
+         */
+        bool start(const ElegooTelemetryConfig &config, std::string &error);
+
+        /**
+         * Stop recording and release the history
+         */
+        void stop();
+
+        static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+        /**
+         * Record the samples of a status event; other events are ignored
+         */
+        void record(const BizEvent &event);
+
+        /**
+         * Record one sample
+         */
+        void record(const std::string &printerId, TelemetryMetric metric, int64_t timestampMs, double value);
+
+        /**
+         * Downsample the history
+         */
+        TelemetryQueryResult query(const TelemetryQueryParams &params) const;
+
+        /**
+         * Heap bytes held by compressed blocks, sealed and open; mapped blocks are not counted
+         */
+        size_t getMemoryUsage() const;
+
+    private:
+        TelemetryStore() = default;
+        ~TelemetryStore();
+        TelemetryStore(const TelemetryStore &) = delete;
+        TelemetryStore &operator=(const TelemetryStore &) = delete;
+
+        struct Series
+        {
+            explicit Series(size_t blockBytes) : open(blockBytes) {}
+
+            std::deque<std::shared_ptr<const TelemetryBlock>> sealed;
+            GorillaEncoder open;
+            int64_t openStartMs = 0;
+            int64_t openEndMs = 0;
+            double openMin = 0.0;
+            double openMax = 0.0;
+            double openSum = 0.0;
+        };
+
+        struct PrinterHistory
+        {
+            mutable std::mutex mutex;
+            std::array<std::unique_ptr<Series>, TELEMETRY_METRIC_COUNT> series;
+            bool removed = false; // Erased by a sweep; writers look the printer up again
+        };
+
+        /**
+         * The printer's history, locked and still in histories_
+         */
+        std::pair<std::shared_ptr<PrinterHistory>, std::unique_lock<std::mutex>> lockHistory(const std::string &printerId);
+        std::shared_ptr<PrinterHistory> getOrCreateHistory(const std::string &printerId);
+        void append(const std::string &printerId, TelemetryMetric metric, Series &series, int64_t timestampMs, double value);
+        void seal(const std::string &printerId, TelemetryMetric metric, Series &series);
+
+        /**
+         * Drop history older than the retention window, including that of printers that stopped
+         * reporting, at most once per sweep interval
+         */
+        void sweep(int64_t nowMs);
+
+        // ========== Segment files ==========
+
+        bool openSegments(const ElegooTelemetryConfig &config, std::string &error);
+        void loadSegment(const std::shared_ptr<TelemetrySegment> &segment, int64_t cutoffMs);
+        void persist(const std::string &printerId, TelemetryMetric metric, TelemetryBlock &block);
+        bool rotateSegment(int64_t dayStartMs);
+        void closeSegments();
+
+        static std::atomic<bool> enabled_;
+
+        std::mutex lifecycleMutex_;
+        mutable std::shared_mutex historiesMutex_;
+        std::unordered_map<std::string, std::shared_ptr<PrinterHistory>> histories_;
+        int64_t retentionMs_ = 0;
+        size_t blockBytes_ = 0;
+        std::atomic<int64_t> lastSweepMs_{0};
+
+        // Lock order: a printer's mutex, then segmentMutex_
+        std::mutex segmentMutex_;
+        std::string segmentPath_; // Empty when history is not persisted
+        size_t segmentBytes_ = 0;
+        std::unique_ptr<ProcessMutex> segmentLock_;
+        std::shared_ptr<TelemetrySegment> writer_;
+        std::vector<std::shared_ptr<TelemetrySegment>> segments_; // Segments with history in the retention window
+    };
+
+} // namespace elink
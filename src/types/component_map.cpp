@@ -0,0 +1,103 @@
+#include "types/component_map.h"
+#include "utils/logger.h"
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace elink
+{
+    namespace
+    {
+        // Function-local so keys built during static initialization of other files find it ready
+        const std::string &standardName(uint16_t id)
+        {
+            static const std::string names[ComponentKey::STANDARD_COUNT] = {
+                "extruder", "heatedBed", "chamber",
+                "model", "heatsink", "controller", "chassis", "aux",
+                "main",
+                "local", "udisk", "sdcard"};
+            return names[id];
+        }
+
+        // Names come from printer messages; past this many, new names are refused
+        constexpr size_t MAX_INTERNED_NAMES = 1024;
+
+        /**
+         * Names of non-standard components, indexed by id - STANDARD_COUNT
+         * A deque keeps references returned by name() stable while it grows.
+         */
+        struct InternTable
+        {
+            std::shared_mutex mutex;
+            std::deque<std::string> names;
+            std::unordered_map<std::string_view, uint16_t> ids;
+        };
+
+        InternTable &internTable()
+        {
+            static InternTable *table = new InternTable(); // never destroyed, keys outlive statics
+            return *table;
+        }
+    } // namespace
+
+    uint16_t ComponentKey::intern(std::string_view name)
+    {
+        for (uint16_t id = 0; id < STANDARD_COUNT; ++id)
+        {
+            if (standardName(id) == name)
+            {
+                return id;
+            }
+        }
+
+        auto &table = internTable();
+        {
+            std::shared_lock<std::shared_mutex> lock(table.mutex);
+            auto it = table.ids.find(name);
+            if (it != table.ids.end())
+            {
+                return it->second;
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock(table.mutex);
+        auto it = table.ids.find(name);
+        if (it != table.ids.end())
+        {
+            return it->second;
+        }
+        if (table.names.size() >= MAX_INTERNED_NAMES)
+        {
+            static std::atomic<bool> reported{false};
+            if (!reported.exchange(true))
+            {
+                ELEGOO_LOG_ERROR("Component name table is full ({} names), ignoring new component names such as {}",
+                                 MAX_INTERNED_NAMES, std::string(name));
+            }
+            return INVALID_ID;
+        }
+        uint16_t id = static_cast<uint16_t>(STANDARD_COUNT + table.names.size());
+        table.names.emplace_back(name);
+        table.ids.emplace(table.names.back(), id);
+        return id;
+    }
+
+    const std::string &ComponentKey::name() const
+    {
+        if (id_ < STANDARD_COUNT)
+        {
+            return standardName(id_);
+        }
+        if (id_ == INVALID_ID)
+        {
+            static const std::string empty;
+            return empty;
+        }
+        auto &table = internTable();
+        std::shared_lock<std::shared_mutex> lock(table.mutex);
+        return table.names[id_ - STANDARD_COUNT];
+    }
+
+} // namespace elink
@@ -0,0 +1,171 @@
+#include "utils/clock.h"
+#include <algorithm>
+#include <thread>
+
+namespace elink
+{
+    // ========== SystemClock ==========
+
+    IClock::time_point SystemClock::now() const
+    {
+        return std::chrono::steady_clock::now();
+    }
+
+    void SystemClock::sleepUntil(time_point deadline)
+    {
+        std::this_thread::sleep_until(deadline);
+    }
+
+    bool SystemClock::waitUntil(std::unique_lock<std::mutex> &lock, std::condition_variable &cv,
+                                time_point deadline, const std::function<bool()> &pred)
+    {
+        return cv.wait_until(lock, deadline, pred);
+    }
+
+    bool SystemClock::waitReadyUntil(const std::function<bool(duration)> &ready, time_point deadline)
+    {
+        auto remaining = deadline - now();
+        return ready(remaining > duration::zero() ? remaining : duration::zero());
+    }
+
+    // ========== VirtualClock ==========
+
+    VirtualClock::VirtualClock(time_point start)
+        : now_(start.time_since_epoch().count())
+    {
+    }
+
+    IClock::time_point VirtualClock::now() const
+    {
+        return time_point(duration(now_.load(std::memory_order_acquire)));
+    }
+
+    void VirtualClock::sleepUntil(time_point deadline)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        sleepers_++;
+        sleepCv_.wait(lock, [this, deadline]
+                      { return now() >= deadline; });
+        sleepers_--;
+    }
+
+    bool VirtualClock::waitUntil(std::unique_lock<std::mutex> &lock, std::condition_variable &cv,
+                                 time_point deadline, const std::function<bool()> &pred)
+    {
+        while (!pred())
+        {
+            if (now() >= deadline)
+            {
+                return pred();
+            }
+            addWaiter(&cv);
+            cv.wait_for(lock, REAL_TIME_SLICE);
+            removeWaiter(&cv);
+        }
+        return true;
+    }
+
+    bool VirtualClock::waitReadyUntil(const std::function<bool(duration)> &ready, time_point deadline)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            sleepers_++;
+        }
+        bool result = ready(REAL_TIME_SLICE);
+        while (!result && now() < deadline)
+        {
+            result = ready(REAL_TIME_SLICE);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            sleepers_--;
+        }
+        return result;
+    }
+
+    void VirtualClock::advance(duration delta)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        now_.fetch_add(delta.count(), std::memory_order_acq_rel);
+        // Notified under mutex_: removeWaiter() takes it, so every registered cv is still alive
+        for (auto *cv : waiters_)
+        {
+            cv->notify_all();
+        }
+        sleepCv_.notify_all();
+    }
+
+    void VirtualClock::advanceInSteps(duration total, duration step, std::chrono::milliseconds realPause)
+    {
+        if (step <= duration::zero())
+        {
+            step = total;
+        }
+        for (duration elapsed = duration::zero(); elapsed < total; elapsed += step)
+        {
+            advance(std::min(step, total - elapsed));
+            std::this_thread::sleep_for(realPause);
+        }
+    }
+
+    size_t VirtualClock::getWaiterCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return waiters_.size() + sleepers_;
+    }
+
+    void VirtualClock::addWaiter(std::condition_variable *cv)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        waiters_.insert(cv);
+    }
+
+    void VirtualClock::removeWaiter(std::condition_variable *cv)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = waiters_.find(cv);
+        if (it != waiters_.end())
+        {
+            waiters_.erase(it);
+        }
+    }
+
+    // ========== Clock ==========
+
+    namespace
+    {
+        SystemClock &systemClock()
+        {
+            static SystemClock clock;
+            return clock;
+        }
+
+        std::mutex &installMutex()
+        {
+            static std::mutex mutex;
+            return mutex;
+        }
+
+        std::shared_ptr<IClock> &installedClock()
+        {
+            static std::shared_ptr<IClock> clock;
+            return clock;
+        }
+    } // namespace
+
+    std::atomic<IClock *> Clock::current_{nullptr};
+
+    IClock &Clock::getClock()
+    {
+        IClock *clock = current_.load(std::memory_order_acquire);
+        return clock ? *clock : systemClock();
+    }
+
+    void Clock::setClock(std::shared_ptr<IClock> clock)
+    {
+        std::lock_guard<std::mutex> lock(installMutex());
+        current_.store(clock.get(), std::memory_order_release);
+        installedClock() = std::move(clock);
+    }
+
+} // namespace elink
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <set>
+#include "elegoo_export.h"
+
+namespace elink
+{
+    /**
+     * Time source and timed waits used by the SDK's timers
+     *
+     * Request timeouts, reconnect delays, status polling, heartbeats, adapter cleanup and the
+     * cloud monitors read time and wait through this interface, so tests can substitute
+     * VirtualClock and drive hours of timer behavior in seconds. Time points share
+     * std::chrono::steady_clock's type so existing members keep their declarations.
+     */
+    class ELEGOO_LINK_API IClock
+    {
+    public:
+        using time_point = std::chrono::steady_clock::time_point;
+        using duration = std::chrono::steady_clock::duration;
+
+        virtual ~IClock() = default;
+
+        virtual time_point now() const = 0;
+
+        /**
+         * Block the calling thread until deadline
+         */
+        virtual void sleepUntil(time_point deadline) = 0;
+
+        /**
+         * Wait on a condition variable until pred() holds or deadline passes
+         * @param lock Lock on the mutex guarding pred, held on entry and on return
+         * @return pred() at return
+         */
+        virtual bool waitUntil(std::unique_lock<std::mutex> &lock, std::condition_variable &cv,
+                               time_point deadline, const std::function<bool()> &pred) = 0;
+
+        /**
+         * Wait until a shared state becomes ready or deadline passes
+         * @param ready Polls the state for a given real-time slice, returns true once ready
+         * @return true if ready
+         */
+        virtual bool waitReadyUntil(const std::function<bool(duration)> &ready, time_point deadline) = 0;
+    };
+
+    /**
+     * std::chrono::steady_clock and the standard library waits
+     */
+    class ELEGOO_LINK_API SystemClock : public IClock
+    {
+    public:
+        time_point now() const override;
+        void sleepUntil(time_point deadline) override;
+        bool waitUntil(std::unique_lock<std::mutex> &lock, std::condition_variable &cv,
+                       time_point deadline, const std::function<bool()> &pred) override;
+        bool waitReadyUntil(const std::function<bool(duration)> &ready, time_point deadline) override;
+    };
+
+    /**
+     * Manually advanced clock for time-compressed tests
+     *
+     * Time only moves through advance(). Sleepers and timed waits blocked on this clock
+     * re-check their deadlines whenever time advances; condition variable notifications from
+     * SDK code still wake waiters immediately. A notification racing with advance() can be
+     * missed, so waiters also re-check every REAL_TIME_SLICE of real time.
+     */
+    class ELEGOO_LINK_API VirtualClock : public IClock
+    {
+    public:
+        static constexpr std::chrono::milliseconds REAL_TIME_SLICE{10};
+
+        /**
+         * @param start Initial time, defaults to the current steady_clock time so that
+         *              time points taken before the clock was installed stay comparable
+         */
+        explicit VirtualClock(time_point start = std::chrono::steady_clock::now());
+
+        time_point now() const override;
+        void sleepUntil(time_point deadline) override;
+        bool waitUntil(std::unique_lock<std::mutex> &lock, std::condition_variable &cv,
+                       time_point deadline, const std::function<bool()> &pred) override;
+        bool waitReadyUntil(const std::function<bool(duration)> &ready, time_point deadline) override;
+
+        /**
+         * Move time forward and wake every thread blocked on this clock
+         */
+        void advance(duration delta);
+
+        /**
+         * Advance in steps, pausing realPause of real time after each so woken threads can
+         * run (and schedule their next wait) before time moves on
+         */
+        void advanceInSteps(duration total, duration step,
+                            std::chrono::milliseconds realPause = std::chrono::milliseconds(1));
+
+        /**
+         * Number of threads currently blocked on this clock
+         * Tests can wait for the expected count before advancing to make runs deterministic.
+         */
+        size_t getWaiterCount() const;
+
+    private:
+        void addWaiter(std::condition_variable *cv);
+        void removeWaiter(std::condition_variable *cv);
+
+        mutable std::mutex mutex_;
+        std::condition_variable sleepCv_;
+        std::multiset<std::condition_variable *> waiters_;
+        size_t sleepers_ = 0;
+        std::atomic<time_point::rep> now_;
+    };
+
+    /**
+     * Process-wide clock used by the SDK
+     */
+    class ELEGOO_LINK_API Clock
+    {
+    public:
+        using time_point = IClock::time_point;
+        using duration = IClock::duration;
+
+        /**
+         * Replace the clock; nullptr restores SystemClock
+         * Install before ElegooLink::initialize() and keep it until cleanup() has returned:
+         * threads read the clock without synchronization beyond the pointer swap.
+         */
+        static void setClock(std::shared_ptr<IClock> clock);
+
+        static IClock &getClock();
+
+        static time_point now() { return getClock().now(); }
+
+        template <typename Rep, typename Period>
+        static void sleepFor(const std::chrono::duration<Rep, Period> &delay)
+        {
+            auto &clock = getClock();
+            clock.sleepUntil(clock.now() + std::chrono::duration_cast<duration>(delay));
+        }
+
+        template <typename Rep, typename Period, typename Predicate>
+        static bool waitFor(std::unique_lock<std::mutex> &lock, std::condition_variable &cv,
+                            const std::chrono::duration<Rep, Period> &timeout, Predicate pred)
+        {
+            auto &clock = getClock();
+            return clock.waitUntil(lock, cv, clock.now() + std::chrono::duration_cast<duration>(timeout),
+                                   std::function<bool()>(std::move(pred)));
+        }
+
+        /**
+         * Wait for a future
+         * @return std::future_status::ready or std::future_status::timeout
+         */
+        template <typename T, typename Rep, typename Period>
+        static std::future_status waitFor(std::future<T> &future, const std::chrono::duration<Rep, Period> &timeout)
+        {
+            auto &clock = getClock();
+            bool ready = clock.waitReadyUntil([&future](duration slice)
+                                              { return future.wait_for(slice) == std::future_status::ready; },
+                                              clock.now() + std::chrono::duration_cast<duration>(timeout));
+            return ready ? std::future_status::ready : std::future_status::timeout;
+        }
+
+    private:
+        static std::atomic<IClock *> current_;
+    };
+
+} // namespace elink
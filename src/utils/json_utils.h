@@ -174,5 +174,59 @@ namespace elink
             }
             return default_value;
         }
+
+        /**
+         * Approximate heap and node memory held by a JSON value
+         * Counts node sizes, string capacities and container overhead; allocator headers are not included
+         */
+        static size_t estimateMemoryUsage(const nlohmann::json &j)
+        {
+            size_t total = sizeof(nlohmann::json);
+            switch (j.type())
+            {
+            case nlohmann::json::value_t::object:
+            {
+                const auto &object = j.get_ref<const nlohmann::json::object_t &>();
+                total += sizeof(nlohmann::json::object_t);
+                for (const auto &item : object)
+                {
+                    // std::map node: three links and a color word around the key/value pair
+                    total += 4 * sizeof(void *) + sizeof(std::string) + stringHeapSize(item.first);
+                    total += estimateMemoryUsage(item.second);
+                }
+                break;
+            }
+            case nlohmann::json::value_t::array:
+            {
+                const auto &array = j.get_ref<const nlohmann::json::array_t &>();
+                total += sizeof(nlohmann::json::array_t);
+                total += (array.capacity() - array.size()) * sizeof(nlohmann::json);
+                for (const auto &item : array)
+                {
+                    total += estimateMemoryUsage(item);
+                }
+                break;
+            }
+            case nlohmann::json::value_t::string:
+            {
+                const auto &str = j.get_ref<const std::string &>();
+                total += sizeof(std::string) + stringHeapSize(str);
+                break;
+            }
+            case nlohmann::json::value_t::binary:
+                total += sizeof(nlohmann::json::binary_t) + j.get_binary().capacity();
+                break;
+            default:
+                break;
+            }
+            return total;
+        }
+
+    private:
+        static size_t stringHeapSize(const std::string &str)
+        {
+            // Short strings live in the inline buffer
+            return str.capacity() > 15 ? str.capacity() + 1 : 0;
+        }
     };
 }
@@ -0,0 +1,201 @@
+#include "tracer.h"
+#include "utils/logger.h"
+#include "utils/utils.h"
+#include <nlohmann/json.hpp>
+#include <fstream>
+#include <functional>
+
+namespace elink
+{
+    std::atomic<bool> Tracer::enabled_{false};
+
+    namespace
+    {
+        // Per-thread buffer of the current trace session
+        thread_local std::shared_ptr<void> t_threadBuffer;
+
+        void writeEscaped(std::ostream &out, const char *text)
+        {
+            out << nlohmann::json(text ? text : "").dump();
+        }
+    } // namespace
+
+    Tracer &Tracer::getInstance()
+    {
+        static Tracer instance;
+        return instance;
+    }
+
+    bool Tracer::start(const std::string &fileName, size_t maxEvents)
+    {
+        if (fileName.empty())
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (enabled_)
+        {
+            ELEGOO_LOG_WARN("Tracing is already running, writing to {}", fileName_);
+            return false;
+        }
+        fileName_ = fileName;
+        maxEvents_ = maxEvents;
+        eventCount_ = 0;
+        droppedEvents_ = 0;
+        buffers_.clear();
+        generation_++;
+        startTime_ = std::chrono::steady_clock::now();
+        enabled_ = true;
+        ELEGOO_LOG_INFO("Tracing started, trace file: {}", fileName_);
+        return true;
+    }
+
+    bool Tracer::stop()
+    {
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+        std::string fileName;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!enabled_)
+            {
+                return false;
+            }
+            enabled_ = false;
+            buffers.swap(buffers_);
+            fileName = fileName_;
+        }
+
+        auto out = PathUtils::openOutputStream(fileName, std::ios::out | std::ios::trunc);
+        if (!out.is_open())
+        {
+            ELEGOO_LOG_ERROR("Failed to open trace file {}", fileName);
+            return false;
+        }
+
+        // Chrome trace event format, see "Trace Event Format" (catapult)
+        out << "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":" << droppedEvents_.load()
+            << "},\"traceEvents\":[\n";
+        out << "{\"ph\":\"M\",\"pid\":1,\"tid\":0,\"name\":\"process_name\",\"args\":{\"name\":\"elegoolink\"}}";
+
+        size_t written = 0;
+        for (const auto &buffer : buffers)
+        {
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+            out << ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+                << ",\"name\":\"thread_name\",\"args\":{\"name\":\"thread " << buffer->threadId << "\"}}";
+            for (const auto &event : buffer->events)
+            {
+                out << ",\n{\"ph\":\"" << event.phase << "\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"cat\":";
+                writeEscaped(out, event.category);
+                out << ",\"name\":";
+                writeEscaped(out, event.name);
+                out << ",\"ts\":" << event.timestampUs;
+                switch (event.phase)
+                {
+                case 'X':
+                    out << ",\"dur\":" << event.durationUs;
+                    break;
+                case 'i':
+                    out << ",\"s\":\"t\"";
+                    break;
+                case 's':
+                    out << ",\"id\":\"" << std::hex << event.id << std::dec << "\"";
+                    break;
+                case 'f':
+                    // Bind to the enclosing slice so the arrow ends at the correlating span
+                    out << ",\"id\":\"" << std::hex << event.id << std::dec << "\",\"bp\":\"e\"";
+                    break;
+                default:
+                    break;
+                }
+                if (!event.args.empty())
+                {
+                    out << ",\"args\":" << event.args;
+                }
+                out << "}";
+                written++;
+            }
+            buffer->events.clear();
+        }
+        out << "\n]}\n";
+
+        ELEGOO_LOG_INFO("Tracing stopped, {} events written to {} ({} dropped)",
+                        written, fileName, droppedEvents_.load());
+        return out.good();
+    }
+
+    int64_t Tracer::nowUs() const
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now() - startTime_)
+            .count();
+    }
+
+    Tracer::ThreadBuffer *Tracer::threadBuffer()
+    {
+        auto buffer = std::static_pointer_cast<ThreadBuffer>(t_threadBuffer);
+        uint64_t generation = generation_.load();
+        if (buffer && buffer->generation == generation)
+        {
+            return buffer.get();
+        }
+
+        // First event of this thread in the current session
+        buffer = std::make_shared<ThreadBuffer>();
+        buffer->threadId = nextThreadId_++;
+        buffer->generation = generation;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!enabled_)
+            {
+                return nullptr;
+            }
+            buffers_.push_back(buffer);
+        }
+        t_threadBuffer = buffer;
+        return buffer.get();
+    }
+
+    void Tracer::append(Event event)
+    {
+        if (eventCount_.fetch_add(1, std::memory_order_relaxed) >= maxEvents_)
+        {
+            droppedEvents_++;
+            return;
+        }
+        ThreadBuffer *buffer = threadBuffer();
+        if (!buffer)
+        {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        buffer->events.push_back(std::move(event));
+    }
+
+    void Tracer::addComplete(const char *category, const char *name, int64_t startUs, int64_t durationUs, std::string args)
+    {
+        append({'X', category, name, startUs, durationUs, 0, std::move(args)});
+    }
+
+    void Tracer::addInstant(const char *category, const char *name, std::string args)
+    {
+        append({'i', category, name, nowUs(), 0, 0, std::move(args)});
+    }
+
+    void Tracer::addFlow(const char *category, const char *name, bool begin, const std::string &key)
+    {
+        append({begin ? 's' : 'f', category, name, nowUs(), 0, std::hash<std::string>{}(key), std::string()});
+    }
+
+    std::string Tracer::formatArgs(Args args)
+    {
+        nlohmann::json object = nlohmann::json::object();
+        for (const auto &arg : args)
+        {
+            object[arg.first] = arg.second;
+        }
+        return object.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+    }
+
+} // namespace elink
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "elegoo_export.h"
+
+namespace elink
+{
+    /**
+     * Span tracer exporting Chrome trace event JSON (chrome://tracing, ui.perfetto.dev)
+     *
+     * Spans are recorded into per-thread buffers while tracing is on and written
+     * to the trace file by stop(). When tracing is off every ELEGOO_TRACE_* macro
+     * costs a single relaxed atomic load; argument expressions are not evaluated.
+     * Define ELINK_DISABLE_TRACING to compile the macros out entirely.
+     */
+    class ELEGOO_LINK_API Tracer
+    {
+    public:
+        using Args = std::initializer_list<std::pair<const char *, std::string>>;
+
+        static Tracer &getInstance();
+
+        /**
+         * Start recording spans
+         * @param fileName Trace file written by stop()
+         * @param maxEvents Events beyond this count are dropped (and counted)
+         * @return false if tracing is already running or fileName is empty
+         */
+        bool start(const std::string &fileName, size_t maxEvents = 1000000);
+
+        /**
+         * Stop recording and write the trace file
+         * @return false if tracing was not running or the file could not be written
+         */
+        bool stop();
+
+        /**
+         * Whether spans are being recorded
+         */
+        static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+        /**
+         * Microseconds since the trace was started
+         */
+        int64_t nowUs() const;
+
+        /**
+         * Record a complete span ("X" event)
+         */
+        void addComplete(const char *category, const char *name, int64_t startUs, int64_t durationUs, std::string args);
+
+        /**
+         * Record an instant event ("i" event)
+         */
+        void addInstant(const char *category, const char *name, std::string args);
+
+        /**
+         * Record a flow step linking spans across threads ("s" / "f" events)
+         * @param begin true for the flow start, false for the flow end
+         * @param key Correlation key, e.g. the request ID
+         */
+        void addFlow(const char *category, const char *name, bool begin, const std::string &key);
+
+        /**
+         * Format span arguments as a JSON object
+         */
+        static std::string formatArgs(Args args);
+
+    private:
+        struct Event
+        {
+            char phase;
+            const char *category;
+            const char *name;
+            int64_t timestampUs;
+            int64_t durationUs;
+            uint64_t id;
+            std::string args;
+        };
+
+        struct ThreadBuffer
+        {
+            uint32_t threadId = 0;
+            uint64_t generation = 0;
+            std::mutex mutex;
+            std::vector<Event> events;
+        };
+
+        Tracer() = default;
+        Tracer(const Tracer &) = delete;
+        Tracer &operator=(const Tracer &) = delete;
+
+        ThreadBuffer *threadBuffer();
+        void append(Event event);
+
+        static std::atomic<bool> enabled_;
+
+        std::mutex mutex_;
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+        std::string fileName_;
+        size_t maxEvents_ = 0;
+        std::atomic<size_t> eventCount_{0};
+        std::atomic<uint64_t> droppedEvents_{0};
+        std::atomic<uint64_t> generation_{0};
+        std::atomic<uint32_t> nextThreadId_{1};
+        std::chrono::steady_clock::time_point startTime_;
+    };
+
+    /**
+     * RAII span; records a complete event on destruction if tracing was on at construction
+     */
+    class TraceScope
+    {
+    public:
+        TraceScope(const char *category, const char *name)
+            : category_(category), name_(name), active_(Tracer::isEnabled())
+        {
+            if (active_)
+            {
+                startUs_ = Tracer::getInstance().nowUs();
+            }
+        }
+
+        TraceScope(const char *category, const char *name, std::string args)
+            : TraceScope(category, name)
+        {
+            args_ = std::move(args);
+        }
+
+        ~TraceScope()
+        {
+            if (active_ && Tracer::isEnabled())
+            {
+                auto &tracer = Tracer::getInstance();
+                tracer.addComplete(category_, name_, startUs_, tracer.nowUs() - startUs_, std::move(args_));
+            }
+        }
+
+        TraceScope(const TraceScope &) = delete;
+        TraceScope &operator=(const TraceScope &) = delete;
+
+    private:
+        const char *category_;
+        const char *name_;
+        bool active_;
+        int64_t startUs_ = 0;
+        std::string args_;
+    };
+
+} // namespace elink
+
+/**
+ * Trace macros; category and name must be string literals
+ */
+#ifndef ELINK_DISABLE_TRACING
+#define ELEGOO_TRACE_CONCAT_INNER(a, b) a##b
+#define ELEGOO_TRACE_CONCAT(a, b) ELEGOO_TRACE_CONCAT_INNER(a, b)
+#define ELEGOO_TRACE_SCOPE(category, name) \
+    elink::TraceScope ELEGOO_TRACE_CONCAT(elinkTraceScope_, __LINE__)(category, name)
+#define ELEGOO_TRACE_SCOPE_ARGS(category, name, ...)                              \
+    elink::TraceScope ELEGOO_TRACE_CONCAT(elinkTraceScope_, __LINE__)(            \
+        category, name,                                                            \
+        elink::Tracer::isEnabled() ? elink::Tracer::formatArgs(__VA_ARGS__) : std::string())
+#define ELEGOO_TRACE_INSTANT(category, name, ...)                                                           \
+    do                                                                                                      \
+    {                                                                                                       \
+        if (elink::Tracer::isEnabled())                                                                     \
+            elink::Tracer::getInstance().addInstant(category, name, elink::Tracer::formatArgs(__VA_ARGS__)); \
+    } while (0)
+#define ELEGOO_TRACE_FLOW_BEGIN(category, name, key)                        \
+    do                                                                      \
+    {                                                                       \
+        if (elink::Tracer::isEnabled())                                     \
+            elink::Tracer::getInstance().addFlow(category, name, true, key); \
+    } while (0)
+#define ELEGOO_TRACE_FLOW_END(category, name, key)                           \
+    do                                                                       \
+    {                                                                        \
+        if (elink::Tracer::isEnabled())                                      \
+            elink::Tracer::getInstance().addFlow(category, name, false, key); \
+    } while (0)
+#else
+#define ELEGOO_TRACE_SCOPE(category, name) ((void)0)
+#define ELEGOO_TRACE_SCOPE_ARGS(category, name, ...) ((void)0)
+#define ELEGOO_TRACE_INSTANT(category, name, ...) ((void)0)
+#define ELEGOO_TRACE_FLOW_BEGIN(category, name, key) ((void)0)
+#define ELEGOO_TRACE_FLOW_END(category, name, key) ((void)0)
+#endif
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "type.h"
+#include <cstddef>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace elink
+{
+    namespace bench
+    {
+        /**
+         * A printer the benchmark connects to
+         */
+        struct BenchPrinter
+        {
+            PrinterType type = PrinterType::UNKNOWN;
+            std::string host;
+            std::string accessCode;
+            std::string serialNumber;
+            std::string name;
+        };
+
+        /**
+         * Benchmark configuration, filled from the command line
+         */
+        struct BenchOptions
+        {
+            std::vector<BenchPrinter> printers;
+            bool discoverPrinters = false;     // Connect to every printer found by discovery
+            std::string defaultAccessCode;     // Access code for discovered CC2 printers
+            int connectConcurrency = 16;       // Parallel connectPrinter calls
+
+            // Workloads run concurrently for durationSec: status, commands, upload, discovery
+            std::set<std::string> workloads = {"status"};
+            int durationSec = 30;
+            int warmupSec = 2;
+
+            // status: expected push rate per printer, used to estimate dropped events (0 disables)
+            double expectedStatusRate = 0.0;
+
+            // commands: concurrent callers issuing the command mix round-robin over printers
+            int commandConcurrency = 8;
+            int commandIntervalMs = 0;
+            std::vector<std::string> commands = {"status", "attributes"};
+            int commandTimeoutMs = 3000;
+
+            // upload: concurrent uploads of a generated file
+            int uploadConcurrency = 4;
+            size_t uploadSizeBytes = 8 * 1024 * 1024;
+
+            // discovery: sweeps repeated every interval
+            int discoveryIntervalSec = 5;
+            int discoveryTimeoutMs = 3000;
+
+            int sampleIntervalMs = 1000;
+            std::string outputPath;
+            int logLevel = 3; // WARN
+        };
+    } // namespace bench
+} // namespace elink
@@ -0,0 +1,75 @@
+#include "latency_recorder.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace elink
+{
+    namespace bench
+    {
+        namespace
+        {
+            double percentile(const std::vector<double> &sorted, double p)
+            {
+                if (sorted.empty())
+                {
+                    return 0.0;
+                }
+                // Nearest-rank percentile
+                size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * static_cast<double>(sorted.size())));
+                return sorted[std::min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+            }
+
+            double round3(double value)
+            {
+                return std::round(value * 1000.0) / 1000.0;
+            }
+        } // namespace
+
+        void LatencyRecorder::record(Clock::duration latency)
+        {
+            recordMs(std::chrono::duration<double, std::milli>(latency).count());
+        }
+
+        void LatencyRecorder::recordMs(double latencyMs)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            samplesMs_.push_back(latencyMs);
+        }
+
+        void LatencyRecorder::reset()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            samplesMs_.clear();
+            errors_ = 0;
+        }
+
+        size_t LatencyRecorder::count() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return samplesMs_.size();
+        }
+
+        nlohmann::json LatencyRecorder::summary() const
+        {
+            std::vector<double> sorted;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                sorted = samplesMs_;
+            }
+            std::sort(sorted.begin(), sorted.end());
+
+            double mean = sorted.empty() ? 0.0 : std::accumulate(sorted.begin(), sorted.end(), 0.0) / static_cast<double>(sorted.size());
+            return {
+                {"count", sorted.size()},
+                {"errors", errors_.load()},
+                {"mean_ms", round3(mean)},
+                {"min_ms", round3(sorted.empty() ? 0.0 : sorted.front())},
+                {"p50_ms", round3(percentile(sorted, 50.0))},
+                {"p90_ms", round3(percentile(sorted, 90.0))},
+                {"p99_ms", round3(percentile(sorted, 99.0))},
+                {"p999_ms", round3(percentile(sorted, 99.9))},
+                {"max_ms", round3(sorted.empty() ? 0.0 : sorted.back())}};
+        }
+    } // namespace bench
+} // namespace elink
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace elink
+{
+    namespace bench
+    {
+        /**
+         * Thread-safe collection of latency samples with percentile reporting
+         *
+         * Samples are kept in full so percentiles are exact; a benchmark run
+         * produces at most a few million samples.
+         */
+        class LatencyRecorder
+        {
+        public:
+            using Clock = std::chrono::steady_clock;
+
+            void record(Clock::duration latency);
+            void recordMs(double latencyMs);
+            void recordError() { errors_++; }
+            void reset();
+
+            size_t count() const;
+            uint64_t errors() const { return errors_.load(); }
+
+            /**
+             * Summary in milliseconds: count, errors, mean, min, p50, p90, p99, p999, max
+             */
+            nlohmann::json summary() const;
+
+        private:
+            mutable std::mutex mutex_;
+            std::vector<double> samplesMs_;
+            std::atomic<uint64_t> errors_{0};
+        };
+
+        /**
+         * Measures the time from construction to stop() or destruction
+         */
+        class ScopedLatency
+        {
+        public:
+            explicit ScopedLatency(LatencyRecorder &recorder) : recorder_(recorder), start_(LatencyRecorder::Clock::now()) {}
+            ~ScopedLatency() { stop(); }
+
+            void stop()
+            {
+                if (!stopped_)
+                {
+                    recorder_.record(LatencyRecorder::Clock::now() - start_);
+                    stopped_ = true;
+                }
+            }
+
+            void fail()
+            {
+                if (!stopped_)
+                {
+                    recorder_.recordError();
+                    stopped_ = true;
+                }
+            }
+
+            /**
+             * Discard the measurement, e.g. for an operation cancelled by shutdown
+             */
+            void dismiss() { stopped_ = true; }
+
+        private:
+            LatencyRecorder &recorder_;
+            LatencyRecorder::Clock::time_point start_;
+            bool stopped_ = false;
+        };
+    } // namespace bench
+} // namespace elink
@@ -0,0 +1,553 @@
+#include "bench_options.h"
+#include "latency_recorder.h"
+#include "process_sampler.h"
+#include "workloads.h"
+#include "elegoo_link.h"
+#include "types/internal/json_serializer.h"
+#include "utils/utils.h"
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace elink;
+using namespace elink::bench;
+
+namespace
+{
+    std::atomic<bool> g_running{true};
+
+    void onSignal(int)
+    {
+        g_running = false;
+    }
+
+    void printUsage(const char *program)
+    {
+        std::cout
+            << "Usage: " << program << " [options]\n"
+            << "\n"
+            << "Printers:\n"
+            << "  --manifest <file>            Printer list written by elegoo_printer_simulator --manifest\n"
+            << "  --printer <proto>,<host>[,<access code>]\n"
+            << "                               Add a printer; proto is cc1, cc2 or moonraker (repeatable)\n"
+            << "  --discover                   Connect to every printer found by UDP discovery\n"
+            << "  --access-code <code>         Access code for discovered CC2 printers\n"
+            << "  --connect-concurrency <n>    Parallel connections during setup (default 16)\n"
+            << "\n"
+            << "Workloads:\n"
+            << "  --workload <list>            Comma separated: status, commands, upload, discovery (default status)\n"
+            << "  --duration <s>               Measurement window (default 30)\n"
+            << "  --warmup <s>                 Load applied before measuring (default 2)\n"
+            << "  --expected-status-rate <hz>  Status pushes per printer, enables dropped event accounting\n"
+            << "  --commands <list>            Command mix: status, status-cached, attributes, refresh, pause-resume (default status,attributes)\n"
+            << "  --command-concurrency <n>    Concurrent command callers (default 8)\n"
+            << "  --command-interval <ms>      Pause between commands per caller (default 0)\n"
+            << "  --command-timeout <ms>       Timeout for request/response commands (default 3000)\n"
+            << "  --upload-concurrency <n>     Concurrent uploads (default 4)\n"
+            << "  --upload-size <bytes>        Upload file size, accepts K/M/G suffix (default 8M)\n"
+            << "  --discovery-interval <s>     Pause between discovery sweeps (default 5)\n"
+            << "  --discovery-timeout <ms>     Discovery sweep timeout (default 3000)\n"
+            << "\n"
+            << "Output:\n"
+            << "  --output <file>              Write the JSON report to a file\n"
+            << "  --sample-interval <ms>       CPU / RSS / thread sampling interval (default 1000)\n"
+            << "  --log-level <0-6>            SDK log level (default 3, WARN)\n"
+            << "  -h, --help                   Show this help\n";
+    }
+
+    std::vector<std::string> splitList(const std::string &value)
+    {
+        std::vector<std::string> items;
+        std::stringstream stream(value);
+        std::string item;
+        while (std::getline(stream, item, ','))
+        {
+            if (!item.empty())
+            {
+                items.push_back(item);
+            }
+        }
+        return items;
+    }
+
+    size_t parseSize(const std::string &value)
+    {
+        size_t pos = 0;
+        double number = std::stod(value, &pos);
+        size_t multiplier = 1;
+        if (pos < value.size())
+        {
+            switch (std::toupper(static_cast<unsigned char>(value[pos])))
+            {
+            case 'K':
+                multiplier = 1024;
+                break;
+            case 'M':
+                multiplier = 1024 * 1024;
+                break;
+            case 'G':
+                multiplier = 1024 * 1024 * 1024;
+                break;
+            default:
+                throw std::invalid_argument("invalid size " + value);
+            }
+        }
+        return static_cast<size_t>(number * static_cast<double>(multiplier));
+    }
+
+    PrinterType parseProtocol(const std::string &protocol)
+    {
+        std::string lower = StringUtils::toLowerCase(protocol);
+        if (lower == "cc1" || lower == "cc")
+            return PrinterType::ELEGOO_FDM_CC;
+        if (lower == "cc2")
+            return PrinterType::ELEGOO_FDM_CC2;
+        if (lower == "moonraker" || lower == "klipper")
+            return PrinterType::GENERIC_FDM_KLIPPER;
+        throw std::invalid_argument("unknown printer protocol " + protocol);
+    }
+
+    std::string defaultModel(PrinterType type)
+    {
+        switch (type)
+        {
+        case PrinterType::ELEGOO_FDM_CC:
+            return "Centauri Carbon";
+        case PrinterType::ELEGOO_FDM_CC2:
+            return "Centauri Carbon 2";
+        default:
+            return "Generic Klipper";
+        }
+    }
+
+    void loadManifest(const std::string &path, BenchOptions &options)
+    {
+        std::ifstream file(path);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("cannot open manifest " + path);
+        }
+        auto manifest = nlohmann::json::parse(file);
+        for (const auto &entry : manifest.at("printers"))
+        {
+            BenchPrinter printer;
+            printer.type = parseProtocol(entry.at("protocol").get<std::string>());
+            printer.host = entry.at("host").get<std::string>();
+            printer.accessCode = entry.value("accessCode", "");
+            printer.serialNumber = entry.value("serialNumber", "");
+            printer.name = entry.value("name", "");
+            options.printers.push_back(std::move(printer));
+        }
+    }
+
+    bool parseArguments(int argc, char *argv[], BenchOptions &options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string
+            {
+                if (i + 1 >= argc)
+                {
+                    throw std::invalid_argument("missing value for " + arg);
+                }
+                return argv[++i];
+            };
+
+            if (arg == "-h" || arg == "--help")
+            {
+                printUsage(argv[0]);
+                std::exit(0);
+            }
+            else if (arg == "--manifest")
+                loadManifest(value(), options);
+            else if (arg == "--printer")
+            {
+                auto parts = splitList(value());
+                if (parts.size() < 2)
+                {
+                    throw std::invalid_argument("--printer expects <proto>,<host>[,<access code>]");
+                }
+                BenchPrinter printer;
+                printer.type = parseProtocol(parts[0]);
+                printer.host = parts[1];
+                printer.accessCode = parts.size() > 2 ? parts[2] : "";
+                options.printers.push_back(std::move(printer));
+            }
+            else if (arg == "--discover")
+                options.discoverPrinters = true;
+            else if (arg == "--access-code")
+                options.defaultAccessCode = value();
+            else if (arg == "--connect-concurrency")
+                options.connectConcurrency = std::stoi(value());
+            else if (arg == "--workload")
+                options.workloads = [&]
+                {
+                    auto list = splitList(value());
+                    return std::set<std::string>(list.begin(), list.end());
+                }();
+            else if (arg == "--duration")
+                options.durationSec = std::stoi(value());
+            else if (arg == "--warmup")
+                options.warmupSec = std::stoi(value());
+            else if (arg == "--expected-status-rate")
+                options.expectedStatusRate = std::stod(value());
+            else if (arg == "--commands")
+                options.commands = splitList(value());
+            else if (arg == "--command-concurrency")
+                options.commandConcurrency = std::stoi(value());
+            else if (arg == "--command-interval")
+                options.commandIntervalMs = std::stoi(value());
+            else if (arg == "--command-timeout")
+                options.commandTimeoutMs = std::stoi(value());
+            else if (arg == "--upload-concurrency")
+                options.uploadConcurrency = std::stoi(value());
+            else if (arg == "--upload-size")
+                options.uploadSizeBytes = parseSize(value());
+            else if (arg == "--discovery-interval")
+                options.discoveryIntervalSec = std::stoi(value());
+            else if (arg == "--discovery-timeout")
+                options.discoveryTimeoutMs = std::stoi(value());
+            else if (arg == "--sample-interval")
+                options.sampleIntervalMs = std::stoi(value());
+            else if (arg == "--output")
+                options.outputPath = value();
+            else if (arg == "--log-level")
+                options.logLevel = std::stoi(value());
+            else
+            {
+                std::cerr << "Unknown option: " << arg << "\n";
+                return false;
+            }
+        }
+
+        for (const auto &workload : options.workloads)
+        {
+            if (workload != "status" && workload != "commands" && workload != "upload" && workload != "discovery")
+            {
+                std::cerr << "Unknown workload: " << workload << "\n";
+                return false;
+            }
+        }
+        for (const auto &command : options.commands)
+        {
+            if (!CommandBurstWorkload::isValidCommand(command))
+            {
+                std::cerr << "Unknown command: " << command << "\n";
+                return false;
+            }
+        }
+        if (options.printers.empty() && !options.discoverPrinters)
+        {
+            std::cerr << "No printers given, use --manifest, --printer or --discover\n";
+            return false;
+        }
+        if (options.durationSec <= 0)
+        {
+            std::cerr << "--duration must be greater than 0\n";
+            return false;
+        }
+        return true;
+    }
+
+    void addDiscoveredPrinters(ElegooLink &link, BenchOptions &options)
+    {
+        PrinterDiscoveryParams params;
+        params.timeoutMs = options.discoveryTimeoutMs;
+        auto result = link.startPrinterDiscovery(params);
+        if (!result.isSuccess() || !result.data.has_value())
+        {
+            std::cerr << "Discovery failed: " << result.message << "\n";
+            return;
+        }
+        for (const auto &info : result.data->printers)
+        {
+            BenchPrinter printer;
+            printer.type = info.printerType;
+            printer.host = info.host;
+            printer.serialNumber = info.serialNumber;
+            printer.name = info.name;
+            printer.accessCode = options.defaultAccessCode;
+            options.printers.push_back(std::move(printer));
+        }
+    }
+
+    /**
+     * Connect every printer with a bounded number of parallel connectPrinter calls
+     */
+    std::vector<ConnectedPrinter> connectPrinters(ElegooLink &link, const BenchOptions &options, LatencyRecorder &connectLatency)
+    {
+        std::vector<ConnectedPrinter> connected;
+        std::mutex connectedMutex;
+        std::atomic<size_t> next{0};
+
+        auto worker = [&]()
+        {
+            for (size_t index = next++; index < options.printers.size() && g_running; index = next++)
+            {
+                const auto &printer = options.printers[index];
+                ConnectPrinterParams params;
+                params.printerType = printer.type;
+                params.host = printer.host;
+                params.serialNumber = printer.serialNumber;
+                params.name = printer.name.empty() ? "bench-" + std::to_string(index) : printer.name;
+                params.model = defaultModel(printer.type);
+                params.brand = printer.type == PrinterType::GENERIC_FDM_KLIPPER ? "Generic" : "Elegoo";
+                if (!printer.accessCode.empty())
+                {
+                    params.authMode = "accessCode";
+                    params.accessCode = printer.accessCode;
+                }
+
+                ScopedLatency latency(connectLatency);
+                auto result = link.connectPrinter(params);
+                if (!result.isSuccess() || !result.data.has_value() || !result.data->isConnected)
+                {
+                    latency.fail();
+                    std::cerr << "Failed to connect " << printer.host << ": " << result.message << "\n";
+                    continue;
+                }
+                latency.stop();
+
+                std::lock_guard<std::mutex> lock(connectedMutex);
+                connected.push_back({result.data->printerInfo.printerId, printer});
+            }
+        };
+
+        std::vector<std::thread> threads;
+        int threadCount = std::max(1, std::min<int>(options.connectConcurrency, static_cast<int>(options.printers.size())));
+        for (int i = 0; i < threadCount; ++i)
+        {
+            threads.emplace_back(worker);
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+        return connected;
+    }
+
+    std::string isoTimestamp()
+    {
+        std::time_t now = std::time(nullptr);
+        std::tm tm{};
+#ifdef _WIN32
+        gmtime_s(&tm, &now);
+#else
+        gmtime_r(&now, &tm);
+#endif
+        std::ostringstream stream;
+        stream << std::put_time(&tm, "%Y-%m-%dT%H:%M:%SZ");
+        return stream.str();
+    }
+
+    void printLatency(const std::string &label, const nlohmann::json &summary)
+    {
+        std::cout << "  " << std::left << std::setw(22) << label << std::right
+                  << " n=" << summary["count"].get<uint64_t>()
+                  << " err=" << summary["errors"].get<uint64_t>()
+                  << std::fixed << std::setprecision(2)
+                  << " p50=" << summary["p50_ms"].get<double>()
+                  << " p90=" << summary["p90_ms"].get<double>()
+                  << " p99=" << summary["p99_ms"].get<double>()
+                  << " max=" << summary["max_ms"].get<double>() << " ms\n";
+    }
+
+    /**
+     * Human readable summary; latency objects print as one line, other values as key=value
+     */
+    void printReport(const nlohmann::json &report)
+    {
+        const auto &process = report["process"];
+        std::cout << "\n=== elink-bench: " << report["connected_printers"] << "/" << report["printers"]
+                  << " printers, " << report["duration_sec"] << " s ===\n";
+        printLatency("connect", report["connect"]);
+        std::cout << std::fixed << std::setprecision(1)
+                  << "  cpu avg=" << process["cpu_percent_avg"].get<double>() << "% max=" << process["cpu_percent_max"].get<double>() << "%"
+                  << "  rss max=" << process["rss_bytes_max"].get<uint64_t>() / (1024.0 * 1024.0) << " MB"
+                  << "  threads max=" << process["threads_max"] << "\n";
+        const auto &eventPool = report["event_pool"];
+        std::cout << "  event pool hit rate=" << eventPool["hit_rate"].get<double>() * 100.0 << "%"
+                  << " pooled=" << eventPool["pooled"] << "/" << eventPool["capacity"] << "\n";
+
+        for (const auto &workload : report["workloads"].items())
+        {
+            std::cout << "[" << workload.key() << "]\n";
+            std::ostringstream scalars;
+            for (const auto &field : workload.value().items())
+            {
+                if (field.value().is_object() && field.value().contains("p50_ms"))
+                {
+                    printLatency(field.key(), field.value());
+                }
+                else
+                {
+                    scalars << " " << field.key() << "=" << field.value().dump();
+                }
+            }
+            if (!scalars.str().empty())
+            {
+                std::cout << " " << scalars.str() << "\n";
+            }
+        }
+    }
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    BenchOptions options;
+    try
+    {
+        if (!parseArguments(argc, argv, options))
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Invalid arguments: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    // Baseline before the SDK spins up its threads
+    ProcessUsage baseline = readProcessUsage();
+
+    auto &link = ElegooLink::getInstance();
+    ElegooLink::Config config;
+    config.log.logLevel = options.logLevel;
+    if (!link.initialize(config))
+    {
+        std::cerr << "Failed to initialize ElegooLink\n";
+        return 1;
+    }
+
+    if (options.discoverPrinters)
+    {
+        addDiscoveredPrinters(link, options);
+    }
+
+    LatencyRecorder connectLatency;
+    auto connectStart = std::chrono::steady_clock::now();
+    auto printers = connectPrinters(link, options, connectLatency);
+    double connectSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - connectStart).count();
+    std::cout << "Connected " << printers.size() << "/" << options.printers.size() << " printers in "
+              << std::fixed << std::setprecision(2) << connectSec << " s" << std::endl;
+    if (printers.empty())
+    {
+        link.cleanup();
+        return 1;
+    }
+    ProcessUsage afterConnect = readProcessUsage();
+
+    std::vector<std::unique_ptr<Workload>> workloads;
+    for (const auto &name : options.workloads)
+    {
+        workloads.push_back(createWorkload(name, link, options, printers));
+    }
+    for (auto &workload : workloads)
+    {
+        workload->start();
+    }
+
+    for (int i = 0; i < options.warmupSec * 10 && g_running; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    // Measurement window
+    ProcessSampler sampler(std::chrono::milliseconds(options.sampleIntervalMs));
+    for (auto &workload : workloads)
+    {
+        workload->resetMeasurements();
+    }
+    sampler.start();
+    auto measureStart = std::chrono::steady_clock::now();
+    auto measureEnd = measureStart + std::chrono::seconds(options.durationSec);
+    while (g_running && std::chrono::steady_clock::now() < measureEnd)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    double elapsedSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - measureStart).count();
+    sampler.stop();
+
+    nlohmann::json workloadReports = nlohmann::json::object();
+    for (auto &workload : workloads)
+    {
+        workload->stop();
+        workloadReports[workload->name()] = workload->report(elapsedSec);
+    }
+
+    // Per-printer accounting, to spot printers responsible for traffic or memory growth
+    nlohmann::json printerResources = nlohmann::json::array();
+    auto resourceStats = link.getAllPrinterResourceStats();
+    if (resourceStats.isSuccess() && resourceStats.data)
+    {
+        printerResources = resourceStats.data->printers;
+    }
+
+    auto poolStats = EventBus::getEventPoolStats();
+    nlohmann::json eventPool = {
+        {"hits", poolStats.hits},
+        {"misses", poolStats.misses},
+        {"hit_rate", poolStats.hitRate()},
+        {"pooled", poolStats.pooled},
+        {"capacity", poolStats.capacity}};
+
+    nlohmann::json report = {
+        {"version", link.getVersion()},
+        {"timestamp", isoTimestamp()},
+        {"hardware_threads", std::thread::hardware_concurrency()},
+        {"printers", options.printers.size()},
+        {"connected_printers", printers.size()},
+        {"duration_sec", std::round(elapsedSec * 100.0) / 100.0},
+        {"connect", connectLatency.summary()},
+        {"connect_total_sec", std::round(connectSec * 100.0) / 100.0},
+        {"baseline", {{"rss_bytes", baseline.rssBytes}, {"threads", baseline.threadCount}}},
+        {"after_connect", {{"rss_bytes", afterConnect.rssBytes}, {"threads", afterConnect.threadCount}}},
+        {"process", sampler.summary()},
+        {"event_pool", eventPool},
+        {"workloads", workloadReports},
+        {"printer_resources", printerResources}};
+
+    printReport(report);
+    if (!options.outputPath.empty())
+    {
+        auto file = PathUtils::openOutputStream(options.outputPath, std::ios::out | std::ios::trunc);
+        if (file.is_open())
+        {
+            file << report.dump(2) << std::endl;
+            std::cout << "Report written to " << options.outputPath << std::endl;
+        }
+        else
+        {
+            std::cerr << "Failed to write report to " << options.outputPath << "\n";
+        }
+    }
+
+    for (const auto &printer : printers)
+    {
+        link.disconnectPrinter(printer.printerId);
+    }
+    link.cleanup();
+    return 0;
+}
@@ -0,0 +1,221 @@
+#include "process_sampler.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#include <tlhelp32.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#include <sys/resource.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace elink
+{
+    namespace bench
+    {
+        ProcessUsage readProcessUsage()
+        {
+            ProcessUsage usage;
+#ifdef _WIN32
+            FILETIME creationTime, exitTime, kernelTime, userTime;
+            if (GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime))
+            {
+                auto toSeconds = [](const FILETIME &ft)
+                {
+                    ULARGE_INTEGER value;
+                    value.LowPart = ft.dwLowDateTime;
+                    value.HighPart = ft.dwHighDateTime;
+                    return static_cast<double>(value.QuadPart) / 1e7; // 100ns units
+                };
+                usage.cpuSeconds = toSeconds(kernelTime) + toSeconds(userTime);
+            }
+
+            PROCESS_MEMORY_COUNTERS counters;
+            if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            {
+                usage.rssBytes = counters.WorkingSetSize;
+            }
+
+            HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+            if (snapshot != INVALID_HANDLE_VALUE)
+            {
+                THREADENTRY32 entry;
+                entry.dwSize = sizeof(entry);
+                DWORD pid = GetCurrentProcessId();
+                if (Thread32First(snapshot, &entry))
+                {
+                    do
+                    {
+                        if (entry.th32OwnerProcessID == pid)
+                        {
+                            usage.threadCount++;
+                        }
+                    } while (Thread32Next(snapshot, &entry));
+                }
+                CloseHandle(snapshot);
+            }
+#elif defined(__APPLE__)
+            rusage ru{};
+            if (getrusage(RUSAGE_SELF, &ru) == 0)
+            {
+                usage.cpuSeconds = ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1e6 +
+                                   ru.ru_stime.tv_sec + ru.ru_stime.tv_usec / 1e6;
+            }
+
+            mach_task_basic_info info;
+            mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+            if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS)
+            {
+                usage.rssBytes = info.resident_size;
+            }
+
+            thread_act_array_t threads;
+            mach_msg_type_number_t threadCount = 0;
+            if (task_threads(mach_task_self(), &threads, &threadCount) == KERN_SUCCESS)
+            {
+                usage.threadCount = static_cast<int>(threadCount);
+                for (mach_msg_type_number_t i = 0; i < threadCount; ++i)
+                {
+                    mach_port_deallocate(mach_task_self(), threads[i]);
+                }
+                vm_deallocate(mach_task_self(), reinterpret_cast<vm_address_t>(threads), threadCount * sizeof(thread_act_t));
+            }
+#else
+            // /proc/self/stat: field 14 utime, 15 stime (clock ticks), 20 num_threads, 24 rss (pages)
+            std::ifstream statFile("/proc/self/stat");
+            std::string content((std::istreambuf_iterator<char>(statFile)), std::istreambuf_iterator<char>());
+            auto commEnd = content.rfind(')');
+            if (commEnd != std::string::npos)
+            {
+                std::istringstream fields(content.substr(commEnd + 2));
+                std::vector<std::string> values;
+                std::string value;
+                while (fields >> value)
+                {
+                    values.push_back(value);
+                }
+                // values[0] is field 3 (state)
+                if (values.size() > 21)
+                {
+                    static const double ticksPerSecond = static_cast<double>(sysconf(_SC_CLK_TCK));
+                    static const uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+                    usage.cpuSeconds = (std::stod(values[11]) + std::stod(values[12])) / ticksPerSecond;
+                    usage.threadCount = std::stoi(values[17]);
+                    usage.rssBytes = std::stoull(values[21]) * pageSize;
+                }
+            }
+#endif
+            return usage;
+        }
+
+        ProcessSampler::ProcessSampler(std::chrono::milliseconds interval)
+            : interval_(interval)
+        {
+        }
+
+        ProcessSampler::~ProcessSampler()
+        {
+            stop();
+        }
+
+        void ProcessSampler::start()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (running_)
+            {
+                return;
+            }
+            samples_.clear();
+            startTime_ = std::chrono::steady_clock::now();
+            startUsage_ = readProcessUsage();
+            running_ = true;
+            thread_ = std::thread(&ProcessSampler::run, this);
+        }
+
+        void ProcessSampler::stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!running_)
+                {
+                    return;
+                }
+                running_ = false;
+            }
+            cv_.notify_all();
+            if (thread_.joinable())
+            {
+                thread_.join();
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopTime_ = std::chrono::steady_clock::now();
+            stopUsage_ = readProcessUsage();
+        }
+
+        void ProcessSampler::run()
+        {
+            auto previousTime = startTime_;
+            auto previousUsage = startUsage_;
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (!cv_.wait_for(lock, interval_, [this]
+                                 { return !running_; }))
+            {
+                lock.unlock();
+                auto now = std::chrono::steady_clock::now();
+                auto usage = readProcessUsage();
+                double wallSec = std::chrono::duration<double>(now - previousTime).count();
+                Sample sample;
+                sample.elapsedSec = std::chrono::duration<double>(now - startTime_).count();
+                sample.cpuPercent = wallSec > 0 ? (usage.cpuSeconds - previousUsage.cpuSeconds) / wallSec * 100.0 : 0.0;
+                sample.rssBytes = usage.rssBytes;
+                sample.threadCount = usage.threadCount;
+                previousTime = now;
+                previousUsage = usage;
+                lock.lock();
+                samples_.push_back(sample);
+            }
+        }
+
+        nlohmann::json ProcessSampler::summary() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            double wallSec = std::chrono::duration<double>(stopTime_ - startTime_).count();
+            double cpuAvg = wallSec > 0 ? (stopUsage_.cpuSeconds - startUsage_.cpuSeconds) / wallSec * 100.0 : 0.0;
+
+            double cpuMax = 0.0;
+            uint64_t rssMax = stopUsage_.rssBytes;
+            int threadsMax = stopUsage_.threadCount;
+            nlohmann::json series = nlohmann::json::array();
+            for (const auto &sample : samples_)
+            {
+                cpuMax = std::max(cpuMax, sample.cpuPercent);
+                rssMax = std::max(rssMax, sample.rssBytes);
+                threadsMax = std::max(threadsMax, sample.threadCount);
+                series.push_back({{"t", std::round(sample.elapsedSec * 10.0) / 10.0},
+                                  {"cpu_percent", std::round(sample.cpuPercent * 10.0) / 10.0},
+                                  {"rss_bytes", sample.rssBytes},
+                                  {"threads", sample.threadCount}});
+            }
+
+            return {
+                {"cpu_seconds", stopUsage_.cpuSeconds - startUsage_.cpuSeconds},
+                {"cpu_percent_avg", std::round(cpuAvg * 10.0) / 10.0},
+                {"cpu_percent_max", std::round(cpuMax * 10.0) / 10.0},
+                {"rss_bytes_start", startUsage_.rssBytes},
+                {"rss_bytes_end", stopUsage_.rssBytes},
+                {"rss_bytes_max", rssMax},
+                {"threads_start", startUsage_.threadCount},
+                {"threads_end", stopUsage_.threadCount},
+                {"threads_max", threadsMax},
+                {"samples", series}};
+        }
+    } // namespace bench
+} // namespace elink
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace elink
+{
+    namespace bench
+    {
+        /**
+         * Resource usage of the current process at one point in time
+         */
+        struct ProcessUsage
+        {
+            double cpuSeconds = 0.0; // User + system CPU time since process start
+            uint64_t rssBytes = 0;   // Resident set size
+            int threadCount = 0;     // Number of threads
+        };
+
+        /**
+         * Read the current process resource usage
+         */
+        ProcessUsage readProcessUsage();
+
+        /**
+         * Samples CPU, RSS and thread count of the current process on a background thread
+         */
+        class ProcessSampler
+        {
+        public:
+            explicit ProcessSampler(std::chrono::milliseconds interval);
+            ~ProcessSampler();
+
+            void start();
+            void stop();
+
+            /**
+             * Summary of the samples taken between start() and stop()
+             */
+            nlohmann::json summary() const;
+
+        private:
+            struct Sample
+            {
+                double elapsedSec;
+                double cpuPercent;
+                uint64_t rssBytes;
+                int threadCount;
+            };
+
+            void run();
+
+            std::chrono::milliseconds interval_;
+            mutable std::mutex mutex_;
+            std::condition_variable cv_;
+            bool running_ = false;
+            std::thread thread_;
+            std::vector<Sample> samples_;
+            ProcessUsage startUsage_;
+            std::chrono::steady_clock::time_point startTime_;
+            std::chrono::steady_clock::time_point stopTime_;
+            ProcessUsage stopUsage_;
+        };
+    } // namespace bench
+} // namespace elink
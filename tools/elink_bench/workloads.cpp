@@ -0,0 +1,472 @@
+#include "workloads.h"
+#include "utils/utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+
+namespace elink
+{
+    namespace bench
+    {
+        namespace
+        {
+            double ratePerSecond(uint64_t count, double elapsedSec)
+            {
+                return elapsedSec > 0 ? std::round(static_cast<double>(count) / elapsedSec * 100.0) / 100.0 : 0.0;
+            }
+        } // namespace
+
+        // ========== Workload ==========
+
+        void Workload::startWorkers(int count, std::function<void()> fn)
+        {
+            running_ = true;
+            for (int i = 0; i < count; ++i)
+            {
+                workers_.emplace_back([this, fn]()
+                                      {
+                                          while (running_)
+                                          {
+                                              fn();
+                                          } });
+            }
+        }
+
+        void Workload::joinWorkers()
+        {
+            running_ = false;
+            for (auto &worker : workers_)
+            {
+                if (worker.joinable())
+                {
+                    worker.join();
+                }
+            }
+            workers_.clear();
+        }
+
+        // ========== Status stream ==========
+
+        void StatusStreamWorkload::start()
+        {
+            running_ = true;
+            statusSubscription_ = link_.subscribeEvent<PrinterStatusEvent>(
+                [this](const std::shared_ptr<PrinterStatusEvent> &event)
+                {
+                    auto now = LatencyRecorder::Clock::now();
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    auto &stream = streams_[event->status.printerId];
+                    if (stream.hasArrival)
+                    {
+                        auto gap = now - stream.lastArrival;
+                        gaps_.record(gap);
+                        // A gap longer than two expected periods means at least one push went missing
+                        if (options_.expectedStatusRate > 0 &&
+                            std::chrono::duration<double>(gap).count() > 2.0 / options_.expectedStatusRate)
+                        {
+                            stalls_++;
+                        }
+                    }
+                    stream.lastArrival = now;
+                    stream.hasArrival = true;
+                    stream.events++;
+                });
+            connectionSubscription_ = link_.subscribeEvent<PrinterConnectionEvent>(
+                [this](const std::shared_ptr<PrinterConnectionEvent> &event)
+                {
+                    if (event->connectionStatus.status == ConnectionStatus::DISCONNECTED)
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        disconnects_++;
+                    }
+                });
+        }
+
+        void StatusStreamWorkload::stop()
+        {
+            running_ = false;
+            link_.unsubscribeEvent<PrinterStatusEvent>(statusSubscription_);
+            link_.unsubscribeEvent<PrinterConnectionEvent>(connectionSubscription_);
+        }
+
+        void StatusStreamWorkload::resetMeasurements()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto &entry : streams_)
+            {
+                entry.second.events = 0;
+            }
+            gaps_.reset();
+            stalls_ = 0;
+            disconnects_ = 0;
+        }
+
+        nlohmann::json StatusStreamWorkload::report(double elapsedSec) const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            uint64_t total = 0;
+            uint64_t minEvents = UINT64_MAX;
+            uint64_t maxEvents = 0;
+            uint64_t dropped = 0;
+            int silent = 0;
+            const double expectedPerPrinter = options_.expectedStatusRate * elapsedSec;
+
+            for (const auto &printer : printers_)
+            {
+                auto it = streams_.find(printer.printerId);
+                uint64_t events = it != streams_.end() ? it->second.events : 0;
+                total += events;
+                minEvents = std::min(minEvents, events);
+                maxEvents = std::max(maxEvents, events);
+                if (events == 0)
+                {
+                    silent++;
+                }
+                if (expectedPerPrinter > 0 && static_cast<double>(events) < expectedPerPrinter)
+                {
+                    dropped += static_cast<uint64_t>(expectedPerPrinter - static_cast<double>(events));
+                }
+            }
+
+            nlohmann::json result = {
+                {"events", total},
+                {"events_per_sec", ratePerSecond(total, elapsedSec)},
+                {"events_per_printer_min", printers_.empty() ? 0 : minEvents},
+                {"events_per_printer_max", maxEvents},
+                {"silent_printers", silent},
+                {"disconnects", disconnects_},
+                {"inter_arrival", gaps_.summary()}};
+            if (options_.expectedStatusRate > 0)
+            {
+                result["expected_events"] = static_cast<uint64_t>(expectedPerPrinter * static_cast<double>(printers_.size()));
+                result["dropped_events"] = dropped;
+                result["stalls"] = stalls_;
+            }
+            return result;
+        }
+
+        // ========== Command bursts ==========
+
+        CommandBurstWorkload::CommandBurstWorkload(ElegooLink &link, const BenchOptions &options, const std::vector<ConnectedPrinter> &printers)
+            : Workload(link, options, printers)
+        {
+            for (const auto &command : options_.commands)
+            {
+                if (command == "pause-resume")
+                {
+                    recorders_["pause"] = std::make_unique<LatencyRecorder>();
+                    recorders_["resume"] = std::make_unique<LatencyRecorder>();
+                }
+                else
+                {
+                    recorders_[command] = std::make_unique<LatencyRecorder>();
+                }
+            }
+        }
+
+        bool CommandBurstWorkload::isValidCommand(const std::string &command)
+        {
+            return command == "status" || command == "status-cached" || command == "attributes" || command == "refresh" || command == "pause-resume";
+        }
+
+        void CommandBurstWorkload::start()
+        {
+            if (printers_.empty() || options_.commands.empty())
+            {
+                return;
+            }
+            startWorkers(options_.commandConcurrency, [this]()
+                         {
+                             uint64_t n = next_++;
+                             const auto &printer = printers_[n % printers_.size()];
+                             const auto &command = options_.commands[(n / printers_.size()) % options_.commands.size()];
+                             runCommand(command, printer.printerId);
+                             if (options_.commandIntervalMs > 0)
+                             {
+                                 std::this_thread::sleep_for(std::chrono::milliseconds(options_.commandIntervalMs));
+                             } });
+        }
+
+        void CommandBurstWorkload::stop()
+        {
+            joinWorkers();
+        }
+
+        void CommandBurstWorkload::runCommand(const std::string &command, const std::string &printerId)
+        {
+            PrinterBaseParams params(printerId);
+            if (command == "status" || command == "status-cached")
+            {
+                PrinterStatusParams statusParams(printerId, command == "status" ? StatusReadMode::REQUEST : StatusReadMode::CACHED);
+                ScopedLatency latency(*recorders_.at(command));
+                if (!link_.getPrinterStatus(statusParams, options_.commandTimeoutMs).isSuccess())
+                    latency.fail();
+            }
+            else if (command == "attributes")
+            {
+                ScopedLatency latency(*recorders_.at(command));
+                if (!link_.getPrinterAttributes(params, options_.commandTimeoutMs).isSuccess())
+                    latency.fail();
+            }
+            else if (command == "refresh")
+            {
+                ScopedLatency latency(*recorders_.at(command));
+                if (!link_.refreshPrinterStatus(PrinterStatusParams(printerId)).isSuccess())
+                    latency.fail();
+            }
+            else if (command == "pause-resume")
+            {
+                // Needs printers that are printing, e.g. a simulator started with --start-printing
+                {
+                    ScopedLatency latency(*recorders_.at("pause"));
+                    if (!link_.pausePrint(params).isSuccess())
+                        latency.fail();
+                }
+                {
+                    ScopedLatency latency(*recorders_.at("resume"));
+                    if (!link_.resumePrint(params).isSuccess())
+                        latency.fail();
+                }
+            }
+        }
+
+        void CommandBurstWorkload::resetMeasurements()
+        {
+            for (auto &entry : recorders_)
+            {
+                entry.second->reset();
+            }
+        }
+
+        nlohmann::json CommandBurstWorkload::report(double elapsedSec) const
+        {
+            nlohmann::json result = nlohmann::json::object();
+            uint64_t total = 0;
+            for (const auto &entry : recorders_)
+            {
+                result[entry.first] = entry.second->summary();
+                total += entry.second->count() + entry.second->errors();
+            }
+            result["commands_per_sec"] = ratePerSecond(total, elapsedSec);
+            return result;
+        }
+
+        // ========== Uploads ==========
+
+        bool UploadWorkload::createUploadFile()
+        {
+            std::error_code ec;
+            auto path = std::filesystem::temp_directory_path(ec) / ("elink_bench_" + CryptoUtils::generateUUID() + ".gcode");
+            if (ec)
+            {
+                return false;
+            }
+            filePath_ = path.string();
+
+            auto file = PathUtils::openOutputStream(filePath_, std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+            {
+                return false;
+            }
+            // Plausible G-code so printers that inspect the file accept it
+            const std::string line = "G1 X100.000 Y100.000 E0.05000 F3000 ; elink-bench payload line\n";
+            size_t written = 0;
+            while (written < options_.uploadSizeBytes)
+            {
+                size_t size = std::min(line.size(), options_.uploadSizeBytes - written);
+                file.write(line.data(), static_cast<std::streamsize>(size));
+                written += size;
+            }
+            return file.good();
+        }
+
+        void UploadWorkload::start()
+        {
+            if (printers_.empty() || !createUploadFile())
+            {
+                return;
+            }
+            startWorkers(options_.uploadConcurrency, [this]()
+                         {
+                             uint64_t n = next_++;
+                             FileUploadParams params;
+                             params.printerId = printers_[n % printers_.size()].printerId;
+                             params.storageLocation = "local";
+                             params.localFilePath = filePath_;
+                             params.fileName = "elink_bench_" + std::to_string(n % printers_.size()) + ".gcode";
+                             params.overwriteExisting = true;
+
+                             ScopedLatency latency(uploads_);
+                             auto result = link_.uploadFile(params, [this](const FileUploadProgressData &)
+                                                            { return running_.load(); });
+                             if (result.isSuccess())
+                             {
+                                 latency.stop();
+                                 bytesUploaded_ += options_.uploadSizeBytes;
+                             }
+                             else if (running_)
+                             {
+                                 latency.fail();
+                             }
+                             else
+                             {
+                                 // Cancelled by stop(), neither a sample nor an error
+                                 latency.dismiss();
+                             } });
+        }
+
+        void UploadWorkload::stop()
+        {
+            joinWorkers();
+            if (!filePath_.empty())
+            {
+                std::error_code ec;
+                std::filesystem::remove(filePath_, ec);
+            }
+        }
+
+        void UploadWorkload::resetMeasurements()
+        {
+            uploads_.reset();
+            bytesUploaded_ = 0;
+        }
+
+        nlohmann::json UploadWorkload::report(double elapsedSec) const
+        {
+            double mbPerSec = elapsedSec > 0 ? static_cast<double>(bytesUploaded_.load()) / elapsedSec / (1024.0 * 1024.0) : 0.0;
+            return {
+                {"file_size_bytes", options_.uploadSizeBytes},
+                {"concurrency", options_.uploadConcurrency},
+                {"bytes_uploaded", bytesUploaded_.load()},
+                {"throughput_mb_per_sec", std::round(mbPerSec * 100.0) / 100.0},
+                {"upload", uploads_.summary()}};
+        }
+
+        // ========== Discovery sweeps ==========
+
+        void DiscoverySweepWorkload::start()
+        {
+            // Only CC1 / CC2 answer UDP discovery
+            size_t expected = std::count_if(printers_.begin(), printers_.end(), [](const ConnectedPrinter &printer)
+                                            { return printer.spec.type == PrinterType::ELEGOO_FDM_CC ||
+                                                     printer.spec.type == PrinterType::ELEGOO_FDM_CC2; });
+            startWorkers(1, [this, expected]()
+                         {
+                             sweep(expected);
+                             for (int i = 0; i < options_.discoveryIntervalSec * 10 && running_; ++i)
+                             {
+                                 std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                             } });
+        }
+
+        void DiscoverySweepWorkload::sweep(size_t expected)
+        {
+            struct SweepState
+            {
+                std::mutex mutex;
+                std::condition_variable cv;
+                size_t found = 0;
+                bool completed = false;
+            };
+            auto state = std::make_shared<SweepState>();
+            auto startTime = LatencyRecorder::Clock::now();
+
+            PrinterDiscoveryParams params;
+            params.timeoutMs = options_.discoveryTimeoutMs;
+            auto result = link_.startPrinterDiscoveryAsync(
+                params,
+                [this, state, startTime, expected](const PrinterInfo &)
+                {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    state->found++;
+                    auto elapsed = LatencyRecorder::Clock::now() - startTime;
+                    if (state->found == 1)
+                    {
+                        firstFound_.record(elapsed);
+                    }
+                    if (state->found == expected)
+                    {
+                        allFound_.record(elapsed);
+                    }
+                },
+                [state](const std::vector<PrinterInfo> &)
+                {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    state->completed = true;
+                    state->cv.notify_all();
+                });
+            if (!result.isSuccess())
+            {
+                sweepDuration_.recordError();
+                return;
+            }
+
+            std::unique_lock<std::mutex> lock(state->mutex);
+            bool completed = state->cv.wait_for(lock, std::chrono::milliseconds(options_.discoveryTimeoutMs + 2000),
+                                                [&state]
+                                                { return state->completed; });
+            if (!completed)
+            {
+                lock.unlock();
+                link_.stopPrinterDiscovery();
+                sweepDuration_.recordError();
+                return;
+            }
+            sweepDuration_.record(LatencyRecorder::Clock::now() - startTime);
+            sweeps_++;
+            printersFound_ += state->found;
+            if (state->found < expected)
+            {
+                incompleteSweeps_++;
+            }
+        }
+
+        void DiscoverySweepWorkload::stop()
+        {
+            running_ = false;
+            link_.stopPrinterDiscovery();
+            joinWorkers();
+        }
+
+        void DiscoverySweepWorkload::resetMeasurements()
+        {
+            firstFound_.reset();
+            allFound_.reset();
+            sweepDuration_.reset();
+            sweeps_ = 0;
+            incompleteSweeps_ = 0;
+            printersFound_ = 0;
+        }
+
+        nlohmann::json DiscoverySweepWorkload::report(double) const
+        {
+            uint64_t sweeps = sweeps_.load();
+            return {
+                {"sweeps", sweeps},
+                {"incomplete_sweeps", incompleteSweeps_.load()},
+                {"printers_found_avg", sweeps > 0 ? static_cast<double>(printersFound_.load()) / static_cast<double>(sweeps) : 0.0},
+                {"first_found", firstFound_.summary()},
+                {"all_found", allFound_.summary()},
+                {"sweep_duration", sweepDuration_.summary()}};
+        }
+
+        std::unique_ptr<Workload> createWorkload(const std::string &name, ElegooLink &link, const BenchOptions &options,
+                                                 const std::vector<ConnectedPrinter> &printers)
+        {
+            if (name == "status")
+                return std::make_unique<StatusStreamWorkload>(link, options, printers);
+            if (name == "commands")
+                return std::make_unique<CommandBurstWorkload>(link, options, printers);
+            if (name == "upload")
+                return std::make_unique<UploadWorkload>(link, options, printers);
+            if (name == "discovery")
+                return std::make_unique<DiscoverySweepWorkload>(link, options, printers);
+            return nullptr;
+        }
+    } // namespace bench
+} // namespace elink
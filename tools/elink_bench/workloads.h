@@ -0,0 +1,182 @@
+#pragma once
+
+#include "bench_options.h"
+#include "latency_recorder.h"
+#include "elegoo_link.h"
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace elink
+{
+    namespace bench
+    {
+        /**
+         * A printer connected for the benchmark run
+         */
+        struct ConnectedPrinter
+        {
+            std::string printerId;
+            BenchPrinter spec;
+        };
+
+        /**
+         * Base class of a benchmark workload
+         *
+         * Workloads run concurrently: start() is called for all of them, then
+         * resetMeasurements() once the warmup is over, then stop() and report().
+         */
+        class Workload
+        {
+        public:
+            Workload(ElegooLink &link, const BenchOptions &options, const std::vector<ConnectedPrinter> &printers)
+                : link_(link), options_(options), printers_(printers) {}
+            virtual ~Workload() = default;
+
+            virtual const char *name() const = 0;
+            virtual void start() = 0;
+            virtual void stop() = 0;
+
+            /**
+             * Discard everything measured so far (end of warmup)
+             */
+            virtual void resetMeasurements() = 0;
+
+            /**
+             * Machine readable results
+             * @param elapsedSec Length of the measurement window
+             */
+            virtual nlohmann::json report(double elapsedSec) const = 0;
+
+        protected:
+            /**
+             * Start count worker threads running fn until stop()
+             */
+            void startWorkers(int count, std::function<void()> fn);
+            void joinWorkers();
+
+            ElegooLink &link_;
+            const BenchOptions &options_;
+            const std::vector<ConnectedPrinter> &printers_;
+            std::atomic<bool> running_{false};
+            std::vector<std::thread> workers_;
+        };
+
+        /**
+         * Measures the status event stream: rate, inter-arrival gaps, stalls and dropped events
+         */
+        class StatusStreamWorkload : public Workload
+        {
+        public:
+            using Workload::Workload;
+
+            const char *name() const override { return "status"; }
+            void start() override;
+            void stop() override;
+            void resetMeasurements() override;
+            nlohmann::json report(double elapsedSec) const override;
+
+        private:
+            struct Stream
+            {
+                LatencyRecorder::Clock::time_point lastArrival;
+                bool hasArrival = false;
+                uint64_t events = 0;
+            };
+
+            mutable std::mutex mutex_;
+            std::map<std::string, Stream> streams_;
+            LatencyRecorder gaps_;
+            uint64_t stalls_ = 0;
+            uint64_t disconnects_ = 0;
+            ElegooLink::EventSubscriptionId statusSubscription_ = 0;
+            ElegooLink::EventSubscriptionId connectionSubscription_ = 0;
+        };
+
+        /**
+         * Issues request/response commands round-robin over printers and records their latency
+         */
+        class CommandBurstWorkload : public Workload
+        {
+        public:
+            CommandBurstWorkload(ElegooLink &link, const BenchOptions &options, const std::vector<ConnectedPrinter> &printers);
+
+            const char *name() const override { return "commands"; }
+            void start() override;
+            void stop() override;
+            void resetMeasurements() override;
+            nlohmann::json report(double elapsedSec) const override;
+
+            /**
+             * Whether the command name is supported by this workload
+             */
+            static bool isValidCommand(const std::string &command);
+
+        private:
+            void runCommand(const std::string &command, const std::string &printerId);
+
+            std::atomic<uint64_t> next_{0};
+            std::map<std::string, std::unique_ptr<LatencyRecorder>> recorders_;
+        };
+
+        /**
+         * Uploads a generated file with a fixed number of concurrent transfers
+         */
+        class UploadWorkload : public Workload
+        {
+        public:
+            using Workload::Workload;
+
+            const char *name() const override { return "upload"; }
+            void start() override;
+            void stop() override;
+            void resetMeasurements() override;
+            nlohmann::json report(double elapsedSec) const override;
+
+        private:
+            bool createUploadFile();
+
+            std::string filePath_;
+            std::atomic<uint64_t> next_{0};
+            std::atomic<uint64_t> bytesUploaded_{0};
+            LatencyRecorder uploads_;
+        };
+
+        /**
+         * Repeats discovery sweeps and records how fast printers are found
+         */
+        class DiscoverySweepWorkload : public Workload
+        {
+        public:
+            using Workload::Workload;
+
+            const char *name() const override { return "discovery"; }
+            void start() override;
+            void stop() override;
+            void resetMeasurements() override;
+            nlohmann::json report(double elapsedSec) const override;
+
+        private:
+            void sweep(size_t expected);
+
+            LatencyRecorder firstFound_;
+            LatencyRecorder allFound_;
+            LatencyRecorder sweepDuration_;
+            std::atomic<uint64_t> sweeps_{0};
+            std::atomic<uint64_t> incompleteSweeps_{0};
+            std::atomic<uint64_t> printersFound_{0};
+        };
+
+        /**
+         * Create a workload by name
+         * @return nullptr for an unknown name
+         */
+        std::unique_ptr<Workload> createWorkload(const std::string &name, ElegooLink &link, const BenchOptions &options,
+                                                 const std::vector<ConnectedPrinter> &printers);
+    } // namespace bench
+} // namespace elink
@@ -0,0 +1,179 @@
+#include "elegoo_link.h"
+#include "elegoo_link_client.h"
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace elink;
+
+namespace
+{
+    struct GatewayOptions
+    {
+        std::string socketPath;
+        int threads = 0;
+        std::string staticWebPath;
+        int logLevel = 2;
+        std::string logFile;
+        bool fleetIndex = false;
+        bool alerts = false;
+
+        // Client mode: send one request to a running gateway and print the result
+        std::string callMethod;
+        std::string callParams = "{}";
+    };
+
+    std::atomic<bool> g_running{true};
+
+    void onSignal(int)
+    {
+        g_running = false;
+    }
+
+    void printUsage(const char *program)
+    {
+        std::cout
+            << "Usage: " << program << " [options]\n"
+            << "       " << program << " [--socket <path>] call <method> [params-json]\n"
+            << "\n"
+            << "Runs one ElegooLink instance that owns all printer connections and serves its API\n"
+            << "to other local processes (ElegooLinkClient) over a Unix domain socket.\n"
+            << "The call form sends a single request to a running gateway and prints the result.\n"
+            << "\n"
+            << "Options:\n"
+            << "  --socket <path>       Socket path (default: per-user path, see README)\n"
+            << "  --threads <n>         Request worker threads (default: hardware concurrency, at least 4)\n"
+            << "  --static-web <dir>    Static web files served by the local web server\n"
+            << "  --log-level <0-6>     SDK log level (default 2, INFO)\n"
+            << "  --log-file <file>     Also write the log to a file\n"
+            << "  --fleet-index         Index printer status for fleet queries\n"
+            << "  --alerts              Evaluate alert rules on printer status\n"
+            << "  -h, --help            Show this help\n";
+    }
+
+    bool parseArguments(int argc, char *argv[], GatewayOptions &options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string
+            {
+                if (i + 1 >= argc)
+                {
+                    throw std::invalid_argument(arg + " requires a value");
+                }
+                return argv[++i];
+            };
+
+            if (arg == "-h" || arg == "--help")
+                return false;
+            else if (arg == "--socket")
+                options.socketPath = value();
+            else if (arg == "--threads")
+                options.threads = std::stoi(value());
+            else if (arg == "--static-web")
+                options.staticWebPath = value();
+            else if (arg == "--log-level")
+                options.logLevel = std::stoi(value());
+            else if (arg == "--log-file")
+                options.logFile = value();
+            else if (arg == "--fleet-index")
+                options.fleetIndex = true;
+            else if (arg == "--alerts")
+                options.alerts = true;
+            else if (arg == "call")
+            {
+                options.callMethod = value();
+                if (i + 1 < argc)
+                {
+                    options.callParams = argv[++i];
+                }
+            }
+            else
+                throw std::invalid_argument("unknown argument " + arg);
+        }
+        return true;
+    }
+
+    int runCall(const GatewayOptions &options)
+    {
+        nlohmann::json params = nlohmann::json::parse(options.callParams, nullptr, false);
+        if (params.is_discarded())
+        {
+            std::cerr << "Invalid params JSON: " << options.callParams << "\n";
+            return 1;
+        }
+
+        ElegooLinkClient client;
+        if (!client.connect(options.socketPath))
+        {
+            std::cerr << "No gateway running, start elink-gateway first\n";
+            return 1;
+        }
+        nlohmann::json result = client.callAsync(options.callMethod, params).get();
+        std::cout << result.dump(2) << std::endl;
+        return result.value("code", 1) == 0 ? 0 : 2;
+    }
+
+    int runGateway(const GatewayOptions &options)
+    {
+        ElegooLink::Config config;
+        config.log.logLevel = options.logLevel;
+        config.log.logEnableFile = !options.logFile.empty();
+        config.log.logFileName = options.logFile;
+        config.local.staticWebPath = options.staticWebPath;
+        config.fleet.fleetIndexEnable = options.fleetIndex;
+        config.alerts.alertsEnable = options.alerts;
+
+        auto &link = ElegooLink::getInstance();
+        if (!link.initialize(config))
+        {
+            std::cerr << "Failed to initialize ElegooLink\n";
+            return 1;
+        }
+
+        auto result = link.startGateway(options.socketPath, options.threads);
+        if (!result.isSuccess())
+        {
+            std::cerr << "Failed to start gateway: " << result.message << "\n";
+            link.cleanup();
+            return 1;
+        }
+        std::cout << "elink-gateway " << link.getVersion() << " serving, press Ctrl+C to stop" << std::endl;
+
+        std::signal(SIGINT, onSignal);
+        std::signal(SIGTERM, onSignal);
+        while (g_running)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        }
+
+        link.cleanup();
+        return 0;
+    }
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    GatewayOptions options;
+    try
+    {
+        if (!parseArguments(argc, argv, options))
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Invalid arguments: " << e.what() << "\n";
+        return 1;
+    }
+
+    return options.callMethod.empty() ? runGateway(options) : runCall(options);
+}
@@ -0,0 +1,340 @@
+#include "cc1_simulated_printer.h"
+#include "http_helpers.h"
+#include "utils/logger.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace elink
+{
+    namespace simulator
+    {
+        namespace
+        {
+            constexpr int WEBSOCKET_PORT = 3030;
+            constexpr const char *MACHINE_NAME = "Centauri Carbon";
+            constexpr const char *FIRMWARE_VERSION = "V1.1.29";
+
+            // SDCP command ids
+            constexpr int CMD_STATUS = 0;
+            constexpr int CMD_ATTRIBUTES = 1;
+            constexpr int CMD_START_PRINT = 128;
+            constexpr int CMD_PAUSE_PRINT = 129;
+            constexpr int CMD_STOP_PRINT = 130;
+            constexpr int CMD_RESUME_PRINT = 131;
+
+            // SDCP Ack values
+            constexpr int ACK_OK = 0;
+            constexpr int ACK_BUSY = 1;
+
+            double round2(double value)
+            {
+                return std::round(value * 100.0) / 100.0;
+            }
+
+            int machineStatus(PrintPhase phase)
+            {
+                return (phase == PrintPhase::PRINTING || phase == PrintPhase::PAUSED) ? 1 : 0;
+            }
+
+            int printInfoStatus(PrintPhase phase)
+            {
+                switch (phase)
+                {
+                case PrintPhase::PRINTING:
+                    return 13;
+                case PrintPhase::PAUSED:
+                    return 6;
+                case PrintPhase::STOPPED:
+                    return 8;
+                case PrintPhase::COMPLETED:
+                    return 9;
+                default:
+                    return 0;
+                }
+            }
+        } // namespace
+
+        CC1SimulatedPrinter::CC1SimulatedPrinter(const SimulatorConfig &config, LinkEmulator &link, const std::string &address, int index)
+            : SimulatedPrinter(config, link, address, index)
+        {
+            char mainboardId[32];
+            std::snprintf(mainboardId, sizeof(mainboardId), "51c1%012x", static_cast<unsigned>(index + 1));
+            serialNumber_ = mainboardId;
+        }
+
+        CC1SimulatedPrinter::~CC1SimulatedPrinter()
+        {
+            stop();
+        }
+
+        bool CC1SimulatedPrinter::start()
+        {
+            wsServer_ = std::make_unique<ix::WebSocketServer>(WEBSOCKET_PORT, address_);
+            wsServer_->setOnClientMessageCallback(
+                [this](std::shared_ptr<ix::ConnectionState>, ix::WebSocket &webSocket, const ix::WebSocketMessagePtr &msg)
+                {
+                    if (msg->type == ix::WebSocketMessageType::Message)
+                    {
+                        handleMessage(findClient(webSocket), msg->str);
+                    }
+                });
+            auto result = wsServer_->listen();
+            if (!result.first)
+            {
+                ELEGOO_LOG_ERROR("[{}] CC1 WebSocket listen on port {} failed: {}", address_, WEBSOCKET_PORT, result.second);
+                wsServer_.reset();
+                return false;
+            }
+            wsServer_->start();
+
+            httpServer_ = std::make_unique<ix::HttpServer>(config_.httpPort, address_);
+            httpServer_->setOnConnectionCallback(
+                [this](ix::HttpRequestPtr request, std::shared_ptr<ix::ConnectionState>)
+                { return handleHttpRequest(request); });
+            result = httpServer_->listen();
+            if (!result.first)
+            {
+                ELEGOO_LOG_ERROR("[{}] CC1 HTTP listen on port {} failed: {}", address_, config_.httpPort, result.second);
+                stop();
+                return false;
+            }
+            httpServer_->start();
+            return true;
+        }
+
+        void CC1SimulatedPrinter::stop()
+        {
+            if (wsServer_)
+            {
+                wsServer_->stop();
+                wsServer_.reset();
+            }
+            if (httpServer_)
+            {
+                httpServer_->stop();
+                httpServer_.reset();
+            }
+        }
+
+        std::string CC1SimulatedPrinter::discoveryReply(int port, const std::string &probe) const
+        {
+            if (port != 3000 || probe.compare(0, 6, "M99999") != 0)
+            {
+                return "";
+            }
+            nlohmann::json reply;
+            reply["Id"] = serialNumber_;
+            reply["Data"] = {
+                {"Name", name()},
+                {"MachineName", MACHINE_NAME},
+                {"BrandName", "ELEGOO"},
+                {"MainboardIP", address_},
+                {"MainboardID", serialNumber_},
+                {"ProtocolVersion", "V3.0.0"},
+                {"FirmwareVersion", FIRMWARE_VERSION}};
+            return reply.dump();
+        }
+
+        // ========== WebSocket ==========
+
+        std::shared_ptr<ix::WebSocket> CC1SimulatedPrinter::findClient(const ix::WebSocket &webSocket) const
+        {
+            if (!wsServer_)
+            {
+                return nullptr;
+            }
+            for (const auto &client : wsServer_->getClients())
+            {
+                if (client.get() == &webSocket)
+                {
+                    return client;
+                }
+            }
+            return nullptr;
+        }
+
+        void CC1SimulatedPrinter::sendTo(std::shared_ptr<ix::WebSocket> client, const std::string &message)
+        {
+            if (!client)
+            {
+                return;
+            }
+            deliver([client, message]()
+                    { client->sendText(message); });
+        }
+
+        void CC1SimulatedPrinter::broadcast(const std::string &message)
+        {
+            if (!wsServer_)
+            {
+                return;
+            }
+            for (const auto &client : wsServer_->getClients())
+            {
+                sendTo(client, message);
+            }
+        }
+
+        void CC1SimulatedPrinter::handleMessage(std::shared_ptr<ix::WebSocket> client, const std::string &message)
+        {
+            countReceived();
+            if (message == "ping")
+            {
+                sendTo(client, "pong");
+                return;
+            }
+
+            nlohmann::json request;
+            try
+            {
+                request = nlohmann::json::parse(message);
+            }
+            catch (const std::exception &e)
+            {
+                ELEGOO_LOG_WARN("[{}] Invalid SDCP message: {}", address_, e.what());
+                return;
+            }
+
+            if (!request.is_object() || !request.contains("Data") || !request["Data"].is_object())
+            {
+                return;
+            }
+            auto data = request["Data"];
+            int cmd = data.value("Cmd", -1);
+            auto params = data.contains("Data") && data["Data"].is_object() ? data["Data"] : nlohmann::json::object();
+
+            int ack = ACK_OK;
+            switch (cmd)
+            {
+            case CMD_START_PRINT:
+                ack = startPrint(params.value("Filename", "sim.gcode")) ? ACK_OK : ACK_BUSY;
+                break;
+            case CMD_PAUSE_PRINT:
+                ack = pausePrint() ? ACK_OK : ACK_BUSY;
+                break;
+            case CMD_STOP_PRINT:
+                ack = stopPrint() ? ACK_OK : ACK_BUSY;
+                break;
+            case CMD_RESUME_PRINT:
+                ack = resumePrint() ? ACK_OK : ACK_BUSY;
+                break;
+            default:
+                break;
+            }
+
+            nlohmann::json response;
+            response["Id"] = request.value("Id", serialNumber_);
+            response["Data"] = {
+                {"Cmd", cmd},
+                {"Data", {{"Ack", ack}}},
+                {"RequestID", data.value("RequestID", "")},
+                {"MainboardID", serialNumber_},
+                {"TimeStamp", unixTimeSeconds()}};
+            response["Topic"] = "sdcp/response/" + serialNumber_;
+            sendTo(client, response.dump());
+
+            // Status and attributes requests are answered by a push on their own topic
+            if (cmd == CMD_STATUS)
+            {
+                sendTo(client, buildStatusMessage(snapshot()).dump());
+            }
+            else if (cmd == CMD_ATTRIBUTES)
+            {
+                sendTo(client, buildAttributesMessage().dump());
+            }
+        }
+
+        void CC1SimulatedPrinter::publishStatus(const PrinterSnapshot &snapshot)
+        {
+            if (!wsServer_ || wsServer_->getClients().empty())
+            {
+                return;
+            }
+            broadcast(buildStatusMessage(snapshot).dump());
+        }
+
+        // ========== Status rendering ==========
+
+        nlohmann::json CC1SimulatedPrinter::buildStatusMessage(const PrinterSnapshot &s) const
+        {
+            char coord[64];
+            std::snprintf(coord, sizeof(coord), "%.2f,%.2f,%.2f", s.x, s.y, s.z);
+
+            nlohmann::json status = {
+                {"CurrentStatus", {machineStatus(s.phase)}},
+                {"PreviousStatus", 0},
+                {"TempOfNozzle", round2(s.nozzleTemp)},
+                {"TempTargetNozzle", s.nozzleTarget},
+                {"TempOfHotbed", round2(s.bedTemp)},
+                {"TempTargetHotbed", s.bedTarget},
+                {"TempOfBox", round2(s.chamberTemp)},
+                {"TempTargetBox", 0},
+                {"CurrenCoord", coord}, // Spelling matches the firmware
+                {"CurrentFanSpeed", {{"ModelFan", s.fanSpeed * 100 / 255}, {"AuxiliaryFan", 0}, {"BoxFan", 0}}},
+                {"LightStatus", {{"MainLight", s.lightOn ? 1 : 0}, {"SecondLight", 0}, {"RgbLight", {0, 0, 0}}}},
+                {"ZOffset", 0.0},
+                {"PrintSpeed", 100},
+                {"PrintInfo", {{"Status", printInfoStatus(s.phase)}, {"CurrentLayer", s.currentLayer}, {"TotalLayer", s.totalLayer}, {"CurrentTicks", static_cast<int>(s.printDurationSec)}, {"TotalTicks", s.totalDurationSec}, {"Filename", s.fileName}, {"ErrorNumber", 0}, {"TaskId", s.taskId}, {"PrintSpeedPct", 100}, {"Progress", static_cast<int>(s.progress() * 100)}}}};
+
+            return {
+                {"Status", status},
+                {"MainboardID", serialNumber_},
+                {"TimeStamp", unixTimeSeconds()},
+                {"Topic", "sdcp/status/" + serialNumber_}};
+        }
+
+        nlohmann::json CC1SimulatedPrinter::buildAttributesMessage() const
+        {
+            nlohmann::json attributes = {
+                {"Name", name()},
+                {"MachineName", MACHINE_NAME},
+                {"BrandName", "ELEGOO"},
+                {"ProtocolVersion", "V3.0.0"},
+                {"FirmwareVersion", FIRMWARE_VERSION},
+                {"MainboardIP", address_},
+                {"MainboardID", serialNumber_},
+                {"NumberOfVideoStreamConnected", 0},
+                {"MaximumVideoStreamAllowed", 1},
+                {"NumberOfCloudSDCPServicesConnected", 0},
+                {"MaximumCloudSDCPSercicesAllowed", 1}};
+
+            return {
+                {"Attributes", attributes},
+                {"MainboardID", serialNumber_},
+                {"TimeStamp", unixTimeSeconds()},
+                {"Topic", "sdcp/attributes/" + serialNumber_}};
+        }
+
+        // ========== HTTP ==========
+
+        ix::HttpResponsePtr CC1SimulatedPrinter::handleHttpRequest(ix::HttpRequestPtr request)
+        {
+            countReceived();
+            std::map<std::string, std::string> query;
+            std::string path = splitUri(request->uri, query);
+
+            if (request->method == "POST" && path == "/uploadFile/upload")
+            {
+                auto contentType = request->headers.find("Content-Type");
+                auto fields = parseMultipart(contentType != request->headers.end() ? contentType->second : "", request->body);
+                const auto *file = findField(fields, "File");
+                const auto *offset = findField(fields, "Offset");
+                if (!file)
+                {
+                    return makeJsonResponse(200, {{"code", "111111"}, {"messages", "missing File field"}, {"success", false}});
+                }
+                uint64_t chunkOffset = offset ? std::strtoull(offset->content.c_str(), nullptr, 10) : 0;
+                storeUploadChunk(file->fileName, chunkOffset, file->content);
+                return makeJsonResponse(200, {{"code", "000000"}, {"messages", nullptr}, {"data", nullptr}, {"success", true}});
+            }
+
+            if (request->method == "GET" && path.compare(0, 13, "/downloadFile") == 0)
+            {
+                return makeBinaryResponse(downloadContent());
+            }
+
+            return makeNotFoundResponse();
+        }
+    } // namespace simulator
+} // namespace elink
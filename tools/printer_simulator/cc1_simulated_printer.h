@@ -0,0 +1,49 @@
+#pragma once
+
+#include "simulated_printer.h"
+#include <ixwebsocket/IXHttpServer.h>
+#include <ixwebsocket/IXWebSocketServer.h>
+#include <nlohmann/json.hpp>
+#include <memory>
+
+namespace elink
+{
+    namespace simulator
+    {
+        /**
+         * Simulated Elegoo CC1 printer speaking SDCP
+         *
+         * Serves the SDCP WebSocket on <address>:3030/websocket and the chunked
+         * upload / download endpoints on <address>:httpPort. Status is pushed on
+         * the sdcp/status topic, attributes on sdcp/attributes.
+         */
+        class CC1SimulatedPrinter : public SimulatedPrinter
+        {
+        public:
+            CC1SimulatedPrinter(const SimulatorConfig &config, LinkEmulator &link, const std::string &address, int index);
+            ~CC1SimulatedPrinter() override;
+
+            const char *protocolName() const override { return "CC1"; }
+            bool start() override;
+            void stop() override;
+            std::string discoveryReply(int port, const std::string &probe) const override;
+
+        protected:
+            void publishStatus(const PrinterSnapshot &snapshot) override;
+
+        private:
+            void handleMessage(std::shared_ptr<ix::WebSocket> client, const std::string &message);
+            std::shared_ptr<ix::WebSocket> findClient(const ix::WebSocket &webSocket) const;
+            void sendTo(std::shared_ptr<ix::WebSocket> client, const std::string &message);
+            void broadcast(const std::string &message);
+
+            ix::HttpResponsePtr handleHttpRequest(ix::HttpRequestPtr request);
+
+            nlohmann::json buildStatusMessage(const PrinterSnapshot &snapshot) const;
+            nlohmann::json buildAttributesMessage() const;
+
+            std::unique_ptr<ix::WebSocketServer> wsServer_;
+            std::unique_ptr<ix::HttpServer> httpServer_;
+        };
+    } // namespace simulator
+} // namespace elink
@@ -0,0 +1,469 @@
+#include "cc2_simulated_printer.h"
+#include "http_helpers.h"
+#include "utils/logger.h"
+#include <cmath>
+#include <cstdio>
+
+namespace elink
+{
+    namespace simulator
+    {
+        namespace
+        {
+            constexpr int MQTT_PORT = 1883;
+            constexpr const char *DEFAULT_ACCESS_CODE = "123456";
+            constexpr const char *MACHINE_MODEL = "Centauri Carbon 2";
+
+            // CC2 error codes used by the simulator
+            constexpr int ERROR_OK = 0;
+            constexpr int ERROR_BUSY = 1;
+            constexpr int ERROR_TOKEN = 1000;
+
+            double round2(double value)
+            {
+                return std::round(value * 100.0) / 100.0;
+            }
+
+            // machine_status.status / sub_status for a print phase
+            std::pair<int, int> machineStatus(PrintPhase phase)
+            {
+                switch (phase)
+                {
+                case PrintPhase::PRINTING:
+                    return {2, 2075};
+                case PrintPhase::PAUSED:
+                    return {2, 2502};
+                default:
+                    return {1, 0};
+                }
+            }
+
+            const char *printState(PrintPhase phase)
+            {
+                switch (phase)
+                {
+                case PrintPhase::PRINTING:
+                    return "printing";
+                case PrintPhase::PAUSED:
+                    return "paused";
+                case PrintPhase::STOPPED:
+                    return "cancelled";
+                case PrintPhase::COMPLETED:
+                    return "complete";
+                default:
+                    return "standby";
+                }
+            }
+
+            // Parse "bytes start-end/total"
+            bool parseContentRange(const std::string &value, uint64_t &start, uint64_t &end, uint64_t &total)
+            {
+                unsigned long long s = 0, e = 0, t = 0;
+                if (std::sscanf(value.c_str(), "bytes %llu-%llu/%llu", &s, &e, &t) != 3)
+                {
+                    return false;
+                }
+                start = s;
+                end = e;
+                total = t;
+                return true;
+            }
+        } // namespace
+
+        CC2SimulatedPrinter::CC2SimulatedPrinter(const SimulatorConfig &config, LinkEmulator &link, const std::string &address, int index)
+            : SimulatedPrinter(config, link, address, index),
+              broker_(address, MQTT_PORT, config.accessCode)
+        {
+            char sn[32];
+            std::snprintf(sn, sizeof(sn), "SIMCC2%010d", index + 1);
+            serialNumber_ = sn;
+            topicPrefix_ = "elegoo/" + serialNumber_ + "/";
+        }
+
+        CC2SimulatedPrinter::~CC2SimulatedPrinter()
+        {
+            stop();
+        }
+
+        bool CC2SimulatedPrinter::start()
+        {
+            broker_.setMessageHandler([this](const std::string &clientId, const std::string &topic, const std::string &payload)
+                                      { handleMqttMessage(clientId, topic, payload); });
+            if (!broker_.start())
+            {
+                return false;
+            }
+
+            httpServer_ = std::make_unique<ix::HttpServer>(config_.httpPort, address_);
+            httpServer_->setOnConnectionCallback(
+                [this](ix::HttpRequestPtr request, std::shared_ptr<ix::ConnectionState>)
+                { return handleHttpRequest(request); });
+            auto result = httpServer_->listen();
+            if (!result.first)
+            {
+                ELEGOO_LOG_ERROR("[{}] CC2 HTTP listen on port {} failed: {}", address_, config_.httpPort, result.second);
+                broker_.stop();
+                httpServer_.reset();
+                return false;
+            }
+            httpServer_->start();
+            return true;
+        }
+
+        void CC2SimulatedPrinter::stop()
+        {
+            broker_.stop();
+            if (httpServer_)
+            {
+                httpServer_->stop();
+                httpServer_.reset();
+            }
+        }
+
+        std::string CC2SimulatedPrinter::discoveryReply(int port, const std::string &probe) const
+        {
+            if (port != 52700)
+            {
+                return "";
+            }
+            try
+            {
+                auto json = nlohmann::json::parse(probe);
+                if (json.value("method", 0) != 7000)
+                {
+                    return "";
+                }
+                nlohmann::json reply;
+                reply["id"] = json.value("id", 0);
+                reply["result"] = {
+                    {"host_name", name()},
+                    {"machine_model", MACHINE_MODEL},
+                    {"sn", serialNumber_},
+                    {"token_status", config_.accessCode != DEFAULT_ACCESS_CODE ? 1 : 0},
+                    {"lan_status", 1}};
+                return reply.dump();
+            }
+            catch (const std::exception &)
+            {
+                return "";
+            }
+        }
+
+        // ========== MQTT ==========
+
+        void CC2SimulatedPrinter::handleMqttMessage(const std::string &clientId, const std::string &topic, const std::string &payload)
+        {
+            if (topic.compare(0, topicPrefix_.size(), topicPrefix_) != 0)
+            {
+                return;
+            }
+            countReceived();
+
+            std::string rest = topic.substr(topicPrefix_.size());
+            if (rest == "api_register")
+            {
+                handleRegister(payload);
+                return;
+            }
+
+            const std::string requestSuffix = "/api_request";
+            if (rest.size() > requestSuffix.size() &&
+                rest.compare(rest.size() - requestSuffix.size(), requestSuffix.size(), requestSuffix) == 0)
+            {
+                std::string requester = rest.substr(0, rest.size() - requestSuffix.size());
+                try
+                {
+                    handleRequest(requester, nlohmann::json::parse(payload));
+                }
+                catch (const std::exception &e)
+                {
+                    ELEGOO_LOG_WARN("[{}] Invalid CC2 request from {}: {}", address_, clientId, e.what());
+                }
+            }
+        }
+
+        void CC2SimulatedPrinter::handleRegister(const std::string &payload)
+        {
+            nlohmann::json request;
+            try
+            {
+                request = nlohmann::json::parse(payload);
+            }
+            catch (const std::exception &)
+            {
+                return;
+            }
+
+            std::string clientId = request.value("client_id", "");
+            std::string requestId = request.value("request_id", "");
+            if (clientId.empty() || requestId.empty())
+            {
+                return;
+            }
+
+            std::string error = "ok";
+            {
+                std::lock_guard<std::mutex> lock(registerMutex_);
+                // Slots of clients whose MQTT session is gone are released
+                for (auto it = registeredClients_.begin(); it != registeredClients_.end();)
+                {
+                    it = broker_.isClientConnected(*it) ? std::next(it) : registeredClients_.erase(it);
+                }
+                if (registeredClients_.count(clientId) == 0 &&
+                    static_cast<int>(registeredClients_.size()) >= config_.maxClientsPerPrinter)
+                {
+                    error = "too many clients";
+                }
+                else
+                {
+                    registeredClients_.insert(clientId);
+                }
+            }
+
+            nlohmann::json response = {{"client_id", clientId}, {"error", error}};
+            std::string topic = topicPrefix_ + requestId + "/register_response";
+            deliver([this, topic, body = response.dump()]()
+                    { broker_.publish(topic, body); });
+        }
+
+        void CC2SimulatedPrinter::handleRequest(const std::string &clientId, const nlohmann::json &request)
+        {
+            std::string responseTopic = topicPrefix_ + clientId + "/api_response";
+
+            if (request.value("type", "") == "PING")
+            {
+                deliver([this, responseTopic]()
+                        { broker_.publish(responseTopic, "{\"type\":\"PONG\"}"); });
+                return;
+            }
+
+            int method = request.value("method", 0);
+            nlohmann::json response;
+            response["id"] = request.value("id", 0);
+            response["method"] = method;
+            response["result"] = handleMethod(method, request.value("params", nlohmann::json::object()));
+            deliver([this, responseTopic, body = response.dump()]()
+                    { broker_.publish(responseTopic, body); });
+        }
+
+        nlohmann::json CC2SimulatedPrinter::handleMethod(int method, const nlohmann::json &params)
+        {
+            nlohmann::json result = nlohmann::json::object();
+            bool ok = true;
+            switch (method)
+            {
+            case 1001: // Attributes
+                result = buildAttributes();
+                break;
+            case 1002: // Full status
+                result = buildFullStatus(snapshot());
+                break;
+            case 1020: // Start print
+                ok = startPrint(params.value("filename", "sim.gcode"));
+                break;
+            case 1021: // Pause
+                ok = pausePrint();
+                break;
+            case 1022: // Stop
+                ok = stopPrint();
+                break;
+            case 1023: // Resume
+                ok = resumePrint();
+                break;
+            case 1043: // Rename
+                setName(params.value("hostname", name()));
+                publishEvent(6008, buildAttributes());
+                break;
+            case 2005: // Canvas status
+                result["canvas_info"] = buildFullStatus(snapshot())["canvas_info"];
+                break;
+            default:
+                // 2004 auto refill, 1057/1058 printer side download and anything else are accepted as is
+                break;
+            }
+            result["error_code"] = ok ? ERROR_OK : ERROR_BUSY;
+            return result;
+        }
+
+        void CC2SimulatedPrinter::publishEvent(int method, nlohmann::json result)
+        {
+            std::lock_guard<std::mutex> lock(eventMutex_);
+            nlohmann::json event;
+            event["id"] = ++eventSequence_;
+            event["method"] = method;
+            event["result"] = std::move(result);
+            deliver([this, body = event.dump()]()
+                    { broker_.publish(topicPrefix_ + "api_status", body); });
+        }
+
+        void CC2SimulatedPrinter::publishStatus(const PrinterSnapshot &snapshot)
+        {
+            // Ids only advance while someone listens, like the firmware which starts counting per session
+            if (broker_.clientCount() == 0)
+            {
+                std::lock_guard<std::mutex> lock(eventMutex_);
+                hasPublished_ = false;
+                return;
+            }
+
+            nlohmann::json delta;
+            {
+                std::lock_guard<std::mutex> lock(eventMutex_);
+                delta = hasPublished_ ? buildStatusDelta(lastPublished_, snapshot) : buildFullStatus(snapshot);
+                lastPublished_ = snapshot;
+                hasPublished_ = true;
+            }
+            publishEvent(6000, std::move(delta));
+        }
+
+        // ========== Status rendering ==========
+
+        nlohmann::json CC2SimulatedPrinter::buildAttributes() const
+        {
+            return {
+                {"machine_model", MACHINE_MODEL},
+                {"hostname", name()},
+                {"sn", serialNumber_},
+                {"ip", address_},
+                {"protocol_version", "1.0.0"},
+                {"software_version", {{"ota_version", "1.1.25.3"}, {"mcu_version", "0.2.14"}, {"soc_version", "1.1.25"}}}};
+        }
+
+        nlohmann::json CC2SimulatedPrinter::buildFullStatus(const PrinterSnapshot &s) const
+        {
+            auto status = machineStatus(s.phase);
+            int remaining = std::max(0, s.totalDurationSec - static_cast<int>(s.printDurationSec));
+
+            nlohmann::json trays = nlohmann::json::array();
+            static const char *colors[] = {"#FFFFFF", "#000000", "#FF0000", "#00FF00"};
+            for (int i = 0; i < 4; ++i)
+            {
+                trays.push_back({{"tray_id", i},
+                                 {"brand", "ELEGOO"},
+                                 {"filament_type", "PLA"},
+                                 {"filament_name", "PLA Basic"},
+                                 {"filament_code", "000" + std::to_string(i + 1)},
+                                 {"filament_color", colors[i]},
+                                 {"min_nozzle_temp", 190},
+                                 {"max_nozzle_temp", 230},
+                                 {"status", i == 0 ? 2 : 1}});
+            }
+
+            return {
+                {"machine_status", {{"status", status.first}, {"sub_status", status.second}, {"exception_status", nlohmann::json::array()}, {"progress", static_cast<int>(s.progress() * 100)}}},
+                {"print_status", {{"filename", s.fileName}, {"uuid", s.taskId}, {"total_duration", s.totalDurationSec}, {"print_duration", static_cast<int>(s.printDurationSec)}, {"remaining_time_sec", remaining}, {"current_layer", s.currentLayer}, {"total_layer", s.totalLayer}, {"state", printState(s.phase)}}},
+                {"extruder", {{"temperature", round2(s.nozzleTemp)}, {"target", s.nozzleTarget}, {"filament_detected", 1}}},
+                {"heater_bed", {{"temperature", round2(s.bedTemp)}, {"target", s.bedTarget}}},
+                {"ztemperature_sensor", {{"temperature", round2(s.chamberTemp)}}},
+                {"fans", {{"fan", {{"speed", s.fanSpeed}}}, {"heater_fan", {{"speed", s.fanSpeed}}}, {"box_fan", {{"speed", 0}}}, {"aux_fan", {{"speed", 0}}}}},
+                {"led", {{"status", s.lightOn ? 1 : 0}}},
+                {"toolhead", {{"homed_axes", "xyz"}}},
+                {"gcode_move_inf", {{"x", round2(s.x)}, {"y", round2(s.y)}, {"z", round2(s.z)}, {"e", round2(s.e)}, {"speed", 12000}, {"speed_mode", 1}}},
+                {"external_device", {{"u_disk", false}, {"camera", false}, {"type", "0"}}},
+                {"canvas_info", {{"active_canvas_id", 0}, {"active_tray_id", 0}, {"auto_refill", false}, {"canvas_list", nlohmann::json::array({{{"canvas_id", 0}, {"connected", 1}, {"tray_list", trays}}})}}}};
+        }
+
+        nlohmann::json CC2SimulatedPrinter::buildStatusDelta(const PrinterSnapshot &p, const PrinterSnapshot &s) const
+        {
+            nlohmann::json delta = nlohmann::json::object();
+            if (p.phase != s.phase)
+            {
+                auto status = machineStatus(s.phase);
+                delta["machine_status"] = {{"status", status.first}, {"sub_status", status.second}};
+                delta["print_status"]["state"] = printState(s.phase);
+            }
+            if (p.fileName != s.fileName || p.taskId != s.taskId)
+            {
+                delta["print_status"]["filename"] = s.fileName;
+                delta["print_status"]["uuid"] = s.taskId;
+                delta["print_status"]["total_duration"] = s.totalDurationSec;
+                delta["print_status"]["total_layer"] = s.totalLayer;
+            }
+            if (static_cast<int>(p.printDurationSec) != static_cast<int>(s.printDurationSec))
+            {
+                delta["print_status"]["print_duration"] = static_cast<int>(s.printDurationSec);
+                delta["print_status"]["remaining_time_sec"] = std::max(0, s.totalDurationSec - static_cast<int>(s.printDurationSec));
+                delta["machine_status"]["progress"] = static_cast<int>(s.progress() * 100);
+            }
+            if (p.currentLayer != s.currentLayer)
+            {
+                delta["print_status"]["current_layer"] = s.currentLayer;
+            }
+            if (round2(p.nozzleTemp) != round2(s.nozzleTemp) || p.nozzleTarget != s.nozzleTarget)
+            {
+                delta["extruder"] = {{"temperature", round2(s.nozzleTemp)}, {"target", s.nozzleTarget}};
+            }
+            if (round2(p.bedTemp) != round2(s.bedTemp) || p.bedTarget != s.bedTarget)
+            {
+                delta["heater_bed"] = {{"temperature", round2(s.bedTemp)}, {"target", s.bedTarget}};
+            }
+            if (p.fanSpeed != s.fanSpeed)
+            {
+                delta["fans"]["fan"]["speed"] = s.fanSpeed;
+            }
+            if (p.x != s.x || p.y != s.y || p.z != s.z)
+            {
+                delta["gcode_move_inf"] = {{"x", round2(s.x)}, {"y", round2(s.y)}, {"z", round2(s.z)}, {"e", round2(s.e)}};
+            }
+            return delta;
+        }
+
+        // ========== HTTP ==========
+
+        bool CC2SimulatedPrinter::isTokenValid(ix::HttpRequestPtr request, const std::map<std::string, std::string> &query) const
+        {
+            auto header = request->headers.find("X-Token");
+            if (header != request->headers.end())
+            {
+                return header->second == config_.accessCode;
+            }
+            auto param = query.find("X-Token");
+            return param != query.end() && param->second == config_.accessCode;
+        }
+
+        ix::HttpResponsePtr CC2SimulatedPrinter::handleHttpRequest(ix::HttpRequestPtr request)
+        {
+            countReceived();
+            std::map<std::string, std::string> query;
+            std::string path = splitUri(request->uri, query);
+
+            if (request->method == "GET" && path == "/system/info")
+            {
+                if (!isTokenValid(request, query))
+                {
+                    return makeJsonResponse(401, {{"error_code", ERROR_TOKEN}});
+                }
+                return makeJsonResponse(200, {{"error_code", ERROR_OK},
+                                              {"system_info", {{"sn", serialNumber_}, {"hostname", name()}, {"machine_model", MACHINE_MODEL}, {"ip", address_}}}});
+            }
+
+            if (request->method == "PUT" && path == "/upload")
+            {
+                if (!isTokenValid(request, query))
+                {
+                    return makeJsonResponse(200, {{"error_code", ERROR_TOKEN}});
+                }
+                uint64_t start = 0, end = 0, total = 0;
+                auto range = request->headers.find("Content-Range");
+                if (range == request->headers.end() || !parseContentRange(range->second, start, end, total))
+                {
+                    return makeJsonResponse(400, {{"error_code", ERROR_BUSY}});
+                }
+                auto fileName = request->headers.find("X-File-Name");
+                storeUploadChunk(fileName != request->headers.end() ? fileName->second : "upload.gcode", start, request->body);
+                return makeJsonResponse(200, {{"error_code", ERROR_OK}});
+            }
+
+            if (request->method == "GET" && path.compare(0, 9, "/download") == 0)
+            {
+                if (!isTokenValid(request, query))
+                {
+                    return makeJsonResponse(401, {{"error_code", ERROR_TOKEN}});
+                }
+                return makeBinaryResponse(downloadContent());
+            }
+
+            return makeNotFoundResponse();
+        }
+    } // namespace simulator
+} // namespace elink
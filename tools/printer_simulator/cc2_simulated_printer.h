@@ -0,0 +1,65 @@
+#pragma once
+
+#include "mqtt_broker.h"
+#include "simulated_printer.h"
+#include <ixwebsocket/IXHttpServer.h>
+#include <nlohmann/json.hpp>
+#include <memory>
+#include <mutex>
+#include <set>
+
+namespace elink
+{
+    namespace simulator
+    {
+        /**
+         * Simulated Elegoo CC2 printer
+         *
+         * Runs the printer's MQTT broker on <address>:1883 and the HTTP file
+         * service on <address>:httpPort. Handles client registration, the
+         * PING/PONG heartbeat, request methods 1001-2005 and publishes 6000
+         * status deltas with sequential ids plus 6008 attribute events.
+         */
+        class CC2SimulatedPrinter : public SimulatedPrinter
+        {
+        public:
+            CC2SimulatedPrinter(const SimulatorConfig &config, LinkEmulator &link, const std::string &address, int index);
+            ~CC2SimulatedPrinter() override;
+
+            const char *protocolName() const override { return "CC2"; }
+            bool start() override;
+            void stop() override;
+            std::string discoveryReply(int port, const std::string &probe) const override;
+
+        protected:
+            void publishStatus(const PrinterSnapshot &snapshot) override;
+
+        private:
+            void handleMqttMessage(const std::string &clientId, const std::string &topic, const std::string &payload);
+            void handleRegister(const std::string &payload);
+            void handleRequest(const std::string &clientId, const nlohmann::json &request);
+            nlohmann::json handleMethod(int method, const nlohmann::json &params);
+
+            ix::HttpResponsePtr handleHttpRequest(ix::HttpRequestPtr request);
+            bool isTokenValid(ix::HttpRequestPtr request, const std::map<std::string, std::string> &query) const;
+
+            nlohmann::json buildAttributes() const;
+            nlohmann::json buildFullStatus(const PrinterSnapshot &snapshot) const;
+            nlohmann::json buildStatusDelta(const PrinterSnapshot &previous, const PrinterSnapshot &current) const;
+
+            void publishEvent(int method, nlohmann::json result);
+
+            std::string topicPrefix_; // "elegoo/<sn>/"
+            MqttBroker broker_;
+            std::unique_ptr<ix::HttpServer> httpServer_;
+
+            std::mutex registerMutex_;
+            std::set<std::string> registeredClients_;
+
+            std::mutex eventMutex_; // Keeps 6000 ids sequential in publish order
+            int eventSequence_ = 0;
+            bool hasPublished_ = false;
+            PrinterSnapshot lastPublished_;
+        };
+    } // namespace simulator
+} // namespace elink
@@ -0,0 +1,142 @@
+#include "discovery_responder.h"
+#include "utils/logger.h"
+#include <algorithm>
+
+namespace elink
+{
+    namespace simulator
+    {
+        namespace
+        {
+            constexpr int DISCOVERY_PORTS[] = {3000, 52700};
+            // Link channel of discovery replies, apart from the printers' own connections
+            constexpr uint64_t DISCOVERY_CHANNEL = UINT64_MAX;
+        } // namespace
+
+        DiscoveryResponder::DiscoveryResponder(const std::vector<std::shared_ptr<SimulatedPrinter>> &printers, LinkEmulator &link)
+            : printers_(printers), link_(link)
+        {
+        }
+
+        DiscoveryResponder::~DiscoveryResponder()
+        {
+            stop();
+        }
+
+        bool DiscoveryResponder::start()
+        {
+            for (int port : DISCOVERY_PORTS)
+            {
+                socket_t sock = socket(AF_INET, SOCK_DGRAM, 0);
+                if (sock == INVALID_SOCKET)
+                {
+                    ELEGOO_LOG_ERROR("Failed to create discovery socket for port {}", port);
+                    continue;
+                }
+                setReuseAddress(sock);
+
+                auto addr = makeAddress("", port);
+                if (bind(sock, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == SOCKET_ERROR)
+                {
+                    ELEGOO_LOG_ERROR("Failed to bind discovery port {}, is another simulator or printer service running?", port);
+                    closeSocket(sock);
+                    continue;
+                }
+                listeners_.push_back({port, sock});
+            }
+
+            if (listeners_.empty())
+            {
+                return false;
+            }
+            running_ = true;
+            thread_ = std::thread(&DiscoveryResponder::run, this);
+            return true;
+        }
+
+        void DiscoveryResponder::stop()
+        {
+            running_ = false;
+            if (thread_.joinable())
+            {
+                thread_.join();
+            }
+            for (auto &listener : listeners_)
+            {
+                closeSocket(listener.sock);
+            }
+            listeners_.clear();
+        }
+
+        void DiscoveryResponder::run()
+        {
+            char buffer[2048];
+            while (running_)
+            {
+                fd_set readSet;
+                FD_ZERO(&readSet);
+                socket_t maxSock = 0;
+                for (const auto &listener : listeners_)
+                {
+                    FD_SET(listener.sock, &readSet);
+                    maxSock = std::max(maxSock, listener.sock);
+                }
+
+                // Short timeout so stop() is honoured promptly
+                timeval timeout{0, 200 * 1000};
+                int ready = select(static_cast<int>(maxSock + 1), &readSet, nullptr, nullptr, &timeout);
+                if (ready <= 0)
+                {
+                    continue;
+                }
+
+                for (const auto &listener : listeners_)
+                {
+                    if (!FD_ISSET(listener.sock, &readSet))
+                    {
+                        continue;
+                    }
+                    sockaddr_in from{};
+                    socklen_t fromLen = sizeof(from);
+                    int received = static_cast<int>(recvfrom(listener.sock, buffer, sizeof(buffer) - 1, 0,
+                                                             reinterpret_cast<sockaddr *>(&from), &fromLen));
+                    if (received <= 0)
+                    {
+                        continue;
+                    }
+                    probesReceived_++;
+                    respond(listener, std::string(buffer, static_cast<size_t>(received)), from);
+                }
+            }
+        }
+
+        void DiscoveryResponder::respond(const Listener &listener, const std::string &probe, const sockaddr_in &from)
+        {
+            for (const auto &printer : printers_)
+            {
+                std::string reply = printer->discoveryReply(listener.port, probe);
+                if (reply.empty())
+                {
+                    continue;
+                }
+
+                std::string address = printer->address();
+                link_.deliver(DISCOVERY_CHANNEL, [address, reply, from]()
+                              {
+                                  // Reply from the printer's own alias so the client sees it as the sender
+                                  socket_t sock = socket(AF_INET, SOCK_DGRAM, 0);
+                                  if (sock == INVALID_SOCKET)
+                                  {
+                                      return;
+                                  }
+                                  auto local = makeAddress(address, 0);
+                                  if (bind(sock, reinterpret_cast<const sockaddr *>(&local), sizeof(local)) != SOCKET_ERROR)
+                                  {
+                                      sendto(sock, reply.data(), static_cast<int>(reply.size()), 0,
+                                             reinterpret_cast<const sockaddr *>(&from), sizeof(from));
+                                  }
+                                  closeSocket(sock); });
+            }
+        }
+    } // namespace simulator
+} // namespace elink
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "simulated_printer.h"
+#include "socket_compat.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace elink
+{
+    namespace simulator
+    {
+        /**
+         * Answers UDP discovery probes on behalf of every simulated printer
+         *
+         * Listens on 0.0.0.0:3000 (CC1, "M99999") and 0.0.0.0:52700 (CC2,
+         * method 7000). Each printer replies from a socket bound to its own
+         * loopback alias, so discovery reports the alias as the printer host.
+         */
+        class DiscoveryResponder
+        {
+        public:
+            DiscoveryResponder(const std::vector<std::shared_ptr<SimulatedPrinter>> &printers, LinkEmulator &link);
+            ~DiscoveryResponder();
+
+            bool start();
+            void stop();
+
+            uint64_t probesReceived() const { return probesReceived_.load(); }
+
+        private:
+            struct Listener
+            {
+                int port;
+                socket_t sock;
+            };
+
+            void run();
+            void respond(const Listener &listener, const std::string &probe, const sockaddr_in &from);
+
+            std::vector<std::shared_ptr<SimulatedPrinter>> printers_;
+            LinkEmulator &link_;
+            std::vector<Listener> listeners_;
+            std::atomic<bool> running_{false};
+            std::thread thread_;
+            std::atomic<uint64_t> probesReceived_{0};
+        };
+    } // namespace simulator
+} // namespace elink
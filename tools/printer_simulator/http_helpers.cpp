@@ -0,0 +1,175 @@
+#include "http_helpers.h"
+#include <cctype>
+
+namespace elink
+{
+    namespace simulator
+    {
+        std::string urlDecode(const std::string &value)
+        {
+            std::string result;
+            result.reserve(value.size());
+            for (size_t i = 0; i < value.size(); ++i)
+            {
+                if (value[i] == '%' && i + 2 < value.size() &&
+                    std::isxdigit(static_cast<unsigned char>(value[i + 1])) &&
+                    std::isxdigit(static_cast<unsigned char>(value[i + 2])))
+                {
+                    result += static_cast<char>(std::stoi(value.substr(i + 1, 2), nullptr, 16));
+                    i += 2;
+                }
+                else if (value[i] == '+')
+                {
+                    result += ' ';
+                }
+                else
+                {
+                    result += value[i];
+                }
+            }
+            return result;
+        }
+
+        std::string splitUri(const std::string &uri, std::map<std::string, std::string> &query)
+        {
+            auto pos = uri.find('?');
+            if (pos == std::string::npos)
+            {
+                return urlDecode(uri);
+            }
+
+            std::string queryString = uri.substr(pos + 1);
+            size_t start = 0;
+            while (start <= queryString.size())
+            {
+                auto end = queryString.find('&', start);
+                if (end == std::string::npos)
+                {
+                    end = queryString.size();
+                }
+                std::string pair = queryString.substr(start, end - start);
+                auto eq = pair.find('=');
+                if (!pair.empty())
+                {
+                    if (eq == std::string::npos)
+                    {
+                        query[urlDecode(pair)] = "";
+                    }
+                    else
+                    {
+                        query[urlDecode(pair.substr(0, eq))] = urlDecode(pair.substr(eq + 1));
+                    }
+                }
+                start = end + 1;
+            }
+            return urlDecode(uri.substr(0, pos));
+        }
+
+        namespace
+        {
+            // Extract name="value" from a Content-Disposition header
+            std::string dispositionParam(const std::string &header, const std::string &key)
+            {
+                std::string token = key + "=\"";
+                auto pos = header.find(token);
+                if (pos == std::string::npos)
+                {
+                    return "";
+                }
+                pos += token.size();
+                auto end = header.find('"', pos);
+                return end == std::string::npos ? "" : header.substr(pos, end - pos);
+            }
+        } // namespace
+
+        std::vector<MultipartField> parseMultipart(const std::string &contentType, const std::string &body)
+        {
+            std::vector<MultipartField> fields;
+            auto pos = contentType.find("boundary=");
+            if (pos == std::string::npos)
+            {
+                return fields;
+            }
+            std::string boundary = contentType.substr(pos + 9);
+            auto semicolon = boundary.find(';');
+            if (semicolon != std::string::npos)
+            {
+                boundary = boundary.substr(0, semicolon);
+            }
+            if (boundary.size() >= 2 && boundary.front() == '"' && boundary.back() == '"')
+            {
+                boundary = boundary.substr(1, boundary.size() - 2);
+            }
+
+            const std::string delimiter = "--" + boundary;
+            size_t cursor = body.find(delimiter);
+            while (cursor != std::string::npos)
+            {
+                cursor += delimiter.size();
+                if (body.compare(cursor, 2, "--") == 0)
+                {
+                    break; // Closing delimiter
+                }
+                if (body.compare(cursor, 2, "\r\n") == 0)
+                {
+                    cursor += 2;
+                }
+
+                auto headerEnd = body.find("\r\n\r\n", cursor);
+                if (headerEnd == std::string::npos)
+                {
+                    break;
+                }
+                std::string headers = body.substr(cursor, headerEnd - cursor);
+                size_t contentStart = headerEnd + 4;
+
+                auto next = body.find("\r\n" + delimiter, contentStart);
+                if (next == std::string::npos)
+                {
+                    break;
+                }
+
+                MultipartField field;
+                field.name = dispositionParam(headers, "name");
+                field.fileName = dispositionParam(headers, "filename");
+                field.content = body.substr(contentStart, next - contentStart);
+                fields.push_back(std::move(field));
+
+                cursor = next + 2;
+            }
+            return fields;
+        }
+
+        const MultipartField *findField(const std::vector<MultipartField> &fields, const std::string &name)
+        {
+            for (const auto &field : fields)
+            {
+                if (field.name == name)
+                {
+                    return &field;
+                }
+            }
+            return nullptr;
+        }
+
+        ix::HttpResponsePtr makeJsonResponse(int status, const nlohmann::json &body)
+        {
+            ix::WebSocketHttpHeaders headers;
+            headers["Content-Type"] = "application/json";
+            return std::make_shared<ix::HttpResponse>(status, status < 400 ? "OK" : "Error",
+                                                      ix::HttpErrorCode::Ok, headers, body.dump());
+        }
+
+        ix::HttpResponsePtr makeBinaryResponse(const std::string &body)
+        {
+            ix::WebSocketHttpHeaders headers;
+            headers["Content-Type"] = "application/octet-stream";
+            return std::make_shared<ix::HttpResponse>(200, "OK", ix::HttpErrorCode::Ok, headers, body);
+        }
+
+        ix::HttpResponsePtr makeNotFoundResponse()
+        {
+            return makeJsonResponse(404, nlohmann::json{{"error", "not found"}});
+        }
+    } // namespace simulator
+} // namespace elink
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <ixwebsocket/IXHttpServer.h>
+#include <nlohmann/json.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace elink
+{
+    namespace simulator
+    {
+        /**
+         * One part of a multipart/form-data body
+         */
+        struct MultipartField
+        {
+            std::string name;
+            std::string fileName;
+            std::string content;
+        };
+
+        /**
+         * Split a request URI into path and decoded query parameters
+         * @param uri Request URI, e.g. "/download?file_name=a.gcode"
+         * @param query Receives the query parameters
+         * @return Decoded path
+         */
+        std::string splitUri(const std::string &uri, std::map<std::string, std::string> &query);
+
+        /**
+         * Percent-decode a URI component
+         */
+        std::string urlDecode(const std::string &value);
+
+        /**
+         * Parse a multipart/form-data body
+         * @param contentType Value of the Content-Type header, carries the boundary
+         * @param body Raw request body
+         * @return Parsed fields, empty if the body is not multipart
+         */
+        std::vector<MultipartField> parseMultipart(const std::string &contentType, const std::string &body);
+
+        /**
+         * Find a multipart field by name
+         */
+        const MultipartField *findField(const std::vector<MultipartField> &fields, const std::string &name);
+
+        ix::HttpResponsePtr makeJsonResponse(int status, const nlohmann::json &body);
+        ix::HttpResponsePtr makeBinaryResponse(const std::string &body);
+        ix::HttpResponsePtr makeNotFoundResponse();
+    } // namespace simulator
+} // namespace elink
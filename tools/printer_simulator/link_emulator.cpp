@@ -0,0 +1,189 @@
+#include "link_emulator.h"
+#include "utils/logger.h"
+#include <algorithm>
+
+namespace elink
+{
+    namespace simulator
+    {
+        LinkEmulator::LinkEmulator(const NetworkProfile &profile)
+            : profile_(profile), rng_(std::random_device{}())
+        {
+            if (profile_.latencyMs > 0 || profile_.jitterMs > 0)
+            {
+                thread_ = std::thread(&LinkEmulator::run, this);
+                for (size_t i = 0; i < WORKER_COUNT; ++i)
+                {
+                    workers_.emplace_back(&LinkEmulator::work, this);
+                }
+            }
+        }
+
+        LinkEmulator::~LinkEmulator()
+        {
+            stop();
+        }
+
+        void LinkEmulator::stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                running_ = false;
+            }
+            cv_.notify_all();
+            workCv_.notify_all();
+            if (thread_.joinable())
+            {
+                thread_.join();
+            }
+            for (auto &worker : workers_)
+            {
+                if (worker.joinable())
+                {
+                    worker.join();
+                }
+            }
+        }
+
+        bool LinkEmulator::shouldDrop()
+        {
+            if (profile_.lossRate <= 0.0)
+            {
+                return false;
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::uniform_real_distribution<double> dist(0.0, 1.0);
+            if (dist(rng_) < profile_.lossRate)
+            {
+                dropped_++;
+                return true;
+            }
+            return false;
+        }
+
+        std::chrono::milliseconds LinkEmulator::nextDelay()
+        {
+            int delay = profile_.latencyMs;
+            if (profile_.jitterMs > 0)
+            {
+                std::uniform_int_distribution<int> dist(0, profile_.jitterMs);
+                delay += dist(rng_);
+            }
+            return std::chrono::milliseconds(delay);
+        }
+
+        bool LinkEmulator::deliver(uint64_t channel, std::function<void()> send)
+        {
+            if (shouldDrop())
+            {
+                return false;
+            }
+
+            if (!thread_.joinable())
+            {
+                delivered_++;
+                send();
+                return true;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!running_)
+                {
+                    return false;
+                }
+                // Jitter delays a message, it does not let it overtake the previous one
+                auto &state = channels_[channel];
+                auto deadline = std::max(std::chrono::steady_clock::now() + nextDelay(), state.lastDeadline);
+                state.lastDeadline = deadline;
+                state.pending++;
+                queue_.push_back(PendingSend{deadline, sequence_++, channel, std::move(send)});
+                std::push_heap(queue_.begin(), queue_.end(), std::greater<PendingSend>());
+            }
+            cv_.notify_one();
+            return true;
+        }
+
+        void LinkEmulator::run()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (running_)
+            {
+                if (queue_.empty())
+                {
+                    cv_.wait(lock);
+                    continue;
+                }
+
+                auto deadline = queue_.front().deadline;
+                if (std::chrono::steady_clock::now() < deadline)
+                {
+                    cv_.wait_until(lock, deadline);
+                    continue;
+                }
+
+                std::pop_heap(queue_.begin(), queue_.end(), std::greater<PendingSend>());
+                PendingSend pending = std::move(queue_.back());
+                queue_.pop_back();
+
+                auto &channel = channels_[pending.channel];
+                channel.pending--;
+                channel.due.push_back(std::move(pending.send));
+                if (!channel.scheduled)
+                {
+                    channel.scheduled = true;
+                    runnable_.push_back(pending.channel);
+                    workCv_.notify_one();
+                }
+            }
+        }
+
+        void LinkEmulator::work()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (true)
+            {
+                workCv_.wait(lock, [this]()
+                             { return !running_ || !runnable_.empty(); });
+                if (!running_)
+                {
+                    return;
+                }
+                uint64_t id = runnable_.front();
+                runnable_.pop_front();
+
+                // The channel stays owned by this worker until its due sends are drained
+                while (running_)
+                {
+                    auto &channel = channels_[id];
+                    if (channel.due.empty())
+                    {
+                        // Every deadline of an idle channel has passed, so its state can go
+                        if (channel.pending == 0)
+                        {
+                            channels_.erase(id);
+                        }
+                        else
+                        {
+                            channel.scheduled = false;
+                        }
+                        break;
+                    }
+                    auto send = std::move(channel.due.front());
+                    channel.due.pop_front();
+                    lock.unlock();
+                    try
+                    {
+                        send();
+                        delivered_++;
+                    }
+                    catch (const std::exception &e)
+                    {
+                        ELEGOO_LOG_WARN("Delayed send failed: {}", e.what());
+                    }
+                    lock.lock();
+                }
+            }
+        }
+    } // namespace simulator
+} // namespace elink
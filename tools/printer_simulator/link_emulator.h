@@ -0,0 +1,110 @@
+#pragma once
+
+#include "simulator_config.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace elink
+{
+    namespace simulator
+    {
+        /**
+         * Applies the configured latency and packet loss to outgoing messages
+         *
+         * One instance is shared by every simulated printer. Delayed sends are timed
+         * by a single scheduler thread and run on a small worker pool, so the cost
+         * does not grow with the number of printers. Messages on one channel (a
+         * printer's connection) keep their order like a TCP stream: a message is
+         * never due before the one sent ahead of it, and a channel's sends run one
+         * at a time. A send that blocks holds up its own channel and one worker only.
+         * A channel's state is dropped once it has nothing queued, so closed
+         * connections leave nothing behind.
+         */
+        class LinkEmulator
+        {
+        public:
+            explicit LinkEmulator(const NetworkProfile &profile);
+            ~LinkEmulator();
+
+            LinkEmulator(const LinkEmulator &) = delete;
+            LinkEmulator &operator=(const LinkEmulator &) = delete;
+
+            /**
+             * Send a message through the emulated link
+             * @param channel Connection the message travels on; messages of a channel are delivered in order
+             * @param send Function that performs the actual send
+             * @return false if the message was dropped
+             */
+            bool deliver(uint64_t channel, std::function<void()> send);
+
+            /**
+             * Whether the next message should be dropped
+             */
+            bool shouldDrop();
+
+            /**
+             * Number of messages dropped so far
+             */
+            uint64_t droppedCount() const { return dropped_.load(); }
+
+            /**
+             * Number of messages sent (immediately or delayed) so far
+             */
+            uint64_t deliveredCount() const { return delivered_.load(); }
+
+            void stop();
+
+        private:
+            static constexpr size_t WORKER_COUNT = 4;
+
+            struct PendingSend
+            {
+                std::chrono::steady_clock::time_point deadline;
+                uint64_t sequence;
+                uint64_t channel;
+                std::function<void()> send;
+
+                bool operator>(const PendingSend &other) const
+                {
+                    return deadline != other.deadline ? deadline > other.deadline : sequence > other.sequence;
+                }
+            };
+
+            struct Channel
+            {
+                std::chrono::steady_clock::time_point lastDeadline{};
+                std::deque<std::function<void()>> due; // Sends past their deadline, in order
+                size_t pending = 0;                    // Sends in queue_ before their deadline
+                bool scheduled = false;                // Queued for or owned by a worker
+            };
+
+            std::chrono::milliseconds nextDelay();
+            void run();
+            void work();
+
+            NetworkProfile profile_;
+            std::mutex mutex_;
+            std::condition_variable cv_;
+            std::condition_variable workCv_;
+            std::vector<PendingSend> queue_; // Min-heap on deadline, ordered by std::greater<PendingSend>
+            std::unordered_map<uint64_t, Channel> channels_;
+            std::deque<uint64_t> runnable_; // Channels with due sends and no worker
+            std::mt19937 rng_;
+            uint64_t sequence_ = 0;
+            bool running_ = true;
+            std::thread thread_;
+            std::vector<std::thread> workers_;
+            std::atomic<uint64_t> dropped_{0};
+            std::atomic<uint64_t> delivered_{0};
+        };
+    } // namespace simulator
+} // namespace elink
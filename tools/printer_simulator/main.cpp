@@ -0,0 +1,418 @@
+#include "cc1_simulated_printer.h"
+#include "cc2_simulated_printer.h"
+#include "discovery_responder.h"
+#include "link_emulator.h"
+#include "moonraker_simulated_printer.h"
+#include "simulator_config.h"
+#include "utils/logger.h"
+#include "utils/utils.h"
+#include <ixwebsocket/IXNetSystem.h>
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <cctype>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace elink;
+using namespace elink::simulator;
+
+namespace
+{
+    std::atomic<bool> g_running{true};
+
+    void onSignal(int)
+    {
+        g_running = false;
+    }
+
+    void printUsage(const char *program)
+    {
+        std::cout
+            << "Usage: " << program << " [options]\n"
+            << "\n"
+            << "Printers (each printer binds its own loopback alias):\n"
+            << "  --cc1 <n>              Number of CC1 (SDCP over WebSocket) printers\n"
+            << "  --cc2 <n>              Number of CC2 (MQTT) printers\n"
+            << "  --moonraker <n>        Number of Moonraker printers\n"
+            << "  --base-address <ip>    First printer address (default 127.0.1.1)\n"
+            << "  --http-port <port>     CC1 / CC2 file transfer port (default 80)\n"
+            << "  --moonraker-port <p>   Moonraker HTTP + WebSocket port (default 80)\n"
+            << "\n"
+            << "Behaviour:\n"
+            << "  --status-rate <hz>     Status pushes per second per printer (default 1)\n"
+            << "  --print-duration <s>   Simulated print job duration (default 1800)\n"
+            << "  --start-printing       Start every printer mid-print\n"
+            << "  --file-size <bytes>    Size of served files, accepts K/M/G suffix (default 8M)\n"
+            << "  --access-code <code>   CC2 access code (default 123456)\n"
+            << "  --max-clients <n>      CC2 client limit per printer (default 4)\n"
+            << "  --no-discovery         Do not answer UDP discovery\n"
+            << "  --upload-dir <dir>     Store uploaded files instead of discarding them\n"
+            << "\n"
+            << "Network impairment:\n"
+            << "  --latency <ms>         One-way delay added to every outgoing message\n"
+            << "  --jitter <ms>          Random extra delay in [0, jitter]\n"
+            << "  --loss <rate>          Outgoing message drop probability (0.0 - 1.0)\n"
+            << "\n"
+            << "Output:\n"
+            << "  --manifest <file>      Write the printer list as JSON\n"
+            << "  --stats-interval <s>   Seconds between stats lines, 0 disables (default 10)\n"
+            << "  --duration <s>         Exit after the given time, 0 runs until Ctrl+C (default 0)\n"
+            << "  --log-level <level>    trace, debug, info, warn or error (default info)\n"
+            << "  -h, --help             Show this help\n";
+    }
+
+    size_t parseSize(const std::string &value)
+    {
+        char *end = nullptr;
+        double number = std::strtod(value.c_str(), &end);
+        size_t multiplier = 1;
+        if (end && *end)
+        {
+            switch (std::toupper(static_cast<unsigned char>(*end)))
+            {
+            case 'K':
+                multiplier = 1024;
+                break;
+            case 'M':
+                multiplier = 1024 * 1024;
+                break;
+            case 'G':
+                multiplier = 1024 * 1024 * 1024;
+                break;
+            default:
+                break;
+            }
+        }
+        return number > 0 ? static_cast<size_t>(number * multiplier) : 0;
+    }
+
+    LogLevel parseLogLevel(const std::string &value)
+    {
+        if (value == "trace")
+            return LogLevel::TRACE;
+        if (value == "debug")
+            return LogLevel::DEBUG;
+        if (value == "warn")
+            return LogLevel::WARN;
+        if (value == "error")
+            return LogLevel::ERROR_LEVEL;
+        return LogLevel::INFO;
+    }
+
+    /**
+     * Produce the next IPv4 address, skipping .0 and .255 host parts
+     * @return Empty string when the address range is exhausted
+     */
+    std::string nextAddress(const std::string &address)
+    {
+        unsigned int a, b, c, d;
+        if (std::sscanf(address.c_str(), "%u.%u.%u.%u", &a, &b, &c, &d) != 4)
+        {
+            return "";
+        }
+        uint32_t value = (a << 24) | (b << 16) | (c << 8) | d;
+        do
+        {
+            ++value;
+        } while ((value & 0xFF) == 0 || (value & 0xFF) == 0xFF);
+        if ((value >> 24) != a)
+        {
+            return "";
+        }
+        return std::to_string(value >> 24) + "." + std::to_string((value >> 16) & 0xFF) + "." +
+               std::to_string((value >> 8) & 0xFF) + "." + std::to_string(value & 0xFF);
+    }
+
+    struct Options
+    {
+        SimulatorConfig config;
+        std::string manifestPath;
+        int statsIntervalSec = 10;
+        int durationSec = 0;
+        LogLevel logLevel = LogLevel::INFO;
+    };
+
+    bool parseArguments(int argc, char *argv[], Options &options)
+    {
+        auto &config = options.config;
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string
+            {
+                if (i + 1 >= argc)
+                {
+                    throw std::invalid_argument("missing value for " + arg);
+                }
+                return argv[++i];
+            };
+
+            if (arg == "-h" || arg == "--help")
+            {
+                printUsage(argv[0]);
+                std::exit(0);
+            }
+            else if (arg == "--cc1")
+                config.cc1Count = std::stoi(value());
+            else if (arg == "--cc2")
+                config.cc2Count = std::stoi(value());
+            else if (arg == "--moonraker")
+                config.moonrakerCount = std::stoi(value());
+            else if (arg == "--base-address")
+                config.baseAddress = value();
+            else if (arg == "--http-port")
+                config.httpPort = std::stoi(value());
+            else if (arg == "--moonraker-port")
+                config.moonrakerPort = std::stoi(value());
+            else if (arg == "--status-rate")
+                config.statusRateHz = std::stod(value());
+            else if (arg == "--print-duration")
+                config.printDurationSec = std::stoi(value());
+            else if (arg == "--start-printing")
+                config.startPrinting = true;
+            else if (arg == "--file-size")
+                config.fileSizeBytes = parseSize(value());
+            else if (arg == "--access-code")
+                config.accessCode = value();
+            else if (arg == "--max-clients")
+                config.maxClientsPerPrinter = std::stoi(value());
+            else if (arg == "--no-discovery")
+                config.enableDiscovery = false;
+            else if (arg == "--upload-dir")
+                config.uploadDir = value();
+            else if (arg == "--latency")
+                config.network.latencyMs = std::stoi(value());
+            else if (arg == "--jitter")
+                config.network.jitterMs = std::stoi(value());
+            else if (arg == "--loss")
+                config.network.lossRate = std::stod(value());
+            else if (arg == "--manifest")
+                options.manifestPath = value();
+            else if (arg == "--stats-interval")
+                options.statsIntervalSec = std::stoi(value());
+            else if (arg == "--duration")
+                options.durationSec = std::stoi(value());
+            else if (arg == "--log-level")
+                options.logLevel = parseLogLevel(value());
+            else
+            {
+                std::cerr << "Unknown option: " << arg << "\n";
+                return false;
+            }
+        }
+
+        if (config.cc1Count + config.cc2Count + config.moonrakerCount <= 0)
+        {
+            std::cerr << "At least one printer is required (--cc1, --cc2 or --moonraker)\n";
+            return false;
+        }
+        if (config.statusRateHz <= 0.0)
+        {
+            std::cerr << "--status-rate must be greater than 0\n";
+            return false;
+        }
+        if (config.network.lossRate < 0.0 || config.network.lossRate > 1.0)
+        {
+            std::cerr << "--loss must be between 0.0 and 1.0\n";
+            return false;
+        }
+        return true;
+    }
+
+    bool writeManifest(const std::string &path, const Options &options,
+                       const std::vector<std::shared_ptr<SimulatedPrinter>> &printers)
+    {
+        nlohmann::json list = nlohmann::json::array();
+        for (const auto &printer : printers)
+        {
+            std::string protocol = printer->protocolName();
+            nlohmann::json entry = {
+                {"protocol", protocol},
+                {"host", printer->address()},
+                {"serialNumber", printer->serialNumber()},
+                {"name", printer->name()}};
+            if (protocol == "CC2")
+            {
+                entry["accessCode"] = options.config.accessCode;
+            }
+            if (protocol == "Moonraker" && options.config.moonrakerPort != 80)
+            {
+                entry["host"] = printer->address() + ":" + std::to_string(options.config.moonrakerPort);
+            }
+            list.push_back(std::move(entry));
+        }
+
+        auto file = PathUtils::openOutputStream(path, std::ios::out | std::ios::trunc);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        file << nlohmann::json{{"printers", list}}.dump(2) << std::endl;
+        return true;
+    }
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    Options options;
+    try
+    {
+        if (!parseArguments(argc, argv, options))
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Invalid arguments: " << e.what() << "\n";
+        return 1;
+    }
+
+    LogConfig logConfig;
+    logConfig.level = options.logLevel;
+    Logger::getInstance().initialize(logConfig);
+
+    ix::initNetSystem();
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+#ifndef _WIN32
+    std::signal(SIGPIPE, SIG_IGN);
+#endif
+
+    const SimulatorConfig &config = options.config;
+    auto link = std::make_unique<LinkEmulator>(config.network);
+
+    // Create printers on consecutive loopback aliases
+    std::vector<std::shared_ptr<SimulatedPrinter>> printers;
+    std::string address = config.baseAddress;
+    auto addPrinters = [&](int count, auto factory) -> bool
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            if (address.empty())
+            {
+                std::cerr << "Address range exhausted after " << printers.size() << " printers\n";
+                return false;
+            }
+            printers.push_back(factory(address, static_cast<int>(printers.size())));
+            address = nextAddress(address);
+        }
+        return true;
+    };
+
+    bool created = addPrinters(config.cc1Count, [&](const std::string &host, int index)
+                               { return std::make_shared<CC1SimulatedPrinter>(config, *link, host, index); }) &&
+                   addPrinters(config.cc2Count, [&](const std::string &host, int index)
+                               { return std::make_shared<CC2SimulatedPrinter>(config, *link, host, index); }) &&
+                   addPrinters(config.moonrakerCount, [&](const std::string &host, int index)
+                               { return std::make_shared<MoonrakerSimulatedPrinter>(config, *link, host, index); });
+    if (!created)
+    {
+        return 1;
+    }
+
+    size_t started = 0;
+    for (const auto &printer : printers)
+    {
+        if (printer->start())
+        {
+            started++;
+        }
+        else
+        {
+            ELEGOO_LOG_ERROR("{} printer at {} failed to start", printer->protocolName(), printer->address());
+        }
+    }
+    if (started == 0)
+    {
+        std::cerr << "No printer could be started, see README for loopback alias and port setup\n";
+        return 1;
+    }
+
+    std::unique_ptr<DiscoveryResponder> discovery;
+    if (config.enableDiscovery)
+    {
+        discovery = std::make_unique<DiscoveryResponder>(printers, *link);
+        if (!discovery->start())
+        {
+            ELEGOO_LOG_WARN("UDP discovery disabled, no discovery port could be bound");
+            discovery.reset();
+        }
+    }
+
+    if (!options.manifestPath.empty() && !writeManifest(options.manifestPath, options, printers))
+    {
+        ELEGOO_LOG_ERROR("Failed to write manifest to {}", options.manifestPath);
+    }
+
+    for (const auto &printer : printers)
+    {
+        std::cout << printer->protocolName() << "\t" << printer->address() << "\t" << printer->serialNumber() << "\n";
+    }
+    std::cout << started << "/" << printers.size() << " printers running, press Ctrl+C to stop" << std::endl;
+
+    // One ticker for all printers; ticks are staggered across the period so
+    // status pushes are spread out instead of arriving in bursts
+    using Clock = std::chrono::steady_clock;
+    const auto period = std::chrono::duration<double>(1.0 / config.statusRateHz);
+    const auto slot = period / static_cast<double>(printers.size());
+    const auto startTime = Clock::now();
+    auto nextStats = startTime + std::chrono::seconds(options.statsIntervalSec);
+    uint64_t round = 0;
+
+    while (g_running)
+    {
+        for (size_t i = 0; i < printers.size() && g_running; ++i)
+        {
+            auto deadline = startTime + std::chrono::duration_cast<Clock::duration>(period * static_cast<double>(round) + slot * static_cast<double>(i));
+            std::this_thread::sleep_until(deadline);
+            printers[i]->tick(period.count());
+        }
+        round++;
+
+        auto now = Clock::now();
+        if (options.durationSec > 0 && now - startTime >= std::chrono::seconds(options.durationSec))
+        {
+            break;
+        }
+        if (options.statsIntervalSec > 0 && now >= nextStats)
+        {
+            uint64_t sent = 0, received = 0, uploaded = 0;
+            for (const auto &printer : printers)
+            {
+                sent += printer->messagesSent();
+                received += printer->messagesReceived();
+                uploaded += printer->bytesUploaded();
+            }
+            ELEGOO_LOG_INFO("Stats: sent={} received={} dropped={} uploaded={}B probes={}",
+                            sent, received, link->droppedCount(), uploaded,
+                            discovery ? discovery->probesReceived() : 0);
+            nextStats = now + std::chrono::seconds(options.statsIntervalSec);
+        }
+    }
+
+    std::cout << "Shutting down..." << std::endl;
+    if (discovery)
+    {
+        discovery->stop();
+    }
+    // Pending delayed sends capture printer pointers, drain them before the printers go away
+    link->stop();
+    for (const auto &printer : printers)
+    {
+        printer->stop();
+    }
+    printers.clear();
+    ix::uninitNetSystem();
+    return 0;
+}
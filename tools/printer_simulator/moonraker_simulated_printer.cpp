@@ -0,0 +1,381 @@
+#include "moonraker_simulated_printer.h"
+#include "http_helpers.h"
+#include "utils/logger.h"
+#include "utils/utils.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+namespace elink
+{
+    namespace simulator
+    {
+        namespace
+        {
+            // JSON-RPC error codes returned by Moonraker
+            constexpr int RPC_METHOD_NOT_FOUND = -32601;
+            constexpr int RPC_INVALID_STATE = 400;
+
+            double round2(double value)
+            {
+                return std::round(value * 100.0) / 100.0;
+            }
+
+            const char *printStatsState(PrintPhase phase)
+            {
+                switch (phase)
+                {
+                case PrintPhase::PRINTING:
+                    return "printing";
+                case PrintPhase::PAUSED:
+                    return "paused";
+                case PrintPhase::STOPPED:
+                    return "cancelled";
+                case PrintPhase::COMPLETED:
+                    return "complete";
+                default:
+                    return "standby";
+                }
+            }
+
+            nlohmann::json position(const PrinterSnapshot &s)
+            {
+                return {round2(s.x), round2(s.y), round2(s.z), round2(s.e)};
+            }
+        } // namespace
+
+        MoonrakerSimulatedPrinter::MoonrakerSimulatedPrinter(const SimulatorConfig &config, LinkEmulator &link, const std::string &address, int index)
+            : SimulatedPrinter(config, link, address, index)
+        {
+            // Moonraker printers are identified by the wlan0 MAC address
+            char mac[32];
+            std::snprintf(mac, sizeof(mac), "02:51:%02x:%02x:%02x:%02x",
+                          (index >> 24) & 0xFF, (index >> 16) & 0xFF, (index >> 8) & 0xFF, index & 0xFF);
+            serialNumber_ = mac;
+        }
+
+        MoonrakerSimulatedPrinter::~MoonrakerSimulatedPrinter()
+        {
+            stop();
+        }
+
+        bool MoonrakerSimulatedPrinter::start()
+        {
+            server_ = std::make_unique<ix::HttpServer>(config_.moonrakerPort, address_);
+            server_->setOnConnectionCallback(
+                [this](ix::HttpRequestPtr request, std::shared_ptr<ix::ConnectionState>)
+                { return handleHttpRequest(request); });
+            server_->setOnClientMessageCallback(
+                [this](std::shared_ptr<ix::ConnectionState>, ix::WebSocket &webSocket, const ix::WebSocketMessagePtr &msg)
+                {
+                    if (msg->type == ix::WebSocketMessageType::Message)
+                    {
+                        handleMessage(webSocket, msg->str);
+                    }
+                    else if (msg->type == ix::WebSocketMessageType::Close)
+                    {
+                        std::lock_guard<std::mutex> lock(subscribersMutex_);
+                        subscribers_.erase(&webSocket);
+                    }
+                });
+
+            auto result = server_->listen();
+            if (!result.first)
+            {
+                ELEGOO_LOG_ERROR("[{}] Moonraker listen on port {} failed: {}", address_, config_.moonrakerPort, result.second);
+                server_.reset();
+                return false;
+            }
+            server_->start();
+            return true;
+        }
+
+        void MoonrakerSimulatedPrinter::stop()
+        {
+            if (server_)
+            {
+                server_->stop();
+                server_.reset();
+            }
+        }
+
+        double MoonrakerSimulatedPrinter::eventTime() const
+        {
+            // Klipper reports monotonic host time
+            return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        // ========== JSON-RPC ==========
+
+        std::shared_ptr<ix::WebSocket> MoonrakerSimulatedPrinter::findClient(const ix::WebSocket &webSocket) const
+        {
+            if (!server_)
+            {
+                return nullptr;
+            }
+            for (const auto &client : server_->getClients())
+            {
+                if (client.get() == &webSocket)
+                {
+                    return client;
+                }
+            }
+            return nullptr;
+        }
+
+        void MoonrakerSimulatedPrinter::handleMessage(ix::WebSocket &webSocket, const std::string &message)
+        {
+            countReceived();
+            nlohmann::json request;
+            try
+            {
+                request = nlohmann::json::parse(message);
+            }
+            catch (const std::exception &e)
+            {
+                ELEGOO_LOG_WARN("[{}] Invalid JSON-RPC message: {}", address_, e.what());
+                return;
+            }
+            if (!request.is_object() || !request.contains("method") || !request["method"].is_string())
+            {
+                return;
+            }
+
+            nlohmann::json response;
+            response["jsonrpc"] = "2.0";
+            response["id"] = request.value("id", nlohmann::json());
+            auto params = request.contains("params") ? request["params"] : nlohmann::json::object();
+            nlohmann::json result;
+            bool ok = handleMethod(webSocket, request["method"].get<std::string>(), params, result);
+            response[ok ? "result" : "error"] = result;
+
+            auto client = findClient(webSocket);
+            if (client)
+            {
+                deliver([client, body = response.dump()]()
+                        { client->sendText(body); });
+            }
+        }
+
+        bool MoonrakerSimulatedPrinter::handleMethod(ix::WebSocket &webSocket, const std::string &method,
+                                                     const nlohmann::json &params, nlohmann::json &result)
+        {
+            auto rpcError = [&result](int code, const std::string &message)
+            {
+                result = {{"code", code}, {"message", message}};
+                return false;
+            };
+
+            if (method == "machine.system_info")
+            {
+                result = {{"system_info", buildSystemInfo()}};
+                return true;
+            }
+            if (method == "printer.objects.subscribe" || method == "printer.objects.query")
+            {
+                if (method == "printer.objects.subscribe")
+                {
+                    std::lock_guard<std::mutex> lock(subscribersMutex_);
+                    subscribers_.insert(&webSocket);
+                }
+                result = {{"eventtime", eventTime()}, {"status", buildFullStatus(snapshot())}};
+                return true;
+            }
+            if (method == "printer.print.start")
+            {
+                std::string fileName = params.is_object() ? params.value("filename", "sim.gcode") : "sim.gcode";
+                result = "ok";
+                return startPrint(fileName) || rpcError(RPC_INVALID_STATE, "Printer is busy");
+            }
+            if (method == "printer.print.pause")
+            {
+                result = "ok";
+                return pausePrint() || rpcError(RPC_INVALID_STATE, "Print is not running");
+            }
+            if (method == "printer.print.resume")
+            {
+                result = "ok";
+                return resumePrint() || rpcError(RPC_INVALID_STATE, "Print is not paused");
+            }
+            if (method == "printer.print.cancel")
+            {
+                result = "ok";
+                return stopPrint() || rpcError(RPC_INVALID_STATE, "No active print");
+            }
+            if (method == "server.database.post_item" || method == "server.database.get_item")
+            {
+                std::string key = params.is_object() ? params.value("key", "") : "";
+                if (key == "general.instanceName" && params.contains("value") && params["value"].is_string())
+                {
+                    setName(params["value"].get<std::string>());
+                }
+                result = {{"namespace", params.is_object() ? params.value("namespace", "") : ""},
+                          {"key", key},
+                          {"value", nlohmann::json::object()}};
+                return true;
+            }
+            if (method == "server.info")
+            {
+                result = {{"klippy_connected", true}, {"klippy_state", "ready"}, {"moonraker_version", "v0.9.3-sim"}};
+                return true;
+            }
+            return rpcError(RPC_METHOD_NOT_FOUND, "Method not found");
+        }
+
+        void MoonrakerSimulatedPrinter::publishStatus(const PrinterSnapshot &snapshot)
+        {
+            if (!server_)
+            {
+                return;
+            }
+
+            std::vector<std::shared_ptr<ix::WebSocket>> targets;
+            nlohmann::json delta;
+            {
+                std::lock_guard<std::mutex> lock(subscribersMutex_);
+                delta = buildStatusDelta(lastPublished_, snapshot);
+                lastPublished_ = snapshot;
+                if (subscribers_.empty())
+                {
+                    return;
+                }
+                for (const auto &client : server_->getClients())
+                {
+                    if (subscribers_.count(client.get()) > 0)
+                    {
+                        targets.push_back(client);
+                    }
+                }
+            }
+            if (targets.empty() || delta.empty())
+            {
+                return;
+            }
+
+            nlohmann::json notification;
+            notification["jsonrpc"] = "2.0";
+            notification["method"] = "notify_status_update";
+            notification["params"] = {delta, eventTime()};
+            std::string body = notification.dump();
+            for (auto &client : targets)
+            {
+                deliver([client, body]()
+                        { client->sendText(body); });
+            }
+        }
+
+        // ========== Status rendering ==========
+
+        nlohmann::json MoonrakerSimulatedPrinter::buildSystemInfo() const
+        {
+            nlohmann::json ipAddress = {{"family", "ipv4"}, {"address", address_}, {"is_link_local", false}};
+            nlohmann::json wlan0 = {{"mac_address", serialNumber_}, {"ip_addresses", nlohmann::json::array({ipAddress})}};
+            return {
+                {"cpu_info", {{"cpu_count", 4}, {"processor", "aarch64"}, {"model", "Simulated"}}},
+                {"distribution", {{"name", "Simulated Klipper Host"}, {"id", "sim"}}},
+                {"product_info", {{"machine_type", "Generic Klipper"}, {"device_name", name()}}},
+                {"network", {{"wlan0", wlan0}}}};
+        }
+
+        nlohmann::json MoonrakerSimulatedPrinter::buildFullStatus(const PrinterSnapshot &s) const
+        {
+            return {
+                {"gcode_move", {{"speed_factor", 1.0}, {"speed", 6000.0}, {"extrude_factor", 1.0}, {"absolute_coordinates", true}, {"position", position(s)}, {"gcode_position", position(s)}}},
+                {"toolhead", {{"homed_axes", "xyz"}, {"print_time", s.printDurationSec}, {"position", position(s)}, {"max_velocity", 500.0}, {"max_accel", 10000.0}}},
+                {"display_status", {{"progress", round2(s.progress())}, {"message", nullptr}}},
+                {"idle_timeout", {{"state", s.phase == PrintPhase::PRINTING ? "Printing" : "Ready"}, {"printing_time", s.printDurationSec}}},
+                {"print_stats", {{"filename", s.fileName}, {"total_duration", s.printDurationSec}, {"print_duration", s.printDurationSec}, {"filament_used", round2(s.e)}, {"state", printStatsState(s.phase)}, {"message", ""}, {"info", {{"total_layer", s.totalLayer}, {"current_layer", s.currentLayer}}}}},
+                {"heater_bed", {{"temperature", round2(s.bedTemp)}, {"target", s.bedTarget}, {"power", s.bedTarget > 0 ? 0.4 : 0.0}}},
+                {"pause_resume", {{"is_paused", s.phase == PrintPhase::PAUSED}}},
+                {"extruder", {{"temperature", round2(s.nozzleTemp)}, {"target", s.nozzleTarget}, {"power", s.nozzleTarget > 0 ? 0.5 : 0.0}, {"can_extrude", s.nozzleTemp > 170.0}}}};
+        }
+
+        nlohmann::json MoonrakerSimulatedPrinter::buildStatusDelta(const PrinterSnapshot &p, const PrinterSnapshot &s) const
+        {
+            nlohmann::json delta = nlohmann::json::object();
+            if (p.x != s.x || p.y != s.y || p.z != s.z || p.e != s.e)
+            {
+                delta["gcode_move"] = {{"position", position(s)}, {"gcode_position", position(s)}};
+                delta["toolhead"] = {{"position", position(s)}, {"print_time", s.printDurationSec}};
+            }
+            if (round2(p.progress()) != round2(s.progress()))
+            {
+                delta["display_status"] = {{"progress", round2(s.progress())}};
+            }
+            if (p.phase != s.phase)
+            {
+                delta["print_stats"]["state"] = printStatsState(s.phase);
+                delta["pause_resume"] = {{"is_paused", s.phase == PrintPhase::PAUSED}};
+                delta["idle_timeout"] = {{"state", s.phase == PrintPhase::PRINTING ? "Printing" : "Ready"}};
+            }
+            if (p.fileName != s.fileName)
+            {
+                delta["print_stats"]["filename"] = s.fileName;
+                delta["print_stats"]["info"] = {{"total_layer", s.totalLayer}};
+            }
+            if (p.printDurationSec != s.printDurationSec)
+            {
+                delta["print_stats"]["print_duration"] = s.printDurationSec;
+                delta["print_stats"]["total_duration"] = s.printDurationSec;
+                delta["print_stats"]["filament_used"] = round2(s.e);
+            }
+            if (p.currentLayer != s.currentLayer)
+            {
+                delta["print_stats"]["info"]["current_layer"] = s.currentLayer;
+            }
+            if (round2(p.nozzleTemp) != round2(s.nozzleTemp) || p.nozzleTarget != s.nozzleTarget)
+            {
+                delta["extruder"] = {{"temperature", round2(s.nozzleTemp)}, {"target", s.nozzleTarget}};
+            }
+            if (round2(p.bedTemp) != round2(s.bedTemp) || p.bedTarget != s.bedTarget)
+            {
+                delta["heater_bed"] = {{"temperature", round2(s.bedTemp)}, {"target", s.bedTarget}};
+            }
+            return delta;
+        }
+
+        // ========== HTTP ==========
+
+        ix::HttpResponsePtr MoonrakerSimulatedPrinter::handleHttpRequest(ix::HttpRequestPtr request)
+        {
+            countReceived();
+            std::map<std::string, std::string> query;
+            std::string path = splitUri(request->uri, query);
+
+            if (request->method == "GET" && path == "/access/oneshot_token")
+            {
+                return makeJsonResponse(200, {{"result", CryptoUtils::generateUUID()}});
+            }
+
+            if (request->method == "POST" && path == "/api/files/local")
+            {
+                auto contentType = request->headers.find("Content-Type");
+                auto fields = parseMultipart(contentType != request->headers.end() ? contentType->second : "", request->body);
+                const auto *file = findField(fields, "file");
+                if (!file)
+                {
+                    return makeJsonResponse(400, {{"error", "No file field in request"}});
+                }
+                storeUploadChunk(file->fileName, 0, file->content);
+
+                const auto *print = findField(fields, "print");
+                bool printStarted = print && print->content == "true" && startPrint(file->fileName);
+                return makeJsonResponse(201, {{"files", {{"local", {{"name", file->fileName}, {"origin", "local"}}}}},
+                                              {"done", true},
+                                              {"print_started", printStarted}});
+            }
+
+            if (request->method == "GET" && path.compare(0, 20, "/server/files/gcodes") == 0)
+            {
+                return makeBinaryResponse(downloadContent());
+            }
+
+            if (request->method == "GET" && path == "/server/info")
+            {
+                return makeJsonResponse(200, {{"result", {{"klippy_connected", true}, {"klippy_state", "ready"}}}});
+            }
+
+            return makeNotFoundResponse();
+        }
+    } // namespace simulator
+} // namespace elink
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "simulated_printer.h"
+#include <ixwebsocket/IXHttpServer.h>
+#include <nlohmann/json.hpp>
+#include <memory>
+#include <mutex>
+#include <set>
+
+namespace elink
+{
+    namespace simulator
+    {
+        /**
+         * Simulated Klipper printer behind Moonraker
+         *
+         * One server on <address>:moonrakerPort answers the HTTP file API
+         * (/access/oneshot_token, /api/files/local, /server/files/gcodes) and
+         * upgrades /websocket to JSON-RPC. Clients that call
+         * printer.objects.subscribe receive notify_status_update deltas.
+         */
+        class MoonrakerSimulatedPrinter : public SimulatedPrinter
+        {
+        public:
+            MoonrakerSimulatedPrinter(const SimulatorConfig &config, LinkEmulator &link, const std::string &address, int index);
+            ~MoonrakerSimulatedPrinter() override;
+
+            const char *protocolName() const override { return "Moonraker"; }
+            bool start() override;
+            void stop() override;
+
+            // Moonraker has no UDP discovery, printers are added by address
+            std::string discoveryReply(int, const std::string &) const override { return ""; }
+
+        protected:
+            void publishStatus(const PrinterSnapshot &snapshot) override;
+
+        private:
+            void handleMessage(ix::WebSocket &webSocket, const std::string &message);
+            /**
+             * Run a JSON-RPC method
+             * @param result Receives the result, or the error object when false is returned
+             * @return true on success
+             */
+            bool handleMethod(ix::WebSocket &webSocket, const std::string &method,
+                              const nlohmann::json &params, nlohmann::json &result);
+            std::shared_ptr<ix::WebSocket> findClient(const ix::WebSocket &webSocket) const;
+
+            ix::HttpResponsePtr handleHttpRequest(ix::HttpRequestPtr request);
+
+            nlohmann::json buildSystemInfo() const;
+            nlohmann::json buildFullStatus(const PrinterSnapshot &snapshot) const;
+            nlohmann::json buildStatusDelta(const PrinterSnapshot &previous, const PrinterSnapshot &current) const;
+            double eventTime() const;
+
+            std::unique_ptr<ix::HttpServer> server_;
+
+            std::mutex subscribersMutex_;
+            std::set<const ix::WebSocket *> subscribers_;
+            PrinterSnapshot lastPublished_;
+        };
+    } // namespace simulator
+} // namespace elink
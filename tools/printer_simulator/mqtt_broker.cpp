@@ -0,0 +1,585 @@
+#include "mqtt_broker.h"
+#include "utils/logger.h"
+#include <algorithm>
+#include <chrono>
+
+namespace elink
+{
+    namespace simulator
+    {
+        namespace
+        {
+            // MQTT control packet types (upper nibble of the fixed header)
+            constexpr uint8_t CONNECT = 0x10;
+            constexpr uint8_t CONNACK = 0x20;
+            constexpr uint8_t PUBLISH = 0x30;
+            constexpr uint8_t PUBACK = 0x40;
+            constexpr uint8_t PUBREC = 0x50;
+            constexpr uint8_t PUBREL = 0x60;
+            constexpr uint8_t PUBCOMP = 0x70;
+            constexpr uint8_t SUBSCRIBE = 0x80;
+            constexpr uint8_t SUBACK = 0x90;
+            constexpr uint8_t UNSUBSCRIBE = 0xA0;
+            constexpr uint8_t UNSUBACK = 0xB0;
+            constexpr uint8_t PINGREQ = 0xC0;
+            constexpr uint8_t PINGRESP = 0xD0;
+            constexpr uint8_t DISCONNECT = 0xE0;
+
+            // CONNACK return codes
+            constexpr uint8_t CONNACK_ACCEPTED = 0x00;
+            constexpr uint8_t CONNACK_BAD_PROTOCOL = 0x01;
+            constexpr uint8_t CONNACK_BAD_CREDENTIALS = 0x04;
+
+            constexpr size_t MAX_PACKET_SIZE = 16 * 1024 * 1024;
+            constexpr int CONNECT_TIMEOUT_MS = 10000;
+
+            std::string encodeLength(size_t length)
+            {
+                std::string result;
+                do
+                {
+                    uint8_t byte = length % 128;
+                    length /= 128;
+                    if (length > 0)
+                    {
+                        byte |= 0x80;
+                    }
+                    result += static_cast<char>(byte);
+                } while (length > 0);
+                return result;
+            }
+
+            std::string encodeString(const std::string &value)
+            {
+                std::string result;
+                result += static_cast<char>((value.size() >> 8) & 0xFF);
+                result += static_cast<char>(value.size() & 0xFF);
+                result += value;
+                return result;
+            }
+
+            std::string encodeUint16(uint16_t value)
+            {
+                std::string result;
+                result += static_cast<char>((value >> 8) & 0xFF);
+                result += static_cast<char>(value & 0xFF);
+                return result;
+            }
+
+            /**
+             * Sequential reader over a packet body
+             */
+            class PacketReader
+            {
+            public:
+                explicit PacketReader(const std::string &body) : body_(body) {}
+
+                bool readByte(uint8_t &value)
+                {
+                    if (pos_ + 1 > body_.size())
+                    {
+                        return false;
+                    }
+                    value = static_cast<uint8_t>(body_[pos_++]);
+                    return true;
+                }
+
+                bool readUint16(uint16_t &value)
+                {
+                    if (pos_ + 2 > body_.size())
+                    {
+                        return false;
+                    }
+                    value = static_cast<uint16_t>((static_cast<uint8_t>(body_[pos_]) << 8) |
+                                                  static_cast<uint8_t>(body_[pos_ + 1]));
+                    pos_ += 2;
+                    return true;
+                }
+
+                bool readString(std::string &value)
+                {
+                    uint16_t length = 0;
+                    if (!readUint16(length) || pos_ + length > body_.size())
+                    {
+                        return false;
+                    }
+                    value = body_.substr(pos_, length);
+                    pos_ += length;
+                    return true;
+                }
+
+                std::string remaining() const { return body_.substr(pos_); }
+                bool atEnd() const { return pos_ >= body_.size(); }
+
+            private:
+                const std::string &body_;
+                size_t pos_ = 0;
+            };
+
+            bool readPacket(socket_t sock, uint8_t &header, std::string &body)
+            {
+                char byte = 0;
+                if (!recvAll(sock, &byte, 1))
+                {
+                    return false;
+                }
+                header = static_cast<uint8_t>(byte);
+
+                size_t length = 0;
+                size_t multiplier = 1;
+                for (int i = 0; i < 4; ++i)
+                {
+                    if (!recvAll(sock, &byte, 1))
+                    {
+                        return false;
+                    }
+                    length += (static_cast<uint8_t>(byte) & 0x7F) * multiplier;
+                    if ((static_cast<uint8_t>(byte) & 0x80) == 0)
+                    {
+                        break;
+                    }
+                    multiplier *= 128;
+                    if (i == 3)
+                    {
+                        return false; // Malformed remaining length
+                    }
+                }
+
+                if (length > MAX_PACKET_SIZE)
+                {
+                    return false;
+                }
+                body.resize(length);
+                return length == 0 || recvAll(sock, &body[0], length);
+            }
+        } // namespace
+
+        MqttBroker::MqttBroker(const std::string &address, int port, const std::string &password)
+            : address_(address), port_(port), password_(password)
+        {
+        }
+
+        MqttBroker::~MqttBroker()
+        {
+            stop();
+        }
+
+        bool MqttBroker::start()
+        {
+            listenSocket_ = socket(AF_INET, SOCK_STREAM, 0);
+            if (listenSocket_ == INVALID_SOCKET)
+            {
+                ELEGOO_LOG_ERROR("[{}] Failed to create MQTT socket", address_);
+                return false;
+            }
+            setReuseAddress(listenSocket_);
+
+            auto addr = makeAddress(address_, port_);
+            if (bind(listenSocket_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == SOCKET_ERROR ||
+                listen(listenSocket_, 16) == SOCKET_ERROR)
+            {
+                ELEGOO_LOG_ERROR("[{}] Failed to listen on MQTT port {}", address_, port_);
+                closeSocket(listenSocket_);
+                listenSocket_ = INVALID_SOCKET;
+                return false;
+            }
+
+            running_ = true;
+            acceptThread_ = std::thread(&MqttBroker::acceptLoop, this);
+            return true;
+        }
+
+        void MqttBroker::stop()
+        {
+            if (!running_.exchange(false))
+            {
+                return;
+            }
+
+            shutdownSocket(listenSocket_);
+            closeSocket(listenSocket_);
+            listenSocket_ = INVALID_SOCKET;
+            if (acceptThread_.joinable())
+            {
+                acceptThread_.join();
+            }
+
+            std::vector<std::shared_ptr<Session>> sessions;
+            {
+                std::lock_guard<std::mutex> lock(sessionsMutex_);
+                sessions.swap(sessions_);
+            }
+            for (auto &session : sessions)
+            {
+                std::lock_guard<std::mutex> lock(session->mutex);
+                shutdownSocket(session->sock);
+            }
+            for (auto &session : sessions)
+            {
+                if (session->thread.joinable())
+                {
+                    session->thread.join();
+                }
+            }
+        }
+
+        size_t MqttBroker::clientCount() const
+        {
+            std::lock_guard<std::mutex> lock(sessionsMutex_);
+            return static_cast<size_t>(std::count_if(sessions_.begin(), sessions_.end(),
+                                                     [](const std::shared_ptr<Session> &s)
+                                                     { return !s->finished; }));
+        }
+
+        bool MqttBroker::isClientConnected(const std::string &clientId) const
+        {
+            std::lock_guard<std::mutex> lock(sessionsMutex_);
+            return std::any_of(sessions_.begin(), sessions_.end(),
+                               [&clientId](const std::shared_ptr<Session> &s)
+                               {
+                                   std::lock_guard<std::mutex> sessionLock(s->mutex);
+                                   return !s->finished && s->clientId == clientId;
+                               });
+        }
+
+        void MqttBroker::acceptLoop()
+        {
+            while (running_)
+            {
+                sockaddr_in clientAddr{};
+                socklen_t addrLen = sizeof(clientAddr);
+                socket_t clientSocket = accept(listenSocket_, reinterpret_cast<sockaddr *>(&clientAddr), &addrLen);
+                if (clientSocket == INVALID_SOCKET)
+                {
+                    if (!running_)
+                    {
+                        break;
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                    continue;
+                }
+
+                int noDelay = 1;
+                setsockopt(clientSocket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char *>(&noDelay), sizeof(noDelay));
+
+                reapFinishedSessions();
+
+                auto session = std::make_shared<Session>();
+                session->sock = clientSocket;
+                {
+                    std::lock_guard<std::mutex> lock(sessionsMutex_);
+                    sessions_.push_back(session);
+                }
+                session->thread = std::thread(&MqttBroker::sessionLoop, this, session);
+            }
+        }
+
+        void MqttBroker::reapFinishedSessions()
+        {
+            std::vector<std::shared_ptr<Session>> finished;
+            {
+                std::lock_guard<std::mutex> lock(sessionsMutex_);
+                auto it = std::partition(sessions_.begin(), sessions_.end(),
+                                         [](const std::shared_ptr<Session> &s)
+                                         { return !s->finished; });
+                finished.assign(it, sessions_.end());
+                sessions_.erase(it, sessions_.end());
+            }
+            for (auto &session : finished)
+            {
+                if (session->thread.joinable())
+                {
+                    session->thread.join();
+                }
+            }
+        }
+
+        void MqttBroker::sessionLoop(std::shared_ptr<Session> session)
+        {
+            setReceiveTimeout(session->sock, CONNECT_TIMEOUT_MS);
+
+            uint8_t header = 0;
+            std::string body;
+            bool connected = false;
+            while (running_ && readPacket(session->sock, header, body))
+            {
+                uint8_t type = header & 0xF0;
+                if (!connected)
+                {
+                    // The first packet must be CONNECT
+                    if (type != CONNECT || !handleConnect(*session, body))
+                    {
+                        break;
+                    }
+                    connected = true;
+                    continue;
+                }
+
+                switch (type)
+                {
+                case PUBLISH:
+                    handlePublish(*session, header, body);
+                    break;
+                case PUBREL:
+                    // QoS 2 release, complete the flow with the same packet id
+                    sendPacket(*session, PUBCOMP, body.substr(0, 2));
+                    break;
+                case PUBACK:
+                case PUBREC:
+                case PUBCOMP:
+                    // Broker only delivers at QoS 0, nothing to track
+                    break;
+                case SUBSCRIBE:
+                    handleSubscribe(*session, body);
+                    break;
+                case UNSUBSCRIBE:
+                    handleUnsubscribe(*session, body);
+                    break;
+                case PINGREQ:
+                    sendPacket(*session, PINGRESP, "");
+                    break;
+                case DISCONNECT:
+                    shutdownSocket(session->sock);
+                    break;
+                default:
+                    ELEGOO_LOG_WARN("[{}] Unsupported MQTT packet type 0x{:02x} from {}", address_, type, session->clientId);
+                    shutdownSocket(session->sock);
+                    break;
+                }
+            }
+
+            if (connected)
+            {
+                ELEGOO_LOG_DEBUG("[{}] MQTT client disconnected: {}", address_, session->clientId);
+            }
+            {
+                std::lock_guard<std::mutex> lock(session->mutex);
+                closeSocket(session->sock);
+                session->sock = INVALID_SOCKET;
+            }
+            session->finished = true;
+        }
+
+        bool MqttBroker::handleConnect(Session &session, const std::string &body)
+        {
+            PacketReader reader(body);
+            std::string protocolName;
+            uint8_t level = 0;
+            uint8_t flags = 0;
+            uint16_t keepAlive = 0;
+            std::string clientId;
+            if (!reader.readString(protocolName) || !reader.readByte(level) ||
+                !reader.readByte(flags) || !reader.readUint16(keepAlive) ||
+                !reader.readString(clientId))
+            {
+                return false;
+            }
+            {
+                std::lock_guard<std::mutex> lock(session.mutex);
+                session.clientId = clientId;
+            }
+
+            // MQTT 3.1.1 ("MQTT", level 4) and 3.1 ("MQIsdp", level 3)
+            bool protocolOk = (protocolName == "MQTT" && level == 4) || (protocolName == "MQIsdp" && level == 3);
+            if (!protocolOk)
+            {
+                sendPacket(session, CONNACK, std::string("\x00", 1) + static_cast<char>(CONNACK_BAD_PROTOCOL));
+                return false;
+            }
+
+            std::string willTopic;
+            std::string willMessage;
+            std::string username;
+            std::string password;
+            if ((flags & 0x04) && (!reader.readString(willTopic) || !reader.readString(willMessage)))
+            {
+                return false;
+            }
+            if ((flags & 0x80) && !reader.readString(username))
+            {
+                return false;
+            }
+            if ((flags & 0x40) && !reader.readString(password))
+            {
+                return false;
+            }
+
+            if (!password_.empty() && password != password_)
+            {
+                ELEGOO_LOG_WARN("[{}] MQTT client {} rejected: bad credentials", address_, session.clientId);
+                sendPacket(session, CONNACK, std::string("\x00", 1) + static_cast<char>(CONNACK_BAD_CREDENTIALS));
+                return false;
+            }
+
+            // Drop the connection after 1.5x keep alive without any packet, as the spec requires
+            setReceiveTimeout(session.sock, keepAlive > 0 ? keepAlive * 1500 : 0);
+            ELEGOO_LOG_DEBUG("[{}] MQTT client connected: {}", address_, session.clientId);
+            return sendPacket(session, CONNACK, std::string("\x00", 1) + static_cast<char>(CONNACK_ACCEPTED));
+        }
+
+        void MqttBroker::handleSubscribe(Session &session, const std::string &body)
+        {
+            PacketReader reader(body);
+            uint16_t packetId = 0;
+            if (!reader.readUint16(packetId))
+            {
+                return;
+            }
+
+            std::string granted;
+            std::string filter;
+            uint8_t qos = 0;
+            while (!reader.atEnd() && reader.readString(filter) && reader.readByte(qos))
+            {
+                {
+                    std::lock_guard<std::mutex> lock(session.mutex);
+                    if (std::find(session.filters.begin(), session.filters.end(), filter) == session.filters.end())
+                    {
+                        session.filters.push_back(filter);
+                    }
+                }
+                granted += static_cast<char>(0x00);
+            }
+            sendPacket(session, SUBACK, encodeUint16(packetId) + granted);
+        }
+
+        void MqttBroker::handleUnsubscribe(Session &session, const std::string &body)
+        {
+            PacketReader reader(body);
+            uint16_t packetId = 0;
+            if (!reader.readUint16(packetId))
+            {
+                return;
+            }
+
+            std::string filter;
+            while (!reader.atEnd() && reader.readString(filter))
+            {
+                std::lock_guard<std::mutex> lock(session.mutex);
+                session.filters.erase(std::remove(session.filters.begin(), session.filters.end(), filter),
+                                      session.filters.end());
+            }
+            sendPacket(session, UNSUBACK, encodeUint16(packetId));
+        }
+
+        void MqttBroker::handlePublish(Session &session, uint8_t header, const std::string &body)
+        {
+            PacketReader reader(body);
+            std::string topic;
+            if (!reader.readString(topic))
+            {
+                return;
+            }
+
+            int qos = (header >> 1) & 0x03;
+            uint16_t packetId = 0;
+            if (qos > 0 && !reader.readUint16(packetId))
+            {
+                return;
+            }
+            std::string payload = reader.remaining();
+
+            if (qos == 1)
+            {
+                sendPacket(session, PUBACK, encodeUint16(packetId));
+            }
+            else if (qos == 2)
+            {
+                sendPacket(session, PUBREC, encodeUint16(packetId));
+            }
+
+            // Relay to other subscribers like a real broker, then hand it to the printer
+            publish(topic, payload);
+            if (messageHandler_)
+            {
+                messageHandler_(session.clientId, topic, payload);
+            }
+        }
+
+        size_t MqttBroker::publish(const std::string &topic, const std::string &payload)
+        {
+            std::vector<std::shared_ptr<Session>> sessions;
+            {
+                std::lock_guard<std::mutex> lock(sessionsMutex_);
+                sessions = sessions_;
+            }
+
+            const std::string packetBody = encodeString(topic) + payload;
+            size_t delivered = 0;
+            for (auto &session : sessions)
+            {
+                if (session->finished)
+                {
+                    continue;
+                }
+                bool subscribed = false;
+                {
+                    std::lock_guard<std::mutex> lock(session->mutex);
+                    subscribed = std::any_of(session->filters.begin(), session->filters.end(),
+                                             [&topic](const std::string &filter)
+                                             { return topicMatches(filter, topic); });
+                }
+                if (subscribed && sendPacket(*session, PUBLISH, packetBody))
+                {
+                    delivered++;
+                }
+            }
+            return delivered;
+        }
+
+        bool MqttBroker::sendPacket(Session &session, uint8_t header, const std::string &body)
+        {
+            std::string packet;
+            packet.reserve(body.size() + 5);
+            packet += static_cast<char>(header);
+            packet += encodeLength(body.size());
+            packet += body;
+
+            std::lock_guard<std::mutex> lock(session.mutex);
+            if (session.sock == INVALID_SOCKET)
+            {
+                return false;
+            }
+            return sendAll(session.sock, packet.data(), packet.size());
+        }
+
+        bool MqttBroker::topicMatches(const std::string &filter, const std::string &topic)
+        {
+            size_t f = 0;
+            size_t t = 0;
+            while (f < filter.size())
+            {
+                auto fEnd = filter.find('/', f);
+                std::string level = filter.substr(f, fEnd == std::string::npos ? std::string::npos : fEnd - f);
+                if (level == "#")
+                {
+                    return true;
+                }
+                if (t > topic.size())
+                {
+                    return false;
+                }
+
+                auto tEnd = topic.find('/', t);
+                std::string topicLevel = topic.substr(t, tEnd == std::string::npos ? std::string::npos : tEnd - t);
+                if (level != "+" && level != topicLevel)
+                {
+                    return false;
+                }
+
+                if (fEnd == std::string::npos)
+                {
+                    return tEnd == std::string::npos;
+                }
+                if (tEnd == std::string::npos)
+                {
+                    // "a/#" also matches "a"
+                    return filter.compare(fEnd + 1, std::string::npos, "#") == 0;
+                }
+                f = fEnd + 1;
+                t = tEnd + 1;
+            }
+            return false;
+        }
+    } // namespace simulator
+} // namespace elink
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "socket_compat.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace elink
+{
+    namespace simulator
+    {
+        /**
+         * Minimal MQTT 3.1 / 3.1.1 broker embedded in a simulated CC2 printer
+         *
+         * Supports what the CC2 firmware broker is used for: CONNECT with
+         * username/password, SUBSCRIBE/UNSUBSCRIBE with '+' and '#' filters,
+         * PUBLISH at QoS 0-2 from clients, PINGREQ and DISCONNECT. Messages are
+         * delivered to subscribers at QoS 0. Retained messages, wills and
+         * persistent sessions are not implemented.
+         */
+        class MqttBroker
+        {
+        public:
+            /**
+             * Called for every PUBLISH received from a client
+             * Parameters: client id, topic, payload
+             */
+            using MessageHandler = std::function<void(const std::string &, const std::string &, const std::string &)>;
+
+            MqttBroker(const std::string &address, int port, const std::string &password);
+            ~MqttBroker();
+
+            MqttBroker(const MqttBroker &) = delete;
+            MqttBroker &operator=(const MqttBroker &) = delete;
+
+            /**
+             * Bind and start accepting clients
+             * @return true if the listening socket is up
+             */
+            bool start();
+
+            /**
+             * Disconnect every client and close the listening socket
+             */
+            void stop();
+
+            void setMessageHandler(MessageHandler handler) { messageHandler_ = std::move(handler); }
+
+            /**
+             * Publish a message to every client subscribed to a matching filter
+             * @return Number of clients the message was written to
+             */
+            size_t publish(const std::string &topic, const std::string &payload);
+
+            /**
+             * Number of connected clients
+             */
+            size_t clientCount() const;
+
+            /**
+             * Whether a client with this MQTT client id is currently connected
+             */
+            bool isClientConnected(const std::string &clientId) const;
+
+            /**
+             * Check an MQTT topic filter against a topic name
+             */
+            static bool topicMatches(const std::string &filter, const std::string &topic);
+
+        private:
+            struct Session
+            {
+                socket_t sock = INVALID_SOCKET;
+                std::string clientId;
+                std::vector<std::string> filters;
+                std::mutex mutex; // Guards filters and socket writes
+                std::atomic<bool> finished{false};
+                std::thread thread;
+            };
+
+            void acceptLoop();
+            void sessionLoop(std::shared_ptr<Session> session);
+            bool handleConnect(Session &session, const std::string &body);
+            void handleSubscribe(Session &session, const std::string &body);
+            void handleUnsubscribe(Session &session, const std::string &body);
+            void handlePublish(Session &session, uint8_t header, const std::string &body);
+            bool sendPacket(Session &session, uint8_t header, const std::string &body);
+            void reapFinishedSessions();
+
+            const std::string address_;
+            const int port_;
+            const std::string password_;
+            MessageHandler messageHandler_;
+
+            socket_t listenSocket_ = INVALID_SOCKET;
+            std::atomic<bool> running_{false};
+            std::thread acceptThread_;
+
+            mutable std::mutex sessionsMutex_;
+            std::vector<std::shared_ptr<Session>> sessions_;
+        };
+    } // namespace simulator
+} // namespace elink
@@ -0,0 +1,225 @@
+#include "simulated_printer.h"
+#include "utils/logger.h"
+#include "utils/utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+
+namespace elink
+{
+    namespace simulator
+    {
+        namespace
+        {
+            // Move a temperature towards its target with a first order response plus sensor noise
+            double approach(double current, double target, double dtSeconds, double noise)
+            {
+                double ambient = 25.0;
+                double goal = target > 0.0 ? target : ambient;
+                double factor = std::min(1.0, dtSeconds * 0.2);
+                return current + (goal - current) * factor + noise;
+            }
+
+            // File names arrive from clients, never let them escape the upload directory
+            std::string sanitizeFileName(const std::string &fileName)
+            {
+                std::string result = fileName;
+                auto pos = result.find_last_of("/\\");
+                if (pos != std::string::npos)
+                {
+                    result = result.substr(pos + 1);
+                }
+                if (result.empty() || result == "." || result == "..")
+                {
+                    result = "upload.gcode";
+                }
+                return result;
+            }
+        } // namespace
+
+        SimulatedPrinter::SimulatedPrinter(const SimulatorConfig &config, LinkEmulator &link, const std::string &address, int index)
+            : config_(config), link_(link), address_(address), index_(index), rng_(static_cast<unsigned>(index) * 7919u + 17u)
+        {
+            name_ = "Sim-" + std::to_string(index + 1);
+            if (config_.startPrinting)
+            {
+                startPrint("sim_benchy_" + std::to_string(index + 1) + ".gcode");
+                // Spread the fleet over the job so the printers do not all finish at the same time
+                std::lock_guard<std::mutex> lock(stateMutex_);
+                std::uniform_real_distribution<double> dist(0.0, 0.9);
+                state_.printDurationSec = dist(rng_) * state_.totalDurationSec;
+                state_.nozzleTemp = state_.nozzleTarget;
+                state_.bedTemp = state_.bedTarget;
+            }
+        }
+
+        std::string SimulatedPrinter::name() const
+        {
+            std::lock_guard<std::mutex> lock(stateMutex_);
+            return name_;
+        }
+
+        void SimulatedPrinter::setName(const std::string &name)
+        {
+            std::lock_guard<std::mutex> lock(stateMutex_);
+            name_ = name;
+        }
+
+        PrinterSnapshot SimulatedPrinter::snapshot() const
+        {
+            std::lock_guard<std::mutex> lock(stateMutex_);
+            return state_;
+        }
+
+        void SimulatedPrinter::tick(double dtSeconds)
+        {
+            PrinterSnapshot current;
+            {
+                std::lock_guard<std::mutex> lock(stateMutex_);
+                std::normal_distribution<double> noise(0.0, 0.15);
+
+                state_.nozzleTemp = approach(state_.nozzleTemp, state_.nozzleTarget, dtSeconds, noise(rng_));
+                state_.bedTemp = approach(state_.bedTemp, state_.bedTarget, dtSeconds, noise(rng_) * 0.5);
+                state_.chamberTemp = approach(state_.chamberTemp, state_.bedTarget > 0.0 ? 32.0 : 0.0, dtSeconds * 0.1, noise(rng_) * 0.1);
+
+                if (state_.phase == PrintPhase::PRINTING)
+                {
+                    state_.printDurationSec = std::min<double>(state_.printDurationSec + dtSeconds, state_.totalDurationSec);
+                    state_.currentLayer = std::max(1, static_cast<int>(state_.progress() * state_.totalLayer));
+                    state_.z = 0.2 * state_.currentLayer;
+
+                    // Trace a circle on the bed so position updates change every tick
+                    double angle = state_.printDurationSec * 0.5;
+                    state_.x = 110.0 + 40.0 * std::cos(angle);
+                    state_.y = 110.0 + 40.0 * std::sin(angle);
+                    state_.e += 0.8 * dtSeconds;
+
+                    if (state_.printDurationSec >= state_.totalDurationSec)
+                    {
+                        state_.phase = PrintPhase::COMPLETED;
+                        state_.nozzleTarget = 0.0;
+                        state_.bedTarget = 0.0;
+                        state_.fanSpeed = 0;
+                        ELEGOO_LOG_INFO("[{}] {} finished printing {}", address_, protocolName(), state_.fileName);
+                    }
+                }
+                current = state_;
+            }
+            publishStatus(current);
+        }
+
+        bool SimulatedPrinter::startPrint(const std::string &fileName)
+        {
+            std::lock_guard<std::mutex> lock(stateMutex_);
+            if (state_.phase == PrintPhase::PRINTING || state_.phase == PrintPhase::PAUSED)
+            {
+                return false;
+            }
+            state_.phase = PrintPhase::PRINTING;
+            state_.fileName = fileName;
+            state_.taskId = CryptoUtils::generateUUID();
+            state_.printDurationSec = 0.0;
+            state_.totalDurationSec = std::max(1, config_.printDurationSec);
+            state_.totalLayer = 250;
+            state_.currentLayer = 0;
+            state_.e = 0.0;
+            state_.nozzleTarget = 210.0;
+            state_.bedTarget = 60.0;
+            state_.fanSpeed = 255;
+            return true;
+        }
+
+        bool SimulatedPrinter::pausePrint()
+        {
+            std::lock_guard<std::mutex> lock(stateMutex_);
+            if (state_.phase != PrintPhase::PRINTING)
+            {
+                return false;
+            }
+            state_.phase = PrintPhase::PAUSED;
+            return true;
+        }
+
+        bool SimulatedPrinter::resumePrint()
+        {
+            std::lock_guard<std::mutex> lock(stateMutex_);
+            if (state_.phase != PrintPhase::PAUSED)
+            {
+                return false;
+            }
+            state_.phase = PrintPhase::PRINTING;
+            return true;
+        }
+
+        bool SimulatedPrinter::stopPrint()
+        {
+            std::lock_guard<std::mutex> lock(stateMutex_);
+            if (state_.phase != PrintPhase::PRINTING && state_.phase != PrintPhase::PAUSED)
+            {
+                return false;
+            }
+            state_.phase = PrintPhase::STOPPED;
+            state_.nozzleTarget = 0.0;
+            state_.bedTarget = 0.0;
+            state_.fanSpeed = 0;
+            return true;
+        }
+
+        void SimulatedPrinter::storeUploadChunk(const std::string &fileName, uint64_t offset, const std::string &data)
+        {
+            bytesUploaded_ += data.size();
+            if (config_.uploadDir.empty())
+            {
+                return;
+            }
+
+            std::string path = config_.uploadDir + "/" + address_ + "_" + sanitizeFileName(fileName);
+            auto mode = std::ios::binary | std::ios::out;
+            mode |= offset == 0 ? std::ios::trunc : std::ios::in;
+            auto file = PathUtils::openOutputStream(path, mode);
+            if (!file.is_open())
+            {
+                ELEGOO_LOG_WARN("[{}] Failed to open upload file {}", address_, path);
+                return;
+            }
+            file.seekp(static_cast<std::streamoff>(offset));
+            file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        }
+
+        const std::string &SimulatedPrinter::downloadContent() const
+        {
+            // Built once and shared by every printer, downloads only measure transfer cost
+            static const std::string content = [size = config_.fileSizeBytes]()
+            {
+                static const std::string line = "G1 X110.000 Y110.000 E0.04000 ; simulated\n";
+                std::string data;
+                data.reserve(size);
+                while (data.size() + line.size() <= size)
+                {
+                    data += line;
+                }
+                data.append(size - data.size(), '\n');
+                return data;
+            }();
+            return content;
+        }
+
+        bool SimulatedPrinter::deliver(std::function<void()> send)
+        {
+            if (!link_.deliver(static_cast<uint64_t>(index_), std::move(send)))
+            {
+                return false;
+            }
+            messagesSent_++;
+            return true;
+        }
+
+        int64_t SimulatedPrinter::unixTimeSeconds() const
+        {
+            return std::chrono::duration_cast<std::chrono::seconds>(
+                       std::chrono::system_clock::now().time_since_epoch())
+                .count();
+        }
+    } // namespace simulator
+} // namespace elink
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "link_emulator.h"
+#include "simulator_config.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <string>
+
+namespace elink
+{
+    namespace simulator
+    {
+        /**
+         * Print job phase shared by all simulated protocols
+         */
+        enum class PrintPhase
+        {
+            IDLE,
+            PRINTING,
+            PAUSED,
+            STOPPED,
+            COMPLETED
+        };
+
+        /**
+         * Protocol independent snapshot of a simulated printer
+         */
+        struct PrinterSnapshot
+        {
+            PrintPhase phase = PrintPhase::IDLE;
+            double nozzleTemp = 25.0;
+            double nozzleTarget = 0.0;
+            double bedTemp = 25.0;
+            double bedTarget = 0.0;
+            double chamberTemp = 25.0;
+            double x = 0.0;
+            double y = 0.0;
+            double z = 0.0;
+            double e = 0.0;
+            int fanSpeed = 0; // 0 - 255
+            bool lightOn = true;
+            std::string fileName;
+            std::string taskId;
+            int currentLayer = 0;
+            int totalLayer = 0;
+            double printDurationSec = 0.0;
+            int totalDurationSec = 0;
+
+            double progress() const
+            {
+                return totalDurationSec > 0 ? printDurationSec / totalDurationSec : 0.0;
+            }
+        };
+
+        /**
+         * Base class of a simulated LAN printer
+         *
+         * Holds the print job model and advances it on every tick; subclasses
+         * expose the model over their printer protocol and push status to their
+         * connected clients from publishStatus().
+         */
+        class SimulatedPrinter
+        {
+        public:
+            SimulatedPrinter(const SimulatorConfig &config, LinkEmulator &link, const std::string &address, int index);
+            virtual ~SimulatedPrinter() = default;
+
+            SimulatedPrinter(const SimulatedPrinter &) = delete;
+            SimulatedPrinter &operator=(const SimulatedPrinter &) = delete;
+
+            /**
+             * Protocol name used in logs, e.g. "CC1"
+             */
+            virtual const char *protocolName() const = 0;
+
+            /**
+             * Bind the printer's listeners on its address
+             * @return true if every listener is up
+             */
+            virtual bool start() = 0;
+
+            /**
+             * Close all listeners and client connections
+             */
+            virtual void stop() = 0;
+
+            /**
+             * Build the reply to a UDP discovery probe
+             * @param port Local port the probe was received on
+             * @param probe Probe payload
+             * @return Reply payload, empty if the probe is not meant for this printer type
+             */
+            virtual std::string discoveryReply(int port, const std::string &probe) const = 0;
+
+            /**
+             * Advance the job model and push a status update to connected clients
+             * @param dtSeconds Time elapsed since the previous tick
+             */
+            void tick(double dtSeconds);
+
+            const std::string &address() const { return address_; }
+            const std::string &serialNumber() const { return serialNumber_; }
+            std::string name() const;
+
+            uint64_t messagesSent() const { return messagesSent_.load(); }
+            uint64_t messagesReceived() const { return messagesReceived_.load(); }
+            uint64_t bytesUploaded() const { return bytesUploaded_.load(); }
+
+        protected:
+            /**
+             * Push the current status to connected clients
+             */
+            virtual void publishStatus(const PrinterSnapshot &snapshot) = 0;
+
+            PrinterSnapshot snapshot() const;
+            void setName(const std::string &name);
+
+            bool startPrint(const std::string &fileName);
+            bool pausePrint();
+            bool resumePrint();
+            bool stopPrint();
+
+            /**
+             * Account an uploaded chunk and store it when an upload directory is configured
+             * @param fileName Target file name
+             * @param offset Offset of the chunk within the file
+             * @param data Chunk payload
+             */
+            void storeUploadChunk(const std::string &fileName, uint64_t offset, const std::string &data);
+
+            /**
+             * Synthetic G-code served for downloads, sized by --file-size
+             */
+            const std::string &downloadContent() const;
+
+            /**
+             * Send through the shared link emulator, in order with the printer's other messages, and count the message
+             */
+            bool deliver(std::function<void()> send);
+            void countReceived() { messagesReceived_++; }
+
+            int64_t unixTimeSeconds() const;
+
+            const SimulatorConfig &config_;
+            LinkEmulator &link_;
+            const std::string address_;
+            const int index_;
+            std::string serialNumber_;
+
+        private:
+            mutable std::mutex stateMutex_;
+            PrinterSnapshot state_;
+            std::string name_;
+            std::mt19937 rng_;
+
+            std::atomic<uint64_t> messagesSent_{0};
+            std::atomic<uint64_t> messagesReceived_{0};
+            std::atomic<uint64_t> bytesUploaded_{0};
+        };
+    } // namespace simulator
+} // namespace elink
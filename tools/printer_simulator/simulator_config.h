@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace elink
+{
+    namespace simulator
+    {
+        /**
+         * Network impairment applied to every message a simulated printer sends
+         */
+        struct NetworkProfile
+        {
+            int latencyMs = 0;     // Fixed one-way delay added before a message is sent
+            int jitterMs = 0;      // Random extra delay in [0, jitterMs]
+            double lossRate = 0.0; // Probability (0.0 - 1.0) that an outgoing message is dropped
+        };
+
+        /**
+         * Simulator configuration, filled from the command line
+         */
+        struct SimulatorConfig
+        {
+            // Number of simulated printers per protocol
+            int cc1Count = 0;
+            int cc2Count = 0;
+            int moonrakerCount = 0;
+
+            // First loopback alias; each printer takes the next address (127.0.1.1, 127.0.1.2, ...)
+            std::string baseAddress = "127.0.1.1";
+
+            // HTTP port used for file transfer (CC1 / CC2) and for Moonraker HTTP + WebSocket
+            int httpPort = 80;
+            int moonrakerPort = 80;
+
+            double statusRateHz = 1.0;              // Status push rate per printer
+            NetworkProfile network;                 // Latency / loss applied to outgoing messages
+            size_t fileSizeBytes = 8 * 1024 * 1024; // Size reported for (and served as) printer-side files
+            int printDurationSec = 1800;            // Simulated duration of a print job
+            bool startPrinting = false;             // Start every printer in the printing state
+
+            std::string accessCode = "123456"; // CC2 MQTT password / HTTP X-Token
+            int maxClientsPerPrinter = 4;      // CC2 registration limit before "too many clients"
+            bool enableDiscovery = true;       // Answer UDP discovery on ports 3000 / 52700
+            std::string uploadDir;             // Directory to store uploads in, empty discards them
+        };
+    } // namespace simulator
+} // namespace elink
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <string>
+
+#ifdef _WIN32
+#define _WINSOCK_DEPRECATED_NO_WARNINGS
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+typedef SOCKET socket_t;
+#else
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <errno.h>
+typedef int socket_t;
+#define INVALID_SOCKET -1
+#define SOCKET_ERROR -1
+#endif
+
+namespace elink
+{
+    namespace simulator
+    {
+        /**
+         * Close a socket handle on any platform
+         */
+        inline void closeSocket(socket_t sock)
+        {
+            if (sock == INVALID_SOCKET)
+            {
+                return;
+            }
+#ifdef _WIN32
+            closesocket(sock);
+#else
+            close(sock);
+#endif
+        }
+
+        /**
+         * Shut down both directions of a socket so that a blocked reader wakes up
+         */
+        inline void shutdownSocket(socket_t sock)
+        {
+            if (sock == INVALID_SOCKET)
+            {
+                return;
+            }
+#ifdef _WIN32
+            shutdown(sock, SD_BOTH);
+#else
+            shutdown(sock, SHUT_RDWR);
+#endif
+        }
+
+        /**
+         * Set the receive timeout of a socket
+         * @param sock Socket handle
+         * @param timeoutMs Timeout in milliseconds, 0 disables the timeout
+         */
+        inline void setReceiveTimeout(socket_t sock, int timeoutMs)
+        {
+#ifdef _WIN32
+            DWORD timeout = static_cast<DWORD>(timeoutMs);
+            setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char *>(&timeout), sizeof(timeout));
+#else
+            struct timeval tv;
+            tv.tv_sec = timeoutMs / 1000;
+            tv.tv_usec = (timeoutMs % 1000) * 1000;
+            setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+#endif
+        }
+
+        /**
+         * Enable SO_REUSEADDR on a socket
+         */
+        inline void setReuseAddress(socket_t sock)
+        {
+            int optval = 1;
+            setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char *>(&optval), sizeof(optval));
+        }
+
+        /**
+         * Send the whole buffer, retrying on short writes
+         * @return true if every byte was written
+         */
+        inline bool sendAll(socket_t sock, const char *data, size_t size)
+        {
+            size_t sent = 0;
+            while (sent < size)
+            {
+#if defined(_WIN32)
+                int n = send(sock, data + sent, static_cast<int>(size - sent), 0);
+#elif defined(MSG_NOSIGNAL)
+                ssize_t n = send(sock, data + sent, size - sent, MSG_NOSIGNAL);
+#else
+                ssize_t n = send(sock, data + sent, size - sent, 0);
+#endif
+                if (n <= 0)
+                {
+                    return false;
+                }
+                sent += static_cast<size_t>(n);
+            }
+            return true;
+        }
+
+        /**
+         * Receive exactly size bytes
+         * @return true if the buffer was filled, false on timeout, error or peer close
+         */
+        inline bool recvAll(socket_t sock, char *data, size_t size)
+        {
+            size_t received = 0;
+            while (received < size)
+            {
+#ifdef _WIN32
+                int n = recv(sock, data + received, static_cast<int>(size - received), 0);
+#else
+                ssize_t n = recv(sock, data + received, size - received, 0);
+#endif
+                if (n <= 0)
+                {
+                    return false;
+                }
+                received += static_cast<size_t>(n);
+            }
+            return true;
+        }
+
+        /**
+         * Build an IPv4 socket address
+         * @param address Dotted IPv4 address, empty or "0.0.0.0" binds all interfaces
+         * @param port Port number
+         */
+        inline sockaddr_in makeAddress(const std::string &address, int port)
+        {
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(static_cast<unsigned short>(port));
+            if (address.empty())
+            {
+                addr.sin_addr.s_addr = htonl(INADDR_ANY);
+            }
+            else
+            {
+                inet_pton(AF_INET, address.c_str(), &addr.sin_addr);
+            }
+            return addr;
+        }
+    } // namespace simulator
+} // namespace elink
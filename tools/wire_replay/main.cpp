@@ -0,0 +1,232 @@
+#include "core/wire_replay.h"
+#include "events/event_system.h"
+#include "types/internal/json_serializer.h"
+#include "utils/logger.h"
+#include "utils/utils.h"
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <csignal>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace elink;
+
+namespace
+{
+    struct ReplayOptions
+    {
+        std::vector<std::string> files;
+        WireReplayOptions replay;
+        bool publishToEventBus = true;
+        std::string eventsOutput;
+        std::string reportOutput;
+        int logLevel = 3;
+    };
+
+    std::vector<std::unique_ptr<WireReplay>> g_replays;
+
+    void onSignal(int)
+    {
+        for (auto &replay : g_replays)
+        {
+            replay->stop();
+        }
+    }
+
+    void printUsage(const char *program)
+    {
+        std::cout
+            << "Usage: " << program << " [options] <capture.elwc>...\n"
+            << "\n"
+            << "Replays wire captures through the SDK message adapter and printer pipeline.\n"
+            << "Several captures are replayed concurrently, one thread each.\n"
+            << "\n"
+            << "Options:\n"
+            << "  --speed <x>          Playback speed multiplier (default 1, captured timing)\n"
+            << "  --max                Replay as fast as possible (throughput benchmark)\n"
+            << "  --loops <n>          Passes over each capture (default 1)\n"
+            << "  --no-event-bus       Stop at the printer event callback, skip EventBus conversion\n"
+            << "  --events <file>      Write every emitted event as a JSON line (regression baselines)\n"
+            << "  --output <file>      Write the JSON report to a file\n"
+            << "  --log-level <0-6>    SDK log level (default 3, WARN)\n"
+            << "  -h, --help           Show this help\n";
+    }
+
+    bool parseArguments(int argc, char *argv[], ReplayOptions &options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string
+            {
+                if (i + 1 >= argc)
+                {
+                    throw std::invalid_argument(arg + " requires a value");
+                }
+                return argv[++i];
+            };
+
+            if (arg == "-h" || arg == "--help")
+                return false;
+            else if (arg == "--speed")
+                options.replay.speed = std::stod(value());
+            else if (arg == "--max")
+                options.replay.speed = 0.0;
+            else if (arg == "--loops")
+                options.replay.loops = std::stoi(value());
+            else if (arg == "--no-event-bus")
+                options.publishToEventBus = false;
+            else if (arg == "--events")
+                options.eventsOutput = value();
+            else if (arg == "--output")
+                options.reportOutput = value();
+            else if (arg == "--log-level")
+                options.logLevel = std::stoi(value());
+            else if (!arg.empty() && arg[0] == '-')
+                throw std::invalid_argument("unknown option " + arg);
+            else
+                options.files.push_back(arg);
+        }
+        if (options.replay.speed < 0.0)
+        {
+            throw std::invalid_argument("--speed must not be negative");
+        }
+        return !options.files.empty();
+    }
+
+    nlohmann::json statsToJson(const std::string &file, const PrinterInfo &info, const WireReplayStats &stats)
+    {
+        double duration = stats.durationSec > 0.0 ? stats.durationSec : 1e-9;
+        return {
+            {"file", file},
+            {"printer_type", printerTypeToString(info.printerType)},
+            {"model", info.model},
+            {"inbound_messages", stats.inboundMessages},
+            {"inbound_bytes", stats.inboundBytes},
+            {"outbound_messages_skipped", stats.outboundMessages},
+            {"commands_sent", stats.commandsSent},
+            {"events", stats.eventsDelivered},
+            {"captured_duration_sec", stats.capturedDurationSec},
+            {"duration_sec", stats.durationSec},
+            {"messages_per_sec", stats.inboundMessages / duration},
+            {"mb_per_sec", stats.inboundBytes / duration / (1024.0 * 1024.0)},
+            {"events_per_sec", stats.eventsDelivered / duration},
+            {"stopped", stats.stopped}};
+    }
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    ReplayOptions options;
+    try
+    {
+        if (!parseArguments(argc, argv, options))
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Invalid arguments: " << e.what() << "\n";
+        return 1;
+    }
+
+    LogConfig logConfig;
+    logConfig.level = static_cast<LogLevel>(options.logLevel);
+    Logger::getInstance().initialize(logConfig);
+
+    for (const auto &file : options.files)
+    {
+        auto replay = std::make_unique<WireReplay>();
+        if (!replay->load(file))
+        {
+            std::cerr << "Failed to load capture " << file << "\n";
+            return 1;
+        }
+        g_replays.push_back(std::move(replay));
+    }
+
+    std::ofstream eventsFile;
+    std::mutex eventsMutex;
+    if (!options.eventsOutput.empty())
+    {
+        eventsFile = PathUtils::openOutputStream(options.eventsOutput, std::ios::out | std::ios::trunc);
+        if (!eventsFile.is_open())
+        {
+            std::cerr << "Failed to open " << options.eventsOutput << "\n";
+            return 1;
+        }
+    }
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    // One EventBus per replay, as in the SDK each LanService owns one
+    std::vector<std::unique_ptr<EventBus>> eventBuses;
+    std::vector<WireReplayStats> results(g_replays.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < g_replays.size(); ++i)
+    {
+        eventBuses.push_back(std::make_unique<EventBus>());
+        EventBus *eventBus = options.publishToEventBus ? eventBuses.back().get() : nullptr;
+        std::ofstream *events = eventsFile.is_open() ? &eventsFile : nullptr;
+        threads.emplace_back([&, i, eventBus, events]()
+                             {
+                                 results[i] = g_replays[i]->run(
+                                     options.replay,
+                                     [&, eventBus, events](const BizEvent &event)
+                                     {
+                                         if (eventBus)
+                                         {
+                                             eventBus->publishFromEvent(event);
+                                         }
+                                         if (events)
+                                         {
+                                             nlohmann::json line = {{"file", options.files[i]},
+                                                                    {"method", static_cast<int>(event.method)},
+                                                                    {"data", event.data}};
+                                             std::lock_guard<std::mutex> lock(eventsMutex);
+                                             *events << line.dump() << "\n";
+                                         }
+                                     }); });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    nlohmann::json report = nlohmann::json::array();
+    std::cout << std::fixed << std::setprecision(1);
+    for (size_t i = 0; i < g_replays.size(); ++i)
+    {
+        const auto &stats = results[i];
+        report.push_back(statsToJson(options.files[i], g_replays[i]->getPrinterInfo(), stats));
+        double duration = stats.durationSec > 0.0 ? stats.durationSec : 1e-9;
+        std::cout << options.files[i] << ": " << stats.inboundMessages << " messages, "
+                  << stats.eventsDelivered << " events in " << std::setprecision(3) << stats.durationSec << " s"
+                  << std::setprecision(1) << " (captured " << stats.capturedDurationSec << " s), "
+                  << stats.inboundMessages / duration << " msg/s, "
+                  << stats.inboundBytes / duration / (1024.0 * 1024.0) << " MB/s"
+                  << (stats.stopped ? " [stopped]" : "") << "\n";
+    }
+
+    if (!options.reportOutput.empty())
+    {
+        auto file = PathUtils::openOutputStream(options.reportOutput, std::ios::out | std::ios::trunc);
+        if (!file.is_open())
+        {
+            std::cerr << "Failed to write report to " << options.reportOutput << "\n";
+            return 1;
+        }
+        file << report.dump(2) << std::endl;
+    }
+    return 0;
+}